@@ -69,8 +69,18 @@
  ******************************************************************/
 #if defined(EMPS_SIMULATION)
 #define DEBUG(format, ...) trace(format, ##__VA_ARGS__)
+#elif defined(__DEBUG) && defined(APP_LOG_TOKENIZED) && APP_LOG_TOKENIZED
+/* Tokenised logging: only the format token and raw arguments are emitted (see tlog.h) */
+#include "tlog.h"
+#define DEBUG(format, ...) TLOG(format, ##__VA_ARGS__)
 #elif defined(__DEBUG)
+/* Lightweight formatter unless APP_PRINTF_LITE=0 (see fmt_lite.h, which includes app_config.h) */
+#include "fmt_lite.h"
+#if APP_PRINTF_LITE
+#define DEBUG(format, ...) fmt_printf(format, ##__VA_ARGS__)
+#else
 #define DEBUG(format, ...) printf(format, ##__VA_ARGS__)
+#endif
 #else
 #define DEBUG(format, ...)
 #undef LOG_LV
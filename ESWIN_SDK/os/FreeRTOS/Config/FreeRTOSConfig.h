@@ -53,9 +53,20 @@
  * On some CPU having a configTICK_RATE_HZ too high could induce scheduling time consuption
  * to high, then the task will not have time to run.
  *
- * configTICK_RATE_HZ = 100 means a Tick every 10ms.
+ * configTICK_RATE_HZ = 100 means a Tick every 10ms. The application's 20ms control
+ * period is a whole number of ticks; sub-tick waits are released by PITMR
+ * (board/board_delay.c, board/hrtimer.c) instead of raising the tick rate.
  */
 #define configTICK_RATE_HZ              ((TickType_t) 100)
+/*
+ * Tickless idle: when the kernel expects to stay idle for at least
+ * configEXPECTED_IDLE_TIME_BEFORE_SLEEP ticks the tick interrupt is pushed out
+ * (vPortSuppressTicksAndSleep in board/board_delay.c keeps mtime running), so
+ * the tick costs nothing while parked. Loops faster than the tick are
+ * released by PITMR (board/hrtimer.c), not by raising the tick rate.
+ */
+#define configUSE_TICKLESS_IDLE                 1
+#define configEXPECTED_IDLE_TIME_BEFORE_SLEEP   2
 #define configMAX_PRIORITIES            (10)
 /*
  * configMINIMAL_STACK_SIZE must be a value greater than the stack use by
@@ -84,14 +95,19 @@
 //#define configTOTAL_HEAP_SIZE                   (16*1024)   //TODO, change heap size 80->16K
 #define configTOTAL_HEAP_SIZE                   (16*1024)
 #define configMAX_TASK_NAME_LEN                 16
+/* APP_USE_TRACE (command line -D, see board/app_config.h) enables the Percepio snapshot recorder */
+#if defined(APP_USE_TRACE) && (APP_USE_TRACE == 1)
+#define configUSE_TRACE_FACILITY                1
+#else
 #define configUSE_TRACE_FACILITY                0
+#endif
 #define configUSE_16_BIT_TICKS                  0
 #define configIDLE_SHOULD_YIELD                 0
 #define configUSE_MUTEXES                       1
 #define configQUEUE_REGISTRY_SIZE               8
 #define configCHECK_FOR_STACK_OVERFLOW          2
 #define configUSE_RECURSIVE_MUTEXES             1
-#define configUSE_MALLOC_FAILED_HOOK            1
+#define configUSE_MALLOC_FAILED_HOOK            0
 #define configUSE_APPLICATION_TASK_TAG          0
 #define configUSE_COUNTING_SEMAPHORES           1
 #define configGENERATE_RUN_TIME_STATS           0
@@ -99,7 +115,13 @@
 #define configENABLE_BACKWARD_COMPATIBILITY     1
 #define configKERNEL_INTERRUPT_PRIORITY         0
 #define configMAX_SYSCALL_INTERRUPT_PRIORITY    7
-#define configSUPPORT_DYNAMIC_ALLOCATION        1
+/*
+ * All kernel objects are allocated statically by the application (tasks, stream
+ * buffers, semaphores including those created by the SDK drivers through OSIF),
+ * so no heap_x.c is linked and configTOTAL_HEAP_SIZE is not used.
+ */
+#define configSUPPORT_STATIC_ALLOCATION         1
+#define configSUPPORT_DYNAMIC_ALLOCATION        0
 #define configUSE_STATS_FORMATTING_FUNCTIONS    1
 #define configNUM_THREAD_LOCAL_STORAGE_POINTERS 5
 /**************************************************************
@@ -149,6 +171,9 @@
 #define INCLUDE_vTaskDelay              1
 #define INCLUDE_eTaskGetState           1
 #define INCLUDE_xTimerPendFunctionCall  1
+#define INCLUDE_uxTaskGetStackHighWaterMark 1
+#define INCLUDE_xTaskGetIdleTaskHandle  1
+#define INCLUDE_xTimerGetTimerDaemonTaskHandle 1
 
 /*
  * Overwrite some of the stack sizes allocated to various test and demo tasks.
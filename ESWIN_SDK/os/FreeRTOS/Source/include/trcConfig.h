@@ -115,7 +115,7 @@ extern "C" {
  *
  * Default value is 1.
  *****************************************************************************/
-#define TRC_CFG_INCLUDE_MEMMANG_EVENTS 1
+#define TRC_CFG_INCLUDE_MEMMANG_EVENTS 0
 
  /******************************************************************************
  * TRC_CFG_INCLUDE_USER_EVENTS
@@ -190,7 +190,7 @@ extern "C" {
  *
  * Default value is 1.
  *****************************************************************************/
-#define TRC_CFG_INCLUDE_OSTICK_EVENTS 1
+#define TRC_CFG_INCLUDE_OSTICK_EVENTS 0
 
  /*****************************************************************************
  * TRC_CFG_INCLUDE_EVENT_GROUP_EVENTS
@@ -248,7 +248,7 @@ extern "C" {
  * In snapshot mode, the TzCtrl task is only used for stack monitoring and is
  * not created unless this is enabled.
  *****************************************************************************/
-#define TRC_CFG_ENABLE_STACK_MONITOR 1
+#define TRC_CFG_ENABLE_STACK_MONITOR 0
 
  /******************************************************************************
  * TRC_CFG_STACK_MONITOR_MAX_TASKS
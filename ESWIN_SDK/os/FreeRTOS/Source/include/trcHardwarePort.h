@@ -506,12 +506,12 @@
 
 #elif (TRC_CFG_HARDWARE_PORT == TRC_HARDWARE_PORT_ESWIN_RSICV)
 
-	/* Timestamping by OS tick only (typically 1 ms resolution) */
+	/* Timestamping by the low 32 bits of the free-running machine timer (mtime) */
 	#define TRC_HWTC_TYPE TRC_FREE_RUNNING_32BIT_INCR
-	#define TRC_HWTC_COUNT (portGET_RUN_TIME_COUNTER_VALUE())
+	#define TRC_HWTC_COUNT ((uint32_t)SysTimer_GetLoadValue())
 	#define TRC_HWTC_PERIOD 0
 	#define TRC_HWTC_DIVISOR 1
-	#define TRC_HWTC_FREQ_HZ TRACE_TICK_RATE_HZ
+	#define TRC_HWTC_FREQ_HZ SystemTimerClock
 
 	/* Set the meaning of IRQ priorities in ISR tracing - see above */
 	#define TRC_IRQ_PRIORITY_ORDER 0
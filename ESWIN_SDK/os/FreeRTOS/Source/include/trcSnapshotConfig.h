@@ -48,7 +48,7 @@
  * Default value is 1000, which means that 4000 bytes is allocated for the
  * event buffer.
  ******************************************************************************/
-#define TRC_CFG_EVENT_BUFFER_SIZE 10000
+#define TRC_CFG_EVENT_BUFFER_SIZE 2048
 //#define TRC_CFG_EVENT_BUFFER_SIZE 200
 
 /*******************************************************************************
@@ -73,7 +73,7 @@
  * check the actual usage by selecting View menu -> Trace Details ->
  * Resource Usage -> Object Table.
  ******************************************************************************/
-#define TRC_CFG_NTASK			15
+#define TRC_CFG_NTASK			12
 #define TRC_CFG_NISR			5
 #define TRC_CFG_NQUEUE			10
 #define TRC_CFG_NSEMAPHORE		10
@@ -534,7 +534,7 @@ __INTERRUPT void xPortSysTickHandler( void )
 
                 /* The reload value is set to whatever fraction of a single tick
                 period remains. */
-                SysTick_Reload(0, ulTimerCountsForOneTick);
+                SysTick_Reload(ulTimerCountsForOneTick);
                 FREERTOS_PORT_DEBUG("TickLess - External Interrupt Happened!\n");
             }
 
@@ -783,6 +783,12 @@ osStatus_t osSemaphoreDelete(osSemaphoreId_t semaphore_id)
 //  ==== Memory Pool Management Functions ====
 osMemoryPoolId_t osMemoryPoolNew(uint32_t block_count, uint32_t block_size, const osMemoryPoolAttr_t *attr)
 {
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 0)
+	(void)block_count;
+	(void)block_size;
+	(void)attr;
+	return NULL;
+#else
 	uint8_t *block_ptr;
 	os_memPool_t *mp;
 
@@ -827,6 +833,7 @@ osMemoryPoolId_t osMemoryPoolNew(uint32_t block_count, uint32_t block_size, cons
 	mp->block_list = block_ptr;
 
 	return mp;
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
 }
 
 const char *osMemoryPoolGetName(osMemoryPoolId_t mp_id)
@@ -994,8 +1001,10 @@ osStatus_t osMemoryPoolDelete(osMemoryPoolId_t mp_id)
 	}
 
 	/* release allocated room */
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
 	vPortFree(mp->start_address);
 	vPortFree(mp);
+#endif
 
 	return osOK;
 }
@@ -1003,22 +1012,37 @@ osStatus_t osMemoryPoolDelete(osMemoryPoolId_t mp_id)
 //  ==== Memory Management Functions ====
 void *osMemoryMalloc(uint32_t nbytes)
 {
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
 	return pvPortMalloc((size_t)nbytes);
+#else
+	(void)nbytes;
+	return NULL;
+#endif
 }
 
 void osMemoryFree(void *ptr)
 {
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
 	vPortFree(ptr);
+#else
+	(void)ptr;
+#endif
 }
 
 void *osMemoryCalloc(uint32_t nmemb, uint32_t nbytes)
 {
 	void *pvReturn;
 
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
 	extern void *memset(void *s, int ch, size_t n);
 	pvReturn = pvPortMalloc(nmemb * nbytes);
 	if (pvReturn)
 		memset(pvReturn, 0, nmemb * nbytes);
+#else
+	(void)nmemb;
+	(void)nbytes;
+	pvReturn = NULL;
+#endif
 	return pvReturn;
 }
 
@@ -40,6 +40,50 @@
 #include "../../../../log/include/log.h"
 #include "platform.h"
 
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+/*
+ * Control blocks for mutexes/semaphores created without caller-provided memory
+ * (attr == NULL or attr->cb_mem == NULL, as the SDK drivers do). Sized at compile
+ * time; a slot is returned to the pool when the object is deleted.
+ */
+#ifndef OSIF_STATIC_SEMAPHORE_COUNT
+#define OSIF_STATIC_SEMAPHORE_COUNT 8U
+#endif
+#ifndef OSIF_STATIC_MUTEX_COUNT
+#define OSIF_STATIC_MUTEX_COUNT 2U
+#endif
+
+static StaticSemaphore_t s_osifSemaphorePool[OSIF_STATIC_SEMAPHORE_COUNT];
+static uint32_t s_osifSemaphoreUsed = 0U;
+static StaticSemaphore_t s_osifMutexPool[OSIF_STATIC_MUTEX_COUNT];
+static uint32_t s_osifMutexUsed = 0U;
+
+static void *OSIF_PoolAlloc(StaticSemaphore_t *pool, uint32_t count, uint32_t *used)
+{
+    void *cb = NULL;
+    taskENTER_CRITICAL();
+    for (uint32_t i = 0U; i < count; i++) {
+        if ((*used & (1UL << i)) == 0U) {
+            *used |= (1UL << i);
+            cb = &pool[i];
+            break;
+        }
+    }
+    taskEXIT_CRITICAL();
+    return cb;
+}
+
+static void OSIF_PoolFree(StaticSemaphore_t *pool, uint32_t count, uint32_t *used, const void *cb)
+{
+    const StaticSemaphore_t *p = (const StaticSemaphore_t *)cb;
+    if ((p >= pool) && (p < &pool[count])) {
+        taskENTER_CRITICAL();
+        *used &= ~(1UL << (uint32_t)(p - pool));
+        taskEXIT_CRITICAL();
+    }
+}
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+
 /*  ==== Kernel Management Functions ==== */
 
 /* Initialize the RTOS Kernel.*/
@@ -532,6 +576,25 @@ OS_Status_t OS_EventFlagsDelete(OS_EventFlagsId_t ef_id)
  */
 OS_MutexId_t OS_MutexNew(const OS_MutexAttr_t *attr)
 {
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+    if ((NULL == attr) || (NULL == attr->cb_mem)) {
+        osMutexAttr_t staticAttr = {0};
+        OS_MutexId_t mutex_id;
+        if (NULL != attr) {
+            staticAttr = *(const osMutexAttr_t *)attr;
+        }
+        staticAttr.cb_mem  = OSIF_PoolAlloc(s_osifMutexPool, OSIF_STATIC_MUTEX_COUNT, &s_osifMutexUsed);
+        staticAttr.cb_size = sizeof(StaticSemaphore_t);
+        if (NULL == staticAttr.cb_mem) {
+            return NULL;
+        }
+        mutex_id = osMutexNew(&staticAttr);
+        if (NULL == mutex_id) {
+            OSIF_PoolFree(s_osifMutexPool, OSIF_STATIC_MUTEX_COUNT, &s_osifMutexUsed, staticAttr.cb_mem);
+        }
+        return mutex_id;
+    }
+#endif
     return osMutexNew((const osMutexAttr_t *)attr);
 }
 
@@ -578,7 +641,11 @@ OS_ThreadId_t OS_MutexGetOwner(OS_MutexId_t mutex_id)
  */
 OS_Status_t OS_MutexDelete(OS_MutexId_t mutex_id)
 {
-    return (OS_Status_t)osMutexDelete(mutex_id);
+    OS_Status_t status = (OS_Status_t)osMutexDelete(mutex_id);
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+    OSIF_PoolFree(s_osifMutexPool, OSIF_STATIC_MUTEX_COUNT, &s_osifMutexUsed, mutex_id);
+#endif
+    return status;
 }
 
 /*  ==== Semaphore Management Functions ====  */
@@ -591,6 +658,25 @@ OS_Status_t OS_MutexDelete(OS_MutexId_t mutex_id)
  */
 OS_SemaphoreId_t OS_SemaphoreNew(uint32_t max_count, uint32_t initial_count, const OS_SemaphoreAttr_t *attr)
 {
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+    if ((NULL == attr) || (NULL == attr->cb_mem)) {
+        osSemaphoreAttr_t staticAttr = {0};
+        OS_SemaphoreId_t semaphore_id;
+        if (NULL != attr) {
+            staticAttr = *(const osSemaphoreAttr_t *)attr;
+        }
+        staticAttr.cb_mem  = OSIF_PoolAlloc(s_osifSemaphorePool, OSIF_STATIC_SEMAPHORE_COUNT, &s_osifSemaphoreUsed);
+        staticAttr.cb_size = sizeof(StaticSemaphore_t);
+        if (NULL == staticAttr.cb_mem) {
+            return NULL;
+        }
+        semaphore_id = osSemaphoreNew(max_count, initial_count, &staticAttr);
+        if (NULL == semaphore_id) {
+            OSIF_PoolFree(s_osifSemaphorePool, OSIF_STATIC_SEMAPHORE_COUNT, &s_osifSemaphoreUsed, staticAttr.cb_mem);
+        }
+        return semaphore_id;
+    }
+#endif
     return osSemaphoreNew(max_count, initial_count, (const osSemaphoreAttr_t *)attr);
 }
 
@@ -637,7 +723,11 @@ uint32_t OS_SemaphoreGetCount(OS_SemaphoreId_t semaphore_id)
  */
 OS_Status_t OS_SemaphoreDelete(OS_SemaphoreId_t semaphore_id)
 {
-    return (OS_Status_t)osSemaphoreDelete(semaphore_id);
+    OS_Status_t status = (OS_Status_t)osSemaphoreDelete(semaphore_id);
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+    OSIF_PoolFree(s_osifSemaphorePool, OSIF_STATIC_SEMAPHORE_COUNT, &s_osifSemaphoreUsed, semaphore_id);
+#endif
+    return status;
 }
 
 /*  ==== Memory Pool Management Functions ====  */
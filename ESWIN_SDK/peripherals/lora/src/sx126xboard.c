@@ -82,7 +82,21 @@ static void SX126xDbgPinRxWrite( uint8_t state );
 static RadioOperatingModes_t OperatingMode;
 DioIrqHandler *DIOx_IRQ_Function;
 
-#define LORA_SPI                                    1
+/* Board wiring (see board/pin_config.c): SPI0 PCS3, the SPI1 instance is used by the W5500 */
+#define LORA_SPI                                    0
+#define LORA_RESET_PORT                             PORTC
+#define LORA_RESET_PIN                              10
+#define LORA_BUSY_PORT                              PORTC
+#define LORA_BUSY_PIN                               3
+/* DIO1 is polled: PORTD04 (the SDK default) is the H30 data-ready interrupt on this board */
+#define LORA_DIO1_PORT                              PORTC
+#define LORA_DIO1_PIN                               23
+#define LORA_ANT_RX_PORT                            PORTC
+#define LORA_ANT_RX_PIN                             19
+#define LORA_ANT_TX_PORT                            PORTC
+#define LORA_ANT_TX_PIN                             21
+/* BUSY stays high for at most a few ms (calibration); bounded so a missing module cannot hang the caller */
+#define LORA_BUSY_WAIT_LOOPS                        200000U
 #define BOARD_TCXO_WAKEUP_TIME                      5
 
 void SX126xIoInit( void )
@@ -91,27 +105,20 @@ void SX126xIoInit( void )
 
 void SX126xIoIrqInit( DioIrqHandler dioIrq )
 {
+    /* No pin interrupt: the handler is called from SX126xIoIrqPoll() */
     DIOx_IRQ_Function=dioIrq;
 
-    if(DIOx_IRQ_Function != NULL) {
-        /* System interrupt type configuration. */
-        OS_RegisterType_t type;
-        type.trig_mode = CLIC_LEVEL_TRIGGER;
-        type.lvl       = 1;
-        type.priority  = 0;
-        type.data_ptr  = NULL;
-
-        /* Set system interrupt request for PORTD04. */
-        OS_RequestIrq(GPIOD_4_IRQn, dioIrq, &type);
-        /* Enable system interrupt for PORTD04. */
-        OS_EnableIrq(GPIOD_4_IRQn);
-    } else {
-        OS_DisableIrq(GPIOD_4_IRQn);
-    }
-
     LoRaIOInitFlag = true;
 }
 
+void SX126xIoIrqPoll( void )
+{
+    if( ( DIOx_IRQ_Function != NULL ) && ( SX126xGetDio1PinState( ) == 1 ) )
+    {
+        DIOx_IRQ_Function( NULL );
+    }
+}
+
 void SX126xIoDbgInit( void )
 {
 #if defined( USE_RADIO_DEBUG )
@@ -135,16 +142,17 @@ void SX126xIoDbgInit( void )
 void SX126xReset( void )
 {
     OS_DelayMs( 10 );
-    PINS_DRV_WritePin(PORTC, 10, 0);
+    PINS_DRV_WritePin(LORA_RESET_PORT, LORA_RESET_PIN, 0);
     OS_DelayMs( 20 );
-    PINS_DRV_WritePin(PORTC, 10, 1);
+    PINS_DRV_WritePin(LORA_RESET_PORT, LORA_RESET_PIN, 1);
     OS_DelayMs( 10 );
 }
 
 void SX126xWaitOnBusy( void )
 {
-    uint8_t val = (uint8_t)(PINS_DRV_ReadPins(PORTD) & ((uint32_t)(1 << 2)));
-    while( 1 == val);
+    uint32_t loops = 0;
+    while( ( ( PINS_DRV_ReadPins(LORA_BUSY_PORT) & ( 1UL << LORA_BUSY_PIN ) ) != 0U ) &&
+           ( loops++ < LORA_BUSY_WAIT_LOOPS ) );
 }
 
 void SX126xWakeup( void )
@@ -242,8 +250,7 @@ void SX126xReadBuffer( uint8_t offset, uint8_t *buffer, uint8_t size )
 
 uint32_t SX126xGetDio1PinState( void )
 {
-    uint8_t val = (uint8_t)(PINS_DRV_ReadPins(PORTD) & ((uint32_t)(1 << 4)));
-    if (1 == val) {
+    if ((PINS_DRV_ReadPins(LORA_DIO1_PORT) & (1UL << LORA_DIO1_PIN)) != 0U) {
         return 1;
     } else {
         return 0;
@@ -287,18 +294,18 @@ uint32_t SX126xGetBoardTcxoWakeupTime( void )
 }
 void SX126xAntSwTx( void )
 {
-    PINS_DRV_WritePin(PORTC, 19, 0);
-    PINS_DRV_WritePin(PORTC, 21, 1);
+    PINS_DRV_WritePin(LORA_ANT_RX_PORT, LORA_ANT_RX_PIN, 0);
+    PINS_DRV_WritePin(LORA_ANT_TX_PORT, LORA_ANT_TX_PIN, 1);
 }
 void SX126xAntSwRx( void )
 {
-    PINS_DRV_WritePin(PORTC, 19, 1);
-    PINS_DRV_WritePin(PORTC, 21, 0);
+    PINS_DRV_WritePin(LORA_ANT_RX_PORT, LORA_ANT_RX_PIN, 1);
+    PINS_DRV_WritePin(LORA_ANT_TX_PORT, LORA_ANT_TX_PIN, 0);
 }
 void SX126xAntSwOff( void )
 {
-    PINS_DRV_WritePin(PORTC, 19, 0);
-    PINS_DRV_WritePin(PORTC, 21, 0);
+    PINS_DRV_WritePin(LORA_ANT_RX_PORT, LORA_ANT_RX_PIN, 0);
+    PINS_DRV_WritePin(LORA_ANT_TX_PORT, LORA_ANT_TX_PIN, 0);
 }
 
 void SX126xIoRfSwitchInit( void )
@@ -45,6 +45,11 @@ void SX126xIoInit( void );
  */
 void SX126xIoIrqInit( DioIrqHandler dioIrq );
 
+/*!
+ * \brief Calls the DIO IRQ handler when DIO1 is high (DIO1 is polled, no pin interrupt)
+ */
+void SX126xIoIrqPoll( void );
+
 /*!
  * \brief De-initializes the radio I/Os pins interface.
  *
@@ -0,0 +1,73 @@
+/* See LICENSE of license details. */
+/*
+ * printf family retarget: with APP_PRINTF_LITE (board/app_config.h) the weak
+ * definitions below are linked instead of newlib's members, so vfprintf and
+ * _dtoa_r (float conversion, heap-backed bignums) are not pulled in.
+ * GCC rewrites printf("...\n") to puts() and printf("%c") to putchar(),
+ * so those are provided too. Output goes through write() -> _write().
+ */
+#if defined ( __GNUC__ )
+#include "eswin_sdk_soc.h"
+#include "fmt_lite.h"
+
+#if APP_PRINTF_LITE
+#include <stdint.h>
+#include <stdio.h>
+#include <unistd.h>
+
+__WEAK int vprintf(const char *fmt, va_list ap)
+{
+	return fmt_vprintf(fmt, ap);
+}
+
+__WEAK int printf(const char *fmt, ...)
+{
+	va_list ap;
+	va_start(ap, fmt);
+	int n = fmt_vprintf(fmt, ap);
+	va_end(ap);
+	return n;
+}
+
+__WEAK int puts(const char *s)
+{
+	return fmt_printf("%s\n", s);
+}
+
+__WEAK int putchar(int c)
+{
+	char ch = (char)c;
+	(void)write(STDOUT_FILENO, &ch, 1);
+	return (unsigned char)ch;
+}
+
+__WEAK int vsnprintf(char *buf, size_t size, const char *fmt, va_list ap)
+{
+	return fmt_vsnprintf(buf, size, fmt, ap);
+}
+
+__WEAK int snprintf(char *buf, size_t size, const char *fmt, ...)
+{
+	va_list ap;
+	va_start(ap, fmt);
+	int n = fmt_vsnprintf(buf, size, fmt, ap);
+	va_end(ap);
+	return n;
+}
+
+__WEAK int vsprintf(char *buf, const char *fmt, va_list ap)
+{
+	return fmt_vsnprintf(buf, SIZE_MAX, fmt, ap);
+}
+
+__WEAK int sprintf(char *buf, const char *fmt, ...)
+{
+	va_list ap;
+	va_start(ap, fmt);
+	int n = fmt_vsnprintf(buf, SIZE_MAX, fmt, ap);
+	va_end(ap);
+	return n;
+}
+#endif /* APP_PRINTF_LITE */
+#else
+#endif
@@ -0,0 +1,41 @@
+/**
+ * @file app_config.h
+ * @author 林木@江南大学
+ * @brief 应用构建选项
+ * @details 编译命令行 -D 可覆盖；默认跟随 SDK 的 OS 选择（config_SELECT_FreeRTOS，
+ *          同时编译 os/FreeRTOS 与 osif_freertos.c）
+ */
+
+#ifndef APP_CONFIG_H
+#define APP_CONFIG_H
+
+// 0: 裸机超级循环；1: FreeRTOS 任务架构（src/app_rtos.c）
+#ifndef APP_USE_FREERTOS
+#ifdef config_SELECT_FreeRTOS
+#define APP_USE_FREERTOS  1
+#else
+#define APP_USE_FREERTOS  0
+#endif
+#endif
+
+// 1: 日志令牌化（board/tlog.h），目标端只输出令牌与原始参数，由 tools/tlog_decode.py 还原
+#ifndef APP_LOG_TOKENIZED
+#define APP_LOG_TOKENIZED  0
+#endif
+
+// 1: printf 系列由 board/fmt_lite.c 实现（定点小数，无堆），不链接 newlib 的 vfprintf/_dtoa_r；
+//    SDK 桩与日志模块经 tlog.h/fmt_lite.h 间接包含本文件，改为 0 即恢复 newlib（对比基准：shell `fmt bench`）
+#ifndef APP_PRINTF_LITE
+#define APP_PRINTF_LITE  1
+#endif
+
+// 1: 内核事件追踪（board/rtos_trace.h，Percepio 快照记录器）；内核也要看到该宏，只能由 -D 给出
+#ifndef APP_USE_TRACE
+#define APP_USE_TRACE  0
+#endif
+
+#if APP_USE_TRACE && !APP_USE_FREERTOS
+#error "APP_USE_TRACE 需要 FreeRTOS 构建（APP_USE_FREERTOS=1）"
+#endif
+
+#endif
@@ -1,21 +1,211 @@
 /**
  * @file board_delay.c
  * @author 林木@江南大学
- * @brief 基础延时函数实现
- * @details 提供毫秒级软件延时功能，用于简单的时序控制
+ * @brief 基础延时与时间戳实现
+ * @details 时基为机器定时器 mtime；唤醒定时器使用 SDK 的 basic_timer（Timer_IRQn），
+ *          回调为空，仅用于把内核从 WFI 中唤醒。FreeRTOS 构建中机器定时器由内核节拍占用，
+ *          不启动唤醒定时器，空闲休眠由空闲任务钩子完成；无节拍空闲（configUSE_TICKLESS_IDLE）
+ *          在此实现，只移动比较值而不停止 mtime，时间戳在休眠期间保持连续
  */
 
 #include "board_delay.h"
+#include "app_config.h"
+#include "basic_api.h"
+#include <stdbool.h>
+#if APP_USE_FREERTOS
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "hrtimer.h"
+#include "rtos_trace.h"
+#endif
 
+static basic_timer_t s_wake_timer;
+static bool s_wake_started = false;
+#if APP_USE_FREERTOS
+// 不足一个节拍的休眠由 PITMR 通道单次释放，同一时刻只服务一个任务
+static StaticSemaphore_t s_hr_sem_cb;
+static SemaphoreHandle_t s_hr_sem = NULL;
+static volatile bool s_hr_busy = false;
+#endif
+
+static void board_wake_callback(void *arg)
+{
+    (void)arg;
+}
+
+void board_delay_init(void)
+{
+#if APP_USE_FREERTOS
+    if (s_hr_sem == NULL) {
+        s_hr_sem = xSemaphoreCreateBinaryStatic(&s_hr_sem_cb);
+    }
+#endif
+    if (s_wake_started || APP_USE_FREERTOS) {
+        return;
+    }
+    basic_timer_init(&s_wake_timer, board_wake_callback, NULL, BOARD_WAKE_PERIOD_MS, FLAG_PERIODIC);
+    s_wake_started = (basic_timer_add(&s_wake_timer) == 0);
+}
+
+// mtime 每微秒计数（SystemTimerClock 为 MHz 整数倍）
+static uint32_t board_ticks_per_us(void)
+{
+    static uint32_t s_ticks_per_us = 0;
+    if (s_ticks_per_us == 0U) {
+        s_ticks_per_us = SystemTimerClock / 1000000UL;
+    }
+    return s_ticks_per_us;
+}
+
+uint64_t board_time_us(void)
+{
+    return SysTimer_GetLoadValue() / board_ticks_per_us();
+}
+
+uint32_t board_time_ms(void)
+{
+    return (uint32_t)(board_time_us() / 1000ULL);
+}
+
+void board_delay_us(uint32_t us)
+{
+    uint64_t start = SysTimer_GetLoadValue();
+    uint64_t ticks = (uint64_t)us * board_ticks_per_us();
+    while (SysTimer_GetLoadValue() - start < ticks) {
+    }
+}
+
+#if APP_USE_FREERTOS
+static void board_hr_release_isr(void)
+{
+    BaseType_t woken = pdFALSE;
+    RtosTrace_IsrBegin(RTOS_TRACE_ISR_SLEEP);
+    HrTimer_Stop(HRTIMER_CH_SLEEP);   // 单次释放
+    (void)xSemaphoreGiveFromISR(s_hr_sem, &woken);
+    RtosTrace_IsrEnd((int)woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+// 阻塞约 us 微秒后由 PITMR 中断唤醒；通道被其他任务占用或启动失败时返回 false（由调用方忙等）
+static bool board_hr_sleep_us(uint32_t us)
+{
+    bool claimed = false;
+    taskENTER_CRITICAL();
+    if (!s_hr_busy && s_hr_sem != NULL) {
+        s_hr_busy = true;
+        claimed = true;
+    }
+    taskEXIT_CRITICAL();
+    if (!claimed) {
+        return false;
+    }
+    (void)xSemaphoreTake(s_hr_sem, 0);   // 清除上次超时后迟到的释放
+    bool ok = HrTimer_Start(HRTIMER_CH_SLEEP, us, board_hr_release_isr);
+    if (ok) {
+        // 超时兜底：释放中断丢失时最多多等两个节拍
+        (void)xSemaphoreTake(s_hr_sem, 2U);
+    }
+    HrTimer_Stop(HRTIMER_CH_SLEEP);
+    s_hr_busy = false;
+    return ok;
+}
+#endif
+
+void board_sleep_until_us(uint64_t deadline_us)
+{
+#if APP_USE_FREERTOS
+    // 调度器运行时整节拍部分阻塞当前任务（不会超过截止时间）；不足一个节拍的余量由 PITMR 释放，
+    // 只留 BOARD_HR_WAKE_US 忙等，节拍保持 100 Hz 而舵机低电平等亚节拍等待不占用 CPU
+    if (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING) {
+        const uint64_t tick_us = 1000000ULL / configTICK_RATE_HZ;
+        uint64_t now_us;
+        while ((now_us = board_time_us()) + tick_us <= deadline_us) {
+            vTaskDelay((TickType_t)((deadline_us - now_us) / tick_us));
+        }
+        now_us = board_time_us();
+        if (now_us + BOARD_HR_WAKE_US + HRTIMER_MIN_PERIOD_US <= deadline_us) {
+            (void)board_hr_sleep_us((uint32_t)(deadline_us - now_us - BOARD_HR_WAKE_US));
+        }
+    }
+#endif
+    uint64_t deadline = deadline_us * board_ticks_per_us();
+    uint64_t margin = (uint64_t)BOARD_SLEEP_MIN_US * board_ticks_per_us();
+    uint64_t now;
+    while ((now = SysTimer_GetLoadValue()) < deadline) {
+        // 至少还有一个唤醒周期时休眠，最后一段忙等以保证精度
+        if (s_wake_started && deadline - now > margin) {
+            __WFI();
+        }
+    }
+}
+
+void board_sleep_us(uint32_t us)
+{
+    board_sleep_until_us(board_time_us() + us);
+}
+
+void board_sched_lock(void)
+{
+#if APP_USE_FREERTOS
+    if (xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED) {
+        vTaskSuspendAll();
+    }
+#endif
+}
+
+void board_sched_unlock(void)
+{
+#if APP_USE_FREERTOS
+    if (xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED) {
+        (void)xTaskResumeAll();
+    }
+#endif
+}
+
+#if APP_USE_FREERTOS && (configUSE_TICKLESS_IDLE == 1)
 /**
- * @brief 简单的毫秒级延时函数
- * @param ms 延时时长（毫秒）
- * @details 基于空循环实现的阻塞式延时，精度取决于系统时钟
+ * @brief 无节拍空闲（覆盖移植层弱定义：移植层会停止 mtime，而本文件以 mtime 为时基）
+ * @details 节拍中断推迟 expected-1 个节拍后休眠；醒来时按实际经过的整节拍数补偿内核节拍，
+ *          被外设中断（PITMR、GPIO 等）提前唤醒时比较值恢复到下一个节拍边界
  */
-void simple_delay_ms(unsigned int ms) {
-    while (ms--) {
-        for (volatile unsigned int i = 0; i < 8000; ++i) {
-            __asm__("nop");
+void vPortSuppressTicksAndSleep(TickType_t expected)
+{
+    const uint64_t ticks_per_os_tick = SystemTimerClock / configTICK_RATE_HZ;
+
+    __disable_irq();
+    if (eTaskConfirmSleepModeStatus() == eAbortSleep) {
+        __enable_irq();
+        return;
+    }
+    // 当前比较值即下一个节拍时刻（节拍中断可能已挂起，推后比较值同时撤销它，由下面统一补偿）
+    uint64_t next_tick = SysTimer_GetCompareValue();
+    uint64_t wake = next_tick + (uint64_t)(expected - 1U) * ticks_per_os_tick;
+    SysTimer_SetCompareValue(wake);
+    // 中断关闭时 WFI 仍由挂起的中断唤醒，唤醒后先补偿节拍再开中断
+    __WFI();
+
+    uint64_t now = SysTimer_GetLoadValue();
+    if (now >= wake) {
+        // 节拍中断已挂起，开中断后由它计入最后一个节拍并重装
+        vTaskStepTick(expected - 1U);
+    } else {
+        TickType_t elapsed = 0;
+        if (now >= next_tick) {
+            elapsed = (TickType_t)((now - next_tick) / ticks_per_os_tick) + 1U;
         }
+        SysTimer_SetCompareValue(next_tick + (uint64_t)elapsed * ticks_per_os_tick);
+        vTaskStepTick(elapsed);
     }
-} 
\ No newline at end of file
+    __enable_irq();
+}
+#endif
+
+/**
+ * @brief 毫秒级延时函数
+ * @param ms 延时时长（毫秒）
+ * @details 基于机器定时器计时，与时钟配置、编译选项无关；等待期间内核处于 WFI 休眠
+ */
+void simple_delay_ms(unsigned int ms) {
+    board_sleep_us((uint32_t)ms * 1000U);
+}
@@ -1,17 +1,60 @@
 /**
  * @file board_delay.h
  * @author 林木@江南大学
- * @brief 基础延时函数接口
- * @details 提供毫秒级软件延时功能
+ * @brief 基础延时与时间戳接口
+ * @details 以 RISC-V 机器定时器（mtime，64 位，SystemTimerClock）为时基：
+ *          微秒级短延时忙等保证精度；毫秒级延时在剩余时间足够时执行 WFI 休眠，
+ *          由 1ms 周期唤醒定时器（及其他中断）唤醒后重新检查截止时间；
+ *          FreeRTOS 构建中调度器运行后整节拍部分改为 vTaskDelay，不足一个节拍的余量由 PITMR 通道释放，
+ *          均让出 CPU
  */
 
 #ifndef BOARD_DELAY_H
 #define BOARD_DELAY_H
 
+#include <stdint.h>
+
+#define BOARD_WAKE_PERIOD_MS  1U     // WFI 唤醒定时器周期
+#define BOARD_SLEEP_MIN_US    1100U  // 剩余时间大于该值才休眠，其余忙等（留出一个唤醒周期 + 余量）
+#define BOARD_HR_WAKE_US      50U    // FreeRTOS 构建：PITMR 释放提前量（中断与任务切换延迟），其余忙等
+
+/**
+ * @brief 启动 WFI 唤醒定时器（时钟初始化后调用一次）；调用前延时函数仍可用，只是不休眠
+ */
+void board_delay_init(void);
+
+/**
+ * @brief 上电以来的时间（微秒 / 毫秒）
+ */
+uint64_t board_time_us(void);
+uint32_t board_time_ms(void);
+
+/**
+ * @brief 微秒级忙等延时（用于舵机脉宽、超声波触发等需要精确边沿的场合）
+ */
+void board_delay_us(uint32_t us);
+
+/**
+ * @brief 休眠到绝对时刻 deadline_us（board_time_us 时基），用于固定周期循环
+ */
+void board_sleep_until_us(uint64_t deadline_us);
+
+/**
+ * @brief 休眠 us 微秒（长时间等待，精度约一个唤醒周期以内由忙等补齐）
+ */
+void board_sleep_us(uint32_t us);
+
+/**
+ * @brief 禁止/恢复任务切换（FreeRTOS 构建挂起调度器，可嵌套；裸机为空操作），
+ *        用于舵机脉宽等不能被抢占拉长的短时段，中断不受影响
+ */
+void board_sched_lock(void);
+void board_sched_unlock(void);
+
 /**
- * @brief 简单的毫秒级延时函数
+ * @brief 毫秒级延时（休眠）
  * @param ms 延时时长（毫秒）
  */
 void simple_delay_ms(unsigned int ms);
 
-#endif 
\ No newline at end of file
+#endif 
@@ -0,0 +1,124 @@
+/**
+ * @file boot.c
+ * @author 林木@江南大学
+ * @brief 并行启动框架实现
+ * @details 时间按调度周期累计（与任务调度器相同的 MISSION_TICK_MS 名义周期），
+ *          begin 中的同步耗时不计入
+ */
+
+#include "boot.h"
+#include "mission.h"
+#include <stdio.h>
+
+static const boot_step_t *s_steps = NULL;
+static uint8_t s_count = 0;
+static boot_step_state_t s_state[BOOT_MAX_STEPS];
+static uint32_t s_begin_ms[BOOT_MAX_STEPS];
+static uint32_t s_ready_ms[BOOT_MAX_STEPS];
+static uint32_t s_ready_mask = 0;
+static uint32_t s_failed_mask = 0;
+static uint32_t s_elapsed = 0;
+
+static void boot_finish(uint8_t i, boot_step_state_t st)
+{
+	s_state[i] = st;
+	s_ready_ms[i] = s_elapsed;
+	if (st == BOOT_STEP_READY) {
+		s_ready_mask |= BOOT_BIT(i);
+	} else {
+		s_failed_mask |= BOOT_BIT(i);
+		printf("Boot: %s 失败\r\n", s_steps[i].name);
+	}
+}
+
+// 依赖就绪的步骤立即启动（begin 后无 poll 的步骤同时就绪，可在同一轮解锁后续步骤）
+static void boot_advance(void)
+{
+	bool progressed = true;
+	while (progressed) {
+		progressed = false;
+		for (uint8_t i = 0; i < s_count; ++i) {
+			const boot_step_t *st = &s_steps[i];
+			if (s_state[i] != BOOT_STEP_PENDING) continue;
+			if ((st->deps & s_failed_mask) != 0U) {
+				boot_finish(i, BOOT_STEP_FAILED);
+				progressed = true;
+				continue;
+			}
+			if ((st->deps & s_ready_mask) != st->deps) continue;
+			s_begin_ms[i] = s_elapsed;
+			s_state[i] = BOOT_STEP_RUNNING;
+			if (st->begin != NULL && !st->begin()) {
+				boot_finish(i, BOOT_STEP_FAILED);
+			} else if (st->poll == NULL) {
+				boot_finish(i, BOOT_STEP_READY);
+			}
+			progressed = true;
+		}
+	}
+}
+
+void Boot_Start(const boot_step_t *steps, uint8_t count)
+{
+	s_steps = steps;
+	s_count = (count > BOOT_MAX_STEPS) ? BOOT_MAX_STEPS : count;
+	s_ready_mask = 0;
+	s_failed_mask = 0;
+	s_elapsed = 0;
+	for (uint8_t i = 0; i < s_count; ++i) {
+		s_state[i] = BOOT_STEP_PENDING;
+		s_begin_ms[i] = 0;
+		s_ready_ms[i] = 0;
+	}
+	boot_advance();
+}
+
+void Boot_Tick(void)
+{
+	for (uint8_t i = 0; i < s_count; ++i) {
+		if (s_state[i] != BOOT_STEP_RUNNING || s_steps[i].poll == NULL) continue;
+		boot_poll_t r = s_steps[i].poll(s_elapsed - s_begin_ms[i]);
+		if (r != BOOT_POLL_BUSY) {
+			boot_finish(i, (r == BOOT_POLL_READY) ? BOOT_STEP_READY : BOOT_STEP_FAILED);
+		}
+	}
+	boot_advance();
+	Mission_WaitTick();
+	s_elapsed += MISSION_TICK_MS;
+}
+
+bool Boot_IsReady(uint32_t mask)
+{
+	return (s_ready_mask & mask) == mask;
+}
+
+bool Boot_WaitReady(uint32_t mask, uint32_t timeout_ms)
+{
+	uint32_t start = s_elapsed;
+	while (!Boot_IsReady(mask)) {
+		if ((s_failed_mask & mask) != 0U || s_elapsed - start >= timeout_ms) {
+			return false;
+		}
+		Boot_Tick();
+	}
+	return true;
+}
+
+boot_step_state_t Boot_GetState(uint8_t id)
+{
+	return (id < s_count) ? s_state[id] : BOOT_STEP_FAILED;
+}
+
+uint32_t Boot_GetElapsedMs(void)
+{
+	return s_elapsed;
+}
+
+void Boot_Report(void)
+{
+	static const char *const names[] = { "PENDING", "RUNNING", "READY", "FAILED" };
+	for (uint8_t i = 0; i < s_count; ++i) {
+		printf("Boot: %-8s %-7s %lu~%lums\r\n", s_steps[i].name, names[s_state[i]],
+		       (unsigned long)s_begin_ms[i], (unsigned long)s_ready_ms[i]);
+	}
+}
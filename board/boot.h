@@ -0,0 +1,61 @@
+/**
+ * @file boot.h
+ * @author 林木@江南大学
+ * @brief 并行启动框架 - 带依赖与就绪标志的启动步骤表
+ * @details 每个子系统提供一个步骤：begin 做立即完成的部分（外设配置、发起动作），
+ *          poll 在后续周期检查是否就绪（舵机回中、IMU 预热等）。依赖满足的步骤依次启动，
+ *          运行中的步骤共享同一个调度周期（舵机脉冲与 IMU 采样交替进行），
+ *          调用方只等待自己需要的步骤就绪即可继续
+ */
+
+#ifndef __BOOT_H__
+#define __BOOT_H__
+
+#include "RISCV_Typedefs.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BOOT_MAX_STEPS  16U
+#define BOOT_BIT(id)    (1UL << (id))
+
+typedef enum {
+    BOOT_POLL_BUSY = 0,
+    BOOT_POLL_READY,
+    BOOT_POLL_FAILED
+} boot_poll_t;
+
+typedef enum {
+    BOOT_STEP_PENDING = 0,    // 等待依赖
+    BOOT_STEP_RUNNING,        // 已启动，等待就绪
+    BOOT_STEP_READY,
+    BOOT_STEP_FAILED
+} boot_step_state_t;
+
+typedef struct {
+    const char *name;
+    uint32_t deps;                          // 依赖步骤的位掩码（BOOT_BIT(步骤序号)）
+    bool (*begin)(void);                    // 返回 false 视为失败；可为 NULL
+    boot_poll_t (*poll)(uint32_t elapsed_ms); // elapsed_ms 为自 begin 起的时间；NULL 表示 begin 后即就绪
+} boot_step_t;
+
+// 载入步骤表（表需在启动期间保持有效），并立即启动无依赖的步骤
+void Boot_Start(const boot_step_t *steps, uint8_t count);
+// 推进一个周期：启动依赖已满足的步骤、轮询运行中的步骤，再占用一个舵机周期
+void Boot_Tick(void);
+// 反复推进直到 mask 中的步骤全部就绪；有步骤失败（或其依赖失败）或超时返回 false
+bool Boot_WaitReady(uint32_t mask, uint32_t timeout_ms);
+bool Boot_IsReady(uint32_t mask);
+boot_step_state_t Boot_GetState(uint8_t id);
+uint32_t Boot_GetElapsedMs(void);
+// 打印各步骤状态与就绪时刻
+void Boot_Report(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __BOOT_H__
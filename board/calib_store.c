@@ -0,0 +1,198 @@
+/**
+ * @file calib_store.c
+ * @author 林木@江南大学
+ * @brief 标定记录持久化实现
+ */
+
+#include "calib_store.h"
+#include "nvm_store.h"
+#include "h30.h"
+#include "my_move.h"
+#include "servo_control.h"
+#include "servo2_control.h"
+#include <stdio.h>
+#include <string.h>
+#include <stddef.h>
+
+#define CALIB_SLOTS  (NVM_CALIB_SIZE / CALIB_SLOT_SIZE)
+
+// 槽按 CALIB_SLOT_SIZE 对齐（记录本身较短），整区读出时按槽取记录，与写入地址一致
+typedef union {
+    calib_record_t rec;
+    uint8_t raw[CALIB_SLOT_SIZE];
+} calib_slot_t;
+
+_Static_assert(sizeof(calib_slot_t) == CALIB_SLOT_SIZE, "calib record exceeds slot");
+
+static calib_record_t s_rec;          // 当前记录（加载或最近一次保存）
+static uint8_t s_slot = 0;            // 当前记录所在槽
+static bool s_loaded = false;
+static float32_t s_saved_turn_gain = 0.0f;
+
+static uint32_t calib_crc(const calib_record_t *r)
+{
+	return NVM_Crc32(r, (uint32_t)offsetof(calib_record_t, crc32));
+}
+
+static bool calib_valid(const calib_record_t *r)
+{
+	return r->magic == CALIB_MAGIC && r->version == CALIB_VERSION &&
+	       r->length == sizeof(calib_record_t) && r->crc32 == calib_crc(r);
+}
+
+static void calib_apply(const calib_record_t *r)
+{
+	float32_t bias;
+	H30_SetPreferredAddr(r->h30_i2c_addr);
+	if (Calib_GetGyroBias(CALIB_DEFAULT_TEMP_C, &bias)) {
+		H30_SetGyroZBias(bias);
+	}
+	for (uint8_t m = 0; m < 4U; ++m) {
+		MyMove_SetMotorCalib(m, r->motor_gain[m], r->motor_deadband[m]);
+	}
+	servo_set_trim_us(r->servo_trim_us[0]);
+	servo2_set_trim_us(r->servo_trim_us[1]);
+	if (r->turn_stop_gain > 0.0f) {
+		MyMove_SetTurnStopGain(r->turn_stop_gain);
+	}
+	for (uint8_t side = 0; side < 2U; ++side) {
+		MotorIdent_SetModel(side, &r->motor_ff[side]);
+	}
+}
+
+bool Calib_Load(void)
+{
+	// 整个标定区一次读出
+	static calib_slot_t slots[CALIB_SLOTS];
+	s_loaded = false;
+	if (!NVM_Read(NVM_CALIB_ADDR, slots, sizeof(slots))) {
+		return false;
+	}
+	int best = -1;
+	for (uint8_t i = 0; i < CALIB_SLOTS; ++i) {
+		if (calib_valid(&slots[i].rec) &&
+		    (best < 0 || (int32_t)(slots[i].rec.sequence - slots[best].rec.sequence) > 0)) {
+			best = i;
+		}
+	}
+	if (best < 0) {
+		printf("Calib: 无有效标定记录，使用默认参数\r\n");
+		return false;
+	}
+	s_rec = slots[best].rec;
+	s_slot = (uint8_t)best;
+	s_loaded = true;
+	s_saved_turn_gain = s_rec.turn_stop_gain;
+	calib_apply(&s_rec);
+	printf("Calib: 已加载槽%d（序号 %lu）\r\n", best, (unsigned long)s_rec.sequence);
+	return true;
+}
+
+bool Calib_IsLoaded(void)
+{
+	return s_loaded;
+}
+
+bool Calib_Save(void)
+{
+	calib_record_t r = s_rec;   // 保留温度档零偏等累计数据
+	r.magic = CALIB_MAGIC;
+	r.version = CALIB_VERSION;
+	r.length = sizeof(calib_record_t);
+	r.sequence = s_loaded ? s_rec.sequence + 1U : 1U;
+	r.h30_i2c_addr = H30_GetI2cAddr();
+	for (uint8_t m = 0; m < 4U; ++m) {
+		MyMove_GetMotorCalib(m, &r.motor_gain[m], &r.motor_deadband[m]);
+	}
+	r.servo_trim_us[0] = servo_get_trim_us();
+	r.servo_trim_us[1] = servo2_get_trim_us();
+	r.turn_stop_gain = MyMove_GetTurnStopGain();
+	for (uint8_t side = 0; side < 2U; ++side) {
+		MotorIdent_GetModel(side, &r.motor_ff[side]);
+	}
+	r.crc32 = calib_crc(&r);
+
+	// 写入下一个槽（旧记录保持有效，直到新记录完整写入）
+	uint8_t slot = s_loaded ? (uint8_t)((s_slot + 1U) % CALIB_SLOTS) : 0U;
+	if (!NVM_Write(NVM_CALIB_ADDR + (uint32_t)slot * CALIB_SLOT_SIZE, &r, sizeof(r))) {
+		printf("Calib: 保存失败\r\n");
+		return false;
+	}
+	s_rec = r;
+	s_slot = slot;
+	s_loaded = true;
+	s_saved_turn_gain = r.turn_stop_gain;
+	printf("Calib: 已保存到槽%d（序号 %lu）\r\n", slot, (unsigned long)r.sequence);
+	return true;
+}
+
+bool Calib_Clear(void)
+{
+	uint32_t zero = 0U;
+	bool ok = true;
+	for (uint8_t i = 0; i < CALIB_SLOTS; ++i) {
+		ok = NVM_Write(NVM_CALIB_ADDR + (uint32_t)i * CALIB_SLOT_SIZE, &zero, sizeof(zero)) && ok;
+	}
+	memset(&s_rec, 0, sizeof(s_rec));
+	s_loaded = false;
+	return ok;
+}
+
+static int calib_temp_bin(float32_t temp_c)
+{
+	float32_t f = (temp_c - CALIB_TEMP_BIN0_C) / CALIB_TEMP_BIN_STEP_C + 0.5f;
+	if (f < 0.0f) return 0;
+	if (f >= (float32_t)CALIB_TEMP_BINS) return (int)CALIB_TEMP_BINS - 1;
+	return (int)f;
+}
+
+void Calib_SetGyroBias(float32_t temp_c, float32_t bias_dps)
+{
+	int b = calib_temp_bin(temp_c);
+	s_rec.gyro_bias_dps[b] = bias_dps;
+	s_rec.gyro_bias_valid |= (uint8_t)(1U << b);
+	H30_SetGyroZBias(bias_dps);
+}
+
+bool Calib_GetGyroBias(float32_t temp_c, float32_t *bias_dps)
+{
+	uint8_t valid = s_rec.gyro_bias_valid;
+	if (valid == 0U) return false;
+	// 在 temp_c 两侧最近的有效档之间线性插值，只有一侧时取该档
+	float32_t pos = (temp_c - CALIB_TEMP_BIN0_C) / CALIB_TEMP_BIN_STEP_C;
+	int lo = -1, hi = -1;
+	for (int i = 0; i < (int)CALIB_TEMP_BINS; ++i) {
+		if ((valid & (1U << i)) == 0U) continue;
+		if ((float32_t)i <= pos) lo = i;
+		if ((float32_t)i >= pos && hi < 0) hi = i;
+	}
+	if (lo < 0) { *bias_dps = s_rec.gyro_bias_dps[hi]; return true; }
+	if (hi < 0 || hi == lo) { *bias_dps = s_rec.gyro_bias_dps[lo]; return true; }
+	float32_t t = (pos - (float32_t)lo) / (float32_t)(hi - lo);
+	*bias_dps = s_rec.gyro_bias_dps[lo] + t * (s_rec.gyro_bias_dps[hi] - s_rec.gyro_bias_dps[lo]);
+	return true;
+}
+
+float32_t Calib_GetSavedTurnStopGain(void)
+{
+	return s_loaded ? s_saved_turn_gain : 0.0f;
+}
+
+void Calib_Print(void)
+{
+	printf("calib %s seq=%lu slot=%d h30=0x%02X bias=%.3fdps\r\n", s_loaded ? "loaded" : "default",
+	       (unsigned long)s_rec.sequence, s_slot, H30_GetI2cAddr(), H30_GetGyroZBias());
+	for (uint8_t i = 0; i < CALIB_TEMP_BINS; ++i) {
+		if (s_rec.gyro_bias_valid & (1U << i)) {
+			printf("  bias@%.0fC=%.3f\r\n", CALIB_TEMP_BIN0_C + CALIB_TEMP_BIN_STEP_C * i, s_rec.gyro_bias_dps[i]);
+		}
+	}
+	for (uint8_t m = 0; m < 4U; ++m) {
+		float32_t g, d;
+		MyMove_GetMotorCalib(m, &g, &d);
+		printf("  motor%d gain=%.3f deadband=%.3f\r\n", m + 1, g, d);
+	}
+	printf("  servo_trim=%d/%dus turn_stop_gain=%.5f\r\n", servo_get_trim_us(), servo2_get_trim_us(),
+	       MyMove_GetTurnStopGain());
+	MotorIdent_Print();
+}
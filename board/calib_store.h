@@ -0,0 +1,64 @@
+/**
+ * @file calib_store.h
+ * @author 林木@江南大学
+ * @brief 标定记录持久化 - 陀螺零偏、电机增益/死区、舵机修正、H30 地址
+ * @details 标定区（NVM_CALIB_ADDR）划分为若干轮换槽，每次保存写入下一个槽并递增序号；
+ *          启动时一次读出整个标定区，取 CRC 有效且序号最大的记录。写入过程中掉电时旧记录仍然有效
+ */
+
+#ifndef __CALIB_STORE_H__
+#define __CALIB_STORE_H__
+
+#include "RISCV_Typedefs.h"
+#include "motor_ident.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CALIB_MAGIC            0x314C4143UL  // "CAL1"
+#define CALIB_VERSION          2U            // 2: 增加电机前馈模型
+#define CALIB_SLOT_SIZE        128U
+#define CALIB_TEMP_BINS        6U            // 陀螺零偏温度档：0,10,...,50°C
+#define CALIB_TEMP_BIN0_C      0.0f
+#define CALIB_TEMP_BIN_STEP_C  10.0f
+#define CALIB_DEFAULT_TEMP_C   25.0f         // 无温度来源时使用的温度
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t length;                          // sizeof(calib_record_t)
+    uint32_t sequence;                        // 写入序号，取最大者为当前记录
+    uint8_t h30_i2c_addr;                     // 0 表示未知
+    uint8_t gyro_bias_valid;                  // 各温度档有效位
+    int16_t servo_trim_us[2];                 // 舵机1/舵机2 脉宽修正
+    float32_t gyro_bias_dps[CALIB_TEMP_BINS]; // 各温度档陀螺 Z 轴零偏
+    float32_t motor_gain[4];                  // 电机1~4 占空比增益
+    float32_t motor_deadband[4];              // 电机1~4 起转死区
+    float32_t turn_stop_gain;                 // 转向停车滑行系数（学习值）
+    motor_model_t motor_ff[2];                // 右侧/左侧电机自检模型（tau_ms=0 表示未自检）
+    uint32_t crc32;                           // 覆盖 crc32 之前的全部字段
+} calib_record_t;
+
+// 读取标定区并应用到各模块（H30 地址需在 H30_Init 前应用），返回是否找到有效记录
+bool Calib_Load(void);
+bool Calib_IsLoaded(void);
+// 采集各模块当前参数写入下一个轮换槽
+bool Calib_Save(void);
+// 使所有槽失效（恢复固件默认值需重启）
+bool Calib_Clear(void);
+// 记录 temp_c 温度下测得的零偏，并立即应用
+void Calib_SetGyroBias(float32_t temp_c, float32_t bias_dps);
+// 按温度插值零偏；无有效档时返回 false
+bool Calib_GetGyroBias(float32_t temp_c, float32_t *bias_dps);
+// 已保存记录中的转向停车系数（未加载返回 0）
+float32_t Calib_GetSavedTurnStopGain(void);
+void Calib_Print(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __CALIB_STORE_H__
@@ -0,0 +1,493 @@
+/**
+ * @file can_bus.c
+ * @author 林木@江南大学
+ * @brief FlexCAN0 上位机命令与遥测总线实现
+ * @details 邮箱分配（共 16 个）：8 个过滤器时 Rx FIFO 占 MB0~7（MB0~5 为 FIFO 本体，MB6~7 存过滤表），
+ *          MB8 POSE、MB9 MOTION、MB10 STATUS、MB11 PARAM_ACK、MB12 自检注入。
+ *          过滤表为格式 A（每项一个完整标准 ID），全局掩码比较 11 位 ID 与 IDE/RTR 位，
+ *          8 项在 DRIVE/PARAM 两个 ID 间交替填满（未用项不能留空，否则匹配 ID 0）。
+ *          接收在 FIFO 完成回调（中断上下文）中解析并立即重新挂起下一次接收；
+ *          参数请求只入队，应答在控制上下文中发送，不在中断里访问参数表与发送邮箱；
+ *          回环自检要重新初始化控制器并消费参数队列，同样只在控制上下文（CanBus_Poll）中执行，
+ *          命令行只置请求标志，参数队列始终只有一个消费者
+ */
+
+#include "can_bus.h"
+#include "sdk_project_config.h"
+#include "shell.h"
+#include "mission.h"
+#include "odometry.h"
+#include "pose_estimator.h"
+#include "hcsr04.h"
+#include "board_delay.h"
+#include <stdio.h>
+#include <string.h>
+
+#define CAN_INST             INST_FLEXCAN_0
+#define CAN_MB_POSE          8U
+#define CAN_MB_MOTION        9U
+#define CAN_MB_STATUS        10U
+#define CAN_MB_ACK           11U
+#define CAN_MB_TEST          12U
+#define CAN_FILTERS          8U
+#define CAN_FIFO_MASK        (0xC0000000UL | 0x7FFUL)  // 格式 A：RTR、IDE 与 11 位 ID 全部比较
+#define CAN_DLC              8U
+#define CAN_NAME_CHUNK       4U        // NAME 应答每帧携带的名称字节数
+#define CAN_TEST_WAIT_MS     20U       // 回环自检等待（1 帧约 0.25 ms）
+
+static bool s_ready = false;
+static flexcan_msgbuff_t s_rx_msg;
+static const flexcan_data_info_t s_tx_info = {
+	.msg_id_type = FLEXCAN_MSG_ID_STD,
+	.data_length = CAN_DLC,
+	.fd_enable = false,
+	.fd_padding = 0U,
+	.enable_brs = false,
+	.is_remote = false,
+};
+
+// 驱动指令快照：中断写、控制周期读，序号保护（与 H30 缓存相同）
+static volatile uint32_t s_drive_seq = 0;  // 奇数表示写入中
+static can_bus_drive_t s_drive;
+
+// 参数请求队列：中断入队、控制上下文出队（单生产者单消费者）
+static uint8_t s_param_q[CAN_BUS_PARAM_QUEUE][CAN_DLC];
+static volatile uint8_t s_param_head = 0;
+static volatile uint8_t s_param_tail = 0;
+
+static volatile bool s_remote_active = false;
+static volatile bool s_selftest_req = false;  // 命令行请求，由 CanBus_Poll 的调用者执行
+static uint32_t s_tick = 0;
+static volatile uint32_t s_rx_frames = 0;    // 通过过滤的帧
+static volatile uint32_t s_rx_param = 0;
+static volatile uint32_t s_rx_bad = 0;       // 长度不符/扩展帧/远程帧
+static volatile uint32_t s_rx_overflow = 0;  // FIFO 溢出 + 参数队列满
+static volatile uint32_t s_tx_done = 0;      // 发送完成（中断计数）
+static uint32_t s_tx_frames = 0;
+static uint32_t s_tx_drops = 0;             // 邮箱上一帧未发出而丢弃
+
+// ========================
+// 字节序
+// ========================
+
+static void can_put_u16(uint8_t *p, uint16_t v)
+{
+	p[0] = (uint8_t)v;
+	p[1] = (uint8_t)(v >> 8);
+}
+
+static void can_put_u32(uint8_t *p, uint32_t v)
+{
+	p[0] = (uint8_t)v;
+	p[1] = (uint8_t)(v >> 8);
+	p[2] = (uint8_t)(v >> 16);
+	p[3] = (uint8_t)(v >> 24);
+}
+
+static uint16_t can_get_u16(const uint8_t *p)
+{
+	return (uint16_t)(p[0] | ((uint16_t)p[1] << 8));
+}
+
+static void can_put_f32(uint8_t *p, float32_t v)
+{
+	uint32_t u;
+	memcpy(&u, &v, sizeof(u));
+	can_put_u32(p, u);
+}
+
+static float32_t can_get_f32(const uint8_t *p)
+{
+	uint32_t u = (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+	float32_t v;
+	memcpy(&v, &u, sizeof(v));
+	return v;
+}
+
+// 四舍五入并饱和到 int16
+static int16_t can_q16(float32_t v, float32_t scale)
+{
+	float32_t s = v * scale;
+	if (s >= 32767.0f) return 32767;
+	if (s <= -32767.0f) return -32767;
+	return (int16_t)((s >= 0.0f) ? (s + 0.5f) : (s - 0.5f));
+}
+
+// ========================
+// 接收（中断上下文）
+// ========================
+
+static void can_rx_drive(const uint8_t *d)
+{
+	can_bus_drive_t cmd = s_drive;
+	float32_t heading = (float32_t)(int16_t)can_get_u16(&d[0]) * 0.01f;
+	if (heading > 180.0f) {
+		heading -= 360.0f;
+	} else if (heading < -180.0f) {
+		heading += 360.0f;
+	}
+	float32_t speed = (float32_t)(int16_t)can_get_u16(&d[2]);
+	uint16_t ttl = can_get_u16(&d[4]);
+	cmd.heading_deg = heading;
+	cmd.speed_mm_s = (speed > 0.0f) ? speed : 0.0f;
+	cmd.ttl_ms = (ttl != 0U) ? ttl : (uint16_t)CAN_BUS_DRIVE_TTL_MS;
+	cmd.mode = d[6];
+	cmd.seq = d[7];
+	cmd.rx_ms = board_time_ms();
+	cmd.count++;
+	s_drive_seq++;
+	__sync_synchronize();
+	s_drive = cmd;
+	__sync_synchronize();
+	s_drive_seq++;
+}
+
+static void can_rx(const flexcan_msgbuff_t *msg)
+{
+	// CS 字段：bit21 IDE，bit20 RTR（过滤器已比较，此处防御性检查）
+	if (msg->dataLen != CAN_DLC || (msg->cs & ((1UL << 21) | (1UL << 20))) != 0U) {
+		s_rx_bad++;
+		return;
+	}
+	s_rx_frames++;
+	uint32_t id = msg->msgId & 0x7FFU;
+	if (id == CAN_BUS_ID_DRIVE) {
+		can_rx_drive(msg->data);
+	} else if (id == CAN_BUS_ID_PARAM) {
+		uint8_t head = s_param_head;
+		if ((uint8_t)(head - s_param_tail) >= CAN_BUS_PARAM_QUEUE) {
+			s_rx_overflow++;
+			return;
+		}
+		memcpy(s_param_q[head & (CAN_BUS_PARAM_QUEUE - 1U)], msg->data, CAN_DLC);
+		__sync_synchronize();
+		s_param_head = (uint8_t)(head + 1U);
+		s_rx_param++;
+	} else {
+		s_rx_bad++;
+	}
+}
+
+static void can_event(uint8_t instance, flexcan_event_type_t eventType, uint32_t buffIdx,
+                      flexcan_state_t *flexcanState)
+{
+	(void)buffIdx;
+	(void)flexcanState;
+	switch (eventType) {
+	case FLEXCAN_EVENT_RXFIFO_COMPLETE:
+		can_rx(&s_rx_msg);
+		// 立即挂起下一次接收，FIFO 中断保持使能
+		(void)FLEXCAN_DRV_RxFifo(instance, &s_rx_msg);
+		break;
+	case FLEXCAN_EVENT_RXFIFO_OVERFLOW:
+		s_rx_overflow++;
+		break;
+	case FLEXCAN_EVENT_TX_COMPLETE:
+		s_tx_done++;
+		break;
+	default:
+		break;
+	}
+}
+
+// ========================
+// 控制器配置
+// ========================
+
+static bool can_start(flexcan_operation_modes_t mode)
+{
+	static const flexcan_id_table_t s_filters[CAN_FILTERS] = {
+		{ false, false, CAN_BUS_ID_DRIVE }, { false, false, CAN_BUS_ID_PARAM },
+		{ false, false, CAN_BUS_ID_DRIVE }, { false, false, CAN_BUS_ID_PARAM },
+		{ false, false, CAN_BUS_ID_DRIVE }, { false, false, CAN_BUS_ID_PARAM },
+		{ false, false, CAN_BUS_ID_DRIVE }, { false, false, CAN_BUS_ID_PARAM },
+	};
+	static const struct {
+		uint8_t mb;
+		uint32_t id;
+	} s_tx_mbs[] = {
+		{ CAN_MB_POSE, CAN_BUS_ID_POSE },
+		{ CAN_MB_MOTION, CAN_BUS_ID_MOTION },
+		{ CAN_MB_STATUS, CAN_BUS_ID_STATUS },
+		{ CAN_MB_ACK, CAN_BUS_ID_PARAM_ACK },
+		{ CAN_MB_TEST, CAN_BUS_ID_PARAM },
+	};
+
+	if (s_ready) {
+		s_ready = false;
+		(void)FLEXCAN_DRV_Deinit(CAN_INST);
+	}
+	flexcan_user_config_t cfg = g_stFlexcan0Config0;
+	cfg.flexcanMode = mode;
+	if (FLEXCAN_DRV_Init(CAN_INST, &g_stFlexcanState_0, &cfg) != STATUS_SUCCESS) {
+		return false;
+	}
+	FLEXCAN_DRV_ConfigRxFifo(CAN_INST, FLEXCAN_RX_FIFO_ID_FORMAT_A, s_filters);
+	FLEXCAN_DRV_SetRxMaskType(CAN_INST, FLEXCAN_RX_MASK_GLOBAL);
+	FLEXCAN_DRV_SetRxFifoGlobalMask(CAN_INST, FLEXCAN_MSG_ID_STD, CAN_FIFO_MASK);
+	for (uint8_t i = 0; i < sizeof(s_tx_mbs) / sizeof(s_tx_mbs[0]); ++i) {
+		if (FLEXCAN_DRV_ConfigTxMb(CAN_INST, s_tx_mbs[i].mb, &s_tx_info, s_tx_mbs[i].id) != STATUS_SUCCESS) {
+			(void)FLEXCAN_DRV_Deinit(CAN_INST);
+			return false;
+		}
+	}
+	FLEXCAN_DRV_InstallEventCallback(CAN_INST, can_event, NULL);
+	if (FLEXCAN_DRV_RxFifo(CAN_INST, &s_rx_msg) != STATUS_SUCCESS) {
+		(void)FLEXCAN_DRV_Deinit(CAN_INST);
+		return false;
+	}
+	s_ready = true;
+	return true;
+}
+
+// 非阻塞发送：邮箱上一帧未发出时丢弃本帧
+static bool can_send(uint8_t mb, uint32_t id, const uint8_t *data)
+{
+	if (FLEXCAN_DRV_Send(CAN_INST, mb, &s_tx_info, id, data) != STATUS_SUCCESS) {
+		s_tx_drops++;
+		return false;
+	}
+	s_tx_frames++;
+	return true;
+}
+
+// ========================
+// 参数请求（控制上下文）
+// ========================
+
+static void can_handle_param(const uint8_t *req)
+{
+	uint8_t ack[CAN_DLC] = { 0 };
+	uint8_t op = req[0];
+	ack[0] = op;
+	ack[1] = req[1];
+	ack[3] = req[2];
+	const param_desc_t *p = Shell_GetParam(req[1]);
+	uint8_t result = CAN_BUS_OK;
+	if (op > CAN_BUS_OP_NAME) {
+		result = CAN_BUS_ERR_FORMAT;
+	} else if (p == NULL) {
+		result = CAN_BUS_ERR_UNKNOWN;
+	} else if (op == CAN_BUS_OP_NAME) {
+		// 超出名称长度的字节为 0，主机读到含 0 的段即结束
+		size_t len = strlen(p->name);
+		size_t off = (size_t)req[2] * CAN_NAME_CHUNK;
+		for (size_t i = 0; i < CAN_NAME_CHUNK; ++i) {
+			ack[4U + i] = (off + i < len) ? (uint8_t)p->name[off + i] : 0U;
+		}
+	} else {
+		if (op == CAN_BUS_OP_SET) {
+			float v = can_get_f32(&req[4]);
+			// NaN 比较均为假，同样拒绝
+			if (v >= p->min && v <= p->max) {
+				*p->value = v;
+			} else {
+				result = CAN_BUS_ERR_RANGE;
+			}
+		}
+		can_put_f32(&ack[4], *p->value);
+	}
+	ack[2] = result;
+	(void)can_send(CAN_MB_ACK, CAN_BUS_ID_PARAM_ACK, ack);
+}
+
+static void can_poll_params(void)
+{
+	// 应答邮箱忙时留在队列中，下次再处理（每次最多一条，应答不互相覆盖）
+	if (s_param_tail == s_param_head || FLEXCAN_DRV_GetTransferStatus(CAN_INST, CAN_MB_ACK) != STATUS_SUCCESS) {
+		return;
+	}
+	uint8_t req[CAN_DLC];
+	uint8_t tail = s_param_tail;
+	__sync_synchronize();
+	memcpy(req, s_param_q[tail & (CAN_BUS_PARAM_QUEUE - 1U)], CAN_DLC);
+	__sync_synchronize();
+	s_param_tail = (uint8_t)(tail + 1U);
+	can_handle_param(req);
+}
+
+// ========================
+// 遥测
+// ========================
+
+static void can_publish(const flight_rec_t *rec)
+{
+	uint8_t d[CAN_DLC];
+	pose2d_t pose;
+	Pose_Get(&pose);
+	can_put_u32(&d[0], (uint32_t)(int32_t)pose.x_mm);
+	can_put_u32(&d[4], (uint32_t)(int32_t)pose.y_mm);
+	(void)can_send(CAN_MB_POSE, CAN_BUS_ID_POSE, d);
+
+	float cm = HCSR04_GetCachedDistance();
+	can_put_u16(&d[0], (uint16_t)can_q16(pose.theta_deg, 100.0f));
+	can_put_u16(&d[2], (uint16_t)rec->rate_ddps);
+	can_put_u16(&d[4], (uint16_t)can_q16(Odom_GetSpeedMmS(), 1.0f));
+	can_put_u16(&d[6], (cm >= 0.0f) ? (uint16_t)(cm * 10.0f) : 0xFFFFU);
+	(void)can_send(CAN_MB_MOTION, CAN_BUS_ID_MOTION, d);
+
+	can_bus_drive_t cmd;
+	bool valid = CanBus_GetDrive(&cmd);
+	uint8_t flags = 0U;
+	if ((rec->flags & FLIGHT_REC_FLAG_OBSTACLE) != 0U) {
+		flags |= CAN_BUS_F_OBSTACLE;
+	}
+	if (s_remote_active) {
+		flags |= CAN_BUS_F_REMOTE;
+	}
+	if (valid) {
+		flags |= CAN_BUS_F_DRIVE_VALID;
+	}
+	can_put_u32(&d[0], Mission_GetElapsedMs());
+	d[4] = rec->step;
+	d[5] = (uint8_t)Mission_GetStatus();
+	d[6] = flags;
+	d[7] = cmd.seq;
+	(void)can_send(CAN_MB_STATUS, CAN_BUS_ID_STATUS, d);
+}
+
+// ========================
+// 接口
+// ========================
+
+bool CanBus_Init(void)
+{
+	s_param_head = 0;
+	s_param_tail = 0;
+	memset(&s_drive, 0, sizeof(s_drive));
+	if (!can_start(FLEXCAN_NORMAL_MODE)) {
+		printf("[can] FlexCAN0 初始化失败，CAN 总线停用\r\n");
+		return false;
+	}
+	printf("[can] FlexCAN0 就绪 500 kbit/s，接收 0x%03lX/0x%03lX\r\n", (unsigned long)CAN_BUS_ID_DRIVE,
+	       (unsigned long)CAN_BUS_ID_PARAM);
+	return true;
+}
+
+bool CanBus_IsReady(void)
+{
+	return s_ready;
+}
+
+void CanBus_Publish(const flight_rec_t *rec)
+{
+	if (!s_ready) {
+		return;
+	}
+	can_poll_params();
+	if (++s_tick >= CAN_BUS_TELEM_DIV) {
+		s_tick = 0;
+		can_publish(rec);
+	}
+}
+
+void CanBus_Poll(void)
+{
+	if (!s_ready) {
+		return;
+	}
+	if (s_selftest_req) {
+		s_selftest_req = false;
+		(void)CanBus_SelfTest();
+		return;
+	}
+	can_poll_params();
+}
+
+bool CanBus_GetDrive(can_bus_drive_t *cmd)
+{
+	uint32_t seq;
+	do {
+		seq = s_drive_seq;
+		__sync_synchronize();
+		*cmd = s_drive;
+		__sync_synchronize();
+	} while ((seq & 1U) != 0U || seq != s_drive_seq);
+	return cmd->count != 0U && board_time_ms() - cmd->rx_ms <= cmd->ttl_ms;
+}
+
+void CanBus_SetRemoteActive(bool active)
+{
+	s_remote_active = active;
+}
+
+bool CanBus_RequestSelfTest(void)
+{
+	if (!s_ready) {
+		printf("[can] 未就绪\r\n");
+		return false;
+	}
+	if (Mission_GetStatus() == MISSION_RUNNING) {
+		printf("[can] 任务运行中，不执行自检\r\n");
+		return false;
+	}
+	s_selftest_req = true;
+	return true;
+}
+
+bool CanBus_SelfTest(void)
+{
+	if (!s_ready) {
+		printf("[can] 未就绪\r\n");
+		return false;
+	}
+	if (Mission_GetStatus() == MISSION_RUNNING) {
+		printf("[can] 任务运行中，不执行自检\r\n");
+		return false;
+	}
+	if (!can_start(FLEXCAN_LOOPBACK_MODE)) {
+		printf("[can] 切换回环模式失败\r\n");
+		(void)can_start(FLEXCAN_NORMAL_MODE);
+		return false;
+	}
+	uint32_t frames0 = s_rx_frames;
+	uint32_t param0 = s_rx_param;
+	uint32_t done0 = s_tx_done;
+
+	// 1) 遥测 ID 的帧：回环时控制器收到自己发出的帧，过滤表不含该 ID，不应进入 FIFO
+	uint8_t d[CAN_DLC] = { 0 };
+	bool sent = FLEXCAN_DRV_Send(CAN_INST, CAN_MB_TEST, &s_tx_info, CAN_BUS_ID_POSE, d) == STATUS_SUCCESS;
+	uint32_t t0 = board_time_ms();
+	while (sent && s_tx_done == done0 && board_time_ms() - t0 < CAN_TEST_WAIT_MS) {
+	}
+	// 2) 参数请求 GET 索引 0：应进入 FIFO、入队，并由 MB11 发出应答
+	d[0] = CAN_BUS_OP_GET;
+	sent = sent && FLEXCAN_DRV_Send(CAN_INST, CAN_MB_TEST, &s_tx_info, CAN_BUS_ID_PARAM, d) == STATUS_SUCCESS;
+	t0 = board_time_ms();
+	while (sent && s_tx_done - done0 < 3U && board_time_ms() - t0 < CAN_TEST_WAIT_MS) {
+		can_poll_params();
+	}
+	uint32_t frames = s_rx_frames - frames0;
+	uint32_t params = s_rx_param - param0;
+	uint32_t done = s_tx_done - done0;
+	bool ok = sent && frames == 1U && params == 1U && done == 3U;
+
+	if (!can_start(FLEXCAN_NORMAL_MODE)) {
+		printf("[can] 恢复正常模式失败，CAN 总线停用\r\n");
+		return false;
+	}
+	printf("[can] 回环自检 %s：发送完成 %lu/3，通过过滤 %lu/1，参数请求 %lu/1\r\n",
+	       ok ? "通过" : "失败", (unsigned long)done, (unsigned long)frames, (unsigned long)params);
+	return ok;
+}
+
+void CanBus_Print(void)
+{
+	if (!s_ready) {
+		printf("[can] 未就绪\r\n");
+		return;
+	}
+	can_bus_drive_t cmd;
+	bool valid = CanBus_GetDrive(&cmd);
+	printf("[can] rx=%lu param=%lu bad=%lu overflow=%lu tx=%lu done=%lu drop=%lu ESR1=0x%08lX\r\n",
+	       (unsigned long)s_rx_frames, (unsigned long)s_rx_param, (unsigned long)s_rx_bad,
+	       (unsigned long)s_rx_overflow, (unsigned long)s_tx_frames, (unsigned long)s_tx_done,
+	       (unsigned long)s_tx_drops, (unsigned long)FLEXCAN_DRV_GetErrorStatus(CAN_INST));
+	if (cmd.count == 0U) {
+		printf("[can] 未收到驱动指令\r\n");
+	} else {
+		printf("[can] drive #%lu seq=%u %s heading=%.2f speed=%.0fmm/s age=%lums%s\r\n", (unsigned long)cmd.count,
+		       cmd.seq, (cmd.mode == CAN_BUS_DRIVE_GO) ? "GO" : "RELEASE", cmd.heading_deg, cmd.speed_mm_s,
+		       (unsigned long)(board_time_ms() - cmd.rx_ms), valid ? "" : "（已过期）");
+	}
+}
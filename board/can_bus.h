@@ -0,0 +1,134 @@
+/**
+ * @file can_bus.h
+ * @author 林木@江南大学
+ * @brief FlexCAN0 上位机命令与遥测总线（500 kbit/s，经典 CAN，标准帧）
+ * @details 上位机（如车载工控机）经 CAN 读取位姿并下发航向/速度指令，在更高层闭环（视觉、规划）：
+ *          - 接收：传统 Rx FIFO + 8 个硬件 ID 过滤器，只接收驱动指令与参数请求两个 ID，
+ *            总线上其他节点的帧不进入 CPU；FIFO 中断回调中解析，驱动指令写入快照（序号保护），
+ *            参数请求排队，在控制周期之间处理
+ *          - 发送：每种帧固定一个发送邮箱，初始化时配置好 ID 与长度，发送只填 8 字节数据；
+ *            邮箱上一帧仍未发出（总线拥塞或无应答）时丢弃本帧并计数，控制周期不等待
+ *          - 驱动指令由任务步骤 remote（MISSION_STEP_REMOTE）执行：按指令航向/速度保持航向行驶，
+ *            指令超过有效期未刷新时停车，收到 RELEASE 结束该步骤
+ *          - 自检：shell `can test` 请求后由控制上下文临时切换到控制器回环模式，验证过滤、接收与应答路径
+ *          未接收发器时发送邮箱无应答，遥测帧计入丢弃，不影响任务。主机端工具 tools/can_host.py
+ */
+
+#ifndef __CAN_BUS_H__
+#define __CAN_BUS_H__
+
+#include "RISCV_Typedefs.h"
+#include "flight_rec.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 帧 ID（11 位标准帧；多车同一总线时整体偏移 CAN_BUS_NODE × 0x10）
+#define CAN_BUS_NODE               0U
+#define CAN_BUS_ID(base)           ((uint32_t)(base) + CAN_BUS_NODE * 0x10U)
+#define CAN_BUS_ID_DRIVE           CAN_BUS_ID(0x120U)  // 上位机 -> 车：航向/速度指令
+#define CAN_BUS_ID_PARAM           CAN_BUS_ID(0x121U)  // 上位机 -> 车：参数读写
+#define CAN_BUS_ID_POSE            CAN_BUS_ID(0x180U)  // 车 -> 上位机：位置
+#define CAN_BUS_ID_MOTION          CAN_BUS_ID(0x181U)  // 车 -> 上位机：航向/角速度/速度/测距
+#define CAN_BUS_ID_STATUS          CAN_BUS_ID(0x182U)  // 车 -> 上位机：任务状态
+#define CAN_BUS_ID_PARAM_ACK       CAN_BUS_ID(0x1A1U)  // 车 -> 上位机：参数应答
+
+#define CAN_BUS_TELEM_DIV          1U      // 遥测每 N 个控制周期发送一次（1：50 Hz，3 帧约占 3% 总线）
+#define CAN_BUS_DRIVE_TTL_MS       200U    // 驱动指令默认有效期（帧内 ttl 为 0 时）
+#define CAN_BUS_PARAM_QUEUE        4U      // 待处理参数请求（2 的幂）
+
+/*
+ * 数据布局（8 字节，小端）：
+ *   DRIVE     heading(i16, 0.01°, 绝对航向) speed(i16, mm/s) ttl(u16, ms) mode(u8) seq(u8)
+ *   PARAM     op(u8) index(u8) chunk(u8) 保留(u8) value(f32)
+ *   POSE      x(i32, mm) y(i32, mm)
+ *   MOTION    theta(i16, 0.01°) rate(i16, 0.1°/s) speed(i16, mm/s) range(u16, mm；无效 0xFFFF)
+ *   STATUS    t(u32, 任务用时 ms) step(u8) status(u8) flags(u8) seq(u8)
+ *   PARAM_ACK op(u8) index(u8) result(u8) chunk(u8) value(f32) 或参数名第 chunk 段的 4 个字符
+ * 参数按索引访问（命令行参数表顺序），名称经 NAME 操作分段读取；索引越界应答 UNKNOWN
+ */
+#define CAN_BUS_DRIVE_RELEASE      0U      // 结束 remote 步骤（任务继续下一步）
+#define CAN_BUS_DRIVE_GO           1U      // 按航向/速度行驶（速度 0 为原地停车）
+
+#define CAN_BUS_OP_GET             0U
+#define CAN_BUS_OP_SET             1U
+#define CAN_BUS_OP_NAME            2U
+
+#define CAN_BUS_OK                 0U
+#define CAN_BUS_ERR_UNKNOWN        1U      // 参数索引越界
+#define CAN_BUS_ERR_RANGE          2U      // 取值超出范围
+#define CAN_BUS_ERR_FORMAT         3U      // 操作码/长度无效
+
+// STATUS 帧 flags
+#define CAN_BUS_F_OBSTACLE         0x01U   // 避障等待中
+#define CAN_BUS_F_REMOTE           0x02U   // 正在执行 remote 步骤
+#define CAN_BUS_F_DRIVE_VALID      0x04U   // 驱动指令在有效期内
+
+// 最近一条驱动指令
+typedef struct {
+    float32_t heading_deg;  // 目标航向（°，[-180, 180]）
+    float32_t speed_mm_s;   // 目标速度（mm/s，负值按 0 处理）
+    uint32_t rx_ms;         // 接收时刻（board_time_ms）
+    uint32_t count;         // 累计接收的驱动帧数（用于判断步骤开始后是否有新指令）
+    uint16_t ttl_ms;        // 有效期
+    uint8_t mode;           // CAN_BUS_DRIVE_*
+    uint8_t seq;            // 上位机序号（原样回显在 STATUS 帧）
+} can_bus_drive_t;
+
+/**
+ * @brief 初始化 FlexCAN0（Rx FIFO 过滤表、发送邮箱）并开始接收
+ * @return 控制器初始化成功返回 true；否则总线停用，其余接口为空操作
+ */
+bool CanBus_Init(void);
+bool CanBus_IsReady(void);
+
+/**
+ * @brief 控制周期调用（Mission_Step 写入飞行记录之后）：处理参数请求，按分频发送遥测帧
+ * @param rec 本周期飞行记录
+ */
+void CanBus_Publish(const flight_rec_t *rec);
+
+/**
+ * @brief 任务未运行时调用：处理参数请求；有自检请求时执行自检
+ */
+void CanBus_Poll(void);
+
+/**
+ * @brief 读取最近一条驱动指令
+ * @param cmd 输出指令（未收到过指令时 count 为 0）
+ * @return 指令在有效期内返回 true
+ */
+bool CanBus_GetDrive(can_bus_drive_t *cmd);
+
+/**
+ * @brief remote 步骤开始/结束时调用，体现在 STATUS 帧 flags
+ */
+void CanBus_SetRemoteActive(bool active);
+
+/**
+ * @brief 命令行调用：请求回环自检，由下一次 CanBus_Poll 执行（FreeRTOS 构建为控制任务），
+ *        不与参数应答、遥测发送并发访问控制器
+ * @return 已排队返回 true；未就绪或任务运行中返回 false
+ */
+bool CanBus_RequestSelfTest(void);
+
+/**
+ * @brief 回环自检：切换到回环模式，注入一帧应被过滤的帧与一条参数请求，检查接收、过滤与应答，
+ *        之后恢复正常模式（任务运行中不执行）；只能在调用 CanBus_Poll/CanBus_Publish 的上下文中调用
+ * @return 通过返回 true
+ */
+bool CanBus_SelfTest(void);
+
+/**
+ * @brief 打印收发计数、接收溢出计数与错误状态
+ */
+void CanBus_Print(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __CAN_BUS_H__
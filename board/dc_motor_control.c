@@ -10,6 +10,7 @@
 
 #include "dc_motor_control.h"
 #include "supertmr_qd_driver.h"
+#include "board_delay.h"
 #include <math.h>  // 添加数学库头文件，用于fabs函数
 // 删除对stdint.h的引用，使用RISCV_Typedefs.h中的定义
 
@@ -140,18 +141,6 @@ static E_GDFLIB_FILTER_IIR1_T_F32* DCMotor_GetFilter(uint8_t motorIndex)
     }
 }
 
-/**
- * @brief 简单的延时函数
- * @param ms 延时毫秒数
- */
-static void SimpleDelay(uint32_t ms)
-{
-    // 简单的软件延时，不精确但可用于方向切换时的短暂延时
-    volatile uint32_t i, j;
-    for(i = 0; i < ms; i++)
-        for(j = 0; j < 10000; j++); // 延时循环
-}
-
 /**
  * @brief 设置电机速度并控制方向
  * @param motorIndex 电机索引(0-3)
@@ -179,7 +168,7 @@ static void DCMotor_SetMotorSpeed(uint8_t motorIndex, float32_t speed)
         }
         
         // 延时一段时间让电机减速
-        SimpleDelay(50);
+        simple_delay_ms(50);
     }
     
     // 记录当前方向
@@ -238,7 +227,8 @@ void DCMotor_Init(void)
 void DCMotor_InitEncoders(void)
 {
     // 初始化SuperTimer实例1(电机2编码器)
-    supertmr_state_t stSupertmr1State;
+    // 驱动保存状态结构体指针，必须为静态存储
+    static supertmr_state_t stSupertmr1State;
     supertmr_user_config_t stSupertmr1UserConfig = {
         .syncMethod = {
             .softwareSync     = true,
@@ -272,7 +262,7 @@ void DCMotor_InitEncoders(void)
     }
     
     // 初始化SuperTimer实例2(电机3编码器)
-    supertmr_state_t stSupertmr2State;
+    static supertmr_state_t stSupertmr2State;
     supertmr_user_config_t stSupertmr2UserConfig = stSupertmr1UserConfig; // 复制相同配置
     
     // 初始化SuperTimer实例2
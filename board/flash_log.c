@@ -0,0 +1,656 @@
+/**
+ * @file flash_log.c
+ * @author 林木@江南大学
+ * @brief 外部 SPI NOR Flash 运行记录器实现
+ * @details 运行中的写入全部为非阻塞 SPI2 DMA 传输，状态机每次调用最多推进几步：
+ *          写使能 → 页编程/扇区擦除 → 读状态寄存器直到空闲。
+ *          初始化、导出、清空在任务未运行时进行，使用 gd25qxx 驱动的阻塞接口。
+ *          写入只在控制任务中进行，命令行操作要求记录器空闲，无需加锁
+ */
+
+#include "flash_log.h"
+#include "sdk_project_config.h"
+#include "gd25qxx.h"
+#include "nvm_store.h"
+#include "board_delay.h"
+#include <stdio.h>
+#include <string.h>
+
+#define FLOG_PAGE            GD25Q128E_PAGE_SIZE
+#define FLOG_SECTOR          GD25Q128E_SECTOR_SIZE
+#define FLOG_DATA_END        GD25Q128E_FLASH_SIZE
+#define FLOG_DATA_SIZE       (FLOG_DATA_END - FLASH_LOG_DATA_ADDR)
+#define FLOG_CMD_BYTES       4U                  // 命令 + 24 位地址
+#define FLOG_PAGE_MAGIC      0x31474C46UL        // "FLG1"
+#define FLOG_RUN_MAGIC       0x4E555246UL        // "FRUN"
+#define FLOG_DONE_MAGIC      0x454E4F44UL        // "DONE"
+#define FLOG_HDR_BYTES       20U
+#define FLOG_PAYLOAD_MAX     (FLOG_PAGE - FLOG_HDR_BYTES)
+#define FLOG_FIELDS          15U
+#define FLOG_REC_MAX         (2U + FLOG_FIELDS * 5U)  // 掩码 + 最长变长整数
+#define FLOG_STEPS_PER_CALL  4U
+
+// 页头（小端）；CRC-32 覆盖 run 起至负载末尾
+typedef struct {
+	uint32_t magic;
+	uint32_t crc32;
+	uint16_t run;
+	uint16_t n_rec;
+	uint32_t seq;       // 运行内页序号
+	uint16_t len;       // 负载字节数
+	uint16_t flags;     // 保留
+} flog_page_hdr_t;
+
+// 运行索引：前 16 字节开始时写入，后 16 字节结束时写入（NOR 未编程字节为 0xFF）
+typedef struct {
+	uint32_t magic;
+	uint16_t run;
+	uint16_t flags;     // 保留
+	uint32_t start_addr;
+	uint32_t t_start_ms;
+	uint32_t end_addr;
+	uint32_t pages;
+	uint32_t records;
+	uint32_t done;
+} flog_run_t;
+
+_Static_assert(sizeof(flog_page_hdr_t) == FLOG_HDR_BYTES, "页头应为 20 字节");
+_Static_assert(sizeof(flog_run_t) == 32U, "运行索引应为 32 字节");
+
+typedef enum {
+	FLOG_ST_IDLE = 0,
+	FLOG_ST_WREN,       // 写使能传输中
+	FLOG_ST_CMD,        // 编程/擦除命令传输中
+	FLOG_ST_POLL        // 状态寄存器读取中
+} flog_state_t;
+
+typedef enum {
+	FLOG_JOB_INDEX_OPEN = 0,
+	FLOG_JOB_PAGE,
+	FLOG_JOB_ERASE,
+	FLOG_JOB_INDEX_CLOSE
+} flog_job_t;
+
+static bool s_ready = false;
+
+// 页缓冲：前 4 字节留给页编程命令与地址，DMA 一次发出
+static uint8_t s_page[2][FLOG_CMD_BYTES + FLOG_PAGE];
+static uint8_t s_fill = 0;              // 正在填充的缓冲
+static bool s_pending = false;          // 另一缓冲已封页待编程
+static uint16_t s_pending_len = 0;
+static uint16_t s_fill_len = 0;         // 负载字节数
+static uint16_t s_fill_n = 0;           // 记录数
+static int32_t s_prev[FLOG_FIELDS];
+static int32_t s_prev_d[FLOG_FIELDS];
+
+// 索引写入缓冲（命令 + 16 字节）
+static uint8_t s_idx_buf[FLOG_CMD_BYTES + 16U];
+static bool s_idx_open_pend = false;
+static bool s_idx_close_pend = false;
+static uint32_t s_idx_addr = 0;         // 当前运行的索引地址
+static uint32_t s_idx_next = FLASH_LOG_INDEX_ADDR;
+
+static uint32_t s_wp = FLASH_LOG_DATA_ADDR;         // 下一页写入地址
+static uint32_t s_erase_ptr = FLASH_LOG_DATA_ADDR;  // 下一个待擦除扇区
+static bool s_run_active = false;
+static bool s_closing = false;
+static uint16_t s_run_id = 0;
+static flog_run_t s_run;
+static uint32_t s_page_seq = 0;
+
+static flog_state_t s_state = FLOG_ST_IDLE;
+static flog_job_t s_job;
+static uint8_t s_cmd[FLOG_CMD_BYTES];
+static uint8_t s_sr_tx[2] = { READ_STATUS_REG1_CMD, 0U };
+static uint8_t s_sr_rx[2];
+
+static uint32_t s_dropped = 0;
+static uint32_t s_spi_errors = 0;
+
+// 导出状态
+static bool s_dump_active = false;
+static flog_run_t s_dump_run;
+static uint32_t s_dump_addr = 0;
+static uint32_t s_dump_seq = 0;
+
+static uint32_t flog_wrap(uint32_t addr)
+{
+	return (addr >= FLOG_DATA_END) ? (addr - FLOG_DATA_SIZE) : addr;
+}
+
+// 写指针前方已擦除的字节数
+static uint32_t flog_ahead(void)
+{
+	return (s_erase_ptr >= s_wp) ? (s_erase_ptr - s_wp) : (s_erase_ptr + FLOG_DATA_SIZE - s_wp);
+}
+
+static void flog_set_cmd(uint8_t *buf, uint8_t cmd, uint32_t addr)
+{
+	buf[0] = cmd;
+	buf[1] = (uint8_t)(addr >> 16);
+	buf[2] = (uint8_t)(addr >> 8);
+	buf[3] = (uint8_t)addr;
+}
+
+// ========================
+// 差分编码
+// ========================
+
+static bool flog_second_order(uint8_t k)
+{
+	// 时间、记录序号、里程近似匀速变化
+	return k == 0U || k == 1U || k == 14U;
+}
+
+static void flog_fields(const flight_rec_t *r, int32_t v[FLOG_FIELDS])
+{
+	v[0] = (int32_t)r->t_ms;
+	v[1] = r->seq;
+	v[2] = r->step;
+	v[3] = r->flags;
+	v[4] = r->yaw_cdeg;
+	v[5] = r->rate_ddps;
+	v[6] = r->err_ddps;
+	v[7] = r->p_e4;
+	v[8] = r->i_e4;
+	v[9] = r->ff_e4;
+	v[10] = r->duty_e4[0];
+	v[11] = r->duty_e4[1];
+	v[12] = r->duty_e4[2];
+	v[13] = r->duty_e4[3];
+	v[14] = r->dist_dmm;
+}
+
+// 编码一条记录到 out，返回字节数；d_out 为本条一阶差分（提交时更新状态）
+static uint8_t flog_encode(const int32_t v[FLOG_FIELDS], int32_t d_out[FLOG_FIELDS], uint8_t *out)
+{
+	uint16_t mask = 0;
+	uint8_t n = 2;
+	for (uint8_t k = 0; k < FLOG_FIELDS; ++k) {
+		int32_t d = (int32_t)((uint32_t)v[k] - (uint32_t)s_prev[k]);
+		int32_t res = flog_second_order(k) ? (int32_t)((uint32_t)d - (uint32_t)s_prev_d[k]) : d;
+		d_out[k] = d;
+		if (res == 0) {
+			continue;
+		}
+		mask |= (uint16_t)(1U << k);
+		uint32_t z = ((uint32_t)res << 1) ^ (uint32_t)(res >> 31);
+		while (z >= 0x80U) {
+			out[n++] = (uint8_t)(z | 0x80U);
+			z >>= 7;
+		}
+		out[n++] = (uint8_t)z;
+	}
+	out[0] = (uint8_t)mask;
+	out[1] = (uint8_t)(mask >> 8);
+	return n;
+}
+
+static void flog_page_reset(void)
+{
+	s_fill_len = 0;
+	s_fill_n = 0;
+	memset(s_prev, 0, sizeof(s_prev));
+	memset(s_prev_d, 0, sizeof(s_prev_d));
+}
+
+// 封页：填页头，交给编程队列（调用前确认 !s_pending）
+static void flog_seal(void)
+{
+	uint8_t *page = &s_page[s_fill][FLOG_CMD_BYTES];
+	flog_page_hdr_t hdr;
+	hdr.magic = FLOG_PAGE_MAGIC;
+	hdr.crc32 = 0;
+	hdr.run = s_run_id;
+	hdr.n_rec = s_fill_n;
+	hdr.seq = s_page_seq++;
+	hdr.len = s_fill_len;
+	hdr.flags = 0xFFFFU;
+	memcpy(page, &hdr, sizeof(hdr));
+	hdr.crc32 = NVM_Crc32(&page[8], (uint32_t)(FLOG_HDR_BYTES - 8U + s_fill_len));
+	memcpy(&page[4], &hdr.crc32, sizeof(hdr.crc32));
+
+	s_run.records += s_fill_n;
+	s_pending_len = (uint16_t)(FLOG_HDR_BYTES + s_fill_len);
+	s_pending = true;
+	s_fill ^= 1U;
+	flog_page_reset();
+}
+
+// ========================
+// 非阻塞擦除/编程状态机
+// ========================
+
+static bool flog_spi_busy(void)
+{
+	uint32_t remained;
+	return SPI_DRV_MasterGetTransferStatus(INST_SPI_2, &remained) == STATUS_BUSY;
+}
+
+static bool flog_spi_start(const uint8_t *tx, uint8_t *rx, uint16_t len)
+{
+	if (SPI_DRV_MasterTransfer(INST_SPI_2, tx, rx, len) != STATUS_SUCCESS) {
+		s_spi_errors++;
+		s_state = FLOG_ST_IDLE;
+		return false;
+	}
+	return true;
+}
+
+// 选择下一项操作：索引登记 > 页编程 > 预擦除 > 索引收尾
+static bool flog_pick_job(void)
+{
+	if (s_idx_open_pend) {
+		s_job = FLOG_JOB_INDEX_OPEN;
+		return true;
+	}
+	if (s_pending && flog_ahead() >= FLOG_PAGE) {
+		s_job = FLOG_JOB_PAGE;
+		return true;
+	}
+	if ((s_run_active || s_pending) && flog_ahead() < FLASH_LOG_ERASE_AHEAD * FLOG_SECTOR) {
+		s_job = FLOG_JOB_ERASE;
+		return true;
+	}
+	if (s_idx_close_pend && !s_pending && s_fill_n == 0U) {
+		s_job = FLOG_JOB_INDEX_CLOSE;
+		return true;
+	}
+	return false;
+}
+
+static bool flog_start_cmd(void)
+{
+	switch (s_job) {
+	case FLOG_JOB_INDEX_OPEN:
+		flog_set_cmd(s_idx_buf, PAGE_PROG_CMD, s_idx_addr);
+		memcpy(&s_idx_buf[FLOG_CMD_BYTES], &s_run, 16U);
+		return flog_spi_start(s_idx_buf, NULL, FLOG_CMD_BYTES + 16U);
+	case FLOG_JOB_INDEX_CLOSE:
+		flog_set_cmd(s_idx_buf, PAGE_PROG_CMD, s_idx_addr + 16U);
+		memcpy(&s_idx_buf[FLOG_CMD_BYTES], &s_run.end_addr, 16U);
+		return flog_spi_start(s_idx_buf, NULL, FLOG_CMD_BYTES + 16U);
+	case FLOG_JOB_PAGE: {
+		uint8_t *buf = s_page[s_fill ^ 1U];
+		flog_set_cmd(buf, PAGE_PROG_CMD, s_wp);
+		return flog_spi_start(buf, NULL, (uint16_t)(FLOG_CMD_BYTES + s_pending_len));
+	}
+	case FLOG_JOB_ERASE:
+	default:
+		flog_set_cmd(s_cmd, SECTOR_ERASE_CMD, s_erase_ptr);
+		return flog_spi_start(s_cmd, NULL, FLOG_CMD_BYTES);
+	}
+}
+
+static void flog_job_done(void)
+{
+	switch (s_job) {
+	case FLOG_JOB_INDEX_OPEN:
+		s_idx_open_pend = false;
+		break;
+	case FLOG_JOB_PAGE:
+		s_wp = flog_wrap(s_wp + FLOG_PAGE);
+		s_run.pages++;
+		s_pending = false;
+		break;
+	case FLOG_JOB_ERASE:
+		s_erase_ptr = flog_wrap(s_erase_ptr + FLOG_SECTOR);
+		break;
+	case FLOG_JOB_INDEX_CLOSE:
+	default:
+		s_idx_close_pend = false;
+		s_closing = false;
+		break;
+	}
+}
+
+void FlashLog_Service(void)
+{
+	if (!s_ready) {
+		return;
+	}
+	// 收尾：上一页编程完成后封最后一页，全部写完后登记终点
+	if (s_closing && s_fill_n > 0U && !s_pending) {
+		flog_seal();
+	}
+	if (s_closing && !s_idx_close_pend && !s_pending && s_fill_n == 0U && !s_idx_open_pend) {
+		s_run.end_addr = s_wp;
+		s_run.done = FLOG_DONE_MAGIC;
+		s_idx_close_pend = true;
+	}
+
+	for (uint8_t step = 0; step < FLOG_STEPS_PER_CALL; ++step) {
+		if (s_state != FLOG_ST_IDLE && flog_spi_busy()) {
+			return;
+		}
+		switch (s_state) {
+		case FLOG_ST_IDLE:
+			if (!flog_pick_job()) {
+				return;
+			}
+			s_cmd[0] = WRITE_ENABLE_CMD;
+			if (flog_spi_start(s_cmd, NULL, 1U)) {
+				s_state = FLOG_ST_WREN;
+			}
+			break;
+		case FLOG_ST_WREN:
+			if (flog_start_cmd()) {
+				s_state = FLOG_ST_CMD;
+			}
+			break;
+		case FLOG_ST_CMD:
+			if (flog_spi_start(s_sr_tx, s_sr_rx, 2U)) {
+				s_state = FLOG_ST_POLL;
+			}
+			break;
+		case FLOG_ST_POLL:
+		default:
+			if ((s_sr_rx[1] & GD25Q128E_FSR_BUSY) != 0U) {
+				// 编程/擦除未完成：重新读状态，下次调用再检查
+				(void)flog_spi_start(s_sr_tx, s_sr_rx, 2U);
+				return;
+			}
+			flog_job_done();
+			s_state = FLOG_ST_IDLE;
+			break;
+		}
+	}
+}
+
+static bool flog_idle(void)
+{
+	return s_state == FLOG_ST_IDLE && !s_pending && s_fill_n == 0U && !s_idx_open_pend &&
+	       !s_idx_close_pend && !s_closing;
+}
+
+// ========================
+// 运行控制
+// ========================
+
+void FlashLog_StartRun(void)
+{
+	if (!s_ready) {
+		return;
+	}
+	if (!flog_idle()) {
+		(void)FlashLog_Flush(FLASH_LOG_FLUSH_MS);
+	}
+	if (s_idx_next >= FLASH_LOG_INDEX_ADDR + FLASH_LOG_INDEX_SIZE) {
+		printf("[flog] 索引已满，执行 flog erase 后继续记录\r\n");
+		return;
+	}
+	// 每次运行从扇区边界开始；跳过的部分超出已擦除范围时重新擦除
+	uint32_t ahead = flog_ahead();
+	uint32_t start = (s_wp + FLOG_SECTOR - 1U) & ~(FLOG_SECTOR - 1U);
+	start = flog_wrap(start);
+	uint32_t skip = (start >= s_wp) ? (start - s_wp) : (start + FLOG_DATA_SIZE - s_wp);
+	s_wp = start;
+	if (ahead < skip) {
+		s_erase_ptr = s_wp;
+	}
+
+	s_dump_active = false;
+	s_run_id++;
+	memset(&s_run, 0xFF, sizeof(s_run));
+	s_run.magic = FLOG_RUN_MAGIC;
+	s_run.run = s_run_id;
+	s_run.start_addr = s_wp;
+	s_run.t_start_ms = board_time_ms();
+	s_run.pages = 0;
+	s_run.records = 0;
+	s_idx_addr = s_idx_next;
+	s_idx_next += sizeof(flog_run_t);
+	s_idx_open_pend = true;
+	s_page_seq = 0;
+	s_fill = 0;
+	s_pending = false;
+	flog_page_reset();
+	s_run_active = true;
+	s_closing = false;
+}
+
+void FlashLog_Append(const flight_rec_t *rec)
+{
+	if (!s_run_active || s_closing) {
+		return;
+	}
+	int32_t v[FLOG_FIELDS];
+	int32_t d[FLOG_FIELDS];
+	uint8_t tmp[FLOG_REC_MAX];
+	flog_fields(rec, v);
+	uint8_t n = flog_encode(v, d, tmp);
+	if (s_fill_len + n > FLOG_PAYLOAD_MAX) {
+		if (s_pending) {
+			// 两个缓冲都在使用（一般为擦除未完成）：丢弃本条
+			s_dropped++;
+			return;
+		}
+		flog_seal();
+		// 新页从零状态编码，页可单独解码
+		n = flog_encode(v, d, tmp);
+	}
+	memcpy(&s_page[s_fill][FLOG_CMD_BYTES + FLOG_HDR_BYTES + s_fill_len], tmp, n);
+	s_fill_len = (uint16_t)(s_fill_len + n);
+	s_fill_n++;
+	memcpy(s_prev, v, sizeof(s_prev));
+	memcpy(s_prev_d, d, sizeof(s_prev_d));
+}
+
+void FlashLog_StopRun(void)
+{
+	if (s_run_active && !s_closing) {
+		s_closing = true;
+		s_run_active = false;
+	}
+}
+
+bool FlashLog_Flush(uint32_t timeout_ms)
+{
+	if (!s_ready) {
+		return true;
+	}
+	uint32_t start = board_time_ms();
+	for (;;) {
+		FlashLog_Service();
+		if (flog_idle()) {
+			return true;
+		}
+		if (board_time_ms() - start >= timeout_ms) {
+			printf("[flog] 写入超时，状态=%d\r\n", s_state);
+			return false;
+		}
+		simple_delay_ms(1);
+	}
+}
+
+// ========================
+// 初始化与恢复（阻塞）
+// ========================
+
+static bool flog_read(uint32_t addr, void *data, uint32_t size)
+{
+	return Flash_GD25Qxx_Read((uint8_t *)data, addr, size) == GD25Qxx_OK;
+}
+
+// 上次运行未收尾（复位/掉电）：沿页头找到最后一页，补写索引后半
+static void flog_recover(flog_run_t *r, uint32_t idx_addr)
+{
+	uint32_t addr = r->start_addr;
+	uint32_t pages = 0;
+	uint32_t records = 0;
+	flog_page_hdr_t hdr;
+	while (pages < FLOG_DATA_SIZE / FLOG_PAGE && flog_read(addr, &hdr, sizeof(hdr)) &&
+	       hdr.magic == FLOG_PAGE_MAGIC && hdr.run == r->run && hdr.seq == pages) {
+		pages++;
+		records += hdr.n_rec;
+		addr = flog_wrap(addr + FLOG_PAGE);
+	}
+	r->end_addr = addr;
+	r->pages = pages;
+	r->records = records;
+	r->done = FLOG_DONE_MAGIC;
+	(void)Flash_GD25Qxx_Write((uint8_t *)&r->end_addr, idx_addr + 16U, 16U);
+	printf("[flog] 运行 %u 未正常结束，已恢复 %lu 页 %lu 条\r\n", r->run, (unsigned long)pages,
+	       (unsigned long)records);
+}
+
+bool FlashLog_Init(void)
+{
+	s_ready = false;
+	if (SPI_DRV_MasterInit(INST_SPI_2, &g_stSpiState_2, &g_stSpi2MasterConfig0) != STATUS_SUCCESS) {
+		return false;
+	}
+	(void)Flash_GD25Qxx_Init();
+	uint8_t id[6];
+	(void)Flash_GD25Qxx_Read_ID(id, READ_ID_CMD);
+	// JEDEC ID：厂商、类型、容量（2^n 字节）
+	if (id[1] == 0x00U || id[1] == 0xFFU || id[3] < 24U || id[3] > 31U) {
+		printf("[flog] 未检测到外部 Flash（ID %02X %02X %02X）\r\n", id[1], id[2], id[3]);
+		return false;
+	}
+
+	// 扫描索引到第一个空条目；最后一条决定写指针与运行号
+	flog_run_t r;
+	flog_run_t last;
+	bool have_last = false;
+	uint32_t addr = FLASH_LOG_INDEX_ADDR;
+	for (; addr < FLASH_LOG_INDEX_ADDR + FLASH_LOG_INDEX_SIZE; addr += sizeof(r)) {
+		if (!flog_read(addr, &r, sizeof(r)) || r.magic != FLOG_RUN_MAGIC) {
+			break;
+		}
+		last = r;
+		have_last = true;
+	}
+	s_idx_next = addr;
+	s_wp = FLASH_LOG_DATA_ADDR;
+	s_run_id = 0;
+	if (have_last) {
+		if (last.done != FLOG_DONE_MAGIC) {
+			flog_recover(&last, addr - sizeof(last));
+		}
+		s_wp = flog_wrap(last.end_addr);
+		s_run_id = last.run;
+	}
+	// 擦除状态未知：写入前一律先擦除
+	s_erase_ptr = s_wp;
+	s_state = FLOG_ST_IDLE;
+	s_ready = true;
+	printf("[flog] 外部 Flash %luMiB 就绪，已有运行 %lu 次，写指针 0x%06lX\r\n", (unsigned long)((1UL << id[3]) >> 20),
+	       (unsigned long)((s_idx_next - FLASH_LOG_INDEX_ADDR) / sizeof(flog_run_t)), (unsigned long)s_wp);
+	return true;
+}
+
+bool FlashLog_IsReady(void)
+{
+	return s_ready;
+}
+
+// ========================
+// 命令行
+// ========================
+
+void FlashLog_Print(void)
+{
+	if (!s_ready) {
+		printf("[flog] 未启用\r\n");
+		return;
+	}
+	printf("[flog] 运行号=%u %s 写指针=0x%06lX 已擦除=%luKiB 本次页=%lu 条=%lu 丢弃=%lu SPI错误=%lu\r\n",
+	       s_run_id, s_run_active ? "记录中" : (flog_idle() ? "空闲" : "收尾中"), (unsigned long)s_wp,
+	       (unsigned long)(flog_ahead() >> 10), (unsigned long)s_run.pages, (unsigned long)s_run.records,
+	       (unsigned long)s_dropped, (unsigned long)s_spi_errors);
+}
+
+void FlashLog_List(void)
+{
+	if (!s_ready || !flog_idle()) {
+		printf("[flog] 未启用或写入中\r\n");
+		return;
+	}
+	flog_run_t r;
+	for (uint32_t addr = FLASH_LOG_INDEX_ADDR; addr < s_idx_next; addr += sizeof(r)) {
+		if (!flog_read(addr, &r, sizeof(r))) {
+			break;
+		}
+		printf("[flog] run=%u start=0x%06lX t0=%lums pages=%lu records=%lu%s\r\n", r.run,
+		       (unsigned long)r.start_addr, (unsigned long)r.t_start_ms, (unsigned long)r.pages,
+		       (unsigned long)r.records, (r.done == FLOG_DONE_MAGIC) ? "" : " 未结束");
+	}
+}
+
+bool FlashLog_DumpBegin(uint16_t run)
+{
+	if (!s_ready || !flog_idle()) {
+		return false;
+	}
+	for (uint32_t addr = FLASH_LOG_INDEX_ADDR; addr < s_idx_next; addr += sizeof(s_dump_run)) {
+		if (flog_read(addr, &s_dump_run, sizeof(s_dump_run)) && s_dump_run.run == run &&
+		    s_dump_run.done == FLOG_DONE_MAGIC) {
+			s_dump_addr = s_dump_run.start_addr;
+			s_dump_seq = 0;
+			s_dump_active = true;
+			printf("[flog] begin run=%u t0=%lums pages=%lu records=%lu\r\n", run,
+			       (unsigned long)s_dump_run.t_start_ms, (unsigned long)s_dump_run.pages,
+			       (unsigned long)s_dump_run.records);
+			return true;
+		}
+	}
+	return false;
+}
+
+bool FlashLog_DumpPoll(uint16_t max_pages)
+{
+	if (!s_dump_active) {
+		return false;
+	}
+	// 页缓冲在空闲时复用为读缓冲；任务开始后 SPI2 归写入使用，导出中止
+	uint8_t *page = s_page[0];
+	for (uint16_t n = 0; n < max_pages && s_dump_seq < s_dump_run.pages; ++n) {
+		if (s_run_active) {
+			printf("[flog] 任务开始，导出中止\r\n");
+			s_dump_seq = s_dump_run.pages;
+			break;
+		}
+		flog_page_hdr_t hdr;
+		if (!flog_read(s_dump_addr, page, FLOG_PAGE)) {
+			break;
+		}
+		memcpy(&hdr, page, sizeof(hdr));
+		if (hdr.magic != FLOG_PAGE_MAGIC || hdr.run != s_dump_run.run || hdr.seq != s_dump_seq ||
+		    hdr.len > FLOG_PAYLOAD_MAX) {
+			// 数据区回绕后已被较新的运行覆盖
+			printf("[flog] run=%u 第 %lu 页起已被覆盖\r\n", s_dump_run.run, (unsigned long)s_dump_seq);
+			s_dump_seq = s_dump_run.pages;
+			break;
+		}
+		printf("[flog] p %06lX ", (unsigned long)s_dump_addr);
+		for (uint16_t i = 0; i < FLOG_HDR_BYTES + hdr.len; ++i) {
+			printf("%02X", page[i]);
+		}
+		printf("\r\n");
+		s_dump_addr = flog_wrap(s_dump_addr + FLOG_PAGE);
+		s_dump_seq++;
+	}
+	if (s_dump_seq >= s_dump_run.pages) {
+		s_dump_active = false;
+		printf("[flog] end\r\n");
+	}
+	return s_dump_active;
+}
+
+bool FlashLog_Erase(void)
+{
+	if (!s_ready || !flog_idle()) {
+		return false;
+	}
+	// 只擦索引区（约 1 s）；数据区在写入前按扇区预擦除
+	for (uint32_t addr = FLASH_LOG_INDEX_ADDR; addr < FLASH_LOG_INDEX_ADDR + FLASH_LOG_INDEX_SIZE; addr += FLOG_SECTOR) {
+		(void)Flash_GD25Qxx_Block_Erase(addr);
+	}
+	s_idx_next = FLASH_LOG_INDEX_ADDR;
+	s_wp = FLASH_LOG_DATA_ADDR;
+	s_erase_ptr = s_wp;
+	s_run_id = 0;
+	memset(&s_run, 0, sizeof(s_run));
+	return true;
+}
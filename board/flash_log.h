@@ -0,0 +1,79 @@
+/**
+ * @file flash_log.h
+ * @author 林木@江南大学
+ * @brief 外部 SPI NOR Flash（GD25Q128，SPI2）运行记录器 - 只追加的日志结构存储
+ * @details 任务运行期间把飞行记录器的每条记录（flight_rec_t）压缩写入外部 Flash：
+ *          - 索引区（前 64 KiB）：每次运行一条 32 字节索引，开始时写入起始地址，结束时补写终点/页数/记录数；
+ *          - 数据区：按页（256 字节）顺序追加，到末尾回绕覆盖最早的运行；每页 20 字节页头
+ *            （魔数、CRC-32、运行号、记录数、页序号、负载长度）+ 压缩负载，可单独解码；
+ *          - 压缩：每条记录 15 个字段相对上一条取差分（时间、序号、里程取二阶差分），
+ *            2 字节变化掩码 + zigzag 变长整数，稳态约 10~20 字节/条；
+ *          - 写入：两个页缓冲交替（控制周期填充一个，另一个经 SPI2 DMA 编程），
+ *            写指针前方保持两个已擦除扇区，擦除与编程都由 FlashLog_Service 逐步推进，不忙等。
+ *          主机端 tools/flog_extract.py 从串口导出文本或整片镜像中按运行提取为 CSV
+ */
+
+#ifndef __FLASH_LOG_H__
+#define __FLASH_LOG_H__
+
+#include "flight_rec.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FLASH_LOG_INDEX_ADDR    0x000000UL  // 索引区
+#define FLASH_LOG_INDEX_SIZE    0x010000UL  // 64 KiB = 2048 条运行索引
+#define FLASH_LOG_DATA_ADDR     0x010000UL  // 数据区起点（至芯片末尾）
+#define FLASH_LOG_ERASE_AHEAD   2U          // 写指针前方保持的已擦除扇区数
+#define FLASH_LOG_DUMP_PAGES    1U          // 命令行每次轮询导出的页数（一页约 530 字节文本）
+#define FLASH_LOG_FLUSH_MS      1000U       // 任务结束后等待写完的上限
+
+/**
+ * @brief 初始化 SPI2 与 Flash，扫描索引恢复写指针（上次运行中断时补写其结束信息）
+ * @return 检测到 16 MiB 以上的 SPI NOR Flash 返回 true；否则记录器停用，其余接口为空操作
+ */
+bool FlashLog_Init(void);
+bool FlashLog_IsReady(void);
+
+/**
+ * @brief 开始一次运行（任务开始时调用）：写指针对齐到扇区，登记索引
+ */
+void FlashLog_StartRun(void);
+
+/**
+ * @brief 追加一条记录（控制周期内调用）：只做差分编码与内存拷贝；
+ *        两个页缓冲都在使用中时丢弃该条并计数
+ */
+void FlashLog_Append(const flight_rec_t *rec);
+
+/**
+ * @brief 推进擦除/编程状态机（每个控制周期调用一次，只发起或检查 DMA 传输）
+ */
+void FlashLog_Service(void);
+
+/**
+ * @brief 结束本次运行：余下记录封页，全部写完后补写索引
+ */
+void FlashLog_StopRun(void);
+
+/**
+ * @brief 推进状态机直到全部写完（任务结束后调用，休眠等待）
+ * @return 在 timeout_ms 内写完返回 true
+ */
+bool FlashLog_Flush(uint32_t timeout_ms);
+
+// 命令行：状态、运行列表、按运行导出（十六进制页）、清空索引
+void FlashLog_Print(void);
+void FlashLog_List(void);
+bool FlashLog_DumpBegin(uint16_t run);
+bool FlashLog_DumpPoll(uint16_t max_pages);
+bool FlashLog_Erase(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __FLASH_LOG_H__
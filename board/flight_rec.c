@@ -0,0 +1,159 @@
+/**
+ * @file flight_rec.c
+ * @author 林木@江南大学
+ * @brief 飞行记录器实现
+ * @details 记录区头部与环形缓冲同在 .noinit 段；头部魔数、记录大小与容量一致时视为有效
+ *          （上电时 RAM 内容随机，校验不过即初始化）。写入只在控制任务中进行，
+ *          导出只在任务未运行时由命令行发起，无需加锁
+ */
+
+#include "flight_rec.h"
+#include "board_delay.h"
+#include <stdio.h>
+#include <string.h>
+
+#define FLIGHT_REC_MAGIC  0x43455246UL   // "FREC"
+
+_Static_assert(sizeof(flight_rec_t) == 32U, "flight_rec_t 应为 32 字节");
+_Static_assert((FLIGHT_REC_CAPACITY & (FLIGHT_REC_CAPACITY - 1U)) == 0U, "FLIGHT_REC_CAPACITY 应为 2 的幂");
+
+typedef struct {
+	uint32_t magic;
+	uint16_t rec_size;
+	uint16_t capacity;
+	uint32_t total;     // 累计写入条数，下一条位置 = total % 容量
+	uint32_t dirty;     // 非零：记录中（任务未正常结束）
+	uint32_t resets;    // 记录中发生的复位次数
+} flight_rec_hdr_t;
+
+static flight_rec_hdr_t s_hdr __attribute__((section(".noinit")));
+static flight_rec_t s_ring[FLIGHT_REC_CAPACITY] __attribute__((section(".noinit")));
+
+static bool s_dump_active = false;
+static uint32_t s_dump_next = 0;    // 下一条导出的累计序号
+static uint32_t s_dump_end = 0;
+
+// 四舍五入并饱和到 int16
+static int16_t frec_q16(float32_t v, float32_t scale)
+{
+	float32_t s = v * scale;
+	if (s >= 32767.0f) return 32767;
+	if (s <= -32767.0f) return -32767;
+	return (int16_t)((s >= 0.0f) ? (s + 0.5f) : (s - 0.5f));
+}
+
+static uint32_t frec_count(void)
+{
+	return (s_hdr.total < FLIGHT_REC_CAPACITY) ? s_hdr.total : FLIGHT_REC_CAPACITY;
+}
+
+static void frec_reset(void)
+{
+	s_hdr.magic = FLIGHT_REC_MAGIC;
+	s_hdr.rec_size = (uint16_t)sizeof(flight_rec_t);
+	s_hdr.capacity = (uint16_t)FLIGHT_REC_CAPACITY;
+	s_hdr.total = 0;
+	s_hdr.dirty = 0;
+	s_hdr.resets = 0;
+}
+
+void FlightRec_Init(void)
+{
+	s_dump_active = false;
+	if (s_hdr.magic != FLIGHT_REC_MAGIC || s_hdr.rec_size != sizeof(flight_rec_t) ||
+	    s_hdr.capacity != FLIGHT_REC_CAPACITY) {
+		// 上电（或固件记录格式变化）：记录区内容无效
+		frec_reset();
+		return;
+	}
+	if (s_hdr.dirty != 0U) {
+		// 任务运行中复位（看门狗、异常）：下次任务会覆盖记录，启动时先导出
+		s_hdr.resets++;
+		s_hdr.dirty = 0;
+		printf("[frec] 任务运行中发生复位（累计 %lu 次），导出复位前记录\r\n", (unsigned long)s_hdr.resets);
+		FlightRec_DumpBegin();
+		while (FlightRec_DumpPoll(FLIGHT_REC_CAPACITY)) {
+		}
+		return;
+	}
+	if (s_hdr.total > 0U) {
+		printf("[frec] 保留上次任务记录 %lu 条（frec dump 导出）\r\n", (unsigned long)frec_count());
+	}
+}
+
+void FlightRec_Start(void)
+{
+	s_dump_active = false;
+	s_hdr.total = 0;
+	s_hdr.dirty = 1;
+}
+
+void FlightRec_Stop(void)
+{
+	s_hdr.dirty = 0;
+}
+
+const flight_rec_t *FlightRec_Record(uint8_t step, uint8_t flags, const my_move_trace_t *tr, float32_t dist_mm)
+{
+	flight_rec_t rec;
+	rec.t_ms = board_time_ms();
+	rec.seq = (uint16_t)s_hdr.total;
+	rec.step = step;
+	rec.flags = flags;
+	rec.yaw_cdeg = frec_q16(tr->yaw_deg, 100.0f);
+	rec.rate_ddps = frec_q16(tr->rate_dps, 10.0f);
+	rec.err_ddps = frec_q16(tr->rate_err_dps, 10.0f);
+	rec.p_e4 = frec_q16(tr->p, 10000.0f);
+	rec.i_e4 = frec_q16(tr->i, 10000.0f);
+	rec.ff_e4 = frec_q16(tr->ff, 10000.0f);
+	for (uint8_t m = 0; m < 4U; ++m) {
+		rec.duty_e4[m] = frec_q16(tr->duty[m], 10000.0f);
+	}
+	rec.dist_dmm = (int32_t)(dist_mm * 10.0f);
+	// 先写记录再推进计数：复位发生在写入中途时最多丢失这一条
+	flight_rec_t *slot = &s_ring[s_hdr.total & (FLIGHT_REC_CAPACITY - 1U)];
+	*slot = rec;
+	s_hdr.total++;
+	return slot;
+}
+
+void FlightRec_Print(void)
+{
+	printf("[frec] 记录 %lu/%u 条，累计写入 %lu，%s，记录中复位 %lu 次\r\n", (unsigned long)frec_count(),
+	       FLIGHT_REC_CAPACITY, (unsigned long)s_hdr.total, s_hdr.dirty ? "记录中" : "空闲",
+	       (unsigned long)s_hdr.resets);
+}
+
+void FlightRec_Clear(void)
+{
+	s_dump_active = false;
+	frec_reset();
+}
+
+void FlightRec_DumpBegin(void)
+{
+	s_dump_end = s_hdr.total;
+	s_dump_next = s_hdr.total - frec_count();
+	s_dump_active = true;
+	printf("[frec] begin n=%lu\r\n", (unsigned long)frec_count());
+	printf("t_ms,seq,step,flags,yaw_cdeg,rate_ddps,err_ddps,p_e4,i_e4,ff_e4,d1_e4,d2_e4,d3_e4,d4_e4,dist_dmm\r\n");
+}
+
+bool FlightRec_DumpPoll(uint16_t max_lines)
+{
+	if (!s_dump_active) {
+		return false;
+	}
+	for (uint16_t n = 0; n < max_lines && s_dump_next != s_dump_end; ++n) {
+		const flight_rec_t *r = &s_ring[s_dump_next & (FLIGHT_REC_CAPACITY - 1U)];
+		printf("%lu,%u,%u,%u,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%ld\r\n", (unsigned long)r->t_ms, r->seq, r->step,
+		       r->flags, r->yaw_cdeg, r->rate_ddps, r->err_ddps, r->p_e4, r->i_e4, r->ff_e4,
+		       r->duty_e4[0], r->duty_e4[1], r->duty_e4[2], r->duty_e4[3], (long)r->dist_dmm);
+		s_dump_next++;
+	}
+	if (s_dump_next == s_dump_end) {
+		s_dump_active = false;
+		printf("[frec] end\r\n");
+	}
+	return s_dump_active;
+}
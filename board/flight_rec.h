@@ -0,0 +1,96 @@
+/**
+ * @file flight_rec.h
+ * @author 林木@江南大学
+ * @brief 飞行记录器 - 控制周期状态环形记录（复位后保留）
+ * @details 任务运行期间每个调度周期记录一条 32 字节定点记录（时间、航向、角速度、跟踪误差、
+ *          PID 各项、四路占空比、里程、标志）；记录区位于 .noinit 段，启动代码不清零，
+ *          看门狗/软件复位后内容仍在。任务未正常结束即复位时，启动阶段自动导出；
+ *          其余情况由命令行 frec dump 按需导出（整数 CSV，不经浮点格式化）
+ */
+
+#ifndef __FLIGHT_REC_H__
+#define __FLIGHT_REC_H__
+
+#include "RISCV_Typedefs.h"
+#include "my_move.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FLIGHT_REC_CAPACITY        256U   // 记录条数（2 的幂；20 ms 周期约 5 s）
+#define FLIGHT_REC_DUMP_LINES      4U     // 命令行每次轮询导出的行数（不撑满日志缓冲区）
+
+// 标志位：低 4 位为步骤类型（mission_step_type_t），高位为状态
+#define FLIGHT_REC_FLAG_TYPE_MASK  0x0FU
+#define FLIGHT_REC_FLAG_OBSTACLE   0x10U  // 避障等待中
+
+// 单条记录（定点，小端），字段顺序保证自然对齐
+typedef struct {
+    uint32_t t_ms;          // board_time_ms
+    uint16_t seq;           // 记录序号（低 16 位），用于识别环绕与缺口
+    uint8_t step;           // 任务步骤序号
+    uint8_t flags;
+    int16_t yaw_cdeg;       // 航向（0.01°）
+    int16_t rate_ddps;      // 角速度（0.1°/s）
+    int16_t err_ddps;       // 角速度跟踪误差（0.1°/s）
+    int16_t p_e4;           // 比例项（占空比 ×1e4）
+    int16_t i_e4;           // 积分项
+    int16_t ff_e4;          // 前馈项
+    int16_t duty_e4[4];     // 电机1~4 占空比（后退为负）
+    int32_t dist_dmm;       // 里程（0.1 mm）
+} flight_rec_t;
+
+/**
+ * @brief 上电/复位后调用一次（串口就绪后）：校验记录区，任务运行中复位时立即导出
+ */
+void FlightRec_Init(void);
+
+/**
+ * @brief 任务开始：清空记录并标记记录中
+ */
+void FlightRec_Start(void);
+
+/**
+ * @brief 任务结束（完成/中止/失败）：清除记录中标志，保留记录供按需导出
+ */
+void FlightRec_Stop(void);
+
+/**
+ * @brief 写入一条记录（控制周期内调用，只做定点量化与一次 32 字节写入）
+ * @param step 任务步骤序号
+ * @param flags 标志（FLIGHT_REC_FLAG_*）
+ * @param tr 本周期控制内部量
+ * @param dist_mm 里程计累计距离
+ * @return 本条记录（环形缓冲内，下一次写入前有效）
+ */
+const flight_rec_t *FlightRec_Record(uint8_t step, uint8_t flags, const my_move_trace_t *tr, float32_t dist_mm);
+
+/**
+ * @brief 打印记录区状态（条数、是否记录中、记录中复位次数）
+ */
+void FlightRec_Print(void);
+
+/**
+ * @brief 清空记录
+ */
+void FlightRec_Clear(void);
+
+/**
+ * @brief 开始导出：打印表头，之后由 FlightRec_DumpPoll 分批输出
+ */
+void FlightRec_DumpBegin(void);
+
+/**
+ * @brief 导出至多 max_lines 条记录
+ * @return 仍有待导出记录返回 true
+ */
+bool FlightRec_DumpPoll(uint16_t max_lines);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __FLIGHT_REC_H__
@@ -0,0 +1,672 @@
+/**
+ * @file fmt_lite.c
+ * @author 林木@江南大学
+ * @brief 轻量格式化输出实现
+ * @details 输出先写入调用者的缓冲：snprintf 写满即截断（只计长度），printf 写满即经 write 输出再继续。
+ *          浮点按位模式拆成 mant·2^e：e ≥ 0 为整数；e < 0 时整数部分 mant >> -e（< 2^53），
+ *          小数部分左对齐到 128 位定点数（4 个 32 位字，f[3] 最高），每乘 10 溢出的高位即下一位十进制数，
+ *          低位全 0 的字不参与乘法（float 提升来的 double 低 29 位为 0，常见日志值只算 2~3 个字）。
+ *          |x| < 2^-75 时低位截断，此时前 22 位小数必为 0，精度 ≤ 22 时结果仍精确
+ */
+
+#include "fmt_lite.h"
+#include <eswin_sdk_soc.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#define FMT_F_LEFT      0x01U   // -
+#define FMT_F_PLUS      0x02U   // +
+#define FMT_F_SPACE     0x04U   // 空格
+#define FMT_F_ALT       0x08U   // #
+#define FMT_F_ZERO      0x10U   // 0
+
+typedef enum {
+	FMT_LEN_NONE = 0,
+	FMT_LEN_HH,
+	FMT_LEN_H,
+	FMT_LEN_L,
+	FMT_LEN_LL,
+	FMT_LEN_Z,
+	FMT_LEN_T,
+	FMT_LEN_BIG_L,
+} fmt_len_t;
+
+typedef struct {
+    uint8_t flags;          // FMT_F_*
+    fmt_len_t len;
+    size_t width;
+    int prec;               // -1：未给出
+} fmt_spec_t;
+
+typedef struct {
+    char *buf;
+    size_t cap;             // 可写字节数（snprintf 为 size-1，留给结尾 0）
+    size_t pos;
+    size_t total;           // 完整输出应有的长度（返回值）
+    bool flush;             // true：写满时输出到 stdout；false：截断
+} fmt_out_t;
+
+static void fmt_flush(fmt_out_t *o)
+{
+	if (o->pos > 0U) {
+		(void)write(STDOUT_FILENO, o->buf, o->pos);
+		o->pos = 0;
+	}
+}
+
+static void fmt_write(fmt_out_t *o, const char *s, size_t n)
+{
+	o->total += n;
+	while (n > 0U) {
+		if (o->pos == o->cap) {
+			if (!o->flush) {
+				return;
+			}
+			fmt_flush(o);
+		}
+		size_t k = o->cap - o->pos;
+		if (k > n) {
+			k = n;
+		}
+		memcpy(o->buf + o->pos, s, k);
+		o->pos += k;
+		s += k;
+		n -= k;
+	}
+}
+
+static void fmt_fill(fmt_out_t *o, char c, size_t n)
+{
+	o->total += n;
+	while (n > 0U) {
+		if (o->pos == o->cap) {
+			if (!o->flush) {
+				return;
+			}
+			fmt_flush(o);
+		}
+		size_t k = o->cap - o->pos;
+		if (k > n) {
+			k = n;
+		}
+		memset(o->buf + o->pos, c, k);
+		o->pos += k;
+		n -= k;
+	}
+}
+
+/**
+ * @brief 按宽度与标志输出：[空格] 前缀 [0 填充] zeros 个 0、body、tail 个 0 [空格]
+ */
+static void fmt_pad(fmt_out_t *o, const fmt_spec_t *sp, const char *pre, size_t npre, size_t zeros,
+                    const char *body, size_t nbody, size_t tail)
+{
+	size_t len = npre + zeros + nbody + tail;
+	size_t pad = (sp->width > len) ? (sp->width - len) : 0U;
+	bool left = (sp->flags & FMT_F_LEFT) != 0U;
+	bool zero_pad = !left && (sp->flags & FMT_F_ZERO) != 0U;
+
+	if (!left && !zero_pad) {
+		fmt_fill(o, ' ', pad);
+	}
+	fmt_write(o, pre, npre);
+	if (zero_pad) {
+		fmt_fill(o, '0', pad);
+	}
+	fmt_fill(o, '0', zeros);
+	fmt_write(o, body, nbody);
+	fmt_fill(o, '0', tail);
+	if (left) {
+		fmt_fill(o, ' ', pad);
+	}
+}
+
+/**
+ * @brief 无符号整数转十进制，从 end 向前写，返回位数；≥ 2^32 时先按 1e9 分段，其余只用 32 位除法
+ */
+static size_t fmt_u64_dec(char *end, uint64_t v)
+{
+	char *p = end;
+	while (v > 0xFFFFFFFFULL) {
+		uint32_t chunk = (uint32_t)(v % 1000000000U);
+		v /= 1000000000U;
+		for (uint8_t i = 0; i < 9U; ++i) {
+			*--p = (char)('0' + chunk % 10U);
+			chunk /= 10U;
+		}
+	}
+	uint32_t w = (uint32_t)v;
+	do {
+		*--p = (char)('0' + w % 10U);
+		w /= 10U;
+	} while (w != 0U);
+	return (size_t)(end - p);
+}
+
+static void fmt_int(fmt_out_t *o, fmt_spec_t *sp, uint64_t v, bool neg, char conv)
+{
+	char buf[24];
+	char *end = buf + sizeof(buf);
+	char *p = end;
+	char pre[2];
+	size_t npre = 0;
+
+	if (conv == 'o') {
+		for (; v != 0U; v >>= 3) {
+			*--p = (char)('0' + (uint32_t)(v & 7U));
+		}
+	} else if (conv == 'x' || conv == 'X' || conv == 'p') {
+		const char *digits = (conv == 'X') ? "0123456789ABCDEF" : "0123456789abcdef";
+		if (v != 0U && (sp->flags & FMT_F_ALT) != 0U && conv != 'p') {
+			pre[npre++] = '0';
+			pre[npre++] = conv;
+		}
+		for (; v != 0U; v >>= 4) {
+			*--p = digits[(uint32_t)v & 15U];
+		}
+		if (conv == 'p') {
+			pre[npre++] = '0';
+			pre[npre++] = 'x';
+		}
+	} else if (v != 0U) {
+		p -= fmt_u64_dec(end, v);
+	}
+	// 精度 0 且值为 0 时不输出数字；未给精度时至少 1 位
+	if (p == end && sp->prec != 0) {
+		*--p = '0';
+	}
+	if (conv == 'd' || conv == 'i') {
+		if (neg) {
+			pre[npre++] = '-';
+		} else if ((sp->flags & FMT_F_PLUS) != 0U) {
+			pre[npre++] = '+';
+		} else if ((sp->flags & FMT_F_SPACE) != 0U) {
+			pre[npre++] = ' ';
+		}
+	}
+
+	size_t n = (size_t)(end - p);
+	size_t zeros = 0;
+	if (sp->prec >= 0) {
+		sp->flags &= (uint8_t)~FMT_F_ZERO;
+		if ((size_t)sp->prec > n) {
+			zeros = (size_t)sp->prec - n;
+		}
+	}
+	// %#o：保证首位为 0
+	if (conv == 'o' && (sp->flags & FMT_F_ALT) != 0U && zeros == 0U && (n == 0U || *p != '0')) {
+		zeros = 1;
+	}
+	fmt_pad(o, sp, pre, npre, zeros, p, n, 0);
+}
+
+/**
+ * @brief |x| ≥ 2^64 的整数值（mant·2^e，e > 11）：33 个 32 位字的大整数反复除以 1e9。
+ *        不内联，平时的栈深度不含这 450 字节
+ */
+static __attribute__((noinline)) void fmt_float_big(fmt_out_t *o, const fmt_spec_t *sp, const char *pre,
+                                                    size_t npre, uint64_t mant, int e, size_t prec)
+{
+	uint32_t w[33];
+	char buf[320];
+	char *end = buf + sizeof(buf) - 1;
+	char *p = end;
+	uint32_t q = (uint32_t)e / 32U;
+	uint32_t r = (uint32_t)e % 32U;
+	int n = (int)q + 3;
+
+	memset(w, 0, sizeof(w));
+	uint64_t lo = mant << r;
+	w[q] = (uint32_t)lo;
+	w[q + 1U] = (uint32_t)(lo >> 32);
+	w[q + 2U] = (r != 0U) ? (uint32_t)(mant >> (64U - r)) : 0U;
+	while (n > 0 && w[n - 1] == 0U) {
+		n--;
+	}
+	while (n > 0) {
+		uint64_t rem = 0;
+		for (int i = n - 1; i >= 0; --i) {
+			uint64_t cur = (rem << 32) | w[i];
+			w[i] = (uint32_t)(cur / 1000000000U);
+			rem = cur % 1000000000U;
+		}
+		while (n > 0 && w[n - 1] == 0U) {
+			n--;
+		}
+		uint32_t c = (uint32_t)rem;
+		if (n > 0) {
+			for (uint8_t i = 0; i < 9U; ++i) {
+				*--p = (char)('0' + c % 10U);
+				c /= 10U;
+			}
+		} else {
+			do {
+				*--p = (char)('0' + c % 10U);
+				c /= 10U;
+			} while (c != 0U);
+		}
+	}
+	size_t nbody = (size_t)(end - p);
+	if (prec > 0U || (sp->flags & FMT_F_ALT) != 0U) {
+		*end = '.';
+		nbody++;
+	}
+	fmt_pad(o, sp, pre, npre, 0, p, nbody, prec);
+}
+
+static void fmt_float(fmt_out_t *o, fmt_spec_t *sp, double x, char conv)
+{
+	union {
+		double d;
+		uint64_t u;
+	} bits = { x };
+	char pre[1];
+	size_t npre = 0;
+	uint32_t bexp = (uint32_t)(bits.u >> 52) & 0x7FFU;
+	uint64_t mant = bits.u & 0x000FFFFFFFFFFFFFULL;
+	int e;
+
+	if ((bits.u >> 63) != 0U) {
+		pre[npre++] = '-';
+	} else if ((sp->flags & FMT_F_PLUS) != 0U) {
+		pre[npre++] = '+';
+	} else if ((sp->flags & FMT_F_SPACE) != 0U) {
+		pre[npre++] = ' ';
+	}
+	if (bexp == 0x7FFU) {
+		const char *s = (mant != 0U) ? ((conv == 'F') ? "NAN" : "nan") : ((conv == 'F') ? "INF" : "inf");
+		sp->flags &= (uint8_t)~FMT_F_ZERO;
+		fmt_pad(o, sp, pre, npre, 0, s, 3, 0);
+		return;
+	}
+	if (bexp == 0U) {
+		e = -1074;
+	} else {
+		mant |= 1ULL << 52;
+		e = (int)bexp - 1075;
+	}
+
+	size_t prec = (sp->prec < 0) ? 6U : (size_t)sp->prec;
+	size_t ndig = (prec > FMT_LITE_FRAC_MAX) ? FMT_LITE_FRAC_MAX : prec;
+	size_t tail = prec - ndig;
+	uint64_t ip;
+	char buf[24 + 1 + FMT_LITE_FRAC_MAX];
+	char *dot = buf + 24;
+	char *frac = dot + 1;
+
+	if (mant == 0U || e >= 0) {
+		if (e > 11 && mant != 0U) {
+			fmt_float_big(o, sp, pre, npre, mant, e, prec);
+			return;
+		}
+		ip = (mant == 0U) ? 0U : (mant << e);
+		memset(frac, '0', ndig);
+	} else {
+		uint32_t f[4] = { 0, 0, 0, 0 };
+		uint32_t shift = (uint32_t)-e;
+		uint64_t fr;
+		if (shift < 64U) {
+			ip = mant >> shift;
+			fr = mant & ((1ULL << shift) - 1U);
+		} else {
+			ip = 0;
+			fr = mant;
+		}
+		// f = fr·2^(128-shift)，即小数部分的 128 位定点表示
+		if (shift <= 128U) {
+			uint32_t s = 128U - shift;
+			uint32_t word = s / 32U;
+			uint32_t b = s % 32U;
+			uint64_t lo = fr << b;
+			uint32_t hi = (b != 0U) ? (uint32_t)(fr >> (64U - b)) : 0U;
+			f[word] = (uint32_t)lo;
+			if (word + 1U < 4U) {
+				f[word + 1U] = (uint32_t)(lo >> 32);
+			}
+			if (word + 2U < 4U) {
+				f[word + 2U] = hi;
+			}
+		} else if (shift - 128U < 64U) {
+			uint64_t t = fr >> (shift - 128U);
+			f[0] = (uint32_t)t;
+			f[1] = (uint32_t)(t >> 32);
+		}
+
+		uint32_t lo_word = 0;
+		while (lo_word < 4U && f[lo_word] == 0U) {
+			lo_word++;
+		}
+		for (size_t i = 0; i < ndig; ++i) {
+			uint32_t carry = 0;
+			for (uint32_t k = lo_word; k < 4U; ++k) {
+				uint64_t t = (uint64_t)f[k] * 10U + carry;
+				f[k] = (uint32_t)t;
+				carry = (uint32_t)(t >> 32);
+			}
+			frac[i] = (char)('0' + carry);
+		}
+		// 剩余部分与 1/2 比较，恰好一半时向偶数舍入
+		bool up;
+		if (ndig < prec) {
+			up = false;
+		} else if (f[3] != 0x80000000U) {
+			up = f[3] > 0x80000000U;
+		} else if ((f[2] | f[1] | f[0]) != 0U) {
+			up = true;
+		} else {
+			uint32_t last = (ndig > 0U) ? (uint32_t)(frac[ndig - 1U] - '0') : (uint32_t)ip;
+			up = (last & 1U) != 0U;
+		}
+		if (up) {
+			size_t i = ndig;
+			while (i > 0U && frac[i - 1U] == '9') {
+				frac[--i] = '0';
+			}
+			if (i > 0U) {
+				frac[i - 1U]++;
+			} else {
+				ip++;
+			}
+		}
+	}
+
+	size_t nint = fmt_u64_dec(dot, ip);
+	size_t nbody = nint;
+	if (prec > 0U || (sp->flags & FMT_F_ALT) != 0U) {
+		*dot = '.';
+		nbody += 1U + ndig;
+	}
+	fmt_pad(o, sp, pre, npre, 0, dot - nint, nbody, tail);
+}
+
+static void fmt_str(fmt_out_t *o, fmt_spec_t *sp, const char *s)
+{
+	size_t n = 0;
+	if (s == NULL) {
+		s = "(null)";
+	}
+	while ((sp->prec < 0 || n < (size_t)sp->prec) && s[n] != '\0') {
+		n++;
+	}
+	sp->flags &= (uint8_t)~FMT_F_ZERO;
+	fmt_pad(o, sp, NULL, 0, 0, s, n, 0);
+}
+
+static void fmt_format(fmt_out_t *o, const char *fmt, va_list ap)
+{
+	for (;;) {
+		const char *run = fmt;
+		while (*fmt != '\0' && *fmt != '%') {
+			fmt++;
+		}
+		fmt_write(o, run, (size_t)(fmt - run));
+		if (*fmt == '\0') {
+			return;
+		}
+		const char *start = fmt++;
+		fmt_spec_t sp = { 0, FMT_LEN_NONE, 0, -1 };
+
+		for (;; ++fmt) {
+			if (*fmt == '-') {
+				sp.flags |= FMT_F_LEFT;
+			} else if (*fmt == '+') {
+				sp.flags |= FMT_F_PLUS;
+			} else if (*fmt == ' ') {
+				sp.flags |= FMT_F_SPACE;
+			} else if (*fmt == '#') {
+				sp.flags |= FMT_F_ALT;
+			} else if (*fmt == '0') {
+				sp.flags |= FMT_F_ZERO;
+			} else {
+				break;
+			}
+		}
+		if (*fmt == '*') {
+			int w = va_arg(ap, int);
+			if (w < 0) {
+				sp.flags |= FMT_F_LEFT;
+				w = -w;
+			}
+			sp.width = (size_t)w;
+			fmt++;
+		} else {
+			while (*fmt >= '0' && *fmt <= '9') {
+				sp.width = sp.width * 10U + (size_t)(*fmt++ - '0');
+			}
+		}
+		if (*fmt == '.') {
+			fmt++;
+			if (*fmt == '*') {
+				int p = va_arg(ap, int);
+				sp.prec = (p < 0) ? -1 : p;
+				fmt++;
+			} else {
+				sp.prec = 0;
+				while (*fmt >= '0' && *fmt <= '9') {
+					sp.prec = sp.prec * 10 + (*fmt++ - '0');
+				}
+			}
+		}
+		switch (*fmt) {
+		case 'h':
+			sp.len = FMT_LEN_H;
+			if (*++fmt == 'h') {
+				sp.len = FMT_LEN_HH;
+				fmt++;
+			}
+			break;
+		case 'l':
+			sp.len = FMT_LEN_L;
+			if (*++fmt == 'l') {
+				sp.len = FMT_LEN_LL;
+				fmt++;
+			}
+			break;
+		case 'j':
+			sp.len = FMT_LEN_LL;
+			fmt++;
+			break;
+		case 'z':
+			sp.len = FMT_LEN_Z;
+			fmt++;
+			break;
+		case 't':
+			sp.len = FMT_LEN_T;
+			fmt++;
+			break;
+		case 'L':
+			sp.len = FMT_LEN_BIG_L;
+			fmt++;
+			break;
+		default:
+			break;
+		}
+
+		char conv = *fmt;
+		if (conv == '\0') {
+			fmt_write(o, start, (size_t)(fmt - start));
+			return;
+		}
+		fmt++;
+		switch (conv) {
+		case 'd':
+		case 'i': {
+			int64_t v;
+			switch (sp.len) {
+			case FMT_LEN_HH: v = (signed char)va_arg(ap, int); break;
+			case FMT_LEN_H:  v = (short)va_arg(ap, int); break;
+			case FMT_LEN_L:  v = va_arg(ap, long); break;
+			case FMT_LEN_LL: v = va_arg(ap, long long); break;
+			case FMT_LEN_Z:
+			case FMT_LEN_T:  v = va_arg(ap, ptrdiff_t); break;
+			default:         v = va_arg(ap, int); break;
+			}
+			fmt_int(o, &sp, (v < 0) ? (0U - (uint64_t)v) : (uint64_t)v, v < 0, conv);
+			break;
+		}
+		case 'u':
+		case 'o':
+		case 'x':
+		case 'X': {
+			uint64_t v;
+			switch (sp.len) {
+			case FMT_LEN_HH: v = (unsigned char)va_arg(ap, unsigned int); break;
+			case FMT_LEN_H:  v = (unsigned short)va_arg(ap, unsigned int); break;
+			case FMT_LEN_L:  v = va_arg(ap, unsigned long); break;
+			case FMT_LEN_LL: v = va_arg(ap, unsigned long long); break;
+			case FMT_LEN_Z:
+			case FMT_LEN_T:  v = va_arg(ap, size_t); break;
+			default:         v = va_arg(ap, unsigned int); break;
+			}
+			fmt_int(o, &sp, v, false, conv);
+			break;
+		}
+		case 'p':
+			sp.flags &= (uint8_t)~(FMT_F_PLUS | FMT_F_SPACE);
+			fmt_int(o, &sp, (uintptr_t)va_arg(ap, void *), false, conv);
+			break;
+		case 'c': {
+			char c = (char)va_arg(ap, int);
+			sp.flags &= (uint8_t)~FMT_F_ZERO;
+			fmt_pad(o, &sp, NULL, 0, 0, &c, 1, 0);
+			break;
+		}
+		case 's':
+			fmt_str(o, &sp, va_arg(ap, const char *));
+			break;
+		case 'f':
+		case 'F':
+			if (sp.len == FMT_LEN_BIG_L) {
+				// %Lf 与 %e 同样不支持：long double 转 double 会链接软浮点 __trunctfdf2，只跳过参数
+				(void)va_arg(ap, long double);
+				fmt_write(o, start, (size_t)(fmt - start));
+			} else {
+				fmt_float(o, &sp, va_arg(ap, double), conv);
+			}
+			break;
+		case 'e':
+		case 'E':
+		case 'g':
+		case 'G':
+		case 'a':
+		case 'A':
+			// 不支持：原样输出说明符，跳过参数
+			if (sp.len == FMT_LEN_BIG_L) {
+				(void)va_arg(ap, long double);
+			} else {
+				(void)va_arg(ap, double);
+			}
+			fmt_write(o, start, (size_t)(fmt - start));
+			break;
+		case 'n':
+			(void)va_arg(ap, void *);
+			break;
+		case '%':
+			fmt_write(o, "%", 1);
+			break;
+		default:
+			fmt_write(o, start, (size_t)(fmt - start));
+			break;
+		}
+	}
+}
+
+int fmt_vsnprintf(char *buf, size_t size, const char *fmt, va_list ap)
+{
+	fmt_out_t o = { buf, (size > 0U) ? (size - 1U) : 0U, 0, 0, false };
+	fmt_format(&o, fmt, ap);
+	if (size > 0U) {
+		buf[o.pos] = '\0';
+	}
+	return (int)o.total;
+}
+
+int fmt_snprintf(char *buf, size_t size, const char *fmt, ...)
+{
+	va_list ap;
+	va_start(ap, fmt);
+	int n = fmt_vsnprintf(buf, size, fmt, ap);
+	va_end(ap);
+	return n;
+}
+
+int fmt_vprintf(const char *fmt, va_list ap)
+{
+	char line[FMT_LITE_LINE_MAX];
+	fmt_out_t o = { line, sizeof(line), 0, 0, true };
+	fmt_format(&o, fmt, ap);
+	fmt_flush(&o);
+	return (int)o.total;
+}
+
+int fmt_printf(const char *fmt, ...)
+{
+	va_list ap;
+	va_start(ap, fmt);
+	int n = fmt_vprintf(fmt, ap);
+	va_end(ap);
+	return n;
+}
+
+// 与 my_move.c 直行日志行相同的格式与参数类型
+#define FMT_BENCH_LINE    "StraightTick: yaw=%.2f°, duty%%: M1=%.1f%% M2=%.1f%% M3=%.1f%% M4=%.1f%%, 避障计数=%d, " \
+                          "等待状态=%s, 纠偏=%.3f, 大误差=%s, 振荡=%s, 实际运动=%dms, 累计等待=%dms\r\n"
+
+void fmt_bench(uint32_t lines)
+{
+	char a[256];
+	char b[256];
+	uint64_t lite_cycles = 0;
+	uint64_t libc_cycles = 0;
+	uint32_t lite_min = UINT32_MAX;
+	uint32_t libc_min = UINT32_MAX;
+	uint32_t mismatch = 0;
+	uint32_t first_bad = 0;
+
+	if (lines == 0U) {
+		return;
+	}
+	for (uint32_t i = 0; i < lines; ++i) {
+		// 参数随 i 变化，覆盖正负、进位与不同位数
+		float y = -179.9f + (float)(i % 3600U) * 0.1f;
+		float d = 5.0f + (float)(i % 950U) * 0.1f;
+		float corr = (float)((int32_t)(i % 2001U) - 1000) * 0.0137f;
+		int hits = (int)(i % 7U);
+		int motion = (int)(i * 100U);
+		int wait = (int)(i * 37U % 5000U);
+		const char *w = (i & 1U) ? "是" : "否";
+		const char *l = (i & 2U) ? "是" : "否";
+		const char *s = (i & 4U) ? "是" : "否";
+
+		uint64_t t0 = __get_rv_cycle();
+		(void)fmt_snprintf(a, sizeof(a), FMT_BENCH_LINE, y, d, d, d * 0.9f, d * 0.9f, hits, w, corr, l, s,
+		                   motion, wait);
+		uint64_t t1 = __get_rv_cycle();
+		(void)snprintf(b, sizeof(b), FMT_BENCH_LINE, y, d, d, d * 0.9f, d * 0.9f, hits, w, corr, l, s,
+		               motion, wait);
+		uint64_t t2 = __get_rv_cycle();
+
+		uint32_t c = (uint32_t)(t1 - t0);
+		lite_cycles += c;
+		lite_min = (c < lite_min) ? c : lite_min;
+		c = (uint32_t)(t2 - t1);
+		libc_cycles += c;
+		libc_min = (c < libc_min) ? c : libc_min;
+		if (strcmp(a, b) != 0) {
+			if (mismatch++ == 0U) {
+				first_bad = i;
+			}
+		}
+	}
+	printf("[fmt] %lu 行 StraightTick: fmt_lite 平均 %lu 周期/行（最少 %lu），snprintf%s 平均 %lu 周期/行（最少 %lu）\r\n",
+	       (unsigned long)lines, (unsigned long)(lite_cycles / lines), (unsigned long)lite_min,
+	       APP_PRINTF_LITE ? "（即 fmt_lite）" : "（newlib）", (unsigned long)(libc_cycles / lines),
+	       (unsigned long)libc_min);
+	if (mismatch == 0U) {
+		printf("[fmt] 输出逐字节相同\r\n");
+	} else {
+		printf("[fmt] 输出不一致 %lu 行，首行 #%lu\r\n", (unsigned long)mismatch, (unsigned long)first_bad);
+	}
+}
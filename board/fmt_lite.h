@@ -0,0 +1,55 @@
+/**
+ * @file fmt_lite.h
+ * @author 林木@江南大学
+ * @brief 轻量格式化输出（APP_PRINTF_LITE=1 时替代 newlib printf 系列）
+ * @details newlib 的 vfprintf 一旦用到 %f 就链接 _dtoa_r（大数运算经 _Balloc 从堆分配），
+ *          每条日志行都要走一遍，代码大、单次调用慢。本模块直接按 IEEE 754 位模式做定点十进制转换：
+ *          - 浮点（%f/%F）：整数部分用 64 位整数，小数部分为 128 位定点数，逐位乘 10 取整，
+ *            按剩余部分正确舍入（恰好一半时取偶），与 newlib/glibc 输出逐字节相同；
+ *            |值| ≥ 2^64 时走大整数路径（罕见，单独占栈）
+ *          - 整数：d i u o x X c s p %，标志 - + 空格 # 0，宽度/精度（含 *），长度 hh h l ll z j t
+ *          - 不支持 %e/%g/%a/%n 与 long double（%Lf 等，工程中未使用）：原样输出说明符并跳过参数
+ *          可重入：无静态状态、不分配堆；printf 在栈上格式化（FMT_LITE_LINE_MAX 字节一段），
+ *          经 write(STDOUT_FILENO) 输出，与令牌化日志帧走同一 _write。
+ *          SDK 桩 platform/stubs/src/printf.c 以弱符号把 printf/vprintf/puts/putchar/sprintf/snprintf/
+ *          vsnprintf 接到本模块（newlib 的 vfprintf 不再被链接），SDK 日志模块（log.h）直接调用 fmt_printf
+ */
+
+#ifndef FMT_LITE_H
+#define FMT_LITE_H
+
+#include "app_config.h"
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FMT_LITE_LINE_MAX    128U    // printf 栈上缓冲（超长时分段写出）
+#define FMT_LITE_FRAC_MAX    40U     // 浮点小数位逐位计算的上限，更多的位补 0（工程中最多 5 位）
+
+/**
+ * @brief 与 C99 vsnprintf 相同：最多写入 size-1 个字符并以 0 结尾，返回完整输出应有的长度
+ */
+int fmt_vsnprintf(char *buf, size_t size, const char *fmt, va_list ap);
+int fmt_snprintf(char *buf, size_t size, const char *fmt, ...) __attribute__((format(printf, 3, 4)));
+
+/**
+ * @brief 格式化到栈上缓冲并写到标准输出，返回输出字符数
+ */
+int fmt_vprintf(const char *fmt, va_list ap);
+int fmt_printf(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+
+/**
+ * @brief 基准：按直行日志行（StraightTick）格式化 lines 次，分别统计本模块与当前链接的 snprintf
+ *        的每行周期数，并比较两者输出是否逐字节相同（APP_PRINTF_LITE=0 构建中即与 newlib 比较）
+ */
+void fmt_bench(uint32_t lines);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -20,16 +20,35 @@
 #define H30_REG_GYRO_BASE            (0x20)   // 连续12字节: X/Y/Z，每轴4字节int
 #define H30_GYRO_DATA_LEN_BYTES      (12)
 #define H30_DATA_SCALE_NOT_MAG       (0.000001f) // 数据缩放因子 1e-6
+#define H30_GYRO_Z_FIXED_BIAS_DPS    (5.5f)      // Z 轴固定零偏（°/s），与监控显示一致
 
 // H30 INT 数据就绪引脚：PORTD, pin 4
 #define H30_INT_PORT                 (PORTD)
 #define H30_INT_PIN                  (4U)
+#define H30_INT_IRQN                 (GPIOD_4_IRQn)
 
 static i2c_master_state_t s_i2c0MasterState;
 static bool s_h30_inited = false;
 static float s_yaw_deg = 0.0f;
 static const float DEAD_ZONE_DPS = 0.15f;  // 死区阈值：0.15°/s
 static uint8_t s_h30_i2c_addr = H30_I2C_ADDR_PRIMARY;
+static uint8_t s_h30_preferred_addr = 0;     // 标定记录中的地址，0 表示未知
+static float s_gyro_z_bias_dps = H30_GYRO_Z_FIXED_BIAS_DPS;
+
+// 缓存模式：采集任务调用 H30_Update 写入，读接口直接返回最新样本（序号为奇数表示写入中）
+typedef struct {
+	float pitch_deg;
+	float roll_deg;
+	float yaw_deg;
+	float gz_dps;
+	uint32_t t_ms;
+} h30_sample_t;
+
+static h30_sample_t s_sample;
+static volatile uint32_t s_sample_seq = 0;
+static bool s_sample_valid = false;
+static bool s_cached_mode = false;
+static void (*s_drdy_callback)(void) = NULL;
 
 static void h30_set_addr_value(uint8_t addr)
 {
@@ -118,46 +137,42 @@ bool H30_Init(void)
 	// 配置 INT 引脚为输入
 	PINS_DRV_WritePinDirection(H30_INT_PORT, H30_INT_PIN, GPIO_INPUT_DIRECTION);
 	
-	// 若扫描曾显示 0x35，则优先尝试 0x35
-	s_h30_i2c_addr = H30_I2C_ADDR_7BIT_PREFERRED;
+	// 标定记录中的地址优先（一次读即完成探测）；否则依次尝试 0x35(7位)/0x6A/0x6B
+	const uint8_t candidates[] = { s_h30_preferred_addr, H30_I2C_ADDR_7BIT_PREFERRED,
+	                               H30_I2C_ADDR_PRIMARY, H30_I2C_ADDR_ALTERNATE };
 	uint8_t probe[H30_GYRO_DATA_LEN_BYTES];
-	if (!h30_read_gyro_block(probe)) {
-		printf("H30 0x35(7位) 读失败，尝试0x6A...\r\n");
-		s_h30_i2c_addr = H30_I2C_ADDR_PRIMARY;
-		if (!h30_read_gyro_block(probe)) {
-			printf("H30 0x6A 读失败，尝试0x6B...\r\n");
-			s_h30_i2c_addr = H30_I2C_ADDR_ALTERNATE;
-			if (!h30_read_gyro_block(probe)) {
-				printf("H30 在 0x35/0x6A/0x6B 均读失败\r\n");
-				// 扫描总线，帮助定位接线/模式问题
-				h30_scan_i2c_bus();
-				return false;
-			}
+	bool found = false;
+	for (uint8_t i = 0; i < sizeof(candidates) && !found; i++) {
+		if (candidates[i] == 0U || (i > 0U && candidates[i] == s_h30_preferred_addr)) continue;
+		s_h30_i2c_addr = candidates[i];
+		found = h30_read_gyro_block(probe);
+		if (!found) {
+			printf("H30 0x%02X 读失败\r\n", s_h30_i2c_addr);
 		}
 	}
+	if (!found) {
+		printf("H30 在 0x35/0x6A/0x6B 均读失败\r\n");
+		// 扫描总线，帮助定位接线/模式问题
+		h30_scan_i2c_bus();
+		return false;
+	}
 	// 通过探测
 	s_h30_inited = true;
 	printf("H30 使用I2C地址 0x%02X\r\n", s_h30_i2c_addr);
 	return true;
 }
 
-bool H30_ReadGzDps(float *gz_dps_out)
+static bool h30_bus_read_gz(float *gz_dps_out)
 {
-	if (!gz_dps_out) return false;
-	// 优先等待INT，但不作为硬性条件
-	( void )h30_wait_data_ready_any(5);
-	// 数据就绪后稍作延时，满足器件保持时间
-	DELAY_MS(1);
 	uint8_t raw[H30_GYRO_DATA_LEN_BYTES];
 	if (!h30_read_gyro_block(raw)) return false;
 	// 数据顺序: X[0..3], Y[4..7], Z[8..11]，单位通过系数换算
 	int32_t gz_i32 = read_le_i32(&raw[8]);
-	float gz_dps = ((float)gz_i32) * H30_DATA_SCALE_NOT_MAG; // 转为dps
-	*gz_dps_out = gz_dps;
+	*gz_dps_out = ((float)gz_i32) * H30_DATA_SCALE_NOT_MAG; // 转为dps
 	return true;
 }
 
-bool H30_ReadEuler(float *pitch_deg, float *roll_deg, float *yaw_deg)
+static bool h30_bus_read_euler(float *pitch_deg, float *roll_deg, float *yaw_deg)
 {
 	uint8_t reg = 0x40; // I2C_EULER_REG_ADDR
 	h30_set_addr();
@@ -166,12 +181,109 @@ bool H30_ReadEuler(float *pitch_deg, float *roll_deg, float *yaw_deg)
 	uint8_t buf[12];
 	st = I2C_DRV_MasterReceiveDataBlocking(INST_I2C_0, buf, 12, true, OSIF_WAIT_FOREVER);
 	if (st != STATUS_SUCCESS) return false;
-	int32_t p_i = read_le_i32(&buf[0]);
-	int32_t r_i = read_le_i32(&buf[4]);
-	int32_t y_i = read_le_i32(&buf[8]);
-	float p = ((float)p_i) * H30_DATA_SCALE_NOT_MAG;
-	float r = ((float)r_i) * H30_DATA_SCALE_NOT_MAG;
-	float y = ((float)y_i) * H30_DATA_SCALE_NOT_MAG;
+	*pitch_deg = ((float)read_le_i32(&buf[0])) * H30_DATA_SCALE_NOT_MAG;
+	*roll_deg  = ((float)read_le_i32(&buf[4])) * H30_DATA_SCALE_NOT_MAG;
+	*yaw_deg   = ((float)read_le_i32(&buf[8])) * H30_DATA_SCALE_NOT_MAG;
+	return true;
+}
+
+// 读取缓存样本（写入被打断时重读）；无样本或超过 H30_SAMPLE_MAX_AGE_MS 视为失败
+static bool h30_get_sample(h30_sample_t *out)
+{
+	uint32_t seq;
+	do {
+		seq = s_sample_seq;
+		__sync_synchronize();
+		*out = s_sample;
+		__sync_synchronize();
+	} while ((seq & 1U) != 0U || seq != s_sample_seq);
+	return s_sample_valid && (board_time_ms() - out->t_ms) <= H30_SAMPLE_MAX_AGE_MS;
+}
+
+bool H30_Update(void)
+{
+	h30_sample_t sample;
+	// 数据就绪后稍作延时，满足器件保持时间
+	DELAY_MS(1);
+	if (!h30_bus_read_gz(&sample.gz_dps)) return false;
+	if (!h30_bus_read_euler(&sample.pitch_deg, &sample.roll_deg, &sample.yaw_deg)) return false;
+	sample.t_ms = board_time_ms();
+	s_sample_seq++;
+	__sync_synchronize();
+	s_sample = sample;
+	s_sample_valid = true;
+	__sync_synchronize();
+	s_sample_seq++;
+	return true;
+}
+
+void H30_SetCachedMode(bool enable)
+{
+	s_cached_mode = enable;
+}
+
+static void h30_drdy_irq_handler(void *arg)
+{
+	(void)arg;
+	PINS_DRV_ClearPinIntFlagCmd(H30_INT_PORT, H30_INT_PIN);
+	if (s_drdy_callback != NULL) {
+		s_drdy_callback();
+	}
+}
+
+void H30_EnableDataReadyIrq(void (*on_ready)(void))
+{
+	OS_RegisterType_t type;
+	s_drdy_callback = on_ready;
+	// 数据就绪上升沿触发；极性不符时采集任务按超时周期轮询，功能不受影响
+	PINS_DRV_SetPinIntSel(H30_INT_PORT, H30_INT_PIN, PORT_INT_RISING_EDGE);
+	PINS_DRV_ClearPinIntFlagCmd(H30_INT_PORT, H30_INT_PIN);
+	type.trig_mode = CLIC_LEVEL_TRIGGER;
+	type.lvl       = 1;
+	type.priority  = 0;
+	type.data_ptr  = NULL;
+	OS_RequestIrq(H30_INT_IRQN, h30_drdy_irq_handler, &type);
+	OS_EnableIrq(H30_INT_IRQN);
+}
+
+bool H30_ReadGzDps(float *gz_dps_out)
+{
+	if (!gz_dps_out) return false;
+	if (s_cached_mode) {
+		h30_sample_t sample;
+		if (!h30_get_sample(&sample)) return false;
+		*gz_dps_out = sample.gz_dps;
+		return true;
+	}
+	// 优先等待INT，但不作为硬性条件
+	( void )h30_wait_data_ready_any(5);
+	// 数据就绪后稍作延时，满足器件保持时间
+	DELAY_MS(1);
+	return h30_bus_read_gz(gz_dps_out);
+}
+
+bool H30_ReadYawRateDps(float *yaw_rate_dps_out)
+{
+	if (!yaw_rate_dps_out) return false;
+	float gz_dps;
+	if (!H30_ReadGzDps(&gz_dps)) return false;
+	// 陀螺 Z 轴右转为正，欧拉 yaw 左转为正，此处统一到欧拉航向方向
+	*yaw_rate_dps_out = -(gz_dps - s_gyro_z_bias_dps);
+	return true;
+}
+
+bool H30_ReadEuler(float *pitch_deg, float *roll_deg, float *yaw_deg)
+{
+	float p, r, y;
+	if (s_cached_mode) {
+		h30_sample_t sample;
+		if (!h30_get_sample(&sample)) return false;
+		p = sample.pitch_deg;
+		r = sample.roll_deg;
+		y = sample.yaw_deg;
+	} else if (!h30_bus_read_euler(&p, &r, &y)) {
+		return false;
+	}
 	if (pitch_deg) *pitch_deg = p;
 	if (roll_deg)  *roll_deg  = r;
 	if (yaw_deg)   *yaw_deg   = y;
@@ -188,10 +300,8 @@ void H30_UpdateYaw(uint32_t dt_ms)
 	float gz_dps;
 	if (!H30_ReadGzDps(&gz_dps)) return;
 	
-	// 直接减去固定的零偏值，防止角度漂移
-	// 根据观察到的数据，零偏约为 5.5°/s（与监控显示一致，如需可调整）
-	const float FIXED_BIAS_DPS = 5.5f;
-	float gz_corr = gz_dps - FIXED_BIAS_DPS;
+	// 减去零偏（默认固定值 5.5°/s，有标定记录时使用标定值），防止角度漂移
+	float gz_corr = gz_dps - s_gyro_z_bias_dps;
 	
 	// 死区处理：如果角速度很小，认为是静止状态
 	if (fabsf(gz_corr) < DEAD_ZONE_DPS) {
@@ -209,9 +319,41 @@ float H30_GetYawDeg(void)
 
 float H30_GetGyroZBias(void)
 {
-	// 零偏补偿已禁用，始终返回 0
-	return 0.0f;
-} 
+	return s_gyro_z_bias_dps;
+}
+
+void H30_SetGyroZBias(float bias_dps)
+{
+	s_gyro_z_bias_dps = bias_dps;
+}
+
+bool H30_MeasureGyroZBias(uint8_t samples, float *bias_dps_out)
+{
+	if (!bias_dps_out || samples == 0U) return false;
+	float sum = 0.0f;
+	uint8_t ok = 0;
+	for (uint8_t i = 0; i < samples; i++) {
+		float gz;
+		if (H30_ReadGzDps(&gz)) {
+			sum += gz;
+			ok++;
+		}
+	}
+	// 少于一半样本成功视为失败
+	if (ok < (uint8_t)((samples + 1U) / 2U)) return false;
+	*bias_dps_out = sum / (float)ok;
+	return true;
+}
+
+void H30_SetPreferredAddr(uint8_t addr_7bit)
+{
+	s_h30_preferred_addr = addr_7bit;
+}
+
+uint8_t H30_GetI2cAddr(void)
+{
+	return s_h30_inited ? s_h30_i2c_addr : 0U;
+}
 
 bool H30_CaptureYawOrigin(uint8_t samples, uint16_t delay_ms_between_samples)
 {
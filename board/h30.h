@@ -22,6 +22,9 @@ bool H30_Init(void);
 // 读取当前 Z 轴角速度（单位：度/秒）。返回是否成功
 bool H30_ReadGzDps(float *gz_dps_out);
 
+// 读取零偏补偿后的航向角速度（单位：度/秒），符号与欧拉 yaw 一致：左转为正。返回是否成功
+bool H30_ReadYawRateDps(float *yaw_rate_dps_out);
+
 // 读取 H30 欧拉角（pitch/roll/yaw，单位：度）。返回是否成功
 bool H30_ReadEuler(float *pitch_deg, float *roll_deg, float *yaw_deg);
 
@@ -37,8 +40,27 @@ void H30_UpdateYaw(uint32_t dt_ms);
 // 获取内部累计航向角（单位：度）。右转为正，左转为负
 float H30_GetYawDeg(void);
 
-// 获取当前陀螺 Z 轴零偏值（单位：度/秒）
+// 获取当前陀螺 Z 轴零偏值（单位：度/秒），默认固定值，可由标定记录覆盖
 float H30_GetGyroZBias(void);
+// 设置陀螺 Z 轴零偏（单位：度/秒）
+void H30_SetGyroZBias(float bias_dps);
+// 静止时平均 samples 个原始 Z 轴角速度作为零偏估计，成功返回 true
+bool H30_MeasureGyroZBias(uint8_t samples, float *bias_dps_out);
+
+// 设置优先探测的 I2C 地址（H30_Init 前调用，0 表示无）
+void H30_SetPreferredAddr(uint8_t addr_7bit);
+// 获取探测成功的 I2C 地址（未初始化返回 0）
+uint8_t H30_GetI2cAddr(void);
+
+// 缓存样本最大有效期（ms），超过后读接口返回失败
+#define H30_SAMPLE_MAX_AGE_MS  50U
+
+// 读取一次欧拉角与 Z 轴角速度写入缓存（由采集任务在数据就绪后调用），成功返回 true
+bool H30_Update(void);
+// 缓存模式：ReadEuler/ReadGzDps/ReadYawRateDps 返回 H30_Update 写入的最新样本，不再访问 I2C
+void H30_SetCachedMode(bool enable);
+// 使能 INT 引脚数据就绪中断，on_ready 在中断上下文中调用（用于通知采集任务）
+void H30_EnableDataReadyIrq(void (*on_ready)(void));
 
 #ifdef __cplusplus
 }
@@ -6,6 +6,33 @@
  */
 
 #include "hcsr04.h"
+#include "board_delay.h"
+#include "osal.h"
+
+static float s_obstacle_threshold_cm = OBSTACLE_THRESHOLD;
+
+// 中断测距状态：0=空闲，1=已触发，2=回波高电平，3=完成
+static volatile uint8_t s_echo_state = 0;
+static volatile uint64_t s_echo_rise_us = 0;
+static volatile uint64_t s_echo_fall_us = 0;
+static void (*s_echo_callback)(void) = NULL;
+
+// 缓存距离（测距任务写入）
+static float s_samples[HCSR04_AVG_SAMPLES];
+static uint8_t s_sample_pos = 0;
+static volatile float s_cached_cm = -1.0f;
+static volatile uint32_t s_cached_t_ms = 0;
+static bool s_cached_mode = false;
+
+static const param_desc_t s_params[] = {
+    { "obstacle_cm", &s_obstacle_threshold_cm, 1.0f, 100.0f },
+};
+
+const param_desc_t *HCSR04_GetParamTable(uint8_t *count)
+{
+    *count = (uint8_t)(sizeof(s_params) / sizeof(s_params[0]));
+    return s_params;
+}
 
 /**
  * @brief 初始化HC-SR04超声波传感器
@@ -33,43 +60,42 @@ float calculate_sound_speed(float temperature)
  */
 float single_measure_distance_cm(void)
 {
-    uint32_t timeout = 60000;
-    uint32_t start_time, end_time, duration;
+    const uint32_t timeout_us = 60000;
+    uint64_t t0, start_time;
+    uint32_t duration;
 
     // 确保ECHO为低电平
+    t0 = board_time_us();
     while (PINS_DRV_ReadPins(ECHO_PORT) & (1 << ECHO_PIN)) {
-        BASIC_DelayUs(1);
+        if (board_time_us() - t0 > timeout_us) {
+            return -1.0f;
+        }
     }
 
     // 发送触发脉冲
     PINS_DRV_WritePin(TRIG_PORT, TRIG_PIN, 0);
-    BASIC_DelayUs(2);
+    board_delay_us(2);
     PINS_DRV_WritePin(TRIG_PORT, TRIG_PIN, 1);
-    BASIC_DelayUs(20);
+    board_delay_us(20);
     PINS_DRV_WritePin(TRIG_PORT, TRIG_PIN, 0);
 
     // 等待ECHO上升沿
-    BASIC_DelayUs(100);
-    timeout = 60000;
+    t0 = board_time_us();
     while (!(PINS_DRV_ReadPins(ECHO_PORT) & (1 << ECHO_PIN))) {
-        if (--timeout == 0) {
+        if (board_time_us() - t0 > timeout_us) {
             return -1.0f;
         }
-        BASIC_DelayUs(1);
     }
 
-    // 记录开始时间并等待下降沿
-    start_time = 0;
-    timeout = 60000;
+    // 以机器定时器时间戳测量高电平宽度（不受轮询循环开销影响）
+    start_time = board_time_us();
     while (PINS_DRV_ReadPins(ECHO_PORT) & (1 << ECHO_PIN)) {
-        if (--timeout == 0) {
+        if (board_time_us() - start_time > timeout_us) {
             return -1.0f;
         }
-        BASIC_DelayUs(1);
-        start_time++;
     }
 
-    duration = start_time;
+    duration = (uint32_t)(board_time_us() - start_time);
     
     // 计算距离 (声速343m/s，往返除以2)
     float distance = (duration * 343.0f * 0.000001f * 100.0f) / 2.0f;
@@ -96,7 +122,7 @@ float HCSR04_MeasureDistance(void)
             valid_count++;
         }
         
-        BASIC_DelayUs(10000); // 10ms间隔
+        simple_delay_ms(10); // 10ms间隔
     }
 
     if (valid_count > 0) {
@@ -112,12 +138,125 @@ float HCSR04_MeasureDistance(void)
  */
 bool HCSR04_IsObstacleDetected(void)
 {
-    float distance = HCSR04_MeasureDistance();
+    float distance = s_cached_mode ? HCSR04_GetCachedDistance() : HCSR04_MeasureDistance();
     
-    if (distance > 0 && distance < OBSTACLE_THRESHOLD) {
+    if (distance > 0 && distance < s_obstacle_threshold_cm) {
         printf("checked，distence: %.1f cm\r\n", distance);
         return true;
     }
     
     return false;
 }
+
+static void hcsr04_echo_irq_handler(void *arg)
+{
+    (void)arg;
+    uint64_t now = board_time_us();
+    bool high = (PINS_DRV_ReadPins(ECHO_PORT) & (1 << ECHO_PIN)) != 0;
+    PINS_DRV_ClearPinIntFlagCmd(ECHO_PORT, ECHO_PIN);
+    if (high && s_echo_state == 1U) {
+        s_echo_rise_us = now;
+        s_echo_state = 2U;
+    } else if (!high && s_echo_state == 2U) {
+        s_echo_fall_us = now;
+        s_echo_state = 3U;
+        if (s_echo_callback != NULL) {
+            s_echo_callback();
+        }
+    }
+}
+
+/**
+ * @brief 使能 ECHO 双边沿中断（中断测距）
+ * @param on_echo 回波结束回调（中断上下文）
+ */
+void HCSR04_EnableEchoIrq(void (*on_echo)(void))
+{
+    OS_RegisterType_t type;
+    s_echo_callback = on_echo;
+    for (uint8_t i = 0; i < HCSR04_AVG_SAMPLES; i++) {
+        s_samples[i] = -1.0f;
+    }
+    PINS_DRV_SetPinIntSel(ECHO_PORT, ECHO_PIN, PORT_INT_EITHER_EDGE);
+    PINS_DRV_ClearPinIntFlagCmd(ECHO_PORT, ECHO_PIN);
+    type.trig_mode = CLIC_LEVEL_TRIGGER;
+    type.lvl       = 1;
+    type.priority  = 0;
+    type.data_ptr  = NULL;
+    OS_RequestIrq(ECHO_IRQN, hcsr04_echo_irq_handler, &type);
+    OS_EnableIrq(ECHO_IRQN);
+}
+
+/**
+ * @brief 发送触发脉冲，回波由中断计时
+ * @return false-上次回波尚未结束
+ */
+bool HCSR04_Trigger(void)
+{
+    if (PINS_DRV_ReadPins(ECHO_PORT) & (1 << ECHO_PIN)) {
+        s_echo_state = 0U;
+        return false;
+    }
+    s_echo_state = 1U;
+    PINS_DRV_WritePin(TRIG_PORT, TRIG_PIN, 0);
+    board_delay_us(2);
+    PINS_DRV_WritePin(TRIG_PORT, TRIG_PIN, 1);
+    board_delay_us(20);
+    PINS_DRV_WritePin(TRIG_PORT, TRIG_PIN, 0);
+    return true;
+}
+
+/**
+ * @brief 取中断测距结果
+ * @return 距离(cm)，-1表示未收到完整回波
+ */
+float HCSR04_TakeEchoCm(void)
+{
+    if (s_echo_state != 3U) {
+        s_echo_state = 0U;
+        return -1.0f;
+    }
+    s_echo_state = 0U;
+    uint32_t duration = (uint32_t)(s_echo_fall_us - s_echo_rise_us);
+    return (duration * 343.0f * 0.000001f * 100.0f) / 2.0f;
+}
+
+/**
+ * @brief 写入一次测距结果并更新缓存距离
+ * @param distance_cm 距离(cm)，-1表示测量失败
+ */
+void HCSR04_PushSample(float distance_cm)
+{
+    float sum = 0.0f;
+    int valid_count = 0;
+
+    s_samples[s_sample_pos] = distance_cm;
+    s_sample_pos = (uint8_t)((s_sample_pos + 1U) % HCSR04_AVG_SAMPLES);
+    for (uint8_t i = 0; i < HCSR04_AVG_SAMPLES; i++) {
+        if (s_samples[i] > 0 && s_samples[i] < 400.0f) {
+            sum += s_samples[i];
+            valid_count++;
+        }
+    }
+    s_cached_cm = (valid_count > 0) ? sum / valid_count : -1.0f;
+    s_cached_t_ms = board_time_ms();
+}
+
+/**
+ * @brief 缓存距离
+ * @return 距离(cm)，-1表示无有效数据或数据过期
+ */
+float HCSR04_GetCachedDistance(void)
+{
+    uint32_t t_ms = s_cached_t_ms;
+    float distance = s_cached_cm;
+    if (board_time_ms() - t_ms > HCSR04_SAMPLE_MAX_AGE_MS) {
+        return -1.0f;
+    }
+    return distance;
+}
+
+void HCSR04_SetCachedMode(bool enable)
+{
+    s_cached_mode = enable;
+}
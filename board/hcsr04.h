@@ -9,6 +9,7 @@
 #define HCSR04_H
 
 #include "pins_driver.h"
+#include "param.h"
 #include "../ESWIN_SDK/platform/basic/include/basic_api.h"
 #include <stdio.h>
 #include <math.h>
@@ -18,11 +19,15 @@
 #define TRIG_PIN     31U
 #define ECHO_PORT    PTA
 #define ECHO_PIN     30U
+#define ECHO_IRQN    GPIOA_30_IRQn
 
 // 测距参数
 #define SOUND_SPEED_20C     343.0f  // 20°C时的声速 (m/s)
 #define TEMP_COEFFICIENT    0.6f    // 温度系数 (m/s/°C)
 #define OBSTACLE_THRESHOLD  6.0f   // 障碍物检测阈值 (cm) - 修改为8cm
+#define HCSR04_AVG_SAMPLES        5U     // 平均窗口（与阻塞测距的 5 次测量一致）
+#define HCSR04_ECHO_TIMEOUT_MS    60U    // 单次测距最长回波时间
+#define HCSR04_SAMPLE_MAX_AGE_MS  300U   // 缓存距离有效期，超过视为无数据
 
 // 函数声明
 void HCSR04_Init(void);
@@ -30,5 +35,19 @@ float HCSR04_MeasureDistance(void);
 bool HCSR04_IsObstacleDetected(void);
 float single_measure_distance_cm(void);
 float calculate_sound_speed(float temperature);
+// 中断测距：ECHO 双边沿中断记录时间戳，on_echo 在下降沿（中断上下文）调用，用于通知测距任务
+void HCSR04_EnableEchoIrq(void (*on_echo)(void));
+// 发送触发脉冲（ECHO 仍为高电平时返回 false）
+bool HCSR04_Trigger(void);
+// 取本次触发的测距结果（cm），未收到完整回波返回 -1
+float HCSR04_TakeEchoCm(void);
+// 写入一次测距结果（-1 表示失败），缓存距离为最近 HCSR04_AVG_SAMPLES 次有效结果的平均
+void HCSR04_PushSample(float distance_cm);
+// 缓存距离（cm），无有效数据或超过 HCSR04_SAMPLE_MAX_AGE_MS 返回 -1
+float HCSR04_GetCachedDistance(void);
+// 缓存模式：HCSR04_IsObstacleDetected 使用缓存距离，不再阻塞测距
+void HCSR04_SetCachedMode(bool enable);
+// 运行时可调参数表（障碍物阈值，默认 OBSTACLE_THRESHOLD）
+const param_desc_t *HCSR04_GetParamTable(uint8_t *count);
 
 #endif // HCSR04_H
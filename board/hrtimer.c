@@ -0,0 +1,82 @@
+/**
+ * @file hrtimer.c
+ * @author 林木@江南大学
+ * @brief 高分辨率周期释放服务实现
+ * @details PITMR0 通道工作在 32 位周期计数模式，计数到零自动重装并产生中断，
+ *          周期精度由 PITMR 功能时钟决定，不受内核节拍、任务调度与无节拍空闲影响
+ */
+
+#include "hrtimer.h"
+#include "sdk_project_config.h"
+#include "pitmr_driver.h"
+#include <stdint.h>
+
+static bool s_pitmr_inited = false;
+static hrtimer_cb_t s_callbacks[HRTIMER_CHANNELS];
+static volatile uint32_t s_releases[HRTIMER_CHANNELS];
+
+static void hrtimer_isr(void *parameter)
+{
+	uint8_t ch = (uint8_t)(uintptr_t)parameter;
+	s_releases[ch]++;
+	if (s_callbacks[ch] != NULL) {
+		s_callbacks[ch]();
+	}
+}
+
+static bool hrtimer_init(void)
+{
+	if (s_pitmr_inited) {
+		return true;
+	}
+	pitmr_user_config_t cfg;
+	(void)PITMR_DRV_GetDefaultConfig(&cfg);
+	// 空闲时内核执行 WFI，定时器需继续计数以唤醒
+	cfg.enableRunInDoze = true;
+	s_pitmr_inited = (PITMR_DRV_Init(HRTIMER_INSTANCE, &cfg) == STATUS_SUCCESS);
+	return s_pitmr_inited;
+}
+
+bool HrTimer_Start(uint8_t channel, uint32_t period_us, hrtimer_cb_t cb)
+{
+	if (channel >= HRTIMER_CHANNELS || period_us < HRTIMER_MIN_PERIOD_US || cb == NULL) {
+		return false;
+	}
+	if (!hrtimer_init()) {
+		return false;
+	}
+	const uint32_t mask = 1UL << channel;
+	(void)PITMR_DRV_StopTimerChannels(HRTIMER_INSTANCE, mask);
+	s_callbacks[channel] = cb;
+	s_releases[channel] = 0;
+
+	pitmr_user_channel_config_t ch_cfg;
+	(void)PITMR_DRV_GetDefaultChanConfig(&ch_cfg);
+	ch_cfg.timerMode = PITMR_PERIODIC_COUNTER;
+	ch_cfg.periodUnits = PITMR_PERIOD_UNITS_MICROSECONDS;
+	ch_cfg.period = period_us;
+	ch_cfg.isInterruptEnabled = true;
+	ch_cfg.callBack = hrtimer_isr;
+	ch_cfg.parameter = (void *)(uintptr_t)channel;
+	if (PITMR_DRV_InitChannel(HRTIMER_INSTANCE, channel, &ch_cfg) != STATUS_SUCCESS) {
+		return false;
+	}
+	return PITMR_DRV_StartTimerChannels(HRTIMER_INSTANCE, mask) == STATUS_SUCCESS;
+}
+
+void HrTimer_Stop(uint8_t channel)
+{
+	if (channel >= HRTIMER_CHANNELS || !s_pitmr_inited) {
+		return;
+	}
+	const uint32_t mask = 1UL << channel;
+	(void)PITMR_DRV_StopTimerChannels(HRTIMER_INSTANCE, mask);
+	(void)PITMR_DRV_DisableTimerChannelInterrupt(HRTIMER_INSTANCE, mask);
+	(void)PITMR_DRV_ClearInterruptFlagTimerChannels(HRTIMER_INSTANCE, mask);
+	s_callbacks[channel] = NULL;
+}
+
+uint32_t HrTimer_GetReleases(uint8_t channel)
+{
+	return (channel < HRTIMER_CHANNELS) ? s_releases[channel] : 0U;
+}
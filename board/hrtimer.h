@@ -0,0 +1,44 @@
+/**
+ * @file hrtimer.h
+ * @author 林木@江南大学
+ * @brief 高分辨率周期释放服务（PITMR0）
+ * @details 每个 PITMR0 通道独立产生微秒级周期中断，在中断中调用释放回调（一般为通知某个任务），
+ *          周期与内核节拍无关，可驱动快于节拍或要求低抖动的内环；中断中只能调用 FromISR 接口
+ */
+
+#ifndef HRTIMER_H
+#define HRTIMER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define HRTIMER_INSTANCE      0U      // PITMR0
+#define HRTIMER_CHANNELS      4U      // PITMR0 通道数
+#define HRTIMER_MIN_PERIOD_US 100U    // 最小周期（中断开销限制）
+
+// 通道分配
+#define HRTIMER_CH_WHEEL      0U      // 车轮速度内环
+#define HRTIMER_CH_SLEEP      1U      // 亚节拍休眠单次释放（board_delay.c）
+
+typedef void (*hrtimer_cb_t)(void);
+
+/**
+ * @brief 启动通道周期释放（通道已启动时更新周期与回调）
+ * @param channel 通道号（< HRTIMER_CHANNELS）
+ * @param period_us 周期（微秒，>= HRTIMER_MIN_PERIOD_US）
+ * @param cb 释放回调（中断上下文）
+ * @return 参数有效且定时器配置成功返回 true
+ */
+bool HrTimer_Start(uint8_t channel, uint32_t period_us, hrtimer_cb_t cb);
+
+/**
+ * @brief 停止通道（不再产生中断）
+ */
+void HrTimer_Stop(uint8_t channel);
+
+/**
+ * @brief 通道启动以来的释放次数
+ */
+uint32_t HrTimer_GetReleases(uint8_t channel);
+
+#endif
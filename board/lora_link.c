@@ -0,0 +1,391 @@
+/**
+ * @file lora_link.c
+ * @author 林木@江南大学
+ * @brief SX1262 LoRa 状态下行实现
+ * @details 射频操作使用 SDK radio.c/sx126x.c（板级连线见 sx126xboard.c），不使用 lora_driver.c 的示例回调。
+ *          编码器保存上一帧的量化状态，差分帧按量化值作差，接收端累加不产生漂移；
+ *          帧发出后即更新参考状态，发送超时则下一帧改发关键帧。
+ */
+
+#include "lora_link.h"
+#include "sdk_project_config.h"
+#include "mission.h"
+#include "my_move.h"
+#include "pose_estimator.h"
+#include "calib_store.h"
+#include "sd_log.h"
+#include "flash_log.h"
+#include "net_telem.h"
+#include "board_delay.h"
+#include "radio.h"
+#include "sx126xboard.h"
+#include <stdio.h>
+#include <string.h>
+
+#define LORA_TEST_REG        0x06C0U   // 可读写寄存器：写入测试值读回判断器件是否存在
+#define LORA_TEST_VALUE      0x11U
+#define LORA_KEY_BITS        80U       // 关键帧：kind + seq + x + y + yaw + herr + step + status + flags + batt
+
+_Static_assert((LORA_KEY_BITS + 7U) / 8U <= LORA_LINK_FRAME_MAX, "key frame exceeds LORA_LINK_FRAME_MAX");
+
+// 控制周期写入的快照（未量化）
+typedef struct {
+	float32_t x_mm;
+	float32_t y_mm;
+	float32_t theta_deg;
+	float32_t herr_deg;
+	uint8_t step;
+	uint8_t status;
+	bool obstacle;
+} lora_snap_t;
+
+// 位流写入（高位在前）
+typedef struct {
+	uint8_t *buf;
+	uint16_t bits;
+} lora_bits_t;
+
+static bool s_ready = false;
+static RadioEvents_t s_events;
+static volatile bool s_tx_busy = false;     // 已调用 Radio.Send，尚未 TxDone
+static bool s_tx_timeout = false;           // 上一帧发送超时（下一帧为关键帧并置标志）
+static uint32_t s_tx_start_ms = 0;
+static uint32_t s_tx_limit_ms = 0;
+static uint32_t s_last_tx_ms = 0;
+static uint32_t s_gap_ms = LORA_LINK_PERIOD_MS;
+static bool s_sent_any = false;
+
+static volatile uint32_t s_snap_seq = 0;    // 奇数表示写入中
+static lora_snap_t s_snap;
+static bool s_snap_valid = false;
+
+static lora_link_state_t s_prev;            // 上一帧（接收端参考状态）
+static bool s_prev_valid = false;
+static uint8_t s_seq = 0;
+static uint8_t s_since_key = 0;
+static uint8_t s_frame[LORA_LINK_FRAME_MAX];
+static uint8_t s_frame_len = 0;
+static uint16_t (*s_batt_hook)(void) = NULL;
+
+static uint32_t s_key_frames = 0;
+static uint32_t s_delta_frames = 0;
+static uint32_t s_key_bytes = 0;
+static uint32_t s_delta_bytes = 0;
+static uint32_t s_timeouts = 0;
+static uint32_t s_air_ms = 0;               // 累计空中时间（发送完成的帧）
+static uint32_t s_first_tx_ms = 0;
+
+static void lora_on_tx_done(void)
+{
+	s_tx_busy = false;
+}
+
+static void lora_bits_put(lora_bits_t *w, uint32_t v, uint8_t n)
+{
+	while (n > 0U) {
+		n--;
+		uint16_t byte = w->bits >> 3;
+		uint8_t mask = (uint8_t)(0x80U >> (w->bits & 7U));
+		if ((v >> n) & 1U) {
+			w->buf[byte] |= mask;
+		}
+		w->bits++;
+	}
+}
+
+// 变长有符号字段：zigzag 后按值大小选 0/4/8/16 位（调用方保证 v 在 int16 范围内）
+static void lora_bits_put_var(lora_bits_t *w, int32_t v)
+{
+	uint32_t z = ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+	if (z == 0U) {
+		lora_bits_put(w, 0U, 2U);
+	} else if (z < 16U) {
+		lora_bits_put(w, 1U, 2U);
+		lora_bits_put(w, z, 4U);
+	} else if (z < 256U) {
+		lora_bits_put(w, 2U, 2U);
+		lora_bits_put(w, z, 8U);
+	} else {
+		lora_bits_put(w, 3U, 2U);
+		lora_bits_put(w, z, 16U);
+	}
+}
+
+static int32_t lora_round_sat(float32_t v, int32_t lo, int32_t hi)
+{
+	if (!(v == v)) {
+		return 0;   // NaN 与自身比较为假
+	}
+	if (v <= (float32_t)lo) {
+		return lo;
+	}
+	if (v >= (float32_t)hi) {
+		return hi;
+	}
+	return (int32_t)((v >= 0.0f) ? (v + 0.5f) : (v - 0.5f));
+}
+
+// 位置增量饱和到 int16（跨度超过 327 m 的跳变）
+static int32_t lora_delta_sat(int32_t d)
+{
+	return (d > 32767) ? 32767 : ((d < -32768) ? -32768 : d);
+}
+
+static void lora_bits_put_misc(lora_bits_t *w, const lora_link_state_t *st)
+{
+	lora_bits_put(w, st->step, 6U);
+	lora_bits_put(w, st->status, 3U);
+	lora_bits_put(w, st->flags, 8U);
+	lora_bits_put(w, st->batt_dv, 8U);
+}
+
+// 编码一帧到 s_frame，返回字节数；差分帧位置增量饱和时 st 改为接收端累加得到的位置
+static uint8_t lora_encode(lora_link_state_t *st, bool key)
+{
+	lora_bits_t w = { s_frame, 0U };
+	memset(s_frame, 0, sizeof(s_frame));
+	lora_bits_put(&w, key ? LORA_LINK_KIND_KEY : LORA_LINK_KIND_DELTA, 1U);
+	lora_bits_put(&w, s_seq & 0x0FU, 4U);
+	if (key) {
+		lora_bits_put(&w, (uint16_t)st->x_cm, 16U);
+		lora_bits_put(&w, (uint16_t)st->y_cm, 16U);
+		lora_bits_put(&w, st->yaw_hdeg, 10U);
+		lora_bits_put(&w, (uint8_t)st->herr_hdeg, 8U);
+		lora_bits_put_misc(&w, st);
+	} else {
+		// 航向增量取最短方向
+		int32_t dyaw = (int32_t)st->yaw_hdeg - (int32_t)s_prev.yaw_hdeg;
+		if (dyaw >= 360) {
+			dyaw -= 720;
+		} else if (dyaw < -360) {
+			dyaw += 720;
+		}
+		// 参考状态随之取饱和后的位置，接收端与编码器保持一致，后续差分帧补齐剩余部分
+		int32_t dx = lora_delta_sat((int32_t)st->x_cm - s_prev.x_cm);
+		int32_t dy = lora_delta_sat((int32_t)st->y_cm - s_prev.y_cm);
+		st->x_cm = (int16_t)(s_prev.x_cm + dx);
+		st->y_cm = (int16_t)(s_prev.y_cm + dy);
+		lora_bits_put_var(&w, dx);
+		lora_bits_put_var(&w, dy);
+		lora_bits_put_var(&w, dyaw);
+		lora_bits_put_var(&w, st->herr_hdeg);
+		bool misc = st->step != s_prev.step || st->status != s_prev.status || st->flags != s_prev.flags ||
+		            st->batt_dv != s_prev.batt_dv;
+		lora_bits_put(&w, misc ? 1U : 0U, 1U);
+		if (misc) {
+			lora_bits_put_misc(&w, st);
+		}
+	}
+	return (uint8_t)((w.bits + 7U) >> 3);
+}
+
+// 读取快照（写入被打断时重读）
+static bool lora_get_snap(lora_snap_t *out)
+{
+	uint32_t seq;
+	do {
+		seq = s_snap_seq;
+		__sync_synchronize();
+		*out = s_snap;
+		__sync_synchronize();
+	} while ((seq & 1U) != 0U || seq != s_snap_seq);
+	return s_snap_valid;
+}
+
+static void lora_build_state(lora_link_state_t *st)
+{
+	lora_snap_t snap;
+	// 任务未运行时控制侧不更新位姿，直接读取
+	if (Mission_GetStatus() != MISSION_RUNNING || !lora_get_snap(&snap)) {
+		pose2d_t pose;
+		Pose_Get(&pose);
+		snap.x_mm = pose.x_mm;
+		snap.y_mm = pose.y_mm;
+		snap.theta_deg = pose.theta_deg;
+		snap.herr_deg = 0.0f;
+		snap.step = Mission_GetStepIndex();
+		snap.status = (uint8_t)Mission_GetStatus();
+		snap.obstacle = false;
+	}
+	st->x_cm = (int16_t)lora_round_sat(snap.x_mm * 0.1f, -32768, 32767);
+	st->y_cm = (int16_t)lora_round_sat(snap.y_mm * 0.1f, -32768, 32767);
+	int32_t yaw = lora_round_sat(MyMove_NormalizeDeg(snap.theta_deg) * 2.0f, -360, 360);
+	st->yaw_hdeg = (uint16_t)((yaw + 720) % 720);
+	st->herr_hdeg = (int8_t)lora_round_sat(snap.herr_deg * 2.0f, -127, 127);
+	st->step = (snap.step > 63U) ? 63U : snap.step;
+	st->status = snap.status & 0x07U;
+	st->flags = 0U;
+	if (snap.obstacle) {
+		st->flags |= LORA_LINK_F_OBSTACLE;
+	}
+	if (!Calib_IsLoaded()) {
+		st->flags |= LORA_LINK_F_NO_CALIB;
+	}
+	if (!SdLog_IsReady()) {
+		st->flags |= LORA_LINK_F_NO_SDLOG;
+	}
+	if (!FlashLog_IsReady()) {
+		st->flags |= LORA_LINK_F_NO_FLOG;
+	}
+	if (!NetTelem_IsReady()) {
+		st->flags |= LORA_LINK_F_NO_NET;
+	}
+	if (s_tx_timeout) {
+		st->flags |= LORA_LINK_F_TX_TIMEOUT;
+	}
+	uint16_t mv = (s_batt_hook != NULL) ? s_batt_hook() : 0U;
+	st->batt_dv = (uint8_t)((mv >= 25500U) ? 255U : (mv + 50U) / 100U);
+}
+
+static uint32_t lora_air_ms(uint8_t len)
+{
+	return Radio.TimeOnAir(MODEM_LORA, LORA_LINK_BANDWIDTH, LORA_LINK_SF, LORA_LINK_CODERATE, LORA_LINK_PREAMBLE,
+	                       false, len, true);
+}
+
+bool LoraLink_Init(void)
+{
+	s_ready = false;
+	if (SPI_DRV_MasterInit(INST_SPI_0, &g_stSpiState_0, &g_stSpi0MasterConfig0) != STATUS_SUCCESS) {
+		printf("[lora] SPI0 初始化失败\r\n");
+		return false;
+	}
+	s_events.TxDone = lora_on_tx_done;
+	Radio.Init(&s_events);
+	// 未接模块时 MISO 上拉读回 0xFF
+	uint8_t orig = Radio.Read(LORA_TEST_REG);
+	Radio.Write(LORA_TEST_REG, LORA_TEST_VALUE);
+	uint8_t test = Radio.Read(LORA_TEST_REG);
+	Radio.Write(LORA_TEST_REG, orig);
+	if (test != LORA_TEST_VALUE) {
+		printf("[lora] 未检测到 SX1262，状态下行停用\r\n");
+		return false;
+	}
+	Radio.SetChannel(LORA_LINK_FREQ_HZ);
+	Radio.SetTxConfig(MODEM_LORA, LORA_LINK_POWER_DBM, 0U, LORA_LINK_BANDWIDTH, LORA_LINK_SF, LORA_LINK_CODERATE,
+	                  LORA_LINK_PREAMBLE, false, true, false, 0U, false, 0U);
+	Radio.Sleep();
+	// 两帧最小间隔按最长帧的空中时间计算，周期更长时取周期
+	uint32_t gap = lora_air_ms(LORA_LINK_FRAME_MAX) * 100U / LORA_LINK_DUTY_PCT;
+	s_gap_ms = (gap > LORA_LINK_PERIOD_MS) ? gap : LORA_LINK_PERIOD_MS;
+	s_prev_valid = false;
+	s_sent_any = false;
+	s_tx_busy = false;
+	s_ready = true;
+	printf("[lora] SX1262 就绪 %lu.%03luMHz SF%u，每 %lums 一帧\r\n", (unsigned long)(LORA_LINK_FREQ_HZ / 1000000UL),
+	       (unsigned long)(LORA_LINK_FREQ_HZ / 1000UL % 1000UL), LORA_LINK_SF, (unsigned long)s_gap_ms);
+	return true;
+}
+
+bool LoraLink_IsReady(void)
+{
+	return s_ready;
+}
+
+void LoraLink_Capture(const flight_rec_t *rec)
+{
+	if (!s_ready) {
+		return;
+	}
+	lora_snap_t snap;
+	pose2d_t pose;
+	Pose_Get(&pose);
+	snap.x_mm = pose.x_mm;
+	snap.y_mm = pose.y_mm;
+	snap.theta_deg = pose.theta_deg;
+	snap.herr_deg = MyMove_NormalizeDeg(MyMove_GetStraightTarget() - (float32_t)rec->yaw_cdeg * 0.01f);
+	snap.step = rec->step;
+	snap.status = (uint8_t)Mission_GetStatus();
+	snap.obstacle = (rec->flags & FLIGHT_REC_FLAG_OBSTACLE) != 0U;
+	s_snap_seq++;
+	__sync_synchronize();
+	s_snap = snap;
+	s_snap_valid = true;
+	__sync_synchronize();
+	s_snap_seq++;
+}
+
+void LoraLink_Service(void)
+{
+	if (!s_ready) {
+		return;
+	}
+	uint32_t now = board_time_ms();
+	if (s_tx_busy) {
+		SX126xIoIrqPoll();
+		Radio.IrqProcess();
+		if (s_tx_busy) {
+			if (now - s_tx_start_ms <= s_tx_limit_ms) {
+				return;
+			}
+			// 未收到 TxDone：接收端可能没收到本帧，下一帧改发关键帧
+			s_tx_busy = false;
+			s_tx_timeout = true;
+			s_timeouts++;
+		} else {
+			s_tx_timeout = false;
+			s_air_ms += lora_air_ms(s_frame_len);
+		}
+		Radio.Sleep();
+	}
+	if (s_sent_any && now - s_last_tx_ms < s_gap_ms) {
+		return;
+	}
+
+	lora_link_state_t st;
+	lora_build_state(&st);
+	bool key = !s_prev_valid || s_tx_timeout || s_since_key + 1U >= LORA_LINK_KEY_EVERY;
+	s_frame_len = lora_encode(&st, key);
+	s_prev = st;
+	s_prev_valid = true;
+	s_seq = (uint8_t)((s_seq + 1U) & 0x0FU);
+	if (key) {
+		s_since_key = 0;
+		s_key_frames++;
+		s_key_bytes += s_frame_len;
+	} else {
+		s_since_key++;
+		s_delta_frames++;
+		s_delta_bytes += s_frame_len;
+	}
+	if (!s_sent_any) {
+		s_first_tx_ms = now;
+	}
+	s_sent_any = true;
+	s_last_tx_ms = now;
+	s_tx_start_ms = now;
+	s_tx_limit_ms = lora_air_ms(s_frame_len) + LORA_LINK_TX_MARGIN_MS;
+	s_tx_busy = true;
+	Radio.Send(s_frame, s_frame_len);
+}
+
+void LoraLink_SetBatteryHook(uint16_t (*read_mv)(void))
+{
+	s_batt_hook = read_mv;
+}
+
+void LoraLink_Print(void)
+{
+	if (!s_ready) {
+		printf("[lora] 未就绪\r\n");
+		return;
+	}
+	uint32_t frames = s_key_frames + s_delta_frames;
+	uint32_t span = board_time_ms() - s_first_tx_ms;
+	// 平均帧长与占空比保留一位小数（整数运算）
+	printf("[lora] frames=%lu key=%lu(%lu.%luB) delta=%lu(%lu.%luB) timeout=%lu duty=%lu.%lu%%\r\n",
+	       (unsigned long)frames, (unsigned long)s_key_frames,
+	       (unsigned long)(s_key_frames ? s_key_bytes / s_key_frames : 0U),
+	       (unsigned long)(s_key_frames ? s_key_bytes * 10U / s_key_frames % 10U : 0U),
+	       (unsigned long)s_delta_frames, (unsigned long)(s_delta_frames ? s_delta_bytes / s_delta_frames : 0U),
+	       (unsigned long)(s_delta_frames ? s_delta_bytes * 10U / s_delta_frames % 10U : 0U),
+	       (unsigned long)s_timeouts, (unsigned long)(span ? s_air_ms * 100U / span : 0U),
+	       (unsigned long)(span ? s_air_ms * 1000U / span % 10U : 0U));
+	if (frames > 0U) {
+		printf("[lora] last=");
+		for (uint8_t i = 0; i < s_frame_len; i++) {
+			printf("%02X", s_frame[i]);
+		}
+		printf("\r\n");
+	}
+}
@@ -0,0 +1,105 @@
+/**
+ * @file lora_link.h
+ * @author 林木@江南大学
+ * @brief SX1262 LoRa 状态下行（SPI0）：差分编码 + 位打包的小帧
+ * @details 上了赛道后拖串口线不现实，以太网也要接网线；LoRa 低占空比地周期发送一帧几字节的状态：
+ *          位姿、航向误差、任务步骤/状态、电池电压与故障标志。
+ *          - 关键帧 10 字节（完整状态），其间为差分帧（位姿相对上一帧的增量 + 变长字段，直行时约 4 字节）；
+ *            每 LORA_LINK_KEY_EVERY 帧或上一帧发送失败后发关键帧，接收端序号不连续时等下一关键帧
+ *          - 控制周期只调用 LoraLink_Capture 写入一份快照（序号保护，与 H30 缓存相同），
+ *            编码与射频操作在后台执行：FreeRTOS 构建为遥测任务，裸机构建为调度空闲时间片与主循环
+ *          - 发送完成（DIO1）轮询读取，不占用中断；发完射频进入睡眠，两帧间隔同时受占空比上限约束
+ *          未检测到 SX1262 时通道停用，其余接口为空操作。主机端解码工具 tools/lora_decode.py
+ */
+
+#ifndef __LORA_LINK_H__
+#define __LORA_LINK_H__
+
+#include "flight_rec.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 射频参数（接收端须一致）
+#define LORA_LINK_FREQ_HZ          470000000UL  // CN470 频段
+#define LORA_LINK_POWER_DBM        17           // 发射功率（CN470 限 50 mW EIRP）
+#define LORA_LINK_BANDWIDTH        0U           // 0: 125 kHz
+#define LORA_LINK_SF               7U           // 扩频因子：10 字节约 41 ms 空中时间
+#define LORA_LINK_CODERATE         1U           // 1: 4/5
+#define LORA_LINK_PREAMBLE         8U
+
+#define LORA_LINK_PERIOD_MS        1000U        // 发送周期
+#define LORA_LINK_DUTY_PCT         10U          // 占空比上限（两帧间隔不小于空中时间 ×100/该值）
+#define LORA_LINK_KEY_EVERY        8U           // 每 N 帧一个关键帧
+#define LORA_LINK_TX_MARGIN_MS     100U         // 超过空中时间该值仍未发完视为发送超时
+#define LORA_LINK_FRAME_MAX        16U          // 帧最大字节数（差分帧最坏 13 字节）
+
+/*
+ * 帧格式（位流，高位在前，末字节低位补 0）：
+ *   kind:1（0 关键帧 / 1 差分帧）seq:4（帧序号，模 16）
+ *   关键帧：x:16 y:16（cm，有符号）yaw:10（0.5°，0~719）herr:8（0.5°，有符号）
+ *           step:6 status:3 flags:8 batt:8                                        共 80 位
+ *   差分帧：dx dy dyaw（相对上一帧，dyaw 取 [-360, 359]）herr（当前值），
+ *           各为 2 位长度码（0/4/8/16 位）+ zigzag 值；dx/dy 超出 int16 时饱和，
+ *           编码器参考状态取饱和后的位置，下一帧继续补齐；
+ *           misc:1，置位时后跟 step/status/flags/batt（宽度同关键帧）
+ */
+#define LORA_LINK_KIND_KEY         0U
+#define LORA_LINK_KIND_DELTA       1U
+
+// 状态标志（flags）
+#define LORA_LINK_F_OBSTACLE       0x01U  // 避障等待中
+#define LORA_LINK_F_NO_CALIB       0x02U  // 未加载标定记录
+#define LORA_LINK_F_NO_SDLOG       0x04U  // SD 卡记录不可用
+#define LORA_LINK_F_NO_FLOG        0x08U  // 外部 Flash 记录不可用
+#define LORA_LINK_F_NO_NET         0x10U  // 以太网遥测不可用
+#define LORA_LINK_F_TX_TIMEOUT     0x20U  // 上一帧发送超时
+
+// 量化后的状态（编码器与接收端各保存一份上一帧的值）
+typedef struct {
+    int16_t x_cm;
+    int16_t y_cm;
+    uint16_t yaw_hdeg;      // 位姿航向（0.5°，0~719）
+    int8_t herr_hdeg;       // 航向误差 = 目标航向 - 航向（0.5°，饱和到 ±63.5°）
+    uint8_t step;           // 任务步骤（饱和到 63）
+    uint8_t status;         // mission_status_t
+    uint8_t flags;          // LORA_LINK_F_*
+    uint8_t batt_dv;        // 电池电压（0.1 V；0 表示未测量）
+} lora_link_state_t;
+
+/**
+ * @brief 初始化 SPI0 并复位 SX1262，配置 LoRa 发送参数后进入睡眠
+ * @return 检测到 SX1262 返回 true；否则通道停用，其余接口为空操作
+ */
+bool LoraLink_Init(void);
+bool LoraLink_IsReady(void);
+
+/**
+ * @brief 控制周期调用（Mission_Step 写入飞行记录之后）：只写入状态快照，不访问射频
+ * @param rec 本周期飞行记录
+ */
+void LoraLink_Capture(const flight_rec_t *rec);
+
+/**
+ * @brief 后台调用（间隔不大于一个控制周期）：检查发送完成/超时，到期时编码并发送一帧
+ */
+void LoraLink_Service(void);
+
+/**
+ * @brief 设置电池电压读取函数（返回 mV；未设置时帧中电压为 0）
+ */
+void LoraLink_SetBatteryHook(uint16_t (*read_mv)(void));
+
+/**
+ * @brief 打印发送计数、关键帧/差分帧平均长度、占空比与最近一帧
+ */
+void LoraLink_Print(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __LORA_LINK_H__
@@ -0,0 +1,324 @@
+/**
+ * @file mission.c
+ * @author 林木@江南大学
+ * @brief 非阻塞任务调度器实现 - 协作式状态机
+ * @details 每个调度周期：先推进当前步骤（瞬时步骤在同一周期内连续推进），再以一个舵机 PWM
+ *          周期占用时间片；两个舵机同时动作时轮流发送脉冲，无脉冲时空等一个周期。
+ *          任务运行期间每个周期向飞行记录器写入一条控制状态，同时追加到外部 Flash 运行记录
+ */
+
+#include "mission.h"
+#include "my_move.h"
+#include "h30.h"
+#include "odometry.h"
+#include "pose_estimator.h"
+#include "servo_control.h"
+#include "servo2_control.h"
+#include "board_delay.h"
+#include "flight_rec.h"
+#include "flash_log.h"
+#include "sd_log.h"
+#include "net_telem.h"
+#include "lora_link.h"
+#include "can_bus.h"
+#include "app_config.h"
+#include "tlog.h"
+#include <stdio.h>
+#include <math.h>
+
+static const mission_step_t *s_steps = NULL;
+static uint8_t s_count = 0;
+static uint8_t s_index = 0;
+static bool s_step_started = false;
+static uint32_t s_step_elapsed = 0;
+static uint32_t s_step_start_ms = 0;
+static uint32_t s_elapsed = 0;
+static mission_status_t s_status = MISSION_IDLE;
+static bool s_servo_turn = false;             // 舵机脉冲轮转：false=servo，true=servo2
+static path_waypoint_t s_straight_wps[2];     // 直行步骤的两点路径
+static uint32_t s_remote_count = 0;           // remote 步骤开始时已收到的驱动指令数
+static void (*s_idle_hook)(void) = NULL;
+
+void Mission_Start(const mission_step_t *steps, uint8_t count)
+{
+	s_steps = steps;
+	s_count = (steps != NULL) ? count : 0U;
+	s_index = 0;
+	s_step_started = false;
+	s_step_elapsed = 0;
+	s_step_start_ms = 0;
+	s_elapsed = 0;
+	s_status = (s_count > 0U) ? MISSION_RUNNING : MISSION_DONE;
+	if (s_status == MISSION_RUNNING) {
+		FlightRec_Start();
+		FlashLog_StartRun();
+		SdLog_StartRun();
+	}
+	TLOG("MissionStart: 步骤数=%d\r\n", s_count);
+}
+
+void Mission_Abort(void)
+{
+	if (s_status == MISSION_RUNNING) {
+		MyMove_Stop();
+		CanBus_SetRemoteActive(false);
+		s_status = MISSION_ABORTED;
+		FlightRec_Stop();
+		FlashLog_StopRun();
+		SdLog_StopRun();
+		TLOG("MissionAbort: step=%d, t=%dms\r\n", s_index, s_elapsed);
+	}
+}
+
+mission_status_t Mission_GetStatus(void)
+{
+	return s_status;
+}
+
+uint8_t Mission_GetStepIndex(void)
+{
+	return s_index;
+}
+
+uint32_t Mission_GetElapsedMs(void)
+{
+	return s_elapsed;
+}
+
+void Mission_SetIdleHook(void (*hook)(void))
+{
+	s_idle_hook = hook;
+}
+
+static bool mission_is_still(void)
+{
+	float p, r, y, rate;
+	if (!H30_ReadYawRateDps(&rate) || !H30_ReadEuler(&p, &r, &y)) {
+		return false;
+	}
+	// 等待期间继续推进位姿估计，避免停车滑行的位移丢失
+	Odom_Update(MISSION_TICK_MS);
+	Pose_StepFromOdom(y, true);
+	return fabsf(rate) < MISSION_STILL_RATE_DPS && fabsf(Odom_GetSpeedMmS()) < MISSION_STILL_SPEED_MM_S;
+}
+
+// 启动当前步骤；返回 false 表示步骤无效
+static bool mission_step_begin(const mission_step_t *st)
+{
+	switch (st->type) {
+	case MISSION_STEP_PATH:
+		return MyMove_PathBegin(st->u.path.wps, st->u.path.count, st->u.path.lookahead_mm, st->u.path.timeout_ms);
+	case MISSION_STEP_STRAIGHT:
+		s_straight_wps[0] = (path_waypoint_t){ 0.0f, 0.0f, st->u.straight.speed, 0U };
+		s_straight_wps[1] = (path_waypoint_t){ st->u.straight.distance_mm, 0.0f, st->u.straight.speed, 0U };
+		return MyMove_PathBegin(s_straight_wps, 2U, fmaxf(st->u.straight.distance_mm, 30.0f), st->u.straight.timeout_ms);
+	case MISSION_STEP_TURN: {
+		float32_t target = MyMove_NormalizeDeg(MyMove_GetStraightTarget() + st->u.turn.delta_deg);
+		MyMove_SetStraightTarget(target);
+		MyMove_TurnBegin(target, st->u.turn.speed, st->u.turn.stop_deg, st->u.turn.timeout_ms);
+		return true;
+	}
+	case MISSION_STEP_SERVO:
+		if (st->u.servo.channel == 2U) {
+			servo2_set_angle_async(st->u.servo.angle);
+		} else {
+			servo_set_angle_async(st->u.servo.angle);
+		}
+		return true;
+	case MISSION_STEP_WAIT:
+		return true;
+	case MISSION_STEP_REMOTE: {
+		// 步骤开始前收到的指令（包括上一个 remote 步骤的 RELEASE）不算数
+		can_bus_drive_t cmd;
+		(void)CanBus_GetDrive(&cmd);
+		s_remote_count = cmd.count;
+		CanBus_SetRemoteActive(true);
+		MyMove_RemoteBegin(st->u.remote.timeout_ms);
+		return true;
+	}
+	default:
+		return false;
+	}
+}
+
+static my_move_status_t mission_remote_tick(uint32_t dt_ms)
+{
+	can_bus_drive_t cmd;
+	bool valid = CanBus_GetDrive(&cmd) && cmd.count != s_remote_count;
+	my_move_status_t res;
+	if (valid && cmd.mode == CAN_BUS_DRIVE_RELEASE) {
+		MyMove_Stop();
+		res = MY_MOVE_DONE;
+	} else {
+		res = MyMove_RemoteTick(dt_ms, valid && cmd.mode == CAN_BUS_DRIVE_GO, cmd.heading_deg, cmd.speed_mm_s);
+	}
+	if (res != MY_MOVE_RUNNING) {
+		CanBus_SetRemoteActive(false);
+	}
+	return res;
+}
+
+// 推进当前步骤一个周期，返回 MY_MOVE_RUNNING 表示尚未结束
+static my_move_status_t mission_step_tick(const mission_step_t *st, uint32_t dt_ms)
+{
+	switch (st->type) {
+	case MISSION_STEP_PATH:
+	case MISSION_STEP_STRAIGHT: {
+		my_move_status_t res = MyMove_PathTick(dt_ms);
+		// 路径要求的舵机2角度交给并行舵机通道
+		uint16_t a2 = MyMove_PathGetServo2Angle();
+		if (res == MY_MOVE_RUNNING && a2 != 0U && a2 != servo2_get_current_angle()) {
+			servo2_set_angle_async(a2);
+		}
+		return res;
+	}
+	case MISSION_STEP_TURN:
+		return MyMove_TurnTick(dt_ms);
+	case MISSION_STEP_SERVO:
+		return MY_MOVE_DONE;
+	case MISSION_STEP_REMOTE:
+		return mission_remote_tick(dt_ms);
+	case MISSION_STEP_WAIT:
+		switch (st->u.wait.cond) {
+		case MISSION_WAIT_MS:
+			return (s_step_elapsed >= st->u.wait.ms) ? MY_MOVE_DONE : MY_MOVE_RUNNING;
+		case MISSION_WAIT_SERVOS_IDLE:
+			return (!servo_is_busy() && servo2_get_state() == SERVO2_STATE_IDLE) ? MY_MOVE_DONE : MY_MOVE_RUNNING;
+		case MISSION_WAIT_STILL:
+			if (st->u.wait.ms != 0U && s_step_elapsed >= st->u.wait.ms) {
+				return MY_MOVE_TIMEOUT;
+			}
+			return mission_is_still() ? MY_MOVE_DONE : MY_MOVE_RUNNING;
+		default:
+			return MY_MOVE_ERROR;
+		}
+	default:
+		return MY_MOVE_ERROR;
+	}
+}
+
+void Mission_WaitTick(void)
+{
+	s_servo_turn = !s_servo_turn;
+	if (s_servo_turn) {
+		if (servo2_service() || servo_service()) return;
+	} else {
+		if (servo_service() || servo2_service()) return;
+	}
+#if !APP_USE_FREERTOS
+	// 空闲时间片写出一个 SD 扇区、推进 LoRa 状态下行（RTOS 构建分别由写入任务、遥测任务负责），
+	// 不足一个周期的部分继续等待
+	uint32_t t0 = board_time_ms();
+	(void)SdLog_Service(1U);
+	LoraLink_Service();
+	uint32_t dt = board_time_ms() - t0;
+	if (dt < MISSION_TICK_MS) {
+		simple_delay_ms(MISSION_TICK_MS - dt);
+	}
+#else
+	simple_delay_ms(MISSION_TICK_MS);
+#endif
+}
+
+// 推进步骤（Mission_Step 的主体），返回任务状态
+static mission_status_t mission_advance(void)
+{
+	// 瞬时完成的步骤（舵机、已满足的等待）在同一周期内连续推进，最多遍历一次步骤表
+	for (uint8_t guard = 0; guard <= s_count && s_index < s_count; ++guard) {
+		const mission_step_t *st = &s_steps[s_index];
+		uint32_t dt = MISSION_TICK_MS;
+		if (!s_step_started) {
+			if (!mission_step_begin(st)) {
+				MyMove_Stop();
+				s_status = MISSION_FAILED;
+				TLOG("MissionFail: step=%d 无效\r\n", s_index);
+				return s_status;
+			}
+			s_step_started = true;
+			s_step_elapsed = 0;
+			s_step_start_ms = s_elapsed;
+			dt = 0U;
+			TLOG("MissionStep: idx=%d, type=%d, t=%dms\r\n", s_index, st->type, s_elapsed);
+		}
+		my_move_status_t res = mission_step_tick(st, dt);
+		if (res == MY_MOVE_RUNNING) {
+			break;
+		}
+		if (res == MY_MOVE_ERROR) {
+			MyMove_Stop();
+			s_status = MISSION_FAILED;
+			TLOG("MissionFail: step=%d, t=%dms\r\n", s_index, s_elapsed);
+			return s_status;
+		}
+		// 超时视为该步结束，继续后续步骤（与原阻塞流程一致）
+		TLOG("MissionStepDone: idx=%d, %s, 用时=%dms\r\n", s_index,
+		       (res == MY_MOVE_TIMEOUT) ? "超时" : "完成", s_elapsed - s_step_start_ms);
+		s_index++;
+		s_step_started = false;
+	}
+
+	if (s_index >= s_count) {
+		s_status = MISSION_DONE;
+		TLOG("MissionDone: 总用时=%dms\r\n", s_elapsed);
+		return s_status;
+	}
+
+	if (s_idle_hook != NULL) {
+		s_idle_hook();
+	}
+	s_elapsed += MISSION_TICK_MS;
+	s_step_elapsed += MISSION_TICK_MS;
+	return s_status;
+}
+
+mission_status_t Mission_Step(void)
+{
+	if (s_status != MISSION_RUNNING) {
+		return s_status;
+	}
+	mission_status_t st = mission_advance();
+
+	// 飞行记录：每周期一条（含结束周期），任务结束后清除记录中标志并收尾外部 Flash 运行
+	const my_move_trace_t *tr = MyMove_GetTrace();
+	uint8_t idx = (s_index < s_count) ? s_index : (uint8_t)(s_count - 1U);
+	uint8_t flags = (uint8_t)s_steps[idx].type & FLIGHT_REC_FLAG_TYPE_MASK;
+	if (tr->obstacle_wait) {
+		flags |= FLIGHT_REC_FLAG_OBSTACLE;
+	}
+	const flight_rec_t *rec = FlightRec_Record(s_index, flags, tr, Odom_GetDistanceMm());
+	FlashLog_Append(rec);
+	SdLog_Append(rec);
+	// 以太网遥测：已订阅时发出本周期帧，并处理收到的命令
+	NetTelem_Publish(rec);
+	// LoRa 状态下行：只写入快照，编码与发送在后台
+	LoraLink_Capture(rec);
+	// CAN：处理参数请求，按分频发送位姿/运动/状态帧
+	CanBus_Publish(rec);
+	if (st != MISSION_RUNNING) {
+		FlightRec_Stop();
+		FlashLog_StopRun();
+		SdLog_StopRun();
+	}
+	// 外部 Flash 擦除/编程只发起或检查一次 DMA 传输
+	FlashLog_Service();
+	return st;
+}
+
+mission_status_t Mission_Tick(void)
+{
+	if (Mission_Step() == MISSION_RUNNING) {
+		Mission_WaitTick();
+	}
+	return s_status;
+}
+
+mission_status_t Mission_Run(const mission_step_t *steps, uint8_t count)
+{
+	Mission_Start(steps, count);
+	while (Mission_Tick() == MISSION_RUNNING) {
+	}
+	// 任务结束后补发剩余舵机脉冲，保证最后的舵机动作到位
+	while (servo_service() || servo2_service()) {
+	}
+	return s_status;
+}
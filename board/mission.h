@@ -0,0 +1,83 @@
+/**
+ * @file mission.h
+ * @author 林木@江南大学
+ * @brief 非阻塞任务调度器接口 - 协作式状态机
+ * @details 任务由步骤表描述；运动类步骤（路径/直行/转向）独占底盘、逐周期推进，
+ *          舵机步骤只设定目标后立即进入下一步，其 PWM 脉冲在后续周期与运动并行发送；
+ *          等待步骤用于在需要时同步（定时、舵机到位、车体静止）
+ */
+
+#ifndef __MISSION_H__
+#define __MISSION_H__
+
+#include "RISCV_Typedefs.h"
+#include "path_follower.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MISSION_TICK_MS           20U     // 调度周期（一个舵机 PWM 周期）
+#define MISSION_STILL_RATE_DPS    3.0f    // 静止判定：角速度阈值
+#define MISSION_STILL_SPEED_MM_S  10.0f   // 静止判定：里程计速度阈值
+
+typedef enum {
+    MISSION_STEP_PATH = 0,    // 航点路径跟踪
+    MISSION_STEP_STRAIGHT,    // 沿当前直行目标行驶指定距离（两点路径）
+    MISSION_STEP_TURN,        // 原地转向：相对当前直行目标转过 delta_deg（正=左转）
+    MISSION_STEP_SERVO,       // 舵机目标角度（并行执行，不等待到位）
+    MISSION_STEP_WAIT,        // 等待条件成立
+    MISSION_STEP_REMOTE       // 按上位机 CAN 指令行驶，收到 RELEASE 或超时结束（timeout_ms 为 0 不限）
+} mission_step_type_t;
+
+typedef enum {
+    MISSION_WAIT_MS = 0,      // 等待固定时间
+    MISSION_WAIT_SERVOS_IDLE, // 等待所有舵机动作完成
+    MISSION_WAIT_STILL        // 等待车体静止（超时 ms 后放行，0 表示不限）
+} mission_wait_t;
+
+typedef struct {
+    mission_step_type_t type;
+    union {
+        struct { const path_waypoint_t *wps; uint8_t count; float32_t lookahead_mm; uint32_t timeout_ms; } path;
+        struct { float32_t distance_mm; float32_t speed; uint32_t timeout_ms; } straight;
+        struct { float32_t delta_deg; float32_t speed; float32_t stop_deg; uint32_t timeout_ms; } turn;
+        struct { uint8_t channel; uint16_t angle; } servo;   // channel: 1=servo, 2=servo2
+        struct { mission_wait_t cond; uint32_t ms; } wait;
+        struct { uint32_t timeout_ms; } remote;
+    } u;
+} mission_step_t;
+
+typedef enum {
+    MISSION_IDLE = 0,
+    MISSION_RUNNING,
+    MISSION_DONE,
+    MISSION_ABORTED,
+    MISSION_FAILED
+} mission_status_t;
+
+// 载入并开始任务（步骤表需在任务期间保持有效）
+void Mission_Start(const mission_step_t *steps, uint8_t count);
+// 推进一个调度周期（约 MISSION_TICK_MS，含舵机脉冲或等待），返回任务状态
+mission_status_t Mission_Tick(void);
+// 只推进步骤、不占用时间片（由调用者按 MISSION_TICK_MS 周期调用，如 RTOS 控制任务）
+mission_status_t Mission_Step(void);
+// 中止任务并停车
+void Mission_Abort(void);
+mission_status_t Mission_GetStatus(void);
+uint8_t Mission_GetStepIndex(void);
+uint32_t Mission_GetElapsedMs(void);
+// 空闲钩子：每个调度周期在步骤推进后、舵机脉冲/等待前调用一次（如命令行轮询），应保持短小
+void Mission_SetIdleHook(void (*hook)(void));
+// 占用一个调度周期：发送一个舵机脉冲（两舵机轮流），无待发脉冲时空等 MISSION_TICK_MS（启动流程等协作循环复用）
+void Mission_WaitTick(void);
+// 阻塞运行整个任务直到结束
+mission_status_t Mission_Run(const mission_step_t *steps, uint8_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __MISSION_H__
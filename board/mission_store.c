@@ -0,0 +1,140 @@
+/**
+ * @file mission_store.c
+ * @author 林木@江南大学
+ * @brief 任务二进制格式解码与 EEPROM 任务槽读写
+ * @details 加载为两次 EEPROM 读（头部 + 负载）与一次硬件 CRC，解码结果放在静态表中供调度器直接使用
+ */
+
+#include "mission_store.h"
+#include "nvm_store.h"
+#include <stdio.h>
+
+static mission_step_t s_steps[MISSION_STORE_MAX_STEPS];
+static path_waypoint_t s_wps[MISSION_STORE_MAX_WPS];
+static uint8_t s_image[NVM_MISSION_SLOT_SIZE];
+
+static uint16_t rd_u16(const uint8_t *p) { return (uint16_t)(p[0] | ((uint16_t)p[1] << 8)); }
+static int16_t rd_i16(const uint8_t *p) { return (int16_t)rd_u16(p); }
+static uint32_t rd_u32(const uint8_t *p)
+{
+	return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// 校验头部与 CRC，返回负载长度（0 表示无效）
+static uint32_t mission_image_check(const uint8_t *image, uint32_t size)
+{
+	if (size < MISSION_IMAGE_HDR_SIZE || rd_u32(&image[0]) != MISSION_IMAGE_MAGIC) {
+		return 0U;
+	}
+	if (image[8] != MISSION_IMAGE_VERSION) {
+		printf("MissionStore: 版本不支持 (%d)\r\n", image[8]);
+		return 0U;
+	}
+	uint8_t nsteps = image[9];
+	uint8_t nwps = image[10];
+	uint32_t payload = rd_u16(&image[12]);
+	if (nsteps == 0U || nsteps > MISSION_STORE_MAX_STEPS || nwps > MISSION_STORE_MAX_WPS ||
+	    payload != (uint32_t)nsteps * MISSION_IMAGE_STEP_SIZE + (uint32_t)nwps * MISSION_IMAGE_WP_SIZE ||
+	    MISSION_IMAGE_HDR_SIZE + payload > size) {
+		printf("MissionStore: 头部无效\r\n");
+		return 0U;
+	}
+	uint32_t crc = NVM_Crc32(&image[8], (MISSION_IMAGE_HDR_SIZE - 8U) + payload);
+	if (crc != rd_u32(&image[4])) {
+		printf("MissionStore: CRC 错误 (0x%08lx != 0x%08lx)\r\n", (unsigned long)crc, (unsigned long)rd_u32(&image[4]));
+		return 0U;
+	}
+	return payload;
+}
+
+bool MissionStore_Decode(const uint8_t *image, uint32_t size, const mission_step_t **steps, uint8_t *count)
+{
+	if (image == NULL || mission_image_check(image, size) == 0U) {
+		return false;
+	}
+	uint8_t nsteps = image[9];
+	uint8_t nwps = image[10];
+	const uint8_t *wp = &image[MISSION_IMAGE_HDR_SIZE + (uint32_t)nsteps * MISSION_IMAGE_STEP_SIZE];
+	for (uint8_t i = 0; i < nwps; ++i, wp += MISSION_IMAGE_WP_SIZE) {
+		s_wps[i].x_mm = (float32_t)rd_i16(&wp[0]);
+		s_wps[i].y_mm = (float32_t)rd_i16(&wp[2]);
+		s_wps[i].speed = (float32_t)rd_u16(&wp[4]) * 0.001f;
+		s_wps[i].servo2_angle = rd_u16(&wp[6]);
+	}
+
+	const uint8_t *rec = &image[MISSION_IMAGE_HDR_SIZE];
+	for (uint8_t i = 0; i < nsteps; ++i, rec += MISSION_IMAGE_STEP_SIZE) {
+		mission_step_t *st = &s_steps[i];
+		uint8_t arg8 = rec[1];
+		uint16_t arg16 = rd_u16(&rec[2]);
+		float32_t heading = (float32_t)rd_i16(&rec[4]) * 0.01f;
+		float32_t speed = (float32_t)rd_u16(&rec[6]) * 0.001f;
+		int32_t value = (int32_t)rd_u32(&rec[8]);
+		uint32_t timeout = rd_u32(&rec[12]);
+		st->type = (mission_step_type_t)rec[0];
+		switch (st->type) {
+		case MISSION_STEP_PATH:
+			if (arg8 < 2U || (uint32_t)arg16 + arg8 > nwps) {
+				printf("MissionStore: 步骤%d 航点越界\r\n", i);
+				return false;
+			}
+			st->u.path.wps = &s_wps[arg16];
+			st->u.path.count = arg8;
+			st->u.path.lookahead_mm = (float32_t)value;
+			st->u.path.timeout_ms = timeout;
+			break;
+		case MISSION_STEP_STRAIGHT:
+			st->u.straight.distance_mm = (float32_t)value;
+			st->u.straight.speed = speed;
+			st->u.straight.timeout_ms = timeout;
+			break;
+		case MISSION_STEP_TURN:
+			st->u.turn.delta_deg = heading;
+			st->u.turn.speed = speed;
+			st->u.turn.stop_deg = (float32_t)arg16 * 0.1f;
+			st->u.turn.timeout_ms = timeout;
+			break;
+		case MISSION_STEP_SERVO:
+			st->u.servo.channel = arg8;
+			st->u.servo.angle = arg16;
+			break;
+		case MISSION_STEP_WAIT:
+			st->u.wait.cond = (mission_wait_t)arg8;
+			st->u.wait.ms = (uint32_t)value;
+			break;
+		case MISSION_STEP_REMOTE:
+			st->u.remote.timeout_ms = timeout;
+			break;
+		default:
+			printf("MissionStore: 步骤%d 类型未知 (%d)\r\n", i, rec[0]);
+			return false;
+		}
+	}
+	*steps = s_steps;
+	*count = nsteps;
+	return true;
+}
+
+bool MissionStore_Load(uint8_t slot, const mission_step_t **steps, uint8_t *count)
+{
+	if (slot >= NVM_MISSION_SLOTS) return false;
+	uint32_t base = NVM_MISSION_ADDR + (uint32_t)slot * NVM_MISSION_SLOT_SIZE;
+	if (!NVM_Read(base, s_image, MISSION_IMAGE_HDR_SIZE) || rd_u32(&s_image[0]) != MISSION_IMAGE_MAGIC) {
+		return false;
+	}
+	uint32_t payload = rd_u16(&s_image[12]);
+	if (MISSION_IMAGE_HDR_SIZE + payload > NVM_MISSION_SLOT_SIZE ||
+	    !NVM_Read(base + MISSION_IMAGE_HDR_SIZE, &s_image[MISSION_IMAGE_HDR_SIZE], payload)) {
+		return false;
+	}
+	return MissionStore_Decode(s_image, MISSION_IMAGE_HDR_SIZE + payload, steps, count);
+}
+
+bool MissionStore_Save(uint8_t slot, const uint8_t *image, uint32_t size)
+{
+	if (slot >= NVM_MISSION_SLOTS || image == NULL || size > NVM_MISSION_SLOT_SIZE) return false;
+	uint32_t payload = mission_image_check(image, size);
+	if (payload == 0U) return false;
+	return NVM_Write(NVM_MISSION_ADDR + (uint32_t)slot * NVM_MISSION_SLOT_SIZE, image,
+	                 MISSION_IMAGE_HDR_SIZE + payload);
+}
@@ -0,0 +1,51 @@
+/**
+ * @file mission_store.h
+ * @author 林木@江南大学
+ * @brief 任务二进制格式与 EEPROM 任务槽
+ * @details 镜像布局（小端）：
+ *          头部 16 字节：magic 'MSN1' | crc32 | version | 步骤数 | 航点数 | flags | 负载长度(u16) | 保留(u16)
+ *          CRC-32 覆盖 crc 字段之后的全部内容（头部 8~15 字节 + 负载）
+ *          负载：步骤记录 16 字节 × 步骤数，随后航点记录 8 字节 × 航点数
+ *          步骤记录：type(u8) | arg8(u8) | arg16(u16) | heading(i16, 0.01°) | speed(u16, ‰) | value(i32) | timeout_ms(u32)
+ *            PATH     arg8=航点数, arg16=首航点索引, value=前视距离 mm
+ *            STRAIGHT value=距离 mm
+ *            TURN     heading=相对转角, arg16=停止阈值(0.1°)
+ *            SERVO    arg8=舵机通道, arg16=角度
+ *            WAIT     arg8=等待条件, value=时间 ms
+ *            REMOTE   仅 timeout_ms（0 不限），其余字段为 0
+ *          航点记录：x(i16 mm) | y(i16 mm) | speed(u16, ‰) | servo2 角度(u16)
+ *          由 tools/mission_compiler.py 从文本描述生成
+ */
+
+#ifndef __MISSION_STORE_H__
+#define __MISSION_STORE_H__
+
+#include "RISCV_Typedefs.h"
+#include "mission.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MISSION_IMAGE_MAGIC      0x314E534DUL  // "MSN1"
+#define MISSION_IMAGE_VERSION    1U
+#define MISSION_IMAGE_HDR_SIZE   16U
+#define MISSION_IMAGE_STEP_SIZE  16U
+#define MISSION_IMAGE_WP_SIZE    8U
+#define MISSION_STORE_MAX_STEPS  32U
+#define MISSION_STORE_MAX_WPS    48U
+
+// 校验并解码一段任务镜像；成功后 steps/count 指向内部缓冲（下一次加载前有效）
+bool MissionStore_Decode(const uint8_t *image, uint32_t size, const mission_step_t **steps, uint8_t *count);
+// 从 EEPROM 任务槽读取、校验并解码
+bool MissionStore_Load(uint8_t slot, const mission_step_t **steps, uint8_t *count);
+// 校验后写入任务槽（只有内容变化的数据块会回写 dflash）
+bool MissionStore_Save(uint8_t slot, const uint8_t *image, uint32_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __MISSION_STORE_H__
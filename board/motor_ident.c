@@ -0,0 +1,201 @@
+/**
+ * @file motor_ident.c
+ * @author 林木@江南大学
+ * @brief 电机特性自检与前馈查表实现
+ * @details 稳态：逐点提高占空比，稳定后按编码器增量测速，最小二乘拟合 v = a·(d - d0) 得到死区 d0；
+ *          时间常数：静止起步阶跃，一阶系统在 t >> τ 时位移 x(t) ≈ v_ss·(t - τ)，
+ *          故 τ = t - x(t)/v_ss，用位移积分估计，不受单周期计数量化影响
+ */
+
+#include "motor_ident.h"
+#include "motor_control.h"
+#include "odometry.h"
+#include "my_move.h"
+#include "board_delay.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+static const float32_t s_ff_duty[MOTOR_FF_POINTS] = { 0.04f, 0.08f, 0.12f, 0.16f, 0.24f, 0.32f, 0.48f, 0.64f };
+static motor_model_t s_model[2];
+
+static uint8_t ident_side_of(uint8_t motor)
+{
+	return (motor <= 1U) ? MOTOR_IDENT_SIDE_RIGHT : MOTOR_IDENT_SIDE_LEFT;
+}
+
+// 直接输出 PWM，不经过 MyMove 的标定映射
+static void ident_drive(uint8_t motor, float32_t duty)
+{
+	uint16_t raw = (uint16_t)(fminf(fmaxf(duty, 0.0f), 1.0f) * 0xFFFF);
+	switch (motor) {
+		case 0: SetMotor1Direction(FORWARD); SetMotor1Speed(raw); break;
+		case 1: SetMotor2Direction(FORWARD); SetMotor2Speed(raw); break;
+		case 2: SetMotor3Direction(FORWARD); SetMotor3Speed(raw); break;
+		case 3: SetMotor4Direction(FORWARD); SetMotor4Speed(raw); break;
+		default: break;
+	}
+}
+
+// 运行 ms 毫秒，返回被测轮累计位移（mm）
+static float32_t ident_run_ms(uint8_t side, uint32_t ms)
+{
+	float32_t sum = 0.0f;
+	for (uint32_t t = 0; t < ms; t += MOTOR_IDENT_PERIOD_MS) {
+		simple_delay_ms(MOTOR_IDENT_PERIOD_MS);
+		Odom_Update(MOTOR_IDENT_PERIOD_MS);
+		float32_t dl, dr;
+		Odom_GetLastWheelDeltaMm(&dl, &dr);
+		sum += fabsf((side == MOTOR_IDENT_SIDE_RIGHT) ? dr : dl);
+	}
+	return sum;
+}
+
+static bool ident_side(uint8_t side, motor_model_t *m)
+{
+	const uint8_t motor = (side == MOTOR_IDENT_SIDE_RIGHT) ? 1U : 2U;
+	memset(m, 0, sizeof(*m));
+
+	// 1) 稳态扫描
+	float32_t sd = 0.0f, sv = 0.0f, sdd = 0.0f, sdv = 0.0f;
+	uint8_t n = 0;
+	for (uint8_t i = 0; i < MOTOR_FF_POINTS; ++i) {
+		ident_drive(motor, s_ff_duty[i]);
+		(void)ident_run_ms(side, MOTOR_IDENT_SETTLE_MS);
+		float32_t v = ident_run_ms(side, MOTOR_IDENT_MEASURE_MS) * 1000.0f / (float32_t)MOTOR_IDENT_MEASURE_MS;
+		printf("MotorIdent: 电机%d duty=%.2f v=%.0fmm/s\r\n", motor + 1, s_ff_duty[i], v);
+		if (v < MOTOR_IDENT_MIN_SPEED) {
+			continue;
+		}
+		m->speed_mm_s[i] = (uint16_t)fminf(v, 65535.0f);
+		sd += s_ff_duty[i]; sv += v; sdd += s_ff_duty[i] * s_ff_duty[i]; sdv += s_ff_duty[i] * v;
+		n++;
+	}
+	ident_drive(motor, 0.0f);
+	(void)ident_run_ms(side, 600U);
+	if (n < 3U) {
+		printf("MotorIdent: 电机%d 有效点不足（编码器或接线异常？）\r\n", motor + 1);
+		return false;
+	}
+	// 最小二乘 v = a·d + b，死区 d0 = -b/a
+	float32_t den = (float32_t)n * sdd - sd * sd;
+	float32_t a = ((float32_t)n * sdv - sd * sv) / den;
+	float32_t b = (sv - a * sd) / (float32_t)n;
+	if (a <= 0.0f) {
+		return false;
+	}
+	float32_t d0 = fminf(fmaxf(-b / a, 0.0f), 0.3f);
+	m->deadband_pm = (uint16_t)(d0 * 1000.0f + 0.5f);
+
+	// 2) 阶跃响应：τ = T - x(T)/v_ss，v_ss 取最后 200ms 平均
+	ident_drive(motor, MOTOR_IDENT_STEP_DUTY);
+	float32_t x_head = ident_run_ms(side, MOTOR_IDENT_STEP_MS - 200U);
+	float32_t x_tail = ident_run_ms(side, 200U);
+	ident_drive(motor, 0.0f);
+	(void)ident_run_ms(side, 600U);
+	float32_t v_ss = x_tail * 1000.0f / 200.0f;
+	float32_t tau_s = 0.02f;
+	if (v_ss >= MOTOR_IDENT_MIN_SPEED) {
+		tau_s = (float32_t)MOTOR_IDENT_STEP_MS / 1000.0f - (x_head + x_tail) / v_ss;
+	}
+	m->tau_ms = (uint16_t)(fminf(fmaxf(tau_s, 0.01f), 0.5f) * 1000.0f + 0.5f);
+
+	// 线性模型回退：指令 s 对应 v = s·MY_SPEED_MM_S_AT_FULL_DUTY = a·(d - d0)
+	float32_t gain = MY_SPEED_MM_S_AT_FULL_DUTY / (a * (1.0f - d0));
+	MyMove_SetMotorCalib(motor, gain, d0);
+	MyMove_SetMotorCalib((side == MOTOR_IDENT_SIDE_RIGHT) ? 0U : 3U, gain, d0);
+	printf("MotorIdent: 电机%d 死区=%.3f 斜率=%.0fmm/s 增益=%.3f τ=%dms\r\n", motor + 1, d0, a, gain, m->tau_ms);
+	return true;
+}
+
+bool MotorIdent_Run(void)
+{
+	printf("MotorIdent: 开始电机自检（车轮需悬空）\r\n");
+	MyMove_Stop();
+	Odom_Update(0U);
+	motor_model_t m;
+	bool ok = true;
+	for (uint8_t side = 0; side < 2U; ++side) {
+		if (ident_side(side, &m)) {
+			s_model[side] = m;
+		} else {
+			ok = false;
+		}
+	}
+	MyMove_Stop();
+	return ok;
+}
+
+bool MotorIdent_DutyForSpeed(uint8_t motor, float32_t speed_mm_s, float32_t *duty)
+{
+	if (motor >= 4U) return false;
+	const motor_model_t *m = &s_model[ident_side_of(motor)];
+	if (m->tau_ms == 0U) return false;
+	if (speed_mm_s <= 0.0f) {
+		*duty = 0.0f;
+		return true;
+	}
+	// 从 (死区, 0) 起沿已起转的点分段线性插值，超出末点按末段斜率外推
+	float32_t d_prev = (float32_t)m->deadband_pm / 1000.0f;
+	float32_t v_prev = 0.0f;
+	float32_t slope = 0.0f;
+	for (uint8_t i = 0; i < MOTOR_FF_POINTS; ++i) {
+		float32_t v = (float32_t)m->speed_mm_s[i];
+		if (v <= v_prev || s_ff_duty[i] <= d_prev) continue;
+		slope = (s_ff_duty[i] - d_prev) / (v - v_prev);
+		if (speed_mm_s <= v) {
+			*duty = d_prev + (speed_mm_s - v_prev) * slope;
+			return true;
+		}
+		d_prev = s_ff_duty[i];
+		v_prev = v;
+	}
+	if (slope <= 0.0f) return false;
+	*duty = fminf(d_prev + (speed_mm_s - v_prev) * slope, 1.0f);
+	return true;
+}
+
+float32_t MotorIdent_GetTauS(void)
+{
+	uint32_t sum = 0U;
+	uint8_t n = 0;
+	for (uint8_t i = 0; i < 2U; ++i) {
+		if (s_model[i].tau_ms != 0U) {
+			sum += s_model[i].tau_ms;
+			n++;
+		}
+	}
+	return (n == 0U) ? 0.0f : (float32_t)sum / (1000.0f * (float32_t)n);
+}
+
+const float32_t *MotorIdent_GetDutyPoints(void)
+{
+	return s_ff_duty;
+}
+
+void MotorIdent_GetModel(uint8_t side, motor_model_t *model)
+{
+	if (side < 2U) *model = s_model[side];
+}
+
+void MotorIdent_SetModel(uint8_t side, const motor_model_t *model)
+{
+	if (side < 2U) s_model[side] = *model;
+}
+
+void MotorIdent_Print(void)
+{
+	static const char *const names[2] = { "right(M1/M2)", "left(M3/M4)" };
+	for (uint8_t s = 0; s < 2U; ++s) {
+		const motor_model_t *m = &s_model[s];
+		if (m->tau_ms == 0U) {
+			printf("motor %s: 未标定\r\n", names[s]);
+			continue;
+		}
+		printf("motor %s: deadband=%.3f tau=%dms v=", names[s], (float32_t)m->deadband_pm / 1000.0f, m->tau_ms);
+		for (uint8_t i = 0; i < MOTOR_FF_POINTS; ++i) {
+			printf("%s%d", (i == 0U) ? "" : "/", m->speed_mm_s[i]);
+		}
+		printf("mm/s\r\n");
+	}
+}
@@ -0,0 +1,54 @@
+/**
+ * @file motor_ident.h
+ * @author 林木@江南大学
+ * @brief 电机特性自检 - 占空比扫描、死区/增益/时间常数拟合与前馈查表
+ * @details 仅电机2（右前）、电机3（左前）带编码器：分别扫描得到右侧/左侧模型，
+ *          同侧后轮（电机1/电机4）沿用前轮模型。自检需将车体架空、车轮悬空
+ */
+
+#ifndef __MOTOR_IDENT_H__
+#define __MOTOR_IDENT_H__
+
+#include "RISCV_Typedefs.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MOTOR_FF_POINTS          8U      // 查表点数（占空比点见 MotorIdent_GetDutyPoints）
+#define MOTOR_IDENT_PERIOD_MS    20U     // 采样周期
+#define MOTOR_IDENT_SETTLE_MS    400U    // 每个占空比点的稳定时间
+#define MOTOR_IDENT_MEASURE_MS   300U    // 每个占空比点的测速窗口
+#define MOTOR_IDENT_STEP_DUTY    0.40f   // 时间常数测试阶跃占空比
+#define MOTOR_IDENT_STEP_MS      800U    // 阶跃持续时间（远大于时间常数）
+#define MOTOR_IDENT_MIN_SPEED    20.0f   // 低于该轮速（mm/s）视为未起转
+
+#define MOTOR_IDENT_SIDE_RIGHT   0U      // 电机2 编码器，电机1/2 使用
+#define MOTOR_IDENT_SIDE_LEFT    1U      // 电机3 编码器，电机3/4 使用
+
+// 单侧电机模型（紧凑格式，直接存入标定记录）
+typedef struct {
+	uint16_t speed_mm_s[MOTOR_FF_POINTS];  // 各占空比点稳态轮速，0 表示未起转
+	uint16_t deadband_pm;                  // 起转死区（占空比千分比）
+	uint16_t tau_ms;                       // 一阶时间常数，0 表示无效模型
+} motor_model_t;
+
+// 阻塞执行自检（约 15 s），成功后更新前馈表并通过 MyMove_SetMotorCalib 写入线性增益/死区
+bool MotorIdent_Run(void);
+// 前馈：目标轮速（mm/s）-> 占空比；该电机无有效模型时返回 false
+bool MotorIdent_DutyForSpeed(uint8_t motor, float32_t speed_mm_s, float32_t *duty);
+// 两侧时间常数均值（秒），无模型时返回 0
+float32_t MotorIdent_GetTauS(void);
+
+const float32_t *MotorIdent_GetDutyPoints(void);
+void MotorIdent_GetModel(uint8_t side, motor_model_t *model);
+void MotorIdent_SetModel(uint8_t side, const motor_model_t *model);
+void MotorIdent_Print(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __MOTOR_IDENT_H__
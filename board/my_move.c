@@ -10,9 +10,15 @@
 #include "h30.h"
 #include "dc_motor_control.h"
 #include "board_delay.h"
+#include "tlog.h"
 #include "servo2_control.h"
 #include "hcsr04.h"
+#include "odometry.h"
+#include "pose_estimator.h"
+#include "path_follower.h"
+#include "motor_ident.h"
 #include <math.h>
+#include <string.h>
 
 // ========================
 // 内部状态与参数
@@ -31,6 +37,16 @@ static float32_t s_integral = 0.0f;
 // 记录上一次直行初始化时的航向
 static float32_t s_last_straight_init_yaw = 0.0f;
 static int s_has_last_straight_init = 0;
+// 连续过渡模式：段结束不停车
+static int s_flow_mode = 0;
+
+// 航向保持（UseTarget 直行 / 按距离直行）：误差低通、死区与纠偏斜率限制
+static float32_t s_hold_err_alpha = 0.30f;
+static float32_t s_hold_deadband_deg = 2.0f;
+static float32_t s_hold_slew_step = 0.08f;
+
+// 最近一个控制周期的内部量（飞行记录器采样）
+static my_move_trace_t s_trace;
 
 static float32_t normalize_deg(float32_t a)
 {
@@ -67,6 +83,38 @@ static float32_t clampf32(float32_t v, float32_t lo, float32_t hi)
 	return v;
 }
 
+// 位姿跟踪：更新里程计并以本周期航向观测推进位姿估计（yaw_valid=false 时仅预测）
+static void move_track_pose(float32_t yaw_deg, bool yaw_valid, uint32_t dt_ms)
+{
+	Odom_Update(dt_ms);
+	Pose_StepFromOdom(yaw_deg, yaw_valid);
+}
+
+// 记录本周期控制量（不含占空比，占空比由基础动作接口记录）
+static void move_trace(float32_t yaw, float32_t rate, float32_t rate_err, float32_t p, float32_t i, float32_t ff)
+{
+	s_trace.yaw_deg = yaw;
+	s_trace.rate_dps = rate;
+	s_trace.rate_err_dps = rate_err;
+	s_trace.p = p;
+	s_trace.i = i;
+	s_trace.ff = ff;
+}
+
+// 记录四路指令占空比（电机1~4，后退为负）
+static void move_trace_duty(float32_t d1, float32_t d2, float32_t d3, float32_t d4)
+{
+	s_trace.duty[0] = d1;
+	s_trace.duty[1] = d2;
+	s_trace.duty[2] = d3;
+	s_trace.duty[3] = d4;
+}
+
+const my_move_trace_t *MyMove_GetTrace(void)
+{
+	return &s_trace;
+}
+
 // 在使用前为带舵机的转向执行函数添加前置声明
 static void MyMove_TurnExecuteGentleToTargetWithServo(float32_t base_turn_speed,
 	float32_t stop_deg,
@@ -126,7 +174,7 @@ void MyMove_StraightHoldYawWithLog(float32_t base_speed, uint32_t duration_ms)
 	s_has_last_straight_init = 1;
 	s_prev_err = 0.0f;
 	s_integral = 0.0f;
-	printf("StraightInit: yaw0=%.2f°\r\n", y0);
+	TLOG("StraightInit: yaw0=%.2f°\r\n", y0);
 
 	uint32_t now = 0;
 	while (now < duration_ms) {
@@ -135,7 +183,7 @@ void MyMove_StraightHoldYawWithLog(float32_t base_speed, uint32_t duration_ms)
 			MyMove_Stop();
 			return;
 		}
-		printf("StraightTick: yaw=%.2f°\r\n", y);
+		TLOG("StraightTick: yaw=%.2f°\r\n", y);
 		float err = normalize_deg(s_target_yaw_deg - y);
 		s_integral += err;
 		if (s_integral > 1000.0f) { s_integral = 1000.0f; }
@@ -176,7 +224,7 @@ void MyMove_StraightHoldYawWithLogAndSpeeds(float32_t base_speed, uint32_t durat
 	s_has_last_straight_init = 1;
 	s_prev_err = 0.0f;
 	s_integral = 0.0f;
-	printf("StraightInit: yaw0=%.2f°\r\n", y0_avg);
+	TLOG("StraightInit: yaw0=%.2f°\r\n", y0_avg);
 
 	uint32_t now = 0;
 	// 误差EMA与死区、输出斜率限制配置
@@ -240,7 +288,7 @@ void MyMove_StraightHoldYawWithLogAndSpeeds(float32_t base_speed, uint32_t durat
 		float d2 = right * 100.0f; // M2右前
 		float d3 = left  * 100.0f; // M3左前
 		float d4 = left  * 100.0f; // M4左后
-		printf("StraightTick: yaw=%.2f°, duty%%: M1=%.1f%% M2=%.1f%% M3=%.1f%% M4=%.1f%%\r\n",
+		TLOG("StraightTick: yaw=%.2f°, duty%%: M1=%.1f%% M2=%.1f%% M3=%.1f%% M4=%.1f%%\r\n",
 		       y, d1, d2, d3, d4);
 
 		simple_delay_ms(100);
@@ -254,6 +302,7 @@ void MyMove_StraightHoldYaw(float32_t base_speed, uint32_t duration_ms)
 {
 	float32_t bs = clampf32(base_speed, 0.0f, 1.0f);
 	uint32_t now = 0;
+	uint64_t next_us = board_time_us();
 	while (now < duration_ms) {
 		float p, r, y;
 		if (!H30_ReadEuler(&p, &r, &y)) {
@@ -269,7 +318,9 @@ void MyMove_StraightHoldYaw(float32_t base_speed, uint32_t duration_ms)
 		float adjust = s_straight_kp * err + s_straight_ki * s_integral + s_straight_kd * derr;
 		float yaw_corr = clampf32(adjust, -0.6f, 0.6f);
 		MyMove_ForwardWithDiff(bs, yaw_corr);
-		for (volatile uint32_t d = 0; d < 100000; ++d) { }
+		// 固定 30ms 周期（含读姿态与输出耗时）
+		next_us += 30000U;
+		board_sleep_until_us(next_us);
 		now += 30;
 	}
 	MyMove_Stop();
@@ -300,7 +351,7 @@ void MyMove_StraightHoldYawWithObstacleAvoidance(float32_t base_speed, uint32_t
 	s_has_last_straight_init = 1;
 	s_prev_err = 0.0f;
 	s_integral = 0.0f;
-	printf("StraightInit: yaw0=%.2f°\r\n", y0_avg);
+	TLOG("StraightInit: yaw0=%.2f°\r\n", y0_avg);
 
 	uint32_t start_time = 0;  // 记录开始时间
 	uint32_t now = 0;         // 当前运行时间
@@ -361,7 +412,7 @@ void MyMove_StraightHoldYawWithObstacleAvoidance(float32_t base_speed, uint32_t
 				if (!is_waiting_for_obstacle) {
 					is_waiting_for_obstacle = true;
 					obstacle_wait_start = now;
-					printf("检测到障碍物（6cm内），停车等待！连续%d次检测到障碍物\r\n", obs_hits);
+					TLOG("检测到障碍物（6cm内），停车等待！连续%d次检测到障碍物\r\n", obs_hits);
 				}
 			}
 		} else {
@@ -370,7 +421,7 @@ void MyMove_StraightHoldYawWithObstacleAvoidance(float32_t base_speed, uint32_t
 			if (is_waiting_for_obstacle) {
 				uint32_t wait_duration = now - obstacle_wait_start;
 				obstacle_wait_time += wait_duration;
-				printf("障碍物消失，继续直行。本次等待时间: %dms, 累计等待时间: %dms\r\n", 
+				TLOG("障碍物消失，继续直行。本次等待时间: %dms, 累计等待时间: %dms\r\n", 
 				       wait_duration, obstacle_wait_time);
 				is_waiting_for_obstacle = false;
 			}
@@ -412,14 +463,14 @@ void MyMove_StraightHoldYawWithObstacleAvoidance(float32_t base_speed, uint32_t
 				large_error_start_time = now;
 				// 重置积分项，避免积分饱和
 				s_integral = 0.0f;
-				printf("检测到大角度偏差: %.2f°，重置积分项\r\n", err);
+				TLOG("检测到大角度偏差: %.2f°，重置积分项\r\n", err);
 			}
 		}
 		
 		// 检查是否退出大误差状态
 		if (large_error_detected && (now - large_error_start_time) > LARGE_ERROR_RESET_MS) {
 			large_error_detected = false;
-			printf("退出大误差处理状态\r\n");
+			TLOG("退出大误差处理状态\r\n");
 		}
 		
 		prev_error = err;
@@ -442,13 +493,13 @@ void MyMove_StraightHoldYawWithObstacleAvoidance(float32_t base_speed, uint32_t
 			kd_effective = s_straight_kd * 3.0f;  // 大幅增加微分增益
 			ki_effective = 0.0f;                  // 禁用积分
 			s_integral = 0.0f;                    // 清零积分项
-			printf("振荡检测！使用振荡抑制模式: Kp=%.3f, Kd=%.3f, Ki=%.3f\r\n", kp_effective, kd_effective, ki_effective);
+			TLOG("振荡检测！使用振荡抑制模式: Kp=%.3f, Kd=%.3f, Ki=%.3f\r\n", kp_effective, kd_effective, ki_effective);
 		} else if (large_error_detected) {
 			// 大误差时：降低增益，增加阻尼，禁用积分
 			kp_effective = s_straight_kp * 0.5f;  // 降低比例增益
 			kd_effective = s_straight_kd * 2.0f;  // 增加微分增益
 			ki_effective = 0.0f;                  // 禁用积分
-			printf("大误差模式: Kp=%.3f, Kd=%.3f, Ki=%.3f\r\n", kp_effective, kd_effective, ki_effective);
+			TLOG("大误差模式: Kp=%.3f, Kd=%.3f, Ki=%.3f\r\n", kp_effective, kd_effective, ki_effective);
 		} else {
 			// 正常误差时：使用标准参数
 			kp_effective = (fabsf(err) < 2.0f) ? (s_straight_kp * 0.6f) : s_straight_kp;
@@ -489,7 +540,7 @@ void MyMove_StraightHoldYawWithObstacleAvoidance(float32_t base_speed, uint32_t
 		float d2 = right * 100.0f; // M2右前
 		float d3 = left  * 100.0f; // M3左前
 		float d4 = left  * 100.0f; // M4左后
-		printf("StraightTick: yaw=%.2f°, duty%%: M1=%.1f%% M2=%.1f%% M3=%.1f%% M4=%.1f%%, 避障计数=%d, 等待状态=%s, 纠偏=%.3f, 大误差=%s, 振荡=%s, 实际运动=%dms, 累计等待=%dms\r\n",
+		TLOG("StraightTick: yaw=%.2f°, duty%%: M1=%.1f%% M2=%.1f%% M3=%.1f%% M4=%.1f%%, 避障计数=%d, 等待状态=%s, 纠偏=%.3f, 大误差=%s, 振荡=%s, 实际运动=%dms, 累计等待=%dms\r\n",
 		       y, d1, d2, d3, d4, obs_hits, is_waiting_for_obstacle ? "是" : "否", yaw_corr, large_error_detected ? "是" : "否", is_oscillating ? "是" : "否", actual_motion_time, obstacle_wait_time);
 
 		simple_delay_ms(100);
@@ -497,11 +548,11 @@ void MyMove_StraightHoldYawWithObstacleAvoidance(float32_t base_speed, uint32_t
 	}
 	
 	// 显示最终统计信息
-	printf("直行完成！总时间: %dms, 实际运动时间: %dms, 累计等待时间: %dms\r\n", 
+	TLOG("直行完成！总时间: %dms, 实际运动时间: %dms, 累计等待时间: %dms\r\n", 
 	       now, actual_motion_time, obstacle_wait_time);
 	
 	// ==================== 姿态矫正功能 ====================
-	printf("\r\n=== 开始姿态矫正 ===\r\n");
+	TLOG("\r\n=== 开始姿态矫正 ===\r\n");
 	
 	// 先停车，确保静止
 	MyMove_Stop();
@@ -510,19 +561,19 @@ void MyMove_StraightHoldYawWithObstacleAvoidance(float32_t base_speed, uint32_t
 	// 读取当前航向角
 	float p_final, r_final, y_final;
 	if (!H30_ReadEuler(&p_final, &r_final, &y_final)) {
-		printf("姿态矫正失败：无法读取当前航向角\r\n");
+		TLOG("姿态矫正失败：无法读取当前航向角\r\n");
 		MyMove_Stop();
 		return;
 	}
 	
 	// 计算与初始航向角的差值
 	float yaw_error = normalize_deg(s_target_yaw_deg - y_final);
-	printf("初始航向: %.2f°, 当前航向: %.2f°, 误差: %.2f°\r\n", 
+	TLOG("初始航向: %.2f°, 当前航向: %.2f°, 误差: %.2f°\r\n", 
 	       s_target_yaw_deg, y_final, yaw_error);
 	
 	// 如果误差大于1度，进行姿态矫正
 	if (fabsf(yaw_error) > 1.0f) {
-		printf("开始姿态矫正，目标误差: ≤1°\r\n");
+		TLOG("开始姿态矫正，目标误差: ≤1°\r\n");
 		
 		// 姿态矫正参数 - 非常温和的参数
 		const float CORRECTION_SPEED = 0.08f;        // 很慢的矫正速度
@@ -538,7 +589,7 @@ void MyMove_StraightHoldYawWithObstacleAvoidance(float32_t base_speed, uint32_t
 		while (fabsf(yaw_error) > 1.0f && (now - correction_start) < CORRECTION_TIMEOUT) {
 			// 读取当前航向
 			if (!H30_ReadEuler(&p_final, &r_final, &y_final)) {
-				printf("姿态矫正失败：无法读取航向角\r\n");
+				TLOG("姿态矫正失败：无法读取航向角\r\n");
 				break;
 			}
 			
@@ -571,7 +622,7 @@ void MyMove_StraightHoldYawWithObstacleAvoidance(float32_t base_speed, uint32_t
 				MyMove_Stop();
 			}
 			
-			printf("姿态矫正: 当前=%.2f°, 目标=%.2f°, 误差=%.2f°, 纠偏=%.3f\r\n", 
+			TLOG("姿态矫正: 当前=%.2f°, 目标=%.2f°, 误差=%.2f°, 纠偏=%.3f\r\n", 
 			       y_final, s_target_yaw_deg, yaw_error, correction_cmd);
 			
 			simple_delay_ms(50);  // 50ms控制周期，更精细
@@ -585,19 +636,19 @@ void MyMove_StraightHoldYawWithObstacleAvoidance(float32_t base_speed, uint32_t
 		// 读取最终航向角
 		if (H30_ReadEuler(&p_final, &r_final, &y_final)) {
 			float final_error = normalize_deg(s_target_yaw_deg - y_final);
-			printf("姿态矫正完成！最终航向: %.2f°, 最终误差: %.2f°\r\n", y_final, final_error);
+			TLOG("姿态矫正完成！最终航向: %.2f°, 最终误差: %.2f°\r\n", y_final, final_error);
 			
 			if (fabsf(final_error) <= 1.0f) {
-				printf("✓ 姿态矫正成功，误差在1°以内\r\n");
+				TLOG("✓ 姿态矫正成功，误差在1°以内\r\n");
 			} else {
-				printf("⚠ 姿态矫正未完全成功，误差: %.2f°\r\n", final_error);
+				TLOG("⚠ 姿态矫正未完全成功，误差: %.2f°\r\n", final_error);
 			}
 		}
 	} else {
-		printf("✓ 航向角误差已在1°以内，无需矫正\r\n");
+		TLOG("✓ 航向角误差已在1°以内，无需矫正\r\n");
 	}
 	
-	printf("=== 姿态矫正结束 ===\r\n\r\n");
+	TLOG("=== 姿态矫正结束 ===\r\n\r\n");
 	
 	MyMove_Stop();
 }
@@ -608,17 +659,17 @@ void MyMove_StraightHoldYawWithObstacleAvoidanceUseTarget(float32_t base_speed,
 	// 直接复用 MyMove_StraightHoldYawWithObstacleAvoidance 的主体，但省略“重新采样/设目标”部分。
 	// 为减少重复代码，调用者先通过 MyMove_SetStraightTarget() 设定好目标，再进入核心循环。
 	float32_t bs = clampf32(base_speed, 0.0f, 1.0f);
-	printf("StraightUseTarget: targetYaw=%.2f°\r\n", s_target_yaw_deg);
+	TLOG("StraightUseTarget: targetYaw=%.2f°\r\n", s_target_yaw_deg);
 
 	uint32_t now = 0;
 	uint32_t obstacle_wait_time = 0;
 	uint32_t actual_motion_time = 0;
 
 	static float err_ema = 0.0f;
-	const float ERR_EMA_ALPHA = 0.30f;
-	const float DEADBAND_DEG = 2.0f;
+	const float ERR_EMA_ALPHA = s_hold_err_alpha;
+	const float DEADBAND_DEG = s_hold_deadband_deg;
 	static float prev_yaw_cmd = 0.0f;
-	const float SLEW_STEP = 0.08f;
+	const float SLEW_STEP = s_hold_slew_step;
 
 	const float LARGE_ERROR_THRESHOLD = 6.0f;
 	const float ERROR_CHANGE_THRESHOLD = 8.0f;
@@ -664,7 +715,7 @@ void MyMove_StraightHoldYawWithObstacleAvoidanceUseTarget(float32_t base_speed,
 				if (!is_waiting_for_obstacle) {
 					is_waiting_for_obstacle = true;
 					obstacle_wait_start = now;
-					printf("检测到障碍物（6cm内），停车等待！连续%d次检测到障碍物\r\n", obs_hits);
+					TLOG("检测到障碍物（6cm内），停车等待！连续%d次检测到障碍物\r\n", obs_hits);
 				}
 			}
 		} else {
@@ -672,7 +723,7 @@ void MyMove_StraightHoldYawWithObstacleAvoidanceUseTarget(float32_t base_speed,
 			if (is_waiting_for_obstacle) {
 				uint32_t wait_duration = now - obstacle_wait_start;
 				obstacle_wait_time += wait_duration;
-				printf("障碍物消失，继续直行。本次等待时间: %dms, 累计等待时间: %dms\r\n", wait_duration, obstacle_wait_time);
+				TLOG("障碍物消失，继续直行。本次等待时间: %dms, 累计等待时间: %dms\r\n", wait_duration, obstacle_wait_time);
 				is_waiting_for_obstacle = false;
 			}
 		}
@@ -721,14 +772,19 @@ void MyMove_StraightHoldYawWithObstacleAvoidanceUseTarget(float32_t base_speed,
 
 		float32_t left  = clampf32(bs - yaw_corr, 0.0f, 1.0f);
 		float32_t right = clampf32(bs + yaw_corr, 0.0f, 1.0f);
-		printf("StraightUseTargetTick: yaw=%.2f°, duty%%: M1=%.1f%% M2=%.1f%% M3=%.1f%% M4=%.1f%%, 目标=%.2f°\r\n",
+		TLOG("StraightUseTargetTick: yaw=%.2f°, duty%%: M1=%.1f%% M2=%.1f%% M3=%.1f%% M4=%.1f%%, 目标=%.2f°\r\n",
 		       y, right*100.0f, right*100.0f, left*100.0f, left*100.0f, s_target_yaw_deg);
 
 		simple_delay_ms(100);
 		now += 100;
 	}
 
-	printf("直行结束（使用外部目标）。实际运动时间: %dms, 累计等待时间: %dms\r\n", actual_motion_time, obstacle_wait_time);
+	TLOG("直行结束（使用外部目标）。实际运动时间: %dms, 累计等待时间: %dms\r\n", actual_motion_time, obstacle_wait_time);
+	if (s_flow_mode && !is_waiting_for_obstacle) {
+		// 连续过渡：保持基础速度直行，交由下一段接管
+		MyMove_ForwardWithDiff(bs, 0.0f);
+		return;
+	}
 	MyMove_Stop();
 }
 
@@ -749,103 +805,258 @@ void MyMove_TurnInit(int direction)
 	}
 }
 
-// 温和型转向执行：参考直行增强版的滤波/限幅/斜率/积分策略
-static void MyMove_TurnExecuteGentleToTarget(float32_t base_turn_speed, float32_t stop_deg, uint32_t timeout_ms, float32_t target_yaw)
+// ========================
+// 原地转向：梯形角速度规划 + 陀螺角速度闭环 + 预测停车
+// ========================
+
+// 转向规划与闭环参数
+#define TURN_PERIOD_MS          20U      // 控制周期（与舵机 PWM 周期一致）
+#define TURN_RATE_MAX_DPS       150.0f   // 占空比 1.0 对应的最大规划角速度（°/s）
+#define TURN_ACCEL_DPS2         360.0f   // 规划角加速度/减速度（°/s²）
+#define TURN_FF_GAIN            1.6f     // 原地旋转前馈补偿（麦克纳姆轮侧滑损失）
+#define TURN_RATE_KP            0.0020f  // 角速度误差比例增益（占空比 / (°/s)）
+#define TURN_RATE_KI            0.0060f  // 角速度误差积分增益（占空比 / (°/s) / s）
+#define TURN_RATE_I_LIMIT       0.10f    // 积分限幅
+#define TURN_MIN_DUTY           0.10f    // 克服静摩擦的最小旋转占空比
+#define TURN_SETTLE_RATE_DPS    3.0f     // 判定静止的角速度阈值
+#define TURN_SETTLE_MAX_MS      300U     // 停车后等待静止的最长时间
+#define TURN_MAX_ATTEMPTS       3        // 停车后误差超限时的补转次数上限
+// 滑行角模型：θ_coast = k * ω²，k 在每次停车后在线学习
+#define TURN_STOP_GAIN_DEFAULT  0.0008f
+#define TURN_STOP_GAIN_MIN      0.0001f
+#define TURN_STOP_GAIN_MAX      0.0050f
+#define TURN_STOP_LEARN_ALPHA   0.30f
+
+static float32_t s_turn_stop_gain = TURN_STOP_GAIN_DEFAULT;
+
+float32_t MyMove_GetTurnStopGain(void)
 {
-	float32_t bs = clampf32(base_turn_speed, 0.0f, 1.0f);
-	if (stop_deg < 0.5f) { stop_deg = 0.5f; }
-	uint32_t elapsed = 0;
-	// 误差EMA/死区/斜率限制参数（适度更保守）
-	static float err_ema = 0.0f;
-	const float ERR_EMA_ALPHA = 0.20f;
-	const float DEADBAND_DEG = 1.2f;
-	static float prev_yaw_cmd = 0.0f;
-	const float SLEW_STEP = 0.035f;
-	// 复用直行PID参数
-	s_prev_err = 0.0f;
+	return s_turn_stop_gain;
+}
+
+void MyMove_SetTurnStopGain(float32_t gain)
+{
+	s_turn_stop_gain = clampf32(gain, TURN_STOP_GAIN_MIN, TURN_STOP_GAIN_MAX);
+}
+
+// 运行时可调参数表（供命令行按名称读写）
+static const param_desc_t s_params[] = {
+	{ "straight_kp",       &s_straight_kp,       0.0f,    1.0f   },
+	{ "straight_ki",       &s_straight_ki,       0.0f,    0.1f   },
+	{ "straight_kd",       &s_straight_kd,       0.0f,    1.0f   },
+	{ "hold_err_alpha",    &s_hold_err_alpha,    0.01f,   1.0f   },
+	{ "hold_deadband_deg", &s_hold_deadband_deg, 0.0f,    10.0f  },
+	{ "hold_slew_step",    &s_hold_slew_step,    0.005f,  0.5f   },
+	{ "turn_stop_gain",    &s_turn_stop_gain,    0.0001f, 0.005f },
+};
+
+const param_desc_t *MyMove_GetParamTable(uint8_t *count)
+{
+	*count = (uint8_t)(sizeof(s_params) / sizeof(s_params[0]));
+	return s_params;
+}
+
+// 控制周期等待：有舵机脉冲时以舵机周期计时
+static void turn_wait_period(uint32_t servo_pulse_us)
+{
+	if (servo_pulse_us != 0U) {
+		servo2_send_pulse(servo_pulse_us);
+	} else {
+		simple_delay_ms(TURN_PERIOD_MS);
+	}
+}
+
+#define TURN_PRESTOP_MS         120U     // 直行后先停再拐弯的等待时间
+
+// 可恢复的原地转向状态：PRESTOP（停车）-> RUN（梯形角速度跟踪）-> SETTLE（等待静止、学习/补转）
+typedef enum {
+	TURN_PH_PRESTOP = 0,
+	TURN_PH_RUN,
+	TURN_PH_SETTLE
+} turn_phase_t;
+
+static struct {
+	turn_phase_t phase;
+	float target;
+	float stop_deg;
+	float rate_max;
+	float ff_per_dps;
+	uint32_t timeout_ms;
+	uint32_t elapsed;        // 转向用时（RUN + SETTLE，不含预停车）
+	uint32_t phase_elapsed;  // 当前阶段用时
+	uint32_t tick;
+	int attempt;
+	bool first_tick;         // 本阶段首个周期（尚未经过时间）
+	float rate_meas;
+	float last_y;
+	float rate_cut;
+	float yaw_cut;
+} s_turn;
+
+static void turn_start_attempt(void)
+{
+	s_turn.phase = TURN_PH_RUN;
+	s_turn.phase_elapsed = 0;
+	s_turn.tick = 0;
+	s_turn.first_tick = true;
+	s_turn.rate_meas = 0.0f;
 	s_integral = 0.0f;
-	float last_y = 0.0f;
+}
+
+static my_move_status_t turn_timeout(void)
+{
+	float final_err = normalize_deg(s_turn.target - s_turn.last_y);
+	TLOG("TurnTimeout: finalYaw=%.2f°, target=%.2f°, err=%.2f°\r\n", s_turn.last_y, s_turn.target, final_err);
+	MyMove_Stop();
+	return MY_MOVE_TIMEOUT;
+}
+
+// 转向开始：梯形角速度参考 ω_ref = min(ω_max, a·t, sqrt(2a·|剩余角|))，陀螺 Z 轴角速度闭环跟踪；
+// 当 学习滑行角 k·ω² 覆盖剩余角时提前停车，静止后若误差仍超 stop_deg 则补转
+void MyMove_TurnBegin(float32_t target_yaw, float32_t base_turn_speed, float32_t stop_deg, uint32_t timeout_ms)
+{
+	float32_t bs = clampf32(base_turn_speed, 0.05f, 1.0f);
+	s_turn.target = normalize_deg(target_yaw);
+	s_turn.stop_deg = (stop_deg < 0.5f) ? 0.5f : stop_deg;
+	s_turn.timeout_ms = timeout_ms;
+	s_turn.rate_max = TURN_RATE_MAX_DPS * bs;
+	// 前馈：原地旋转 ω = 2·s·K / W  =>  s = ω·W / (2K)
+	s_turn.ff_per_dps = TURN_FF_GAIN * (MY_TRACK_WIDTH_MM * 0.5f) / (MY_SPEED_MM_S_AT_FULL_DUTY * 57.29578f);
+	s_turn.elapsed = 0;
+	s_turn.attempt = 0;
+	s_turn.last_y = 0.0f;
+	s_turn.phase = TURN_PH_PRESTOP;
+	s_turn.phase_elapsed = 0;
 	// 直行后先停再拐弯
 	MyMove_Stop();
-	simple_delay_ms(120);
-	// 复位跨次调用的静态状态
-	err_ema = 0.0f;
-	prev_yaw_cmd = 0.0f;
+}
 
-	while (elapsed < timeout_ms) {
-		float p, r, y;
-		if (!H30_ReadEuler(&p, &r, &y)) {
-			MyMove_Stop();
-			return;
+my_move_status_t MyMove_TurnTick(uint32_t dt_ms)
+{
+	// 停车/等待静止阶段无控制输出，只保留最近的航向与角速度
+	move_trace(s_turn.last_y, s_turn.rate_meas, 0.0f, 0.0f, 0.0f, 0.0f);
+	s_trace.obstacle_wait = false;
+	if (s_turn.phase == TURN_PH_PRESTOP) {
+		s_turn.phase_elapsed += dt_ms;
+		if (s_turn.phase_elapsed < TURN_PRESTOP_MS) {
+			return MY_MOVE_RUNNING;
 		}
-		last_y = y;
-		float err_raw = normalize_deg(target_yaw - y);
-		float aerr = (err_raw >= 0.0f) ? err_raw : -err_raw;
-		if (aerr <= stop_deg) {
-			printf("TurnDone: finalYaw=%.2f°, target=%.2f°, err=%.2f°\r\n", y, target_yaw, err_raw);
+		turn_start_attempt();
+	}
+
+	if (s_turn.phase == TURN_PH_SETTLE) {
+		// 停车并等待静止，按实际滑行角更新停车模型
+		s_turn.phase_elapsed += dt_ms;
+		s_turn.elapsed += dt_ms;
+		float rate;
+		if (s_turn.phase_elapsed < TURN_SETTLE_MAX_MS &&
+		    !(H30_ReadYawRateDps(&rate) && fabsf(rate) < TURN_SETTLE_RATE_DPS)) {
+			return MY_MOVE_RUNNING;
+		}
+		float p, r, y_settled;
+		if (!H30_ReadEuler(&p, &r, &y_settled)) {
 			MyMove_Stop();
-			return;
+			return MY_MOVE_ERROR;
 		}
-		printf("TurnTick: yaw=%.2f°, target=%.2f°, err=%.2f°\r\n", y, target_yaw, err_raw);
-		// EMA + 死区
-		err_ema = (1.0f - ERR_EMA_ALPHA) * err_ema + ERR_EMA_ALPHA * err_raw;
-		float err = err_ema;
-		if (fabsf(err) < DEADBAND_DEG) { err = 0.0f; }
-
-		// 上限随速度：略高于直行，便于控制但仍克制
-		float rot_limit = fminf(0.18f, bs * 0.32f + 0.03f);
+		s_turn.last_y = y_settled;
+		if (s_turn.rate_cut > 20.0f) {
+			float coast_meas = fabsf(normalize_deg(y_settled - s_turn.yaw_cut));
+			float k_meas = coast_meas / (s_turn.rate_cut * s_turn.rate_cut);
+			MyMove_SetTurnStopGain((1.0f - TURN_STOP_LEARN_ALPHA) * s_turn_stop_gain + TURN_STOP_LEARN_ALPHA * k_meas);
+		}
+		float final_err = normalize_deg(s_turn.target - y_settled);
+		if (fabsf(final_err) <= s_turn.stop_deg) {
+			TLOG("TurnDone: finalYaw=%.2f°, target=%.2f°, err=%.2f°, time=%dms, stopGain=%.5f\r\n",
+			       y_settled, s_turn.target, final_err, s_turn.elapsed, s_turn_stop_gain);
+			return MY_MOVE_DONE;
+		}
+		TLOG("TurnRetry: yaw=%.2f°, err=%.2f°\r\n", y_settled, final_err);
+		if (++s_turn.attempt >= TURN_MAX_ATTEMPTS) {
+			return turn_timeout();
+		}
+		turn_start_attempt();
+		return MY_MOVE_RUNNING;
+	}
 
-		float derr = err - s_prev_err;
-		s_prev_err = err;
-		float rot_pd = s_straight_kp * err + s_straight_kd * derr;
+	// TURN_PH_RUN
+	if (!s_turn.first_tick) {
+		s_turn.elapsed += dt_ms;
+		s_turn.phase_elapsed += dt_ms;
+	}
+	s_turn.first_tick = false;
+	if (s_turn.elapsed >= s_turn.timeout_ms) {
+		return turn_timeout();
+	}
 
-		// 受控积分
-		if (fabsf(rot_pd) < rot_limit * 0.85f && fabsf(err) > (DEADBAND_DEG * 0.5f)) {
-			s_integral += s_straight_ki * err;
-			if (s_integral > 0.12f) { s_integral = 0.12f; }
-			if (s_integral < -0.12f) { s_integral = -0.12f; }
-		} else {
-			s_integral *= 0.98f;
-		}
+	const float dt = (float)TURN_PERIOD_MS / 1000.0f;
+	float p, r, y;
+	if (!H30_ReadEuler(&p, &r, &y)) {
+		MyMove_Stop();
+		return MY_MOVE_ERROR;
+	}
+	s_turn.last_y = y;
+	move_track_pose(y, true, dt_ms);
+	float rem = normalize_deg(s_turn.target - y);
+	float arem = fabsf(rem);
+	float dir = (rem >= 0.0f) ? 1.0f : -1.0f;
+	float rate_meas;
+	if (!H30_ReadYawRateDps(&rate_meas)) {
+		rate_meas = 0.0f;
+	}
+	s_turn.rate_meas = rate_meas;
 
-		float yaw_cmd = rot_pd + s_integral;
-		if (yaw_cmd > rot_limit) { yaw_cmd = rot_limit; }
-		if (yaw_cmd < -rot_limit) { yaw_cmd = -rot_limit; }
-		float delta = yaw_cmd - prev_yaw_cmd;
-		if (delta > SLEW_STEP) { yaw_cmd = prev_yaw_cmd + SLEW_STEP; }
-		else if (delta < -SLEW_STEP) { yaw_cmd = prev_yaw_cmd - SLEW_STEP; }
-		prev_yaw_cmd = yaw_cmd;
+	// 预测停车：以当前角速度滑行的角度覆盖剩余角（同向运动时）
+	float coast = s_turn_stop_gain * rate_meas * rate_meas;
+	if (arem <= s_turn.stop_deg || (rate_meas * dir > 0.0f && coast >= arem - s_turn.stop_deg * 0.5f)) {
+		s_turn.rate_cut = fabsf(rate_meas);
+		s_turn.yaw_cut = y;
+		MyMove_Stop();
+		s_turn.phase = TURN_PH_SETTLE;
+		s_turn.phase_elapsed = 0;
+		return MY_MOVE_RUNNING;
+	}
 
-		// 原地旋转：左右轮反向
-		float rot_base = fminf(0.35f, bs * 0.40f + 0.05f); // 基础旋转速度（温和）
-		float scale = (rot_limit > 1e-6f) ? (fabsf(yaw_cmd) / rot_limit) : 0.0f;
-		float rot_speed = clampf32(rot_base * scale, 0.12f, 0.5f);
-		if (yaw_cmd > 0.0f) {
-			// 左转
-			MyMove_TurnLeft(rot_speed);
-		} else if (yaw_cmd < 0.0f) {
-			// 右转
-			MyMove_TurnRight(rot_speed);
-		} else {
-			MyMove_Stop();
-		}
+	// 梯形角速度参考
+	float ramp_in = TURN_ACCEL_DPS2 * ((float)s_turn.phase_elapsed / 1000.0f + dt);
+	float ramp_out = sqrtf(2.0f * TURN_ACCEL_DPS2 * arem);
+	float rate_ref = dir * fminf(s_turn.rate_max, fminf(ramp_in, ramp_out));
+
+	float rate_err = rate_ref - rate_meas;
+	s_integral += TURN_RATE_KI * rate_err * dt;
+	s_integral = clampf32(s_integral, -TURN_RATE_I_LIMIT, TURN_RATE_I_LIMIT);
+	float cmd = s_turn.ff_per_dps * rate_ref + TURN_RATE_KP * rate_err + s_integral;
+	move_trace(y, rate_meas, rate_err, TURN_RATE_KP * rate_err, s_integral, s_turn.ff_per_dps * rate_ref);
+	float mag = clampf32(fabsf(cmd) + TURN_MIN_DUTY, TURN_MIN_DUTY, 0.5f);
+	if (cmd > 0.0f) {
+		MyMove_TurnLeft(mag);
+	} else if (cmd < 0.0f) {
+		MyMove_TurnRight(mag);
+	} else {
+		MyMove_Stop();
+	}
 
-		for (volatile uint32_t d = 0; d < 100000; ++d) { }
-		elapsed += 30;
+	if ((s_turn.tick++ % 5U) == 0U) {
+		TLOG("TurnTick: yaw=%.2f°, target=%.2f°, err=%.2f°, rateRef=%.1f, rate=%.1f\r\n",
+		       y, s_turn.target, rem, rate_ref, rate_meas);
 	}
-	// 超时信息
-	{
-		float final_err = normalize_deg(target_yaw - last_y);
-		printf("TurnTimeout: finalYaw=%.2f°, target=%.2f°, err=%.2f°\r\n", last_y, target_yaw, final_err);
+	return MY_MOVE_RUNNING;
+}
+
+// 阻塞式转向：逐周期推进 MyMove_TurnTick，有舵机脉冲时以舵机周期计时
+static void MyMove_TurnExecuteGentleToTarget(float32_t base_turn_speed, float32_t stop_deg, uint32_t timeout_ms,
+                                             float32_t target_yaw, uint32_t servo_pulse_us)
+{
+	MyMove_TurnBegin(target_yaw, base_turn_speed, stop_deg, timeout_ms);
+	while (MyMove_TurnTick(TURN_PERIOD_MS) == MY_MOVE_RUNNING) {
+		turn_wait_period(servo_pulse_us);
 	}
-	MyMove_Stop();
 }
 
 // 执行转向：直到 |误差|<=stop_deg 或超时
 void MyMove_TurnExecute(float32_t base_turn_speed, float32_t stop_deg, uint32_t timeout_ms)
 {
 	// 使用温和型转向到 s_target_yaw_deg
-	MyMove_TurnExecuteGentleToTarget(base_turn_speed, stop_deg, timeout_ms, s_target_yaw_deg);
+	MyMove_TurnExecuteGentleToTarget(base_turn_speed, stop_deg, timeout_ms, s_target_yaw_deg, 0U);
 }
 
 void MyMove_TurnDelta(float32_t delta_deg, float32_t base_turn_speed, float32_t stop_deg, uint32_t timeout_ms)
@@ -859,7 +1070,7 @@ void MyMove_TurnDelta(float32_t delta_deg, float32_t base_turn_speed, float32_t
 	s_prev_err = 0.0f;
 	s_integral = 0.0f;
 	// 直接以目标航向进行温和型执行
-	MyMove_TurnExecuteGentleToTarget(base_turn_speed, stop_deg, timeout_ms, s_target_yaw_deg);
+	MyMove_TurnExecuteGentleToTarget(base_turn_speed, stop_deg, timeout_ms, s_target_yaw_deg, 0U);
 }
 
 void MyMove_TurnLeft90(float32_t base_turn_speed, float32_t stop_deg, uint32_t timeout_ms)
@@ -879,43 +1090,184 @@ void MyMove_TurnRight90(float32_t base_turn_speed, float32_t stop_deg, uint32_t
 	s_target_yaw_deg = target;
 	s_prev_err = 0.0f;
 	s_integral = 0.0f;
-	MyMove_TurnExecuteGentleToTarget(base_turn_speed, stop_deg, timeout_ms, target);
+	MyMove_TurnExecuteGentleToTarget(base_turn_speed, stop_deg, timeout_ms, target, 0U);
+}
+
+// 电机标定：占空比增益与起转死区（索引 0~3 对应电机1~4）
+static float32_t s_motor_gain[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+static float32_t s_motor_deadband[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+void MyMove_SetMotorCalib(uint8_t motor, float32_t gain, float32_t deadband)
+{
+	if (motor >= 4U) return;
+	s_motor_gain[motor] = clampf32(gain, 0.5f, 2.0f);
+	s_motor_deadband[motor] = clampf32(deadband, 0.0f, 0.3f);
+}
+
+void MyMove_GetMotorCalib(uint8_t motor, float32_t *gain, float32_t *deadband)
+{
+	if (motor >= 4U) return;
+	*gain = s_motor_gain[motor];
+	*deadband = s_motor_deadband[motor];
+}
+
+// 指令占空比 -> PWM 占空比：有自检模型时把 s 视为目标轮速 s·MY_SPEED_MM_S_AT_FULL_DUTY 查前馈表；
+// 否则 d = 死区 + (1-死区)·增益·s（s=0 时输出 0；默认增益 1、死区 0 即直接输出）
+static float32_t move_duty_f(uint8_t motor, float32_t s)
+{
+	if (s <= 0.0f) return 0.0f;
+	float32_t d;
+	if (!MotorIdent_DutyForSpeed(motor, s * MY_SPEED_MM_S_AT_FULL_DUTY, &d)) {
+		d = s_motor_deadband[motor] + (1.0f - s_motor_deadband[motor]) * s_motor_gain[motor] * s;
+	}
+	return clampf32(d, 0.0f, 1.0f);
+}
+
+static uint16_t move_duty(uint8_t motor, float32_t s)
+{
+	return (uint16_t)(move_duty_f(motor, s) * 0xFFFF);
+}
+
+// ========================
+// 前轮速度内环
+// ========================
+// 下标 0 右前（电机2），1 左前（电机3）。目标由控制任务写、车轮任务读，用序号保护（同 can_bus.c）；
+// 车轮任务优先级更高，读到写入中的序号时不等待，本周期沿用上次输出
+typedef struct {
+    float32_t target_mm_s[2];   // 目标轮速（mm/s，前进为正，0 表示停转）
+    float32_t ff_duty[2];       // 前馈占空比
+} wheel_cmd_t;
+
+static wheel_cmd_t s_wheel_cmd;
+static volatile uint32_t s_wheel_seq = 0;
+static volatile bool s_wheel_loop_on = false;
+static float32_t s_wheel_integ[2];
+static uint16_t s_wheel_out[2];
+
+static void wheel_write(uint8_t side, uint16_t duty)
+{
+	if (side == 0U) {
+		SetMotor2Speed(duty);
+	} else {
+		SetMotor3Speed(duty);
+	}
+}
+
+// 前轮指令：设置方向；内环运行时只发布目标与前馈（PWM 只由车轮任务写，避免两个任务同时重配 PWM），
+// 否则直接写前馈占空比
+static void move_front(uint8_t side, uint8_t dir, float32_t s)
+{
+	uint8_t motor = (side == 0U) ? 1U : 2U;
+	float32_t ff = move_duty_f(motor, s);
+	if (side == 0U) {
+		SetMotor2Direction(dir);
+	} else {
+		SetMotor3Direction(dir);
+	}
+	if (!s_wheel_loop_on) {
+		wheel_write(side, (uint16_t)(ff * 0xFFFF));
+		return;
+	}
+	s_wheel_seq++;
+	__sync_synchronize();
+	s_wheel_cmd.target_mm_s[side] = ((dir == FORWARD) ? s : -s) * MY_SPEED_MM_S_AT_FULL_DUTY;
+	s_wheel_cmd.ff_duty[side] = ff;
+	__sync_synchronize();
+	s_wheel_seq++;
+}
+
+void MyMove_WheelLoopEnable(bool enable)
+{
+	if (enable == s_wheel_loop_on) return;
+	if (enable) {
+		// 目标清零：下一次基础动作发布目标之前，内环不改动当前前轮输出
+		memset(&s_wheel_cmd, 0, sizeof(s_wheel_cmd));
+		s_wheel_integ[0] = s_wheel_integ[1] = 0.0f;
+		s_wheel_out[0] = s_wheel_out[1] = 0U;
+		__sync_synchronize();
+		s_wheel_loop_on = true;
+		return;
+	}
+	s_wheel_loop_on = false;
+	__sync_synchronize();
+	for (uint8_t side = 0; side < 2U; ++side) {
+		wheel_write(side, (uint16_t)(s_wheel_cmd.ff_duty[side] * 0xFFFF));
+	}
+}
+
+void MyMove_WheelLoopStep(uint32_t dt_us)
+{
+	if (!s_wheel_loop_on || dt_us == 0U) return;
+	wheel_cmd_t cmd;
+	uint32_t seq0 = s_wheel_seq;
+	__sync_synchronize();
+	cmd = s_wheel_cmd;
+	__sync_synchronize();
+	if ((seq0 & 1U) != 0U || seq0 != s_wheel_seq) {
+		return;
+	}
+	float32_t v[2];
+	Odom_GetWheelSpeedMmS(&v[1], &v[0]);
+	float32_t dt_s = (float32_t)dt_us * 1e-6f;
+	for (uint8_t side = 0; side < 2U; ++side) {
+		float32_t d = 0.0f;
+		float32_t tgt = cmd.target_mm_s[side];
+		if (tgt != 0.0f) {
+			// 按目标方向取实测轮速，误差为正表示偏慢
+			float32_t err = (tgt > 0.0f) ? (tgt - v[side]) : (v[side] - tgt);
+			s_wheel_integ[side] = clampf32(s_wheel_integ[side] + MY_WHEEL_KI * err * dt_s,
+			                               -MY_WHEEL_I_LIMIT, MY_WHEEL_I_LIMIT);
+			d = clampf32(cmd.ff_duty[side] + MY_WHEEL_KP * err + s_wheel_integ[side], 0.0f, 1.0f);
+		} else {
+			s_wheel_integ[side] = 0.0f;
+		}
+		// 占空比未变时不重配 PWM
+		uint16_t raw = (uint16_t)(d * 0xFFFF);
+		if (raw != s_wheel_out[side]) {
+			s_wheel_out[side] = raw;
+			wheel_write(side, raw);
+		}
+	}
 }
 
 // 基础动作与差速接口保持不变
 void MyMove_Forward(float32_t speed)
 {
 	float32_t s = clampf32(speed, 0.0f, 1.0f);
-	SetMotor1Direction(FORWARD); SetMotor1Speed((uint16_t)(s * 0xFFFF));
-	SetMotor2Direction(FORWARD); SetMotor2Speed((uint16_t)(s * 0xFFFF));
-	SetMotor3Direction(FORWARD); SetMotor3Speed((uint16_t)(s * 0xFFFF));
-	SetMotor4Direction(FORWARD); SetMotor4Speed((uint16_t)(s * 0xFFFF));
+	SetMotor1Direction(FORWARD); SetMotor1Speed(move_duty(0, s));
+	move_front(0, FORWARD, s);
+	move_front(1, FORWARD, s);
+	SetMotor4Direction(FORWARD); SetMotor4Speed(move_duty(3, s));
+	move_trace_duty(s, s, s, s);
 }
 
 void MyMove_TurnLeft(float32_t speed)
 {
 	float32_t s = clampf32(speed, 0.0f, 1.0f);
-	SetMotor1Direction(FORWARD);  SetMotor1Speed((uint16_t)(s * 0xFFFF));
-	SetMotor2Direction(FORWARD);  SetMotor2Speed((uint16_t)(s * 0xFFFF));
-	SetMotor3Direction(BACKWARD); SetMotor3Speed((uint16_t)(s * 0xFFFF));
-	SetMotor4Direction(BACKWARD); SetMotor4Speed((uint16_t)(s * 0xFFFF));
+	SetMotor1Direction(FORWARD);  SetMotor1Speed(move_duty(0, s));
+	move_front(0, FORWARD, s);
+	move_front(1, BACKWARD, s);
+	SetMotor4Direction(BACKWARD); SetMotor4Speed(move_duty(3, s));
+	move_trace_duty(s, s, -s, -s);
 }
 
 void MyMove_TurnRight(float32_t speed)
 {
 	float32_t s = clampf32(speed, 0.0f, 1.0f);
-	SetMotor1Direction(BACKWARD); SetMotor1Speed((uint16_t)(s * 0xFFFF));
-	SetMotor2Direction(BACKWARD); SetMotor2Speed((uint16_t)(s * 0xFFFF));
-	SetMotor3Direction(FORWARD);  SetMotor3Speed((uint16_t)(s * 0xFFFF));
-	SetMotor4Direction(FORWARD);  SetMotor4Speed((uint16_t)(s * 0xFFFF));
+	SetMotor1Direction(BACKWARD); SetMotor1Speed(move_duty(0, s));
+	move_front(0, BACKWARD, s);
+	move_front(1, FORWARD, s);
+	SetMotor4Direction(FORWARD);  SetMotor4Speed(move_duty(3, s));
+	move_trace_duty(-s, -s, s, s);
 }
 
 void MyMove_Stop(void)
 {
 	SetMotor1Speed(0);
-	SetMotor2Speed(0);
-	SetMotor3Speed(0);
+	move_front(0, FORWARD, 0.0f);
+	move_front(1, FORWARD, 0.0f);
 	SetMotor4Speed(0);
+	move_trace_duty(0.0f, 0.0f, 0.0f, 0.0f);
 }
 
 void MyMove_ForwardWithDiff(float32_t base_speed, float32_t yaw_corr)
@@ -924,10 +1276,11 @@ void MyMove_ForwardWithDiff(float32_t base_speed, float32_t yaw_corr)
 	float32_t yc = clampf32(yaw_corr, -0.6f, 0.6f);
 	float32_t left  = clampf32(bs - yc, 0.0f, 1.0f);
 	float32_t right = clampf32(bs + yc, 0.0f, 1.0f);
-	SetMotor1Direction(FORWARD); SetMotor1Speed((uint16_t)(right * 0xFFFF));
-	SetMotor2Direction(FORWARD); SetMotor2Speed((uint16_t)(right * 0xFFFF));
-	SetMotor3Direction(FORWARD); SetMotor3Speed((uint16_t)(left  * 0xFFFF));
-	SetMotor4Direction(FORWARD); SetMotor4Speed((uint16_t)(left  * 0xFFFF));
+	SetMotor1Direction(FORWARD); SetMotor1Speed(move_duty(0, right));
+	move_front(0, FORWARD, right);
+	move_front(1, FORWARD, left);
+	SetMotor4Direction(FORWARD); SetMotor4Speed(move_duty(3, left));
+	move_trace_duty(right, right, left, left);
 }
 
 void MyMove_ForwardWithYaw(float32_t base_speed, float32_t yaw_error_deg, float32_t Kp)
@@ -955,35 +1308,60 @@ void MyMove_TurnRight90WithServo(float32_t base_turn_speed, float32_t stop_deg,
 	MyMove_TurnExecuteGentleToTargetWithServo(base_turn_speed, stop_deg, timeout_ms, target, servo_angle);
 }
 
-// 带舵机控制的转向执行函数
+// 带舵机控制的转向执行函数：每个控制周期发送一个舵机2脉冲，保证舵机与电机并行工作
 static void MyMove_TurnExecuteGentleToTargetWithServo(float32_t base_turn_speed, float32_t stop_deg, uint32_t timeout_ms, float32_t target_yaw, uint16_t servo_angle)
 {
-	float32_t bs = clampf32(base_turn_speed, 0.0f, 1.0f);
+	// 计算目标角度对应的脉宽（避免调用会阻塞的 servo2_set_angle）
+	uint32_t servo_target_pulse = servo2_angle_to_pulse_us(servo_angle);
+	MyMove_TurnExecuteGentleToTarget(base_turn_speed, stop_deg, timeout_ms, target_yaw, servo_target_pulse);
+}
+
+// ========================
+// 行进中弧线转弯
+// ========================
+
+// 弧线转弯参数
+#define ARC_RATE_ACCEL_DPS2  180.0f  // 入弯/出弯角速度斜坡（°/s²），决定回旋线过渡段长度
+#define ARC_RATE_KP          0.004f  // 角速度误差比例增益（差速 / (°/s)）
+#define ARC_RATE_KI          0.010f  // 角速度误差积分增益（差速 / (°/s) / s）
+#define ARC_RATE_I_LIMIT     0.08f   // 积分限幅
+#define ARC_MIN_RADIUS_MM    (MY_TRACK_WIDTH_MM * 0.5f) // 最小半径：内侧轮速度为零
+
+void MyMove_SetFlowMode(int enable)
+{
+	s_flow_mode = enable ? 1 : 0;
+}
+
+int MyMove_GetFlowMode(void)
+{
+	return s_flow_mode;
+}
+
+// 弧线转弯执行：角速度参考 = min(弧线角速度, 入弯斜坡, 出弯减速曲线)，陀螺闭环跟踪
+// servo_pulse_us 非 0 时每周期发送一个舵机2脉冲，并以舵机周期作为控制周期
+static void MyMove_TurnArcToTarget(float32_t base_speed, float32_t target_yaw, float32_t radius_mm,
+                                   float32_t stop_deg, uint32_t timeout_ms, uint32_t servo_pulse_us)
+{
+	float32_t bs = clampf32(base_speed, 0.05f, 1.0f);
 	if (stop_deg < 0.5f) { stop_deg = 0.5f; }
-	uint32_t elapsed = 0;
-	
-	// 误差EMA/死区/斜率限制参数（适度更保守）
-	static float err_ema = 0.0f;
-	const float ERR_EMA_ALPHA = 0.20f;
-	const float DEADBAND_DEG = 1.2f;
-	static float prev_yaw_cmd = 0.0f;
-	const float SLEW_STEP = 0.035f;
-	
-	// 复用直行PID参数
+	if (radius_mm < ARC_MIN_RADIUS_MM) { radius_mm = ARC_MIN_RADIUS_MM; }
+
+	// 弧线角速度：ω = v / R
+	const float dt = (float)MY_ARC_PERIOD_MS / 1000.0f;
+	const float rad2deg = 57.29578f;
+	float v_mm_s = bs * MY_SPEED_MM_S_AT_FULL_DUTY;
+	float rate_arc = (v_mm_s / radius_mm) * rad2deg;
+	// 差速前馈系数：yaw_corr = ω(rad/s) * W / (2 * K)，K 为满占空比速度
+	float ff_per_dps = (MY_TRACK_WIDTH_MM * 0.5f) / (MY_SPEED_MM_S_AT_FULL_DUTY * rad2deg);
+
 	s_prev_err = 0.0f;
 	s_integral = 0.0f;
+	uint32_t elapsed = 0;
+	uint32_t tick = 0;
 	float last_y = 0.0f;
-	
-	// 直行后先停再拐弯
-	MyMove_Stop();
-	simple_delay_ms(120);
-	
-	// 复位跨次调用的静态状态
-	err_ema = 0.0f;
-	prev_yaw_cmd = 0.0f;
 
-	// 计算目标角度对应的脉宽（避免调用会阻塞的 servo2_set_angle）
-	uint32_t servo_target_pulse = servo2_angle_to_pulse_us(servo_angle);
+	TLOG("ArcStart: target=%.2f°, R=%.0fmm, speed=%.2f, rateArc=%.1f°/s\r\n",
+	       target_yaw, radius_mm, bs, rate_arc);
 
 	while (elapsed < timeout_ms) {
 		float p, r, y;
@@ -992,67 +1370,497 @@ static void MyMove_TurnExecuteGentleToTargetWithServo(float32_t base_turn_speed,
 			return;
 		}
 		last_y = y;
-		float err_raw = normalize_deg(target_yaw - y);
-		float aerr = (err_raw >= 0.0f) ? err_raw : -err_raw;
-		if (aerr <= stop_deg) {
-			printf("TurnDone: finalYaw=%.2f°, target=%.2f°, err=%.2f°\r\n", y, target_yaw, err_raw);
-			MyMove_Stop();
+		move_track_pose(y, true, MY_ARC_PERIOD_MS);
+		float rem = normalize_deg(target_yaw - y);
+		if (fabsf(rem) <= stop_deg) {
+			TLOG("ArcDone: finalYaw=%.2f°, target=%.2f°, err=%.2f°, time=%dms\r\n", y, target_yaw, rem, elapsed);
+			s_target_yaw_deg = target_yaw;
+			s_prev_err = 0.0f;
+			s_integral = 0.0f;
+			if (s_flow_mode) {
+				MyMove_ForwardWithDiff(bs, 0.0f);
+			} else {
+				MyMove_Stop();
+			}
 			return;
 		}
-		printf("TurnTick: yaw=%.2f°, target=%.2f°, err=%.2f°\r\n", y, target_yaw, err_raw);
-		
-		// EMA + 死区
-		err_ema = (1.0f - ERR_EMA_ALPHA) * err_ema + ERR_EMA_ALPHA * err_raw;
-		float err = err_ema;
-		if (fabsf(err) < DEADBAND_DEG) { err = 0.0f; }
 
-		// 上限随速度：略高于直行，便于控制但仍克制
-		float rot_limit = fminf(0.18f, bs * 0.32f + 0.03f);
+		// 参考角速度：入弯斜坡（曲率线性增长）、恒定弧段、出弯按 ω²=2aθ 减速
+		float ramp_in = ARC_RATE_ACCEL_DPS2 * ((float)elapsed / 1000.0f + dt);
+		float ramp_out = sqrtf(2.0f * ARC_RATE_ACCEL_DPS2 * fabsf(rem));
+		float rate_mag = fminf(rate_arc, fminf(ramp_in, ramp_out));
+		float rate_ref = (rem > 0.0f) ? rate_mag : -rate_mag;
+
+		// 角速度闭环：读取失败时仅使用前馈
+		float rate_meas;
+		float rate_err = 0.0f;
+		if (H30_ReadYawRateDps(&rate_meas)) {
+			rate_err = rate_ref - rate_meas;
+			s_integral += ARC_RATE_KI * rate_err * dt;
+			s_integral = clampf32(s_integral, -ARC_RATE_I_LIMIT, ARC_RATE_I_LIMIT);
+		} else {
+			rate_meas = rate_ref;
+		}
+		float yaw_corr = ff_per_dps * rate_ref + ARC_RATE_KP * rate_err + s_integral;
+		// 内侧轮不反转：差速不超过基础速度
+		yaw_corr = clampf32(yaw_corr, -bs, bs);
+		MyMove_ForwardWithDiff(bs, yaw_corr);
 
-		float derr = err - s_prev_err;
-		s_prev_err = err;
-		float rot_pd = s_straight_kp * err + s_straight_kd * derr;
+		if ((tick++ % 5U) == 0U) {
+			TLOG("ArcTick: yaw=%.2f°, rem=%.2f°, rateRef=%.1f, rate=%.1f, corr=%.3f\r\n",
+			       y, rem, rate_ref, rate_meas, yaw_corr);
+		}
 
-		// 受控积分
-		if (fabsf(rot_pd) < rot_limit * 0.85f && fabsf(err) > (DEADBAND_DEG * 0.5f)) {
-			s_integral += s_straight_ki * err;
-			if (s_integral > 0.12f) { s_integral = 0.12f; }
-			if (s_integral < -0.12f) { s_integral = -0.12f; }
+		if (servo_pulse_us != 0U) {
+			servo2_send_pulse(servo_pulse_us);
 		} else {
-			s_integral *= 0.98f;
+			simple_delay_ms(MY_ARC_PERIOD_MS);
 		}
+		elapsed += MY_ARC_PERIOD_MS;
+	}
 
-		float yaw_cmd = rot_pd + s_integral;
-		if (yaw_cmd > rot_limit) { yaw_cmd = rot_limit; }
-		if (yaw_cmd < -rot_limit) { yaw_cmd = -rot_limit; }
-		float delta = yaw_cmd - prev_yaw_cmd;
-		if (delta > SLEW_STEP) { yaw_cmd = prev_yaw_cmd + SLEW_STEP; }
-		else if (delta < -SLEW_STEP) { yaw_cmd = prev_yaw_cmd - SLEW_STEP; }
-		prev_yaw_cmd = yaw_cmd;
+	// 超时：停车，由下一段从静止重新开始
+	TLOG("ArcTimeout: finalYaw=%.2f°, target=%.2f°, err=%.2f°\r\n", last_y, target_yaw, normalize_deg(target_yaw - last_y));
+	s_target_yaw_deg = target_yaw;
+	MyMove_Stop();
+}
+
+void MyMove_TurnArc(float32_t base_speed, float32_t delta_deg, float32_t radius_mm,
+                    float32_t stop_deg, uint32_t timeout_ms)
+{
+	float32_t target = normalize_deg(s_target_yaw_deg + delta_deg);
+	MyMove_TurnArcToTarget(base_speed, target, radius_mm, stop_deg, timeout_ms, 0U);
+}
+
+void MyMove_TurnRight90ArcWithServo(float32_t base_speed, float32_t radius_mm,
+                                    float32_t stop_deg, uint32_t timeout_ms, uint16_t servo_angle)
+{
+	// 以直行目标为基准，避免转弯起点的航向偏差累积到下一段
+	float32_t target = normalize_deg(s_target_yaw_deg - 90.0f);
+	uint32_t servo_target_pulse = servo2_angle_to_pulse_us(servo_angle);
+	MyMove_TurnArcToTarget(base_speed, target, radius_mm, stop_deg, timeout_ms, servo_target_pulse);
+}
+
+// ========================
+// 按距离结束的直行（轮式里程计）
+// ========================
+
+#define DIST_PERIOD_MS        50U      // 控制周期
+#define DIST_DECEL_MM_S2      250.0f   // 规划减速度（mm/s²）
+#define DIST_CRAWL_DUTY       0.06f    // 末段最小占空比（克服静摩擦）
+#define DIST_STOP_TOL_MM      3.0f     // 到达容差（mm）
+#define DIST_STOP_LATENCY_S   0.08f    // 停车滑行提前量：剩余距离 <= v * latency 时停车（有自检模型时取电机时间常数）
+
+// 航向保持状态：与 UseTarget 直行一致的 EMA/死区/限幅/斜率策略
+typedef struct {
+	float err_ema;
+	float prev_err;
+	float integral;
+	float prev_cmd;
+} heading_hold_t;
+
+static void heading_hold_reset(heading_hold_t *h)
+{
+	h->err_ema = 0.0f;
+	h->prev_err = 0.0f;
+	h->integral = 0.0f;
+	h->prev_cmd = 0.0f;
+}
+
+// 输入航向误差（目标-当前，度）与当前基础速度，返回差速纠偏量
+static float heading_hold_step(heading_hold_t *h, float err_raw, float bs)
+{
+	const float ERR_EMA_ALPHA = s_hold_err_alpha;
+	const float DEADBAND_DEG = s_hold_deadband_deg;
+	const float SLEW_STEP = s_hold_slew_step;
+
+	h->err_ema = (1.0f - ERR_EMA_ALPHA) * h->err_ema + ERR_EMA_ALPHA * err_raw;
+	float err = h->err_ema;
+	if (fabsf(err) < DEADBAND_DEG) { err = 0.0f; }
+
+	float rot_limit = fminf(0.10f, bs * 0.20f + 0.02f);
+	float derr = err - h->prev_err;
+	h->prev_err = err;
+	float rot_pd = s_straight_kp * err + s_straight_kd * derr;
+
+	if (fabsf(rot_pd) < rot_limit * 0.7f && fabsf(err) > (DEADBAND_DEG * 0.9f)) {
+		h->integral += s_straight_ki * err;
+		h->integral = clampf32(h->integral, -0.05f, 0.05f);
+	} else {
+		h->integral *= 0.90f;
+	}
 
-		// 原地旋转：左右轮反向
-		float rot_base = fminf(0.35f, bs * 0.40f + 0.05f); // 基础旋转速度（温和）
-		float scale = (rot_limit > 1e-6f) ? (fabsf(yaw_cmd) / rot_limit) : 0.0f;
-		float rot_speed = clampf32(rot_base * scale, 0.12f, 0.5f);
-		if (yaw_cmd > 0.0f) {
-			// 左转
-			MyMove_TurnLeft(rot_speed);
-		} else if (yaw_cmd < 0.0f) {
-			// 右转
-			MyMove_TurnRight(rot_speed);
+	float cmd = clampf32(rot_pd + h->integral, -rot_limit, rot_limit);
+	float delta = cmd - h->prev_cmd;
+	if (delta > SLEW_STEP) { cmd = h->prev_cmd + SLEW_STEP; }
+	else if (delta < -SLEW_STEP) { cmd = h->prev_cmd - SLEW_STEP; }
+	h->prev_cmd = cmd;
+	return cmd;
+}
+
+void MyMove_StraightDistanceUseTarget(float32_t base_speed, float32_t distance_mm, uint32_t timeout_ms)
+{
+	float32_t bs = clampf32(base_speed, DIST_CRAWL_DUTY, 1.0f);
+	TLOG("StraightDistance: targetYaw=%.2f°, distance=%.0fmm\r\n", s_target_yaw_deg, distance_mm);
+
+	heading_hold_t hh;
+	heading_hold_reset(&hh);
+	const float v_max = bs * MY_SPEED_MM_S_AT_FULL_DUTY;
+
+	move_track_pose(0.0f, false, 0U);
+	const float start_mm = Odom_GetDistanceMm();
+	float travelled = 0.0f;
+	uint32_t now = 0;
+	uint32_t motion_time = 0;
+	uint32_t obstacle_wait_time = 0;
+	uint32_t tick = 0;
+
+	int obs_hits = 0;
+	const int OBS_HITS_THRESHOLD = 3;
+	const uint32_t OBS_MIN_ENABLE_MS = 500;
+	bool is_waiting_for_obstacle = false;
+	uint32_t obstacle_wait_start = 0;
+
+	while (motion_time < timeout_ms) {
+		float p, r, y;
+		if (!H30_ReadEuler(&p, &r, &y)) {
+			MyMove_Stop();
+			return;
+		}
+		move_track_pose(y, true, DIST_PERIOD_MS);
+		travelled = Odom_GetDistanceMm() - start_mm;
+		float rem = distance_mm - travelled;
+		float v = Odom_GetSpeedMmS();
+
+		// 到达判定：非连续模式按当前速度预留滑行距离
+		float tau = MotorIdent_GetTauS();
+		float lead = s_flow_mode ? 0.0f : fmaxf(v, 0.0f) * ((tau > 0.0f) ? tau : DIST_STOP_LATENCY_S);
+		if (rem <= DIST_STOP_TOL_MM + lead) {
+			break;
+		}
+
+		if (now > OBS_MIN_ENABLE_MS && HCSR04_IsObstacleDetected()) {
+			obs_hits++;
+			if (obs_hits >= OBS_HITS_THRESHOLD) {
+				MyMove_Stop();
+				if (!is_waiting_for_obstacle) {
+					is_waiting_for_obstacle = true;
+					obstacle_wait_start = now;
+					TLOG("检测到障碍物（6cm内），停车等待！连续%d次检测到障碍物\r\n", obs_hits);
+				}
+			}
 		} else {
+			obs_hits = 0;
+			if (is_waiting_for_obstacle) {
+				uint32_t wait_duration = now - obstacle_wait_start;
+				obstacle_wait_time += wait_duration;
+				TLOG("障碍物消失，继续直行。本次等待时间: %dms, 累计等待时间: %dms\r\n", wait_duration, obstacle_wait_time);
+				is_waiting_for_obstacle = false;
+				heading_hold_reset(&hh);
+			}
+		}
+		if (is_waiting_for_obstacle) {
+			simple_delay_ms(DIST_PERIOD_MS);
+			now += DIST_PERIOD_MS;
+			continue;
+		}
+
+		// 速度规划：v_cmd = min(v_max, sqrt(2·a·剩余距离))，连续模式下不减速
+		float v_cmd = s_flow_mode ? v_max : fminf(v_max, sqrtf(2.0f * DIST_DECEL_MM_S2 * rem));
+		float duty = clampf32(v_cmd / MY_SPEED_MM_S_AT_FULL_DUTY, DIST_CRAWL_DUTY, bs);
+		float yaw_corr = heading_hold_step(&hh, normalize_deg(s_target_yaw_deg - y), duty);
+		MyMove_ForwardWithDiff(duty, yaw_corr);
+
+		if ((tick++ % 2U) == 0U) {
+			TLOG("StraightDistanceTick: yaw=%.2f°, dist=%.1fmm, rem=%.1fmm, v=%.0fmm/s, duty=%.3f, 纠偏=%.3f\r\n",
+			       y, travelled, rem, v, duty, yaw_corr);
+		}
+
+		simple_delay_ms(DIST_PERIOD_MS);
+		now += DIST_PERIOD_MS;
+		motion_time += DIST_PERIOD_MS;
+	}
+
+	TLOG("直行结束（按距离）。行驶: %.1fmm / %.0fmm, 运动时间: %dms, 累计等待时间: %dms%s\r\n",
+	       travelled, distance_mm, motion_time, obstacle_wait_time, (motion_time >= timeout_ms) ? "（超时）" : "");
+	if (s_flow_mode && motion_time < timeout_ms) {
+		MyMove_ForwardWithDiff(bs, 0.0f);
+		return;
+	}
+	MyMove_Stop();
+}
+
+// ========================
+// 航点路径跟踪（纯追踪）
+// ========================
+
+#define PATH_PERIOD_MS        40U      // 控制周期（含一个舵机 PWM 周期）
+#define PATH_LOG_EVERY        3U       // 日志间隔（周期数）
+
+// 障碍物停车等待：连续命中 OBS_HITS_THRESHOLD 次后停车，障碍消失后恢复
+typedef struct {
+	int hits;
+	bool waiting;
+	uint32_t wait_start;
+	uint32_t wait_total;
+} obstacle_guard_t;
+
+static void obstacle_guard_reset(obstacle_guard_t *g)
+{
+	g->hits = 0;
+	g->waiting = false;
+	g->wait_start = 0;
+	g->wait_total = 0;
+}
+
+// 返回 true 表示需要停车等待；resumed 置位表示本周期障碍消失、恢复运动
+static bool obstacle_guard_step(obstacle_guard_t *g, uint32_t now, bool *resumed)
+{
+	const int OBS_HITS_THRESHOLD = 3;
+	const uint32_t OBS_MIN_ENABLE_MS = 500;
+	*resumed = false;
+	if (now > OBS_MIN_ENABLE_MS && HCSR04_IsObstacleDetected()) {
+		g->hits++;
+		if (g->hits >= OBS_HITS_THRESHOLD) {
 			MyMove_Stop();
+			if (!g->waiting) {
+				g->waiting = true;
+				g->wait_start = now;
+				TLOG("检测到障碍物（6cm内），停车等待！连续%d次检测到障碍物\r\n", g->hits);
+			}
+		}
+	} else {
+		g->hits = 0;
+		if (g->waiting) {
+			uint32_t wait_duration = now - g->wait_start;
+			g->wait_total += wait_duration;
+			TLOG("障碍物消失，继续跟踪。本次等待时间: %dms, 累计等待时间: %dms\r\n", wait_duration, g->wait_total);
+			g->waiting = false;
+			*resumed = true;
+		}
+	}
+	return g->waiting;
+}
+
+static struct {
+	path_cmd_t cmd;
+	obstacle_guard_t obs;
+	float rate_i;
+	uint32_t timeout_ms;
+	uint32_t now;
+	uint32_t motion_time;   // 运动时间（不含避障等待）
+	uint32_t tick;
+	bool first_tick;
+} s_path;
+
+bool MyMove_PathBegin(const path_waypoint_t *wps, uint8_t count, float32_t lookahead_mm, uint32_t timeout_ms)
+{
+	pose2d_t pose;
+	move_track_pose(0.0f, false, 0U);
+	Pose_Get(&pose);
+	// 路径坐标系：原点为当前位置，x 轴为当前直行目标航向（而非瞬时航向，避免带入初始偏差）
+	if (!PathFollower_Start(wps, count, lookahead_mm, pose.x_mm, pose.y_mm, s_target_yaw_deg)) {
+		TLOG("PathError: 航点数无效 (%d)\r\n", count);
+		return false;
+	}
+	TLOG("PathStart: 航点=%d, 前视=%.0fmm, 起点=(%.1f, %.1f), 航向=%.2f°\r\n",
+	       count, lookahead_mm, pose.x_mm, pose.y_mm, s_target_yaw_deg);
+
+	s_path.cmd = (path_cmd_t){0};
+	obstacle_guard_reset(&s_path.obs);
+	s_path.rate_i = 0.0f;
+	s_path.timeout_ms = timeout_ms;
+	s_path.now = 0;
+	s_path.motion_time = 0;
+	s_path.tick = 0;
+	s_path.first_tick = true;
+	return true;
+}
+
+static my_move_status_t path_finish(my_move_status_t status)
+{
+	pose2d_t pose;
+	// 后续直行沿路径终点切线方向
+	s_target_yaw_deg = normalize_deg(PathFollower_GetFinalHeadingDeg());
+	s_prev_err = 0.0f;
+	s_integral = 0.0f;
+	Pose_Get(&pose);
+	TLOG("PathDone: 终点=(%.1f, %.1f), θ=%.2f°, 运动时间: %dms, 累计等待时间: %dms%s\r\n",
+	       pose.x_mm, pose.y_mm, pose.theta_deg, s_path.motion_time, s_path.obs.wait_total,
+	       (status == MY_MOVE_TIMEOUT) ? "（超时）" : "");
+	if (s_flow_mode && status == MY_MOVE_DONE) {
+		MyMove_ForwardWithDiff(clampf32(s_path.cmd.speed, DIST_CRAWL_DUTY, 1.0f), 0.0f);
+	} else {
+		MyMove_Stop();
+	}
+	return status;
+}
+
+my_move_status_t MyMove_PathTick(uint32_t dt_ms)
+{
+	if (!s_path.first_tick) {
+		s_path.now += dt_ms;
+		if (!s_path.obs.waiting) {
+			s_path.motion_time += dt_ms;
 		}
+	}
+	s_path.first_tick = false;
+	if (s_path.motion_time >= s_path.timeout_ms) {
+		return path_finish(MY_MOVE_TIMEOUT);
+	}
 
-		// 发送一个完整的舵机PWM周期，以保证舵机与电机每周期并行工作
-		servo2_send_pulse(servo_target_pulse);
-		elapsed += (SERVO2_PERIOD_US / 1000U); // 以舵机周期为时间基准
+	float p, r, y;
+	if (!H30_ReadEuler(&p, &r, &y)) {
+		MyMove_Stop();
+		return MY_MOVE_ERROR;
 	}
-	
-	// 超时信息
-	{
-		float final_err = normalize_deg(target_yaw - last_y);
-		printf("TurnTimeout: finalYaw=%.2f°, target=%.2f°, err=%.2f°\r\n", last_y, target_yaw, final_err);
+	pose2d_t pose;
+	move_track_pose(y, true, dt_ms);
+	move_trace(y, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+	Pose_Get(&pose);
+	float v = Odom_GetSpeedMmS();
+	path_cmd_t *cmd = &s_path.cmd;
+	PathFollower_Step(&pose, s_flow_mode ? 0.0f : v, cmd);
+	if (cmd->done) {
+		return path_finish(MY_MOVE_DONE);
 	}
+
+	bool resumed;
+	s_trace.obstacle_wait = obstacle_guard_step(&s_path.obs, s_path.now, &resumed);
+	if (s_trace.obstacle_wait) {
+		return MY_MOVE_RUNNING;
+	}
+	if (resumed) {
+		s_path.rate_i = 0.0f;
+	}
+
+	// 差速：前馈 duty·κ·W/2（ω = v·κ）+ 陀螺角速度 PI 跟踪
+	float duty = clampf32(cmd->speed, DIST_CRAWL_DUTY, 1.0f);
+	float rate_ref = duty * MY_SPEED_MM_S_AT_FULL_DUTY * cmd->curvature_per_mm * 57.29578f;
+	float yaw_corr = duty * cmd->curvature_per_mm * (MY_TRACK_WIDTH_MM * 0.5f);
+	float rate_meas;
+	if (H30_ReadYawRateDps(&rate_meas)) {
+		float rate_err = rate_ref - rate_meas;
+		s_path.rate_i = clampf32(s_path.rate_i + ARC_RATE_KI * rate_err * ((float)dt_ms / 1000.0f),
+		                         -ARC_RATE_I_LIMIT, ARC_RATE_I_LIMIT);
+		move_trace(y, rate_meas, rate_err, ARC_RATE_KP * rate_err, s_path.rate_i, yaw_corr);
+		yaw_corr += ARC_RATE_KP * rate_err + s_path.rate_i;
+	} else {
+		move_trace(y, 0.0f, 0.0f, 0.0f, 0.0f, yaw_corr);
+	}
+	// 内侧轮不反转
+	yaw_corr = clampf32(yaw_corr, -duty, duty);
+	MyMove_ForwardWithDiff(duty, yaw_corr);
+
+	if ((s_path.tick++ % PATH_LOG_EVERY) == 0U) {
+		TLOG("PathTick: seg=%d, pos=(%.1f, %.1f), θ=%.2f°, xte=%.1fmm, rem=%.1fmm, duty=%.3f, κ=%.5f/mm, 纠偏=%.3f\r\n",
+		       cmd->segment, pose.x_mm, pose.y_mm, pose.theta_deg, cmd->cross_track_mm,
+		       cmd->remaining_mm, duty, cmd->curvature_per_mm, yaw_corr);
+	}
+	return MY_MOVE_RUNNING;
+}
+
+uint16_t MyMove_PathGetServo2Angle(void)
+{
+	return s_path.cmd.servo2_angle;
+}
+
+// 阻塞式路径跟踪：逐周期推进 MyMove_PathTick；需要保持舵机2角度时以一个舵机脉冲占用周期的前 20ms
+void MyMove_FollowPath(const path_waypoint_t *wps, uint8_t count, float32_t lookahead_mm, uint32_t timeout_ms)
+{
+	if (!MyMove_PathBegin(wps, count, lookahead_mm, timeout_ms)) {
+		return;
+	}
+	while (MyMove_PathTick(PATH_PERIOD_MS) == MY_MOVE_RUNNING) {
+		uint16_t servo2_angle = MyMove_PathGetServo2Angle();
+		if (servo2_angle != 0U) {
+			servo2_send_pulse(servo2_angle_to_pulse_us(servo2_angle));
+			simple_delay_ms(PATH_PERIOD_MS - 20U);
+		} else {
+			simple_delay_ms(PATH_PERIOD_MS);
+		}
+	}
+}
+
+// ========================
+// 上位机航向/速度指令（CAN remote 步骤）
+// ========================
+
+#define REMOTE_LOG_EVERY      25U      // 日志间隔（周期数）
+
+static struct {
+	heading_hold_t hh;
+	obstacle_guard_t obs;
+	uint32_t timeout_ms;
+	uint32_t now;
+	uint32_t tick;
+	bool driving;          // 上一周期按指令行驶中
+	bool first_tick;
+} s_remote;
+
+void MyMove_RemoteBegin(uint32_t timeout_ms)
+{
+	move_track_pose(0.0f, false, 0U);
+	heading_hold_reset(&s_remote.hh);
+	obstacle_guard_reset(&s_remote.obs);
+	s_remote.timeout_ms = timeout_ms;
+	s_remote.now = 0;
+	s_remote.tick = 0;
+	s_remote.driving = false;
+	s_remote.first_tick = true;
 	MyMove_Stop();
+	TLOG("RemoteStart: 等待上位机指令, 航向=%.2f°, 时限=%dms\r\n", s_target_yaw_deg, timeout_ms);
+}
+
+my_move_status_t MyMove_RemoteTick(uint32_t dt_ms, bool valid, float32_t heading_deg, float32_t speed_mm_s)
+{
+	if (!s_remote.first_tick) {
+		s_remote.now += dt_ms;
+	}
+	s_remote.first_tick = false;
+	if (s_remote.timeout_ms != 0U && s_remote.now >= s_remote.timeout_ms) {
+		MyMove_Stop();
+		TLOG("RemoteDone: 超时, 用时: %dms, 累计等待时间: %dms\r\n", s_remote.now, s_remote.obs.wait_total);
+		return MY_MOVE_TIMEOUT;
+	}
+
+	float p, r, y;
+	if (!H30_ReadEuler(&p, &r, &y)) {
+		MyMove_Stop();
+		return MY_MOVE_ERROR;
+	}
+	move_track_pose(y, true, dt_ms);
+	move_trace(y, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+
+	bool resumed;
+	s_trace.obstacle_wait = obstacle_guard_step(&s_remote.obs, s_remote.now, &resumed);
+	if (s_trace.obstacle_wait) {
+		return MY_MOVE_RUNNING;
+	}
+	// 指令过期或速度为 0：原地停车等待新指令（不结束步骤）
+	if (!valid || speed_mm_s <= 0.0f) {
+		if (s_remote.driving) {
+			TLOG("RemoteHold: 指令%s，停车\r\n", valid ? "速度为 0" : "过期");
+		}
+		s_remote.driving = false;
+		MyMove_Stop();
+		return MY_MOVE_RUNNING;
+	}
+	if (!s_remote.driving || resumed) {
+		heading_hold_reset(&s_remote.hh);
+	}
+	s_remote.driving = true;
+
+	// 与直行相同的航向保持；大角度转向由上位机分段给出或先插入 turn 步骤
+	s_target_yaw_deg = normalize_deg(heading_deg);
+	float duty = clampf32(speed_mm_s / MY_SPEED_MM_S_AT_FULL_DUTY, DIST_CRAWL_DUTY, 1.0f);
+	float yaw_corr = heading_hold_step(&s_remote.hh, normalize_deg(s_target_yaw_deg - y), duty);
+	move_trace(y, 0.0f, 0.0f, yaw_corr, 0.0f, 0.0f);
+	MyMove_ForwardWithDiff(duty, yaw_corr);
+
+	if ((s_remote.tick++ % REMOTE_LOG_EVERY) == 0U) {
+		TLOG("RemoteTick: yaw=%.2f°, 目标=%.2f°, v=%.0fmm/s, duty=%.3f, 纠偏=%.3f\r\n",
+		       y, s_target_yaw_deg, speed_mm_s, duty, yaw_corr);
+	}
+	return MY_MOVE_RUNNING;
 }
@@ -9,6 +9,8 @@
 #define __MY_MOVE_H__
 
 #include "RISCV_Typedefs.h"
+#include "path_follower.h"
+#include "param.h"
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -68,9 +70,15 @@ float32_t MyMove_GetStraightTarget(void);
 // 使用当前目标航向执行直行（带避障），不会重新采样初始航向
 void MyMove_StraightHoldYawWithObstacleAvoidanceUseTarget(float32_t base_speed, uint32_t duration_ms);
 
+// 按距离结束的直行（带避障）：以当前目标航向行驶 distance_mm 毫米，由编码器里程计判定结束，
+// 速度按 sqrt(2·a·剩余距离) 规划减速以准确停在目标距离（连续过渡模式下不减速、不停车）；
+// timeout_ms 为运动时间上限（不含避障等待）
+void MyMove_StraightDistanceUseTarget(float32_t base_speed, float32_t distance_mm, uint32_t timeout_ms);
+
 // 初始化转向：direction=MY_TURN_LEFT/MY_TURN_RIGHT，目标为当前yaw±90°
 void MyMove_TurnInit(int direction);
-// 执行转向闭环：内部读取 H30 yaw，直到 |误差|<=stop_deg 或超时
+// 执行转向闭环：梯形角速度规划 + 陀螺角速度跟踪，按学习的滑行角提前停车，
+// 静止后 |误差|<=stop_deg 即完成，否则补转，直到超时
 void MyMove_TurnExecute(float32_t base_turn_speed, float32_t stop_deg, uint32_t timeout_ms);
 // 便捷：按相对角度转向（正=左转，负=右转）
 void MyMove_TurnDelta(float32_t delta_deg, float32_t base_turn_speed, float32_t stop_deg, uint32_t timeout_ms);
@@ -78,9 +86,101 @@ void MyMove_TurnDelta(float32_t delta_deg, float32_t base_turn_speed, float32_t
 void MyMove_TurnLeft90(float32_t base_turn_speed, float32_t stop_deg, uint32_t timeout_ms);
 void MyMove_TurnRight90(float32_t base_turn_speed, float32_t stop_deg, uint32_t timeout_ms);
 
+// 原地转向停车模型：滑行角 = gain * ω²（°, °/s），每次转向后在线学习，可读出持久化
+float32_t MyMove_GetTurnStopGain(void);
+void MyMove_SetTurnStopGain(float32_t gain);
+
 // 结合舵机控制的转向函数：小车转向的同时舵机反向转动，保持物品相对地面静止
 void MyMove_TurnRight90WithServo(float32_t base_turn_speed, float32_t stop_deg, uint32_t timeout_ms, uint16_t servo_angle);
 
+// 电机标定（motor 0~3 对应电机1~4）：输出占空比 = 死区 + (1-死区)·增益·指令占空比
+void MyMove_SetMotorCalib(uint8_t motor, float32_t gain, float32_t deadband);
+void MyMove_GetMotorCalib(uint8_t motor, float32_t *gain, float32_t *deadband);
+
+// 运行时可调参数表（直行 PID、航向保持滤波/死区/斜率、转向停车增益）
+const param_desc_t *MyMove_GetParamTable(uint8_t *count);
+
+// ========================
+// 行进中弧线转弯（不停车）：恒定半径圆弧 + 角速度斜坡入弯/出弯（近似回旋线）
+// 以陀螺角速度闭环跟踪参考角速度，配合连续过渡模式实现 直行→转弯→直行 不停车
+// ========================
+
+// 车体几何与速度标定（按机型调整）
+#define MY_TRACK_WIDTH_MM           160.0f  // 左右轮距（mm）
+#define MY_SPEED_MM_S_AT_FULL_DUTY  900.0f  // 占空比 1.0 时的直线速度估计（mm/s）
+#define MY_ARC_PERIOD_MS            20U     // 弧线转弯控制周期（与舵机 PWM 周期一致）
+
+// 连续过渡模式：enable=1 时直行/弧线转弯结束不停车，保持当前速度交给下一段
+void MyMove_SetFlowMode(int enable);
+int MyMove_GetFlowMode(void);
+
+// 弧线转弯：以当前直行目标为基准转过 delta_deg（正=左转，负=右转），半径 radius_mm，
+// 直到 |误差|<=stop_deg 或超时；结束后直行目标更新为弧线终点航向
+void MyMove_TurnArc(float32_t base_speed, float32_t delta_deg, float32_t radius_mm,
+                    float32_t stop_deg, uint32_t timeout_ms);
+// 便捷：行进中右转90°弧线，转弯同时舵机2保持在 servo_angle
+void MyMove_TurnRight90ArcWithServo(float32_t base_speed, float32_t radius_mm,
+                                    float32_t stop_deg, uint32_t timeout_ms, uint16_t servo_angle);
+
+// 可恢复动作（供任务调度器逐周期推进）：Begin 后每个控制周期调用一次 Tick，返回 MY_MOVE_RUNNING 以外的值即结束
+typedef enum {
+    MY_MOVE_RUNNING = 0,
+    MY_MOVE_DONE,
+    MY_MOVE_TIMEOUT,
+    MY_MOVE_ERROR
+} my_move_status_t;
+
+// 原地转向到绝对航向 target_yaw（梯形角速度 + 预测停车 + 补转），dt_ms 为距上次调用的时间
+void MyMove_TurnBegin(float32_t target_yaw, float32_t base_turn_speed, float32_t stop_deg, uint32_t timeout_ms);
+my_move_status_t MyMove_TurnTick(uint32_t dt_ms);
+
+// ========================
+// 航点路径跟踪（纯追踪）：航点坐标以当前位置为原点、当前直行目标航向为 x 轴（左为 +y），
+// 每周期由位姿估计求前视点曲率并按拐点转角/终点减速；拐角由前视点跨段自然圆滑过渡。
+// 结束后直行目标更新为路径终点切线方向；timeout_ms 为运动时间上限（不含避障等待）
+// ========================
+void MyMove_FollowPath(const path_waypoint_t *wps, uint8_t count, float32_t lookahead_mm, uint32_t timeout_ms);
+// 可恢复形式：Begin 返回航点是否有效；Tick 每周期调用；GetServo2Angle 为当前应保持的舵机2角度（0=不驱动）
+bool MyMove_PathBegin(const path_waypoint_t *wps, uint8_t count, float32_t lookahead_mm, uint32_t timeout_ms);
+my_move_status_t MyMove_PathTick(uint32_t dt_ms);
+uint16_t MyMove_PathGetServo2Angle(void);
+
+// ========================
+// 上位机指令行驶（CAN remote 步骤）：每周期传入最近一条驱动指令，按指令航向/速度保持航向行驶；
+// 指令无效（过期）或速度为 0 时停车等待，不结束；timeout_ms 为步骤时长上限（0 表示不限）。
+// 结束条件（收到 RELEASE）由调用方判断
+// ========================
+void MyMove_RemoteBegin(uint32_t timeout_ms);
+my_move_status_t MyMove_RemoteTick(uint32_t dt_ms, bool valid, float32_t heading_deg, float32_t speed_mm_s);
+
+// 最近一个控制周期的内部量（供飞行记录器逐周期采样）；转向/路径 Tick 更新控制项，
+// 基础动作接口更新占空比
+typedef struct {
+    float32_t yaw_deg;
+    float32_t rate_dps;
+    float32_t rate_err_dps;   // 角速度跟踪误差（参考 - 实测）
+    float32_t p;              // 比例项（占空比）
+    float32_t i;              // 积分项
+    float32_t ff;             // 前馈项
+    float32_t duty[4];        // 电机1~4 指令占空比（后退为负）
+    bool obstacle_wait;       // 避障等待中
+} my_move_trace_t;
+const my_move_trace_t *MyMove_GetTrace(void);
+
+// ========================
+// 前轮速度内环（FreeRTOS 构建由 PITMR 释放的车轮任务驱动）
+// 前轮（电机2 右前、电机3 左前）带编码器：内环运行时基础动作接口只发布目标轮速与前馈占空比，
+// 由 MyMove_WheelLoopStep 按 Odom_GetWheelSpeedMmS 的实测轮速做 PI 修正后写 PWM；后轮仍开环
+// ========================
+#define MY_WHEEL_KP       0.0006f   // 比例增益（占空比 / (mm/s)）
+#define MY_WHEEL_KI       0.006f    // 积分增益（占空比 / (mm/s·s)）
+#define MY_WHEEL_I_LIMIT  0.25f     // 积分项限幅（占空比）
+
+// 启停内环（控制任务中调用）：启动时清积分；停止时按当前前馈占空比直接写出前轮 PWM
+void MyMove_WheelLoopEnable(bool enable);
+// 内环一步（车轮任务中调用，在 Odom_SampleWheels 之后），dt_us 为采样周期；内环未启动时不做任何事
+void MyMove_WheelLoopStep(uint32_t dt_us);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,488 @@
+/**
+ * @file net_telem.c
+ * @author 林木@江南大学
+ * @brief W5500 以太网 UDP 遥测与命令通道实现
+ * @details 不经 SDK socket.c/w5500_conf.c（其写缓冲函数先把数据拷入栈上临时数组，sendto 每次
+ *          重设目的地址并忙等发送完成），直接按 W5500 帧格式（VDM 模式：16 位地址 + 控制字节 + 数据）
+ *          访问寄存器与套接字缓冲：
+ *          - 只用套接字 0（UDP），发送写指针 Sn_TX_WR 打开套接字后读一次，之后本地维护；
+ *          - 发送一帧 = 一次写入发送缓冲 + 写 Sn_TX_WR + SEND 命令，下一帧发送前检查 Sn_IR；
+ *          - 每次访问都是一次片选内的阻塞传输（SPI_DRV_MasterTransferBlocking），返回时数据已传完；
+ *          - 目的地址只在变化时重写（遥测与应答通常发往同一主机）
+ */
+
+#include "net_telem.h"
+#include "sdk_project_config.h"
+#include "shell.h"
+#include "mission.h"
+#include "odometry.h"
+#include "pose_estimator.h"
+#include "hcsr04.h"
+#include "board_delay.h"
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+// W5500 寄存器地址（MR/IR 等宏名较短，放在最后包含）
+#include "w5500.h"
+
+#define NET_SOCK             0U
+#define NET_SPI_HDR          3U        // 地址高/低字节 + 控制字节（BSB | RWB | OM）
+#define NET_SPI_READ         0x00U
+#define NET_SPI_WRITE        0x04U
+#define NET_SPI_TIMEOUT_MS   5U
+#define NET_REG_MAX          18U       // 寄存器连续读写的最大字节数（GAR~SIPR）
+#define NET_UDP_INFO         8U        // 接收缓冲中每个数据报前的信息段：源 IP + 源端口 + 长度（大端）
+#define NET_CHIP_VERSION     0x04U
+#define NET_RESET_LOW_US     1000U     // RSTn 低电平保持（≥500 µs）
+#define NET_RESET_WAIT_MS    100U      // 复位释放后等待内部 PLL 稳定的上限
+#define NET_CMD_POLLS        16U       // 等待 Sn_CR 清零的读取次数
+#define NET_ACK_POLLS        32U       // 应答前等待上一帧发送完成的读取次数
+#define NET_RETRY_100US      1000U     // ARP 重试间隔 100 ms
+#define NET_RETRY_COUNT      2U        // 目的主机无响应时约 300 ms 后 TIMEOUT（默认 1.6 s）
+
+// 套接字发送/接收缓冲的 SPI 地址（指针为 16 位，芯片按缓冲大小自动回绕）
+#define NET_TXBUF(ptr)       (((uint32_t)(ptr) << 8) + (NET_SOCK << 5) + 0x10U)
+#define NET_RXBUF(ptr)       (((uint32_t)(ptr) << 8) + (NET_SOCK << 5) + 0x18U)
+
+// 发送缓冲：SPI 地址/控制段紧邻报文头，帧字段直接写入，整帧一次 SPI 传输写出
+typedef struct {
+	uint8_t pad;                    // 使报文头 4 字节对齐
+	uint8_t spi[NET_SPI_HDR];
+	net_telem_hdr_t hdr;
+	union {
+		net_telem_rec_t rec;
+		net_telem_ack_t ack;
+	} body;
+} net_frame_t;
+
+// 接收缓冲：同样在报文头前留出 SPI 段，命令负载直接读入
+typedef struct {
+	uint8_t pad;
+	uint8_t spi[NET_SPI_HDR];
+	net_telem_hdr_t hdr;
+	net_telem_param_t param;
+} net_rx_t;
+
+_Static_assert(sizeof(net_telem_hdr_t) == 8U, "报文头应为 8 字节");
+_Static_assert(sizeof(net_telem_rec_t) == 48U, "遥测帧负载应为 48 字节");
+_Static_assert(sizeof(net_telem_ack_t) == 36U, "应答负载应为 36 字节");
+_Static_assert(offsetof(net_frame_t, hdr) == NET_SPI_HDR + 1U, "SPI 段须紧邻报文头");
+_Static_assert(offsetof(net_rx_t, hdr) == NET_SPI_HDR + 1U, "SPI 段须紧邻报文头");
+
+static bool s_ready = false;
+static net_frame_t s_frame;
+static net_rx_t s_rx;
+static uint16_t s_tx_wr = 0;            // Sn_TX_WR 本地副本
+static bool s_send_pending = false;     // 已发出 SEND，尚未确认 SEND_OK/TIMEOUT
+static bool s_dst_valid = false;        // Sn_DIPR/Sn_DPORT 已写入 s_dst_*
+static uint8_t s_dst_ip[4];
+static uint16_t s_dst_port = 0;
+static bool s_peer_valid = false;       // 遥测订阅方
+static uint8_t s_peer_ip[4];
+static uint16_t s_peer_port = 0;
+static uint32_t s_peer_seen_ms = 0;
+static uint16_t s_tx_seq = 0;
+static uint32_t s_tx_frames = 0;
+static uint32_t s_tx_drops = 0;         // 上一帧未发完而丢弃
+static uint32_t s_tx_timeouts = 0;      // ARP/发送超时（目的主机不可达）
+static uint32_t s_rx_cmds = 0;
+static uint32_t s_rx_bad = 0;
+static uint32_t s_spi_errors = 0;
+static volatile uint8_t s_phycfgr = 0;  // PHYCFGR 缓存：命令行在遥测任务中打印，不访问 SPI1
+
+// ========================
+// W5500 寄存器访问
+// ========================
+
+// 一次片选：buf 前 3 字节由此填写，其后 len 字节为数据（读操作时原地接收）；
+// 阻塞到传输结束（SPI1 的 PDMA 搬运只省去逐字节中断，不与调用方并行）
+static bool net_xfer(uint8_t *buf, uint32_t addrbsb, uint8_t rw, uint16_t len)
+{
+	buf[0] = (uint8_t)(addrbsb >> 16);
+	buf[1] = (uint8_t)(addrbsb >> 8);
+	buf[2] = (uint8_t)((addrbsb & 0xF8U) | rw);
+	if (SPI_DRV_MasterTransferBlocking(INST_SPI_1, buf, (rw == NET_SPI_READ) ? buf : NULL,
+	                                   (uint16_t)(NET_SPI_HDR + len), NET_SPI_TIMEOUT_MS) != STATUS_SUCCESS) {
+		s_spi_errors++;
+		return false;
+	}
+	return true;
+}
+
+static bool net_write(uint32_t addrbsb, const void *data, uint8_t len)
+{
+	uint8_t buf[NET_SPI_HDR + NET_REG_MAX];
+	memcpy(&buf[NET_SPI_HDR], data, len);
+	return net_xfer(buf, addrbsb, NET_SPI_WRITE, len);
+}
+
+static bool net_read(uint32_t addrbsb, void *data, uint8_t len)
+{
+	uint8_t buf[NET_SPI_HDR + NET_REG_MAX];
+	if (!net_xfer(buf, addrbsb, NET_SPI_READ, len)) {
+		return false;
+	}
+	memcpy(data, &buf[NET_SPI_HDR], len);
+	return true;
+}
+
+static bool net_write8(uint32_t addrbsb, uint8_t v)
+{
+	return net_write(addrbsb, &v, 1U);
+}
+
+static bool net_read8(uint32_t addrbsb, uint8_t *v)
+{
+	return net_read(addrbsb, v, 1U);
+}
+
+// 16 位计数寄存器（大端）：芯片可能在两字节之间更新，连续两次读数一致才采用
+static bool net_read16(uint32_t addrbsb, uint16_t *v)
+{
+	uint8_t a[2];
+	uint8_t b[2];
+	if (!net_read(addrbsb, a, 2U)) {
+		return false;
+	}
+	for (uint8_t i = 0; i < NET_CMD_POLLS; ++i) {
+		if (!net_read(addrbsb, b, 2U)) {
+			return false;
+		}
+		if (a[0] == b[0] && a[1] == b[1]) {
+			*v = (uint16_t)((b[0] << 8) | b[1]);
+			return true;
+		}
+		a[0] = b[0];
+		a[1] = b[1];
+	}
+	return false;
+}
+
+// 套接字命令：芯片接受后 Sn_CR 自动清零
+static bool net_command(uint8_t cmd)
+{
+	if (!net_write8(Sn_CR(NET_SOCK), cmd)) {
+		return false;
+	}
+	for (uint8_t i = 0; i < NET_CMD_POLLS; ++i) {
+		uint8_t cr;
+		if (!net_read8(Sn_CR(NET_SOCK), &cr)) {
+			return false;
+		}
+		if (cr == 0U) {
+			return true;
+		}
+	}
+	return false;
+}
+
+// ========================
+// 发送
+// ========================
+
+// 上一帧发送完成（或超时）后才能写入下一帧；最多读 polls 次 Sn_IR
+static bool net_tx_ready(uint8_t polls)
+{
+	for (uint8_t i = 0; s_send_pending && i < polls; ++i) {
+		uint8_t ir;
+		if (!net_read8(Sn_IR(NET_SOCK), &ir)) {
+			return false;
+		}
+		uint8_t done = ir & (Sn_IR_SEND_OK | Sn_IR_TIMEOUT);
+		if (done != 0U) {
+			if ((done & Sn_IR_TIMEOUT) != 0U) {
+				s_tx_timeouts++;
+			}
+			(void)net_write8(Sn_IR(NET_SOCK), done);
+			s_send_pending = false;
+		}
+	}
+	return !s_send_pending;
+}
+
+static bool net_set_dest(const uint8_t ip[4], uint16_t port)
+{
+	if (s_dst_valid && s_dst_port == port && memcmp(s_dst_ip, ip, 4U) == 0) {
+		return true;
+	}
+	// Sn_DIPR0~3 与 Sn_DPORT0~1 地址连续，一次写入
+	const uint8_t d[6] = { ip[0], ip[1], ip[2], ip[3], (uint8_t)(port >> 8), (uint8_t)port };
+	s_dst_valid = net_write(Sn_DIPR0(NET_SOCK), d, sizeof(d));
+	if (s_dst_valid) {
+		memcpy(s_dst_ip, ip, 4U);
+		s_dst_port = port;
+	}
+	return s_dst_valid;
+}
+
+// 发送 s_frame 中已组好的负载（len 字节）；报文头在此填写
+static bool net_send(const uint8_t ip[4], uint16_t port, uint8_t type, uint16_t seq, uint16_t len, uint8_t polls)
+{
+	if (!net_tx_ready(polls) || !net_set_dest(ip, port)) {
+		return false;
+	}
+	s_frame.hdr.magic = NET_TELEM_MAGIC;
+	s_frame.hdr.version = NET_TELEM_VERSION;
+	s_frame.hdr.type = type;
+	s_frame.hdr.seq = seq;
+	s_frame.hdr.len = len;
+	uint16_t n = (uint16_t)(sizeof(net_telem_hdr_t) + len);
+	if (!net_xfer(s_frame.spi, NET_TXBUF(s_tx_wr), NET_SPI_WRITE, n)) {
+		return false;
+	}
+	uint16_t next = (uint16_t)(s_tx_wr + n);
+	const uint8_t wr[2] = { (uint8_t)(next >> 8), (uint8_t)next };
+	if (!net_write(Sn_TX_WR0(NET_SOCK), wr, 2U)) {
+		return false;
+	}
+	s_tx_wr = next;
+	if (!net_command(Sn_CR_SEND)) {
+		return false;
+	}
+	s_send_pending = true;
+	return true;
+}
+
+// 四舍五入并饱和到 int16
+static int16_t net_q16(float32_t v, float32_t scale)
+{
+	float32_t s = v * scale;
+	if (s >= 32767.0f) return 32767;
+	if (s <= -32767.0f) return -32767;
+	return (int16_t)((s >= 0.0f) ? (s + 0.5f) : (s - 0.5f));
+}
+
+static void net_publish_rec(const flight_rec_t *rec)
+{
+	net_telem_rec_t *f = &s_frame.body.rec;
+	pose2d_t pose;
+	Pose_Get(&pose);
+	float cm = HCSR04_GetCachedDistance();
+	f->rec = *rec;
+	f->x_dmm = (int32_t)(pose.x_mm * 10.0f);
+	f->y_dmm = (int32_t)(pose.y_mm * 10.0f);
+	f->theta_cdeg = net_q16(pose.theta_deg, 100.0f);
+	f->speed_mms = net_q16(Odom_GetSpeedMmS(), 1.0f);
+	f->range_mm = (cm >= 0.0f) ? (uint16_t)(cm * 10.0f) : 0xFFFFU;
+	f->status = (uint8_t)Mission_GetStatus();
+	f->drops = (uint8_t)s_tx_drops;
+	// 序号不论是否发出都递增，主机据缺口统计丢帧
+	if (net_send(s_peer_ip, s_peer_port, NET_TELEM_T_REC, s_tx_seq, sizeof(*f), 1U)) {
+		s_tx_frames++;
+	} else {
+		s_tx_drops++;
+	}
+	s_tx_seq++;
+}
+
+// ========================
+// 命令
+// ========================
+
+static uint8_t net_param(bool set, net_telem_ack_t *ack)
+{
+	s_rx.param.name[NET_TELEM_NAME_MAX - 1U] = '\0';
+	memcpy(ack->name, s_rx.param.name, NET_TELEM_NAME_MAX);
+	const param_desc_t *p = Shell_FindParam(s_rx.param.name);
+	if (p == NULL) {
+		return NET_TELEM_ERR_UNKNOWN;
+	}
+	ack->min = p->min;
+	ack->max = p->max;
+	uint8_t result = NET_TELEM_OK;
+	if (set) {
+		float v = s_rx.param.value;
+		// NaN 比较均为假，同样拒绝
+		if (v >= p->min && v <= p->max) {
+			// 与命令行相同：单个 float 写入为原子操作，下一控制周期生效
+			*p->value = v;
+		} else {
+			result = NET_TELEM_ERR_RANGE;
+		}
+	}
+	ack->value = *p->value;
+	return result;
+}
+
+static void net_handle(const uint8_t ip[4], uint16_t port, uint16_t len)
+{
+	const net_telem_hdr_t *h = &s_rx.hdr;
+	if (len < sizeof(*h) || h->magic != NET_TELEM_MAGIC || h->version != NET_TELEM_VERSION ||
+	    h->len != len - sizeof(*h)) {
+		s_rx_bad++;
+		return;
+	}
+	net_telem_ack_t *ack = &s_frame.body.ack;
+	memset(ack, 0, sizeof(*ack));
+	ack->cmd = h->type;
+	switch (h->type) {
+	case NET_TELEM_T_HELLO:
+		if (!s_peer_valid || s_peer_port != port || memcmp(s_peer_ip, ip, 4U) != 0) {
+			printf("[net] 遥测订阅 %d.%d.%d.%d:%u\r\n", ip[0], ip[1], ip[2], ip[3], port);
+		}
+		memcpy(s_peer_ip, ip, 4U);
+		s_peer_port = port;
+		s_peer_valid = true;
+		s_peer_seen_ms = board_time_ms();
+		break;
+	case NET_TELEM_T_BYE:
+		s_peer_valid = false;
+		break;
+	case NET_TELEM_T_GET:
+	case NET_TELEM_T_SET:
+		ack->result = (h->len == sizeof(net_telem_param_t)) ? net_param(h->type == NET_TELEM_T_SET, ack)
+		                                                     : NET_TELEM_ERR_FORMAT;
+		break;
+	default:
+		ack->result = NET_TELEM_ERR_FORMAT;
+		break;
+	}
+	s_rx_cmds++;
+	// 应答可稍等上一帧发完；仍未完成时放弃，由主机超时重发
+	(void)net_send(ip, port, NET_TELEM_T_ACK, h->seq, sizeof(*ack), NET_ACK_POLLS);
+}
+
+static void net_poll_rx(void)
+{
+	for (uint8_t n = 0; n < NET_TELEM_RX_PER_POLL; ++n) {
+		uint16_t rsr;
+		uint16_t rd;
+		uint8_t info[NET_UDP_INFO];
+		if (!net_read16(Sn_RX_RSR0(NET_SOCK), &rsr) || rsr < NET_UDP_INFO ||
+		    !net_read16(Sn_RX_RD0(NET_SOCK), &rd) || !net_read(NET_RXBUF(rd), info, NET_UDP_INFO)) {
+			return;
+		}
+		uint16_t port = (uint16_t)((info[4] << 8) | info[5]);
+		uint16_t len = (uint16_t)((info[6] << 8) | info[7]);
+		// 超长数据报只读入报文头与命令负载，其余直接跳过
+		uint16_t take = len;
+		if (take > sizeof(net_telem_hdr_t) + sizeof(net_telem_param_t)) {
+			take = sizeof(net_telem_hdr_t) + sizeof(net_telem_param_t);
+		}
+		memset(&s_rx.hdr, 0, sizeof(s_rx.hdr));
+		if (take > 0U && !net_xfer(s_rx.spi, NET_RXBUF(rd + NET_UDP_INFO), NET_SPI_READ, take)) {
+			return;
+		}
+		rd = (uint16_t)(rd + NET_UDP_INFO + len);
+		const uint8_t rdb[2] = { (uint8_t)(rd >> 8), (uint8_t)rd };
+		if (!net_write(Sn_RX_RD0(NET_SOCK), rdb, 2U) || !net_command(Sn_CR_RECV)) {
+			return;
+		}
+		net_handle(info, port, len);
+	}
+}
+
+static void net_check_peer(void)
+{
+	if (s_peer_valid && board_time_ms() - s_peer_seen_ms > NET_TELEM_PEER_TIMEOUT_MS) {
+		s_peer_valid = false;
+		printf("[net] 订阅超时，停止发送\r\n");
+	}
+}
+
+// ========================
+// 接口
+// ========================
+
+bool NetTelem_Init(void)
+{
+	s_ready = false;
+	if (SPI_DRV_MasterInit(INST_SPI_1, &g_stSpiState_1, &g_stSpi1MasterConfig0) != STATUS_SUCCESS) {
+		printf("[net] SPI1 初始化失败\r\n");
+		return false;
+	}
+	// RSTn 上电保持低电平，此处给出完整复位脉冲后释放
+	PINS_DRV_WritePin(PORTC, 22, 0);
+	board_delay_us(NET_RESET_LOW_US);
+	PINS_DRV_WritePin(PORTC, 22, 1);
+	uint8_t ver = 0;
+	for (uint32_t t = 0; t < NET_RESET_WAIT_MS && ver != NET_CHIP_VERSION; ++t) {
+		simple_delay_ms(1);
+		if (!net_read8(VERSIONR, &ver)) {
+			ver = 0;
+		}
+	}
+	if (ver != NET_CHIP_VERSION) {
+		printf("[net] 未检测到 W5500（VERSIONR=0x%02X），以太网遥测停用\r\n", ver);
+		return false;
+	}
+
+	// GAR(4) + SUBR(4) + SHAR(6) + SIPR(4) 地址连续，一次写入
+	static const uint8_t s_gw[4] = NET_TELEM_GATEWAY;
+	static const uint8_t s_mask[4] = NET_TELEM_NETMASK;
+	static const uint8_t s_mac[6] = NET_TELEM_MAC;
+	static const uint8_t s_ip[4] = NET_TELEM_IP;
+	uint8_t addr[NET_REG_MAX];
+	memcpy(&addr[0], s_gw, 4U);
+	memcpy(&addr[4], s_mask, 4U);
+	memcpy(&addr[8], s_mac, 6U);
+	memcpy(&addr[14], s_ip, 4U);
+	const uint8_t rtr[2] = { (uint8_t)(NET_RETRY_100US >> 8), (uint8_t)NET_RETRY_100US };
+	const uint8_t port[2] = { (uint8_t)(NET_TELEM_PORT >> 8), (uint8_t)NET_TELEM_PORT };
+	uint8_t sr = 0;
+	bool ok = net_write(GAR0, addr, NET_REG_MAX) &&
+	          net_write(RTR0, rtr, 2U) && net_write8(WIZ_RCR, NET_RETRY_COUNT) &&
+	          net_write8(Sn_MR(NET_SOCK), Sn_MR_UDP) && net_write(Sn_PORT0(NET_SOCK), port, 2U) &&
+	          net_command(Sn_CR_OPEN) && net_read8(Sn_SR(NET_SOCK), &sr) && sr == SOCK_UDP &&
+	          net_read16(Sn_TX_WR0(NET_SOCK), &s_tx_wr);
+	if (!ok) {
+		printf("[net] UDP 套接字打开失败（SR=0x%02X）\r\n", sr);
+		return false;
+	}
+	s_send_pending = false;
+	s_dst_valid = false;
+	s_peer_valid = false;
+	s_ready = true;
+	printf("[net] W5500 就绪 %d.%d.%d.%d:%u\r\n", s_ip[0], s_ip[1], s_ip[2], s_ip[3], NET_TELEM_PORT);
+	return true;
+}
+
+bool NetTelem_IsReady(void)
+{
+	return s_ready;
+}
+
+void NetTelem_Publish(const flight_rec_t *rec)
+{
+	if (!s_ready) {
+		return;
+	}
+	net_check_peer();
+	if (s_peer_valid) {
+		net_publish_rec(rec);
+	}
+	net_poll_rx();
+}
+
+void NetTelem_Poll(void)
+{
+	if (!s_ready) {
+		return;
+	}
+	net_check_peer();
+	net_poll_rx();
+	uint8_t phy;
+	if (net_read8(PHYCFGR, &phy)) {
+		s_phycfgr = phy;
+	}
+}
+
+void NetTelem_Print(void)
+{
+	if (!s_ready) {
+		printf("[net] 未就绪\r\n");
+		return;
+	}
+	uint8_t phy = s_phycfgr;
+	// PHYCFGR（控制上下文中 NetTelem_Poll 读取）：bit0 链路，bit1 100M，bit2 全双工
+	printf("[net] link=%s%s port=%u peer=", (phy & 0x01U) ? "up" : "down",
+	       (phy & 0x01U) ? ((phy & 0x02U) ? " 100M" : " 10M") : "", NET_TELEM_PORT);
+	if (s_peer_valid) {
+		printf("%d.%d.%d.%d:%u\r\n", s_peer_ip[0], s_peer_ip[1], s_peer_ip[2], s_peer_ip[3], s_peer_port);
+	} else {
+		printf("无\r\n");
+	}
+	printf("[net] tx=%lu drop=%lu timeout=%lu cmd=%lu bad=%lu spi_err=%lu\r\n", (unsigned long)s_tx_frames,
+	       (unsigned long)s_tx_drops, (unsigned long)s_tx_timeouts, (unsigned long)s_rx_cmds,
+	       (unsigned long)s_rx_bad, (unsigned long)s_spi_errors);
+}
@@ -0,0 +1,122 @@
+/**
+ * @file net_telem.h
+ * @author 林木@江南大学
+ * @brief W5500 以太网（SPI1）UDP 遥测与命令通道
+ * @details 串口（UART2，115200）有效带宽约 11 KB/s，日志与遥测共用时只能抽样输出；
+ *          以太网通道每个控制周期发送一帧二进制遥测（飞行记录 + 位姿/速度/测距），不抽样。
+ *          - 发送：帧在 SPI 传输缓冲中就地组装（前 3 字节留给 W5500 地址/控制段），
+ *            一次阻塞 SPI 传输直接写入 W5500 套接字发送缓冲，不经 SDK socket 层的中间拷贝
+ *            （SPI1 配置为 PDMA 搬运，但调用方等待传输结束，20 MHz 下一帧约 25 µs）；
+ *            上一帧未发送完成（SEND_OK）时丢弃本帧并计数，控制周期不等待
+ *          - 命令：主机发送 HELLO 订阅（发送方地址成为遥测目的地址，超时未续订则停止发送），
+ *            GET/SET 按名称读写命令行同一参数表，逐条应答
+ *          收发都在控制任务（裸机为主循环）中进行，SPI1 与 W5500 寄存器无需加锁；
+ *          参数修改在两个控制周期之间生效。未检测到 W5500 时通道停用，其余接口为空操作。
+ *          主机端工具 tools/net_telem.py
+ */
+
+#ifndef __NET_TELEM_H__
+#define __NET_TELEM_H__
+
+#include "flight_rec.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 网络配置（静态地址；与主机同网段）
+#define NET_TELEM_IP               { 192, 168, 1, 88 }
+#define NET_TELEM_NETMASK          { 255, 255, 255, 0 }
+#define NET_TELEM_GATEWAY          { 192, 168, 1, 1 }
+#define NET_TELEM_MAC              { 0x00, 0x08, 0xDC, 0x11, 0x11, 0x11 }  // 同一网段多台时需各不相同
+#define NET_TELEM_PORT             5000U   // 本机 UDP 端口（遥测与命令共用）
+
+#define NET_TELEM_PEER_TIMEOUT_MS  5000U   // 订阅有效期（主机每秒续订一次 HELLO）
+#define NET_TELEM_RX_PER_POLL      2U      // 每次轮询最多处理的命令数
+
+// 报文（小端）：8 字节报文头 + 负载
+#define NET_TELEM_MAGIC            0x544EU // "NT"
+#define NET_TELEM_VERSION          1U
+#define NET_TELEM_NAME_MAX         20U     // 参数名（含结尾 0）
+
+typedef enum {
+    NET_TELEM_T_REC   = 0x01,   // 设备 -> 主机：控制周期帧（net_telem_rec_t）
+    NET_TELEM_T_HELLO = 0x10,   // 主机 -> 设备：订阅/续订遥测（无负载）
+    NET_TELEM_T_BYE   = 0x11,   // 取消订阅（无负载）
+    NET_TELEM_T_GET   = 0x12,   // 读参数（net_telem_param_t，value 忽略）
+    NET_TELEM_T_SET   = 0x13,   // 写参数（net_telem_param_t）
+    NET_TELEM_T_ACK   = 0x80    // 设备 -> 主机：应答（net_telem_ack_t）
+} net_telem_type_t;
+
+typedef enum {
+    NET_TELEM_OK = 0,
+    NET_TELEM_ERR_UNKNOWN,      // 未知参数
+    NET_TELEM_ERR_RANGE,        // 取值超出范围
+    NET_TELEM_ERR_FORMAT        // 报文类型/长度无效
+} net_telem_result_t;
+
+typedef struct {
+    uint16_t magic;         // NET_TELEM_MAGIC
+    uint8_t version;        // NET_TELEM_VERSION
+    uint8_t type;           // net_telem_type_t
+    uint16_t seq;           // 设备帧：发送序号；应答：回显命令序号
+    uint16_t len;           // 负载字节数
+} net_telem_hdr_t;
+
+// 控制周期帧负载：飞行记录 + 记录中没有的位姿/速度/测距
+typedef struct {
+    flight_rec_t rec;
+    int32_t x_dmm;          // 位姿 x（0.1 mm）
+    int32_t y_dmm;          // 位姿 y（0.1 mm）
+    int16_t theta_cdeg;     // 位姿航向（0.01°）
+    int16_t speed_mms;      // 里程计速度（mm/s）
+    uint16_t range_mm;      // 超声波缓存距离（无有效数据 0xFFFF）
+    uint8_t status;         // mission_status_t
+    uint8_t drops;          // 累计丢帧数（低 8 位）
+} net_telem_rec_t;
+
+typedef struct {
+    char name[NET_TELEM_NAME_MAX];
+    float value;
+} net_telem_param_t;
+
+typedef struct {
+    uint8_t cmd;            // 被应答的命令类型
+    uint8_t result;         // net_telem_result_t
+    uint16_t reserved;
+    char name[NET_TELEM_NAME_MAX];
+    float value;            // GET/SET：当前值
+    float min;
+    float max;
+} net_telem_ack_t;
+
+/**
+ * @brief 初始化 SPI1 并复位 W5500，配置地址并打开 UDP 套接字
+ * @return 检测到 W5500 返回 true；否则通道停用，其余接口为空操作
+ */
+bool NetTelem_Init(void);
+bool NetTelem_IsReady(void);
+
+/**
+ * @brief 控制周期调用（Mission_Step 写入飞行记录之后）：处理命令，已订阅时发送一帧
+ * @param rec 本周期飞行记录
+ */
+void NetTelem_Publish(const flight_rec_t *rec);
+
+/**
+ * @brief 任务未运行时调用（与 NetTelem_Publish 同一执行上下文）：处理命令
+ */
+void NetTelem_Poll(void);
+
+/**
+ * @brief 打印地址、链路、订阅方与收发计数
+ */
+void NetTelem_Print(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __NET_TELEM_H__
@@ -0,0 +1,62 @@
+/**
+ * @file nvm_store.c
+ * @author 林木@江南大学
+ * @brief 非易失存储实现 - FMC 模拟 EEPROM + 硬件 CRC
+ */
+
+#include "nvm_store.h"
+#include "fmc_eeprom_driver.h"
+#include "crc_driver.h"
+#include <stdio.h>
+
+#define INST_CRC_0  (0U)
+
+// 标准 CRC-32：写入按位反射、读出按位与字节反射并取反
+static const crc_user_config_t s_crc32_config = {
+	.crcWidth           = CRC_BITS_32,
+	.polynomial         = 0x04C11DB7UL,
+	.readTranspose      = CRC_TRANSPOSE_BITS_AND_BYTES,
+	.writeTranspose     = CRC_TRANSPOSE_BITS,
+	.complementChecksum = true,
+	.seed               = 0xFFFFFFFFUL,
+};
+
+static bool s_nvm_ready = false;
+
+bool NVM_Init(void)
+{
+	FMC_DRV_EepromInit();
+	CRC_DRV_Init(INST_CRC_0, &s_crc32_config);
+	// 以一次读操作探测 EEPROM 是否在 NVR 中使能
+	uint8_t probe;
+	s_nvm_ready = (FMC_DRV_EepromRead(0U, &probe, 1U) == STATUS_SUCCESS);
+	if (!s_nvm_ready) {
+		printf("NVM: EEPROM 未使能，参数与任务将使用固件默认值\r\n");
+	}
+	return s_nvm_ready;
+}
+
+bool NVM_IsReady(void)
+{
+	return s_nvm_ready;
+}
+
+bool NVM_Read(uint32_t addr, void *data, uint32_t size)
+{
+	if (!s_nvm_ready) return false;
+	return FMC_DRV_EepromRead(addr, data, size) == STATUS_SUCCESS;
+}
+
+bool NVM_Write(uint32_t addr, const void *data, uint32_t size)
+{
+	if (!s_nvm_ready) return false;
+	return FMC_DRV_EepromWrite(addr, (void *)data, size) == STATUS_SUCCESS;
+}
+
+uint32_t NVM_Crc32(const void *data, uint32_t size)
+{
+	// 重新配置以装载初值，开始新的计算
+	CRC_DRV_Configure(INST_CRC_0, &s_crc32_config);
+	CRC_DRV_WriteData8(INST_CRC_0, (const uint8_t *)data, size);
+	return CRC_DRV_GetCrcResult(INST_CRC_0);
+}
@@ -0,0 +1,39 @@
+/**
+ * @file nvm_store.h
+ * @author 林木@江南大学
+ * @brief 非易失存储接口 - FMC 模拟 EEPROM + 硬件 CRC
+ * @details 统一管理 EEPROM 地址分区与 CRC-32 校验；EEPROM 由 NVRAM 映射，读取为内存拷贝，
+ *          写入时驱动只回写内容变化的 6 字节数据块到 dflash，不需要整扇区擦写
+ */
+
+#ifndef __NVM_STORE_H__
+#define __NVM_STORE_H__
+
+#include "RISCV_Typedefs.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// EEPROM 分区（地址范围 0x000-0xFFF，实际容量由 NVR 配置）
+#define NVM_MISSION_ADDR      0x0000U  // 任务槽区
+#define NVM_MISSION_SLOT_SIZE 0x0400U  // 每个任务槽 1KiB
+#define NVM_MISSION_SLOTS     2U
+#define NVM_CALIB_ADDR        0x0800U  // 标定记录区
+#define NVM_CALIB_SIZE        0x0400U
+
+// 初始化 EEPROM 模拟与 CRC 模块，返回 EEPROM 是否可用
+bool NVM_Init(void);
+bool NVM_IsReady(void);
+bool NVM_Read(uint32_t addr, void *data, uint32_t size);
+bool NVM_Write(uint32_t addr, const void *data, uint32_t size);
+// 标准 CRC-32（多项式 0x04C11DB7，输入/输出反射，初值与结果取反，与 zlib.crc32 一致）
+uint32_t NVM_Crc32(const void *data, uint32_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __NVM_STORE_H__
@@ -0,0 +1,140 @@
+/**
+ * @file odometry.c
+ * @author 林木@江南大学
+ * @brief 轮式里程计实现 - 基于前轮正交编码器
+ * @details 电机2（右前）、电机3（左前）带编码器，后轮开环无反馈；
+ *          以左右轮增量均值作为车体位移；单侧打滑时取较小一侧，单侧无计数（卡死/丢数）时只用另一侧
+ */
+
+#include "odometry.h"
+#include "dc_motor_control.h"
+#include <math.h>
+
+// 每个编码器计数对应的轮缘位移（mm）
+#define ODOM_MM_PER_COUNT  (3.14159265f * ODOM_WHEEL_DIAMETER_MM / (float32_t)ENCODER_COUNTS_PER_REV)
+
+static uint16_t s_last_cnt_right = 0;
+static uint16_t s_last_cnt_left = 0;
+static float32_t s_distance_mm = 0.0f;
+static float32_t s_speed_mm_s = 0.0f;
+static float32_t s_last_dl_mm = 0.0f;
+static float32_t s_last_dr_mm = 0.0f;
+static float32_t s_last_ds_mm = 0.0f;
+static bool s_odom_inited = false;
+
+// 内环采样状态（与 Odom_Update 独立）
+static uint16_t s_wheel_last_right = 0;
+static uint16_t s_wheel_last_left = 0;
+static volatile float32_t s_wheel_speed_right = 0.0f;
+static volatile float32_t s_wheel_speed_left = 0.0f;
+
+// 16 位计数器回绕安全的有符号增量
+static int32_t odom_count_delta(uint16_t now, uint16_t last)
+{
+	return (int32_t)(int16_t)(uint16_t)(now - last);
+}
+
+void Odom_Init(void)
+{
+	DCMotor_InitEncoders();
+	DCMotor_UpdateEncoderCounts();
+	s_last_cnt_right = g_au16EncoderCounts[1];
+	s_last_cnt_left = g_au16EncoderCounts[2];
+	s_wheel_last_right = s_last_cnt_right;
+	s_wheel_last_left = s_last_cnt_left;
+	Odom_Reset();
+	s_odom_inited = true;
+}
+
+void Odom_Reset(void)
+{
+	s_distance_mm = 0.0f;
+	s_speed_mm_s = 0.0f;
+	s_last_dl_mm = 0.0f;
+	s_last_dr_mm = 0.0f;
+	s_last_ds_mm = 0.0f;
+}
+
+void Odom_Update(uint32_t dt_ms)
+{
+	if (!s_odom_inited) return;
+	DCMotor_UpdateEncoderCounts();
+	uint16_t cnt_right = g_au16EncoderCounts[1];
+	uint16_t cnt_left = g_au16EncoderCounts[2];
+	int32_t dcr = odom_count_delta(cnt_right, s_last_cnt_right) * ODOM_RIGHT_SIGN;
+	int32_t dcl = odom_count_delta(cnt_left, s_last_cnt_left) * ODOM_LEFT_SIGN;
+	s_last_cnt_right = cnt_right;
+	s_last_cnt_left = cnt_left;
+
+	float32_t dr = (float32_t)dcr * ODOM_MM_PER_COUNT;
+	float32_t dl = (float32_t)dcl * ODOM_MM_PER_COUNT;
+	s_last_dl_mm = dl;
+	s_last_dr_mm = dr;
+
+	// 融合：同向时取均值；一侧增量远大于另一侧（打滑）时取较小者，避免里程虚增；
+	// 一侧无计数而另一侧有（编码器卡死/丢数）时排除该侧，只用另一侧
+	float32_t ad = fabsf(dl);
+	float32_t bd = fabsf(dr);
+	float32_t ds;
+	if (ad == 0.0f || bd == 0.0f) {
+		ds = dl + dr;
+	} else if (ad > bd * ODOM_SLIP_RATIO || bd > ad * ODOM_SLIP_RATIO) {
+		ds = (ad < bd) ? dl : dr;
+	} else {
+		ds = 0.5f * (dl + dr);
+	}
+	s_distance_mm += ds;
+	s_last_ds_mm = ds;
+
+	if (dt_ms > 0U) {
+		float32_t v = ds * 1000.0f / (float32_t)dt_ms;
+		s_speed_mm_s = (1.0f - ODOM_SPEED_EMA_ALPHA) * s_speed_mm_s + ODOM_SPEED_EMA_ALPHA * v;
+	}
+}
+
+float32_t Odom_GetDistanceMm(void)
+{
+	return s_distance_mm;
+}
+
+float32_t Odom_GetSpeedMmS(void)
+{
+	return s_speed_mm_s;
+}
+
+float32_t Odom_GetLastDeltaMm(void)
+{
+	return s_last_ds_mm;
+}
+
+void Odom_GetLastWheelDeltaMm(float32_t *left_mm, float32_t *right_mm)
+{
+	if (left_mm)  *left_mm  = s_last_dl_mm;
+	if (right_mm) *right_mm = s_last_dr_mm;
+}
+
+void Odom_SampleWheels(uint32_t dt_us)
+{
+	if (!s_odom_inited || dt_us == 0U) return;
+	// 只读计数寄存器，不改动 g_au16EncoderCounts，避免与控制任务中的 Odom_Update 互相干扰
+	uint16_t cnt_right = SUPERTMR_DRV_QuadGetState(MOTOR2_ENCODER_INSTANCE).counter;
+	uint16_t cnt_left = SUPERTMR_DRV_QuadGetState(MOTOR3_ENCODER_INSTANCE).counter;
+	int32_t dcr = odom_count_delta(cnt_right, s_wheel_last_right) * ODOM_RIGHT_SIGN;
+	int32_t dcl = odom_count_delta(cnt_left, s_wheel_last_left) * ODOM_LEFT_SIGN;
+	s_wheel_last_right = cnt_right;
+	s_wheel_last_left = cnt_left;
+
+	// 单次采样只有几个计数，速度由一阶低通平滑：alpha = dt / (tau + dt)
+	float32_t dt_s = (float32_t)dt_us * 1e-6f;
+	float32_t alpha = dt_s / (ODOM_WHEEL_SPEED_TAU_MS * 1e-3f + dt_s);
+	float32_t vr = (float32_t)dcr * ODOM_MM_PER_COUNT / dt_s;
+	float32_t vl = (float32_t)dcl * ODOM_MM_PER_COUNT / dt_s;
+	s_wheel_speed_right += alpha * (vr - s_wheel_speed_right);
+	s_wheel_speed_left += alpha * (vl - s_wheel_speed_left);
+}
+
+void Odom_GetWheelSpeedMmS(float32_t *left_mm_s, float32_t *right_mm_s)
+{
+	if (left_mm_s)  *left_mm_s  = s_wheel_speed_left;
+	if (right_mm_s) *right_mm_s = s_wheel_speed_right;
+}
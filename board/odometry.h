@@ -0,0 +1,53 @@
+/**
+ * @file odometry.h
+ * @author 林木@江南大学
+ * @brief 轮式里程计接口 - 基于前轮正交编码器
+ * @details 融合左前/右前轮编码器增量，提供行驶距离、速度与左右轮增量
+ */
+
+#ifndef __ODOMETRY_H__
+#define __ODOMETRY_H__
+
+#include "RISCV_Typedefs.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 轮子与编码器参数（按机型调整）
+#define ODOM_WHEEL_DIAMETER_MM   65.0f   // 麦克纳姆轮直径（mm）
+#define ODOM_RIGHT_SIGN          (+1)    // 右前轮（电机2）编码器计数方向：前进为正时取 +1
+#define ODOM_LEFT_SIGN           (-1)    // 左前轮（电机3）编码器计数方向
+#define ODOM_SLIP_RATIO          2.5f    // 左右轮增量比超过该值视为单侧打滑/丢数
+#define ODOM_SPEED_EMA_ALPHA     0.35f   // 速度低通系数
+#define ODOM_WHEEL_SPEED_TAU_MS  10.0f   // 车轮速度（内环采样）低通时间常数（ms）
+
+// 初始化编码器并清零里程
+void Odom_Init(void);
+// 清零累计里程（不影响编码器硬件计数）
+void Odom_Reset(void);
+// 读取编码器并更新里程，dt_ms 为距上次调用的时间（用于速度估计）
+void Odom_Update(uint32_t dt_ms);
+
+// 累计行驶距离（mm，前进为正，融合左右轮）
+float32_t Odom_GetDistanceMm(void);
+// 车体线速度估计（mm/s，低通后）
+float32_t Odom_GetSpeedMmS(void);
+// 最近一次 Odom_Update 的车体前进增量（mm，融合后）
+float32_t Odom_GetLastDeltaMm(void);
+// 最近一次 Odom_Update 的左右轮增量（mm）
+void Odom_GetLastWheelDeltaMm(float32_t *left_mm, float32_t *right_mm);
+
+// 车轮速度内环采样：直接读编码器更新左右轮速度，dt_us 为采样周期；
+// 与 Odom_Update 各自记录上次计数，可在更高优先级的高频任务中调用
+void Odom_SampleWheels(uint32_t dt_us);
+// 左右轮速度（mm/s，按 ODOM_WHEEL_SPEED_TAU_MS 低通），前轮速度内环的反馈
+void Odom_GetWheelSpeedMmS(float32_t *left_mm_s, float32_t *right_mm_s);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __ODOMETRY_H__
@@ -0,0 +1,29 @@
+/**
+ * @file param.h
+ * @author 林木@江南大学
+ * @brief 运行时可调参数描述
+ * @details 各模块以静态表导出可调参数（名称、变量地址、取值范围），命令行按名称读写
+ */
+
+#ifndef __PARAM_H__
+#define __PARAM_H__
+
+#include "RISCV_Typedefs.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    const char *name;
+    float32_t *value;
+    float32_t min;
+    float32_t max;
+} param_desc_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __PARAM_H__
@@ -0,0 +1,190 @@
+/**
+ * @file path_follower.c
+ * @author 林木@江南大学
+ * @brief 航点路径跟踪实现 - 纯追踪（Pure Pursuit）
+ * @details 载入时预计算各段长度、方向与拐点限速（O(n) 一次）；运行时每周期 O(1)：
+ *          投影到当前段求横向偏差与剩余路程，前视点沿路径前推最多跨两段，
+ *          曲率 κ = 2·y_L / L²（y_L 为前视点在车体系中的横向坐标）
+ */
+
+#include "path_follower.h"
+#include "my_move.h"
+#include <math.h>
+
+#define PF_DEG2RAD  0.017453293f
+#define PF_RAD2DEG  57.29578f
+
+static path_waypoint_t s_wps[PATH_MAX_WAYPOINTS];
+static float32_t s_seg_len[PATH_MAX_WAYPOINTS];     // 段 i：wps[i] -> wps[i+1]
+static float32_t s_seg_ux[PATH_MAX_WAYPOINTS];
+static float32_t s_seg_uy[PATH_MAX_WAYPOINTS];
+static float32_t s_len_after[PATH_MAX_WAYPOINTS];   // 段 i 之后（不含段 i）的剩余总长
+static float32_t s_corner_v[PATH_MAX_WAYPOINTS];    // 航点 i 处的限速（mm/s），终点为 0
+static uint8_t s_count = 0;
+static uint8_t s_seg = 0;
+static float32_t s_lookahead = 150.0f;
+static float32_t s_ox = 0.0f, s_oy = 0.0f, s_oth = 0.0f, s_oc = 1.0f, s_os = 0.0f;
+
+bool PathFollower_Start(const path_waypoint_t *wps, uint8_t count, float32_t lookahead_mm,
+                        float32_t origin_x_mm, float32_t origin_y_mm, float32_t origin_theta_deg)
+{
+	if (!wps || count < 2U || count > PATH_MAX_WAYPOINTS) {
+		s_count = 0;
+		return false;
+	}
+	s_count = count;
+	s_seg = 0;
+	s_lookahead = (lookahead_mm < 30.0f) ? 30.0f : lookahead_mm;
+	s_ox = origin_x_mm;
+	s_oy = origin_y_mm;
+	s_oth = origin_theta_deg * PF_DEG2RAD;
+	s_oc = cosf(s_oth);
+	s_os = sinf(s_oth);
+
+	for (uint8_t i = 0; i < count; ++i) {
+		s_wps[i] = wps[i];
+	}
+	for (uint8_t i = 0; i + 1U < count; ++i) {
+		float32_t dx = s_wps[i + 1U].x_mm - s_wps[i].x_mm;
+		float32_t dy = s_wps[i + 1U].y_mm - s_wps[i].y_mm;
+		float32_t len = sqrtf(dx * dx + dy * dy);
+		if (len < 1.0f) { len = 1.0f; }
+		s_seg_len[i] = len;
+		s_seg_ux[i] = dx / len;
+		s_seg_uy[i] = dy / len;
+	}
+	// 剩余长度（自后向前累加）
+	s_len_after[count - 2U] = 0.0f;
+	for (int i = (int)count - 3; i >= 0; --i) {
+		s_len_after[i] = s_len_after[i + 1] + s_seg_len[i + 1];
+	}
+	// 拐点限速：按转角余弦在 [PATH_CORNER_SPEED_MIN, 1] 间插值（直线不减速，90° 取下限）
+	for (uint8_t i = 1; i + 1U < count; ++i) {
+		float32_t cosang = s_seg_ux[i - 1U] * s_seg_ux[i] + s_seg_uy[i - 1U] * s_seg_uy[i];
+		if (cosang < 0.0f) { cosang = 0.0f; }
+		float32_t ratio = PATH_CORNER_SPEED_MIN + (1.0f - PATH_CORNER_SPEED_MIN) * cosang;
+		float32_t v_seg = fminf(s_wps[i].speed, s_wps[i + 1U].speed);
+		s_corner_v[i] = ratio * v_seg * MY_SPEED_MM_S_AT_FULL_DUTY;
+	}
+	s_corner_v[0] = 0.0f;
+	s_corner_v[count - 1U] = 0.0f;
+	return true;
+}
+
+float32_t PathFollower_GetFinalHeadingDeg(void)
+{
+	if (s_count < 2U) return s_oth * PF_RAD2DEG;
+	uint8_t last = (uint8_t)(s_count - 2U);
+	return (s_oth + atan2f(s_seg_uy[last], s_seg_ux[last])) * PF_RAD2DEG;
+}
+
+// 段 i 上从参数 t（mm）出发沿路径前推 dist，返回路径系中的点；最多跨到 i+2 段
+static void pf_point_ahead(uint8_t i, float32_t t, float32_t dist, float32_t *px, float32_t *py)
+{
+	uint8_t last = (uint8_t)(s_count - 2U);
+	float32_t s = t + dist;
+	for (uint8_t k = 0; k < 3U; ++k) {
+		if (s <= s_seg_len[i] || i == last) {
+			if (i == last && s > s_seg_len[i]) { s = s_seg_len[i]; }
+			*px = s_wps[i].x_mm + s_seg_ux[i] * s;
+			*py = s_wps[i].y_mm + s_seg_uy[i] * s;
+			return;
+		}
+		s -= s_seg_len[i];
+		i++;
+	}
+	*px = s_wps[i].x_mm;
+	*py = s_wps[i].y_mm;
+}
+
+// 前视点所在段索引（与 pf_point_ahead 相同的前推规则）
+static uint8_t pf_segment_ahead(uint8_t i, float32_t t, float32_t dist)
+{
+	uint8_t last = (uint8_t)(s_count - 2U);
+	float32_t s = t + dist;
+	for (uint8_t k = 0; k < 2U && i < last && s > s_seg_len[i]; ++k) {
+		s -= s_seg_len[i];
+		i++;
+	}
+	return i;
+}
+
+void PathFollower_Step(const pose2d_t *pose, float32_t speed_mm_s, path_cmd_t *cmd)
+{
+	cmd->speed = 0.0f;
+	cmd->curvature_per_mm = 0.0f;
+	cmd->cross_track_mm = 0.0f;
+	cmd->remaining_mm = 0.0f;
+	cmd->servo2_angle = 0U;
+	cmd->segment = s_seg;
+	cmd->done = true;
+	if (s_count < 2U) return;
+
+	// 世界系 -> 路径系
+	float32_t wx = pose->x_mm - s_ox;
+	float32_t wy = pose->y_mm - s_oy;
+	float32_t px = s_oc * wx + s_os * wy;
+	float32_t py = -s_os * wx + s_oc * wy;
+	float32_t th = pose->theta_deg * PF_DEG2RAD - s_oth;
+
+	// 投影到当前段；越过段尾则切换到下一段（每周期最多前进一段）
+	uint8_t last = (uint8_t)(s_count - 2U);
+	float32_t rx = px - s_wps[s_seg].x_mm;
+	float32_t ry = py - s_wps[s_seg].y_mm;
+	float32_t t = rx * s_seg_ux[s_seg] + ry * s_seg_uy[s_seg];
+	if (t >= s_seg_len[s_seg] && s_seg < last) {
+		s_seg++;
+		rx = px - s_wps[s_seg].x_mm;
+		ry = py - s_wps[s_seg].y_mm;
+		t = rx * s_seg_ux[s_seg] + ry * s_seg_uy[s_seg];
+	}
+	if (t < 0.0f) { t = 0.0f; }
+	float32_t cross = s_seg_ux[s_seg] * ry - s_seg_uy[s_seg] * rx;
+	float32_t to_seg_end = s_seg_len[s_seg] - t;
+	if (to_seg_end < 0.0f) { to_seg_end = 0.0f; }
+	float32_t remaining = to_seg_end + s_len_after[s_seg];
+
+	cmd->segment = s_seg;
+	cmd->cross_track_mm = cross;
+	cmd->remaining_mm = remaining;
+
+	// 到达判定：按当前速度预留滑行距离
+	float32_t lead = fmaxf(speed_mm_s, 0.0f) * 0.08f;
+	if (s_seg == last && remaining <= PATH_ARRIVE_TOL_MM + lead) {
+		return;
+	}
+	cmd->done = false;
+
+	// 前视点与纯追踪曲率
+	float32_t lx_p, ly_p;
+	pf_point_ahead(s_seg, t, s_lookahead, &lx_p, &ly_p);
+	float32_t dx = lx_p - px;
+	float32_t dy = ly_p - py;
+	float32_t c = cosf(th);
+	float32_t sn = sinf(th);
+	float32_t lx = c * dx + sn * dy;
+	float32_t ly = -sn * dx + c * dy;
+	float32_t L2 = lx * lx + ly * ly;
+	if (L2 < 1.0f) { L2 = 1.0f; }
+	float32_t kappa = 2.0f * ly / L2;
+	if (lx < 0.0f) {
+		// 前视点在车后：按最大曲率朝其一侧转向
+		kappa = (ly >= 0.0f ? 2.0f : -2.0f) / s_lookahead;
+	}
+	cmd->curvature_per_mm = kappa;
+
+	// 速度：路段速度，受后续两个拐点与终点的 v² = vc² + 2·a·d 约束
+	uint8_t seg_la = pf_segment_ahead(s_seg, t, s_lookahead);
+	float32_t v = s_wps[s_seg + 1U].speed * MY_SPEED_MM_S_AT_FULL_DUTY;
+	float32_t d = to_seg_end;
+	for (uint8_t k = 1; k <= 2U && (s_seg + k) < s_count; ++k) {
+		uint8_t wi = (uint8_t)(s_seg + k);
+		float32_t vc = s_corner_v[wi];
+		v = fminf(v, sqrtf(vc * vc + 2.0f * PATH_DECEL_MM_S2 * d));
+		if (wi + 1U < s_count) {
+			d += s_seg_len[wi];
+		}
+	}
+	cmd->speed = v / MY_SPEED_MM_S_AT_FULL_DUTY;
+	cmd->servo2_angle = s_wps[seg_la + 1U].servo2_angle;
+}
@@ -0,0 +1,63 @@
+/**
+ * @file path_follower.h
+ * @author 林木@江南大学
+ * @brief 航点路径跟踪接口 - 纯追踪（Pure Pursuit）
+ * @details 输入航点折线与当前位姿，输出速度与曲率指令；每周期只检查当前及后两段，
+ *          计算量与航点数无关；前视点跨越拐点时自然形成弯道圆滑过渡，入弯前按转角限速
+ */
+
+#ifndef __PATH_FOLLOWER_H__
+#define __PATH_FOLLOWER_H__
+
+#include "RISCV_Typedefs.h"
+#include "pose_estimator.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PATH_MAX_WAYPOINTS        16U
+#define PATH_DECEL_MM_S2          250.0f  // 规划减速度（mm/s²）
+#define PATH_CORNER_SPEED_MIN     0.35f   // 90° 拐点处限速比例下限（相对路段速度）
+#define PATH_ARRIVE_TOL_MM        5.0f    // 终点到达容差（mm）
+
+/**
+ * @brief 航点
+ * @details 坐标以路径起点位姿为原点、起始航向为 x 轴（左为 +y）；
+ *          speed 为驶向该航点路段的基础占空比；servo2_angle 为前视点位于该路段时舵机2保持的角度（0=不驱动）
+ */
+typedef struct {
+    float32_t x_mm;
+    float32_t y_mm;
+    float32_t speed;
+    uint16_t servo2_angle;
+} path_waypoint_t;
+
+/**
+ * @brief 单周期跟踪指令
+ */
+typedef struct {
+    float32_t speed;            // 基础占空比（已含弯道/终点减速）
+    float32_t curvature_per_mm; // 曲率（1/mm，左转为正）
+    float32_t cross_track_mm;   // 横向偏差（路径左侧为正）
+    float32_t remaining_mm;     // 到终点剩余路程
+    uint16_t servo2_angle;      // 本周期舵机2角度（0=不驱动）
+    uint8_t segment;            // 当前路段索引
+    bool done;                  // 已到达终点
+} path_cmd_t;
+
+// 载入路径：origin 为路径坐标系原点在世界系中的位姿（θ 为 x 轴方向），返回是否有效
+bool PathFollower_Start(const path_waypoint_t *wps, uint8_t count, float32_t lookahead_mm,
+                        float32_t origin_x_mm, float32_t origin_y_mm, float32_t origin_theta_deg);
+// 单步：输入当前世界系位姿与当前车速估计（mm/s），输出指令
+void PathFollower_Step(const pose2d_t *pose, float32_t speed_mm_s, path_cmd_t *cmd);
+// 路径终点切线方向（世界系航向，度）
+float32_t PathFollower_GetFinalHeadingDeg(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __PATH_FOLLOWER_H__
@@ -0,0 +1,81 @@
+/**
+ * Copyright Statement:
+ * This software and related documentation (ESWIN SOFTWARE) are protected under relevant copyright laws.
+ * The information contained herein is confidential and proprietary to
+ * Beijing ESWIN Computing Technology Co., Ltd.(ESWIN)and/or its licensors.
+ * Without the prior written permission of ESWIN and/or its licensors, any reproduction, modification,
+ * use or disclosure Software, and information contained herein, in whole or in part, shall be strictly prohibited.
+ *
+ * Copyright ©[2023] [Beijing ESWIN Computing Technology Co., Ltd.]. All rights reserved.
+ *
+ * RECEIVER HEREBY UNEQUIVOCALLY ACKNOWLEDGES AND AGREES THAT THE SOFTWARE
+ * AND ITS DOCUMENTATIONS (ESWIN SOFTWARE) RECEIVED FROM ESWIN AND / OR ITS REPRESENTATIVES
+ * ARE PROVIDED TO RECEIVER ON AN "AS-IS" BASIS ONLY. ESWIN EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE OR NON INFRINGEMENT.
+ * NEITHER DOES ESWIN PROVIDE ANY WARRANTY WHATSOEVER WITH RESPECT TO THE SOFTWARE OF ANY THIRD PARTY
+ * WHICH MAY BE USED BY,INCORPORATED IN, OR SUPPLIED WITH THE ESWIN SOFTWARE,
+ * AND RECEIVER AGREES TO LOOK ONLY TO SUCH THIRD PARTY FOR ANY WARRANTY CLAIM RELATING THERETO.
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ESWIN BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @file peripherals_spi_0_config.h
+ * @file peripherals_flexcan_0_config.c
+ * @brief FlexCAN0：上位机命令与遥测总线（500 kbit/s，经典 CAN）
+ * @date 2025-07-10
+ *
+ */
+
+#include "peripherals_flexcan_0_config.h"
+
+flexcan_state_t g_stFlexcanState_0;
+
+flexcan_user_config_t g_stFlexcan0Config0 = {
+    .max_num_mb                  = 16U,                            // FIFO 占 MB0~7，发送用 MB8~
+    .num_id_filters              = FLEXCAN_RX_FIFO_ID_FILTERS_8,
+    .is_rx_fifo_needed           = true,                           // 传统 Rx FIFO（6 帧深）+ 硬件 ID 过滤
+    .num_enhanced_std_id_filters = 0U,
+    .num_enhanced_ext_id_filters = 0U,
+    .num_enhanced_watermark      = 0U,
+    .is_enhanced_rx_fifo_needed  = false,
+    .flexcanMode                 = FLEXCAN_NORMAL_MODE,            // 自检时临时改为 FLEXCAN_LOOPBACK_MODE
+    .payload =
+        {
+            .blockR0 = FLEXCAN_PAYLOAD_SIZE_8,
+            .blockR1 = FLEXCAN_PAYLOAD_SIZE_8,
+            .blockR2 = FLEXCAN_PAYLOAD_SIZE_8,
+            .blockR3 = FLEXCAN_PAYLOAD_SIZE_8,
+        },
+    .fd_enable = false,
+    .pe_clock  = FLEXCAN_CLK_SOURCE_OSC,                           // SOSC 24MHz
+    // 24MHz / 3 = 8MHz，16 tq/位：同步 1 + 传播 7 + 相位1 6 + 相位2 2，采样点 87.5%
+    .bitrate =
+        {
+            .propSeg    = 6U,
+            .phaseSeg1  = 5U,
+            .phaseSeg2  = 1U,
+            .preDivider = 2U,
+            .rJumpwidth = 1U,
+        },
+    .bitrate_cbt =
+        {
+            .propSeg    = 6U,
+            .phaseSeg1  = 5U,
+            .phaseSeg2  = 1U,
+            .preDivider = 2U,
+            .rJumpwidth = 1U,
+        },
+    .transfer_type    = FLEXCAN_RXFIFO_USING_INTERRUPTS,
+    .rxFifoDMAChannel = 0U,
+    .time_stamp =
+        {
+            .timeStampSource      = FLEXCAN_CAN_CLK_TIMESTAMP_SRC,
+            .msgBuffTimeStampType = FLEXCAN_MSGBUFFTIMESTAMP_TIMER,
+            .hrConfigType         = FLEXCAN_TIMESTAMPCAPTURE_DISABLE,
+        },
+};
@@ -36,6 +36,10 @@
 pdma_state_t g_stPdmaState0;
 
 pdma_chn_state_t g_stPdma0ChnState0;
+pdma_chn_state_t g_stPdma0ChnState1;
+pdma_chn_state_t g_stPdma0ChnState2;
+pdma_chn_state_t g_stPdma0ChnState3;
+pdma_chn_state_t g_stPdma0ChnState4;
 
 pdma_channel_config_t g_stPdma0ChannelConfig0 = {
     .groupPriority   = PDMA_GRP0_PRIO_LOW_GRP1_PRIO_HIGH,
@@ -47,12 +51,64 @@ pdma_channel_config_t g_stPdma0ChannelConfig0 = {
     .callbackParam   = NULL,
 };
 
+// SPI2 发送（外部 Flash 页编程）
+pdma_channel_config_t g_stPdma0ChannelConfig1 = {
+    .groupPriority   = PDMA_GRP0_PRIO_LOW_GRP1_PRIO_HIGH,
+    .channelPriority = PDMA_CHN_DEFAULT_PRIORITY,
+    .virtChnConfig   = 1,
+    .source          = PDMA_REQ_SPI2_TX,
+    .enableTrigger   = false,
+    .callback        = NULL,
+    .callbackParam   = NULL,
+};
+
+// SPI2 接收
+pdma_channel_config_t g_stPdma0ChannelConfig2 = {
+    .groupPriority   = PDMA_GRP0_PRIO_LOW_GRP1_PRIO_HIGH,
+    .channelPriority = PDMA_CHN_DEFAULT_PRIORITY,
+    .virtChnConfig   = 2,
+    .source          = PDMA_REQ_SPI2_RX,
+    .enableTrigger   = false,
+    .callback        = NULL,
+    .callbackParam   = NULL,
+};
+
+// SPI1 发送（W5500 以太网）
+pdma_channel_config_t g_stPdma0ChannelConfig3 = {
+    .groupPriority   = PDMA_GRP0_PRIO_LOW_GRP1_PRIO_HIGH,
+    .channelPriority = PDMA_CHN_DEFAULT_PRIORITY,
+    .virtChnConfig   = 3,
+    .source          = PDMA_REQ_SPI1_TX,
+    .enableTrigger   = false,
+    .callback        = NULL,
+    .callbackParam   = NULL,
+};
+
+// SPI1 接收
+pdma_channel_config_t g_stPdma0ChannelConfig4 = {
+    .groupPriority   = PDMA_GRP0_PRIO_LOW_GRP1_PRIO_HIGH,
+    .channelPriority = PDMA_CHN_DEFAULT_PRIORITY,
+    .virtChnConfig   = 4,
+    .source          = PDMA_REQ_SPI1_RX,
+    .enableTrigger   = false,
+    .callback        = NULL,
+    .callbackParam   = NULL,
+};
+
 const pdma_channel_config_t *g_stPdma0ChannelConfigArray[PDMA_CHANNEL_CONFIG_COUNT] = {
     &g_stPdma0ChannelConfig0,
+    &g_stPdma0ChannelConfig1,
+    &g_stPdma0ChannelConfig2,
+    &g_stPdma0ChannelConfig3,
+    &g_stPdma0ChannelConfig4,
 };
 
 pdma_chn_state_t *g_stPdma0ChnStateArray[PDMA_CHN_STATE_COUNT] = {
     &g_stPdma0ChnState0,
+    &g_stPdma0ChnState1,
+    &g_stPdma0ChnState2,
+    &g_stPdma0ChnState3,
+    &g_stPdma0ChnState4,
 };
 
 pdma_user_config_t g_stPdma0UserConfig0 = {
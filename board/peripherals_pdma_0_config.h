@@ -35,16 +35,24 @@
 
 #include "pdma_driver.h"
 
-#define PDMA_CHN_STATE_COUNT      (1U)
-#define PDMA_CHANNEL_CONFIG_COUNT (1U)
+#define PDMA_CHN_STATE_COUNT      (5U)
+#define PDMA_CHANNEL_CONFIG_COUNT (5U)
 
 #define INST_PDMA_0 (0U)
 
 extern pdma_state_t g_stPdmaState0;
 
 extern pdma_channel_config_t g_stPdma0ChannelConfig0;
+extern pdma_channel_config_t g_stPdma0ChannelConfig1;
+extern pdma_channel_config_t g_stPdma0ChannelConfig2;
+extern pdma_channel_config_t g_stPdma0ChannelConfig3;
+extern pdma_channel_config_t g_stPdma0ChannelConfig4;
 
 extern pdma_chn_state_t g_stPdma0ChnState0;
+extern pdma_chn_state_t g_stPdma0ChnState1;
+extern pdma_chn_state_t g_stPdma0ChnState2;
+extern pdma_chn_state_t g_stPdma0ChnState3;
+extern pdma_chn_state_t g_stPdma0ChnState4;
 
 extern pdma_chn_state_t *g_stPdma0ChnStateArray[PDMA_CHN_STATE_COUNT];
 
@@ -0,0 +1,52 @@
+/**
+ * Copyright Statement:
+ * This software and related documentation (ESWIN SOFTWARE) are protected under relevant copyright laws.
+ * The information contained herein is confidential and proprietary to
+ * Beijing ESWIN Computing Technology Co., Ltd.(ESWIN)and/or its licensors.
+ * Without the prior written permission of ESWIN and/or its licensors, any reproduction, modification,
+ * use or disclosure Software, and information contained herein, in whole or in part, shall be strictly prohibited.
+ *
+ * Copyright ©[2023] [Beijing ESWIN Computing Technology Co., Ltd.]. All rights reserved.
+ *
+ * RECEIVER HEREBY UNEQUIVOCALLY ACKNOWLEDGES AND AGREES THAT THE SOFTWARE
+ * AND ITS DOCUMENTATIONS (ESWIN SOFTWARE) RECEIVED FROM ESWIN AND / OR ITS REPRESENTATIVES
+ * ARE PROVIDED TO RECEIVER ON AN "AS-IS" BASIS ONLY. ESWIN EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE OR NON INFRINGEMENT.
+ * NEITHER DOES ESWIN PROVIDE ANY WARRANTY WHATSOEVER WITH RESPECT TO THE SOFTWARE OF ANY THIRD PARTY
+ * WHICH MAY BE USED BY,INCORPORATED IN, OR SUPPLIED WITH THE ESWIN SOFTWARE,
+ * AND RECEIVER AGREES TO LOOK ONLY TO SUCH THIRD PARTY FOR ANY WARRANTY CLAIM RELATING THERETO.
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ESWIN BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @file peripherals_spi_2_config.c
+ * @brief SPI2 主机：外部 SPI NOR Flash（GD25Q128，运行记录）
+ * @date 2025-07-10
+ *
+ */
+
+#include "peripherals_spi_2_config.h"
+
+spi_state_t g_stSpiState_2;
+
+spi_master_config_t g_stSpi2MasterConfig0 = {
+    .bitsPerSec        = 10000000UL,               // GD25Q128 读命令 0x03 上限 80MHz，保守取 10MHz
+    .euWhichPcs        = SPI_PCS0,
+    .euPcsPolarity     = SPI_ACTIVE_LOW,
+    .isPcsContinuous   = true,                     // 命令 + 地址 + 数据在一次片选内完成
+    .bitcount          = 8U,
+    .euClkPhase        = SPI_CLOCK_PHASE_1ST_EDGE, // 模式 0
+    .euClkPolarity     = SPI_SCK_ACTIVE_HIGH,
+    .lsbFirst          = false,
+    .euTransferType    = SPI_USING_DMA,
+    .rxDMAChannel      = 2U,                       // 见 peripherals_pdma_0_config.c
+    .txDMAChannel      = 1U,
+    .callback          = NULL,
+    .callbackParam     = NULL,
+    .euWidth           = SPI_SINGLE_BIT_XFER,
+};
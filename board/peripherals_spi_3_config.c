@@ -0,0 +1,69 @@
+/**
+ * Copyright Statement:
+ * This software and related documentation (ESWIN SOFTWARE) are protected under relevant copyright laws.
+ * The information contained herein is confidential and proprietary to
+ * Beijing ESWIN Computing Technology Co., Ltd.(ESWIN)and/or its licensors.
+ * Without the prior written permission of ESWIN and/or its licensors, any reproduction, modification,
+ * use or disclosure Software, and information contained herein, in whole or in part, shall be strictly prohibited.
+ *
+ * Copyright ©[2023] [Beijing ESWIN Computing Technology Co., Ltd.]. All rights reserved.
+ *
+ * RECEIVER HEREBY UNEQUIVOCALLY ACKNOWLEDGES AND AGREES THAT THE SOFTWARE
+ * AND ITS DOCUMENTATIONS (ESWIN SOFTWARE) RECEIVED FROM ESWIN AND / OR ITS REPRESENTATIVES
+ * ARE PROVIDED TO RECEIVER ON AN "AS-IS" BASIS ONLY. ESWIN EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE OR NON INFRINGEMENT.
+ * NEITHER DOES ESWIN PROVIDE ANY WARRANTY WHATSOEVER WITH RESPECT TO THE SOFTWARE OF ANY THIRD PARTY
+ * WHICH MAY BE USED BY,INCORPORATED IN, OR SUPPLIED WITH THE ESWIN SOFTWARE,
+ * AND RECEIVER AGREES TO LOOK ONLY TO SUCH THIRD PARTY FOR ANY WARRANTY CLAIM RELATING THERETO.
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ESWIN BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @file peripherals_spi_3_config.c
+ * @brief SPI3 主机：SD 卡（SPI 模式，spi_sd 驱动，运行记录）
+ * @date 2025-07-10
+ *
+ */
+
+#include "peripherals_spi_3_config.h"
+
+spi_state_t g_stSpiState_3;
+
+spi_master_config_t g_stSpi3MasterConfig0 = {
+    .bitsPerSec        = 400000UL,                 // SD 卡识别阶段上限 400kHz
+    .euWhichPcs        = SPI_PCS1,
+    .euPcsPolarity     = SPI_ACTIVE_LOW,
+    .isPcsContinuous   = true,                     // 命令/数据块期间保持片选
+    .bitcount          = 8U,
+    .euClkPhase        = SPI_CLOCK_PHASE_1ST_EDGE, // 模式 0
+    .euClkPolarity     = SPI_SCK_ACTIVE_HIGH,
+    .lsbFirst          = false,
+    .euTransferType    = SPI_USING_INTERRUPTS,     // 驱动逐字节传输，不使用 DMA
+    .rxDMAChannel      = 0U,
+    .txDMAChannel      = 0U,
+    .callback          = NULL,
+    .callbackParam     = NULL,
+    .euWidth           = SPI_SINGLE_BIT_XFER,
+};
+
+spi_master_config_t g_stSpi3MasterConfig1 = {
+    .bitsPerSec        = 10000000UL,               // 初始化完成后切换（SPI 模式上限 25MHz，保守取 10MHz）
+    .euWhichPcs        = SPI_PCS1,
+    .euPcsPolarity     = SPI_ACTIVE_LOW,
+    .isPcsContinuous   = true,
+    .bitcount          = 8U,
+    .euClkPhase        = SPI_CLOCK_PHASE_1ST_EDGE,
+    .euClkPolarity     = SPI_SCK_ACTIVE_HIGH,
+    .lsbFirst          = false,
+    .euTransferType    = SPI_USING_INTERRUPTS,
+    .rxDMAChannel      = 0U,
+    .txDMAChannel      = 0U,
+    .callback          = NULL,
+    .callbackParam     = NULL,
+    .euWidth           = SPI_SINGLE_BIT_XFER,
+};
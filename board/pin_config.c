@@ -405,4 +405,250 @@ pin_settings_config_t g_stPinmuxConfigArr[NUM_OF_CONFIGURED_PINS] = {
         .clearIntFlag   = true,
         .debounceEnable = false,
     },    
+    {
+        //SPI2_SIN function, 100pin package, 1pin - 外部 Flash SO
+        .base        = PORTA,
+        .pinPortIdx  = 0U,
+        .pullConfig  = PORT_INTERNAL_PULL_NOT_ENABLED,
+        .driveSelect = PORT_STR2_DRIVE_STRENGTH,
+        .mux         = PORT_MUX_ALT3,
+        .isGpio      = false,
+    },
+    {
+        //SPI2_SCK function, 100pin package, 2pin - 外部 Flash SCLK
+        .base        = PORTA,
+        .pinPortIdx  = 1U,
+        .pullConfig  = PORT_INTERNAL_PULL_NOT_ENABLED,
+        .driveSelect = PORT_STR2_DRIVE_STRENGTH,
+        .mux         = PORT_MUX_ALT3,
+        .isGpio      = false,
+    },
+    {
+        //SPI2_PCS0 function, 100pin package, 5pin - 外部 Flash CS#
+        .base        = PORTA,
+        .pinPortIdx  = 4U,
+        .pullConfig  = PORT_INTERNAL_PULL_NOT_ENABLED,
+        .driveSelect = PORT_STR2_DRIVE_STRENGTH,
+        .mux         = PORT_MUX_ALT2,
+        .isGpio      = false,
+    },
+    {
+        //SPI2_SOUT function, 100pin package, 39pin - 外部 Flash SI
+        .base        = PORTB,
+        .pinPortIdx  = 9U,
+        .pullConfig  = PORT_INTERNAL_PULL_NOT_ENABLED,
+        .driveSelect = PORT_STR2_DRIVE_STRENGTH,
+        .mux         = PORT_MUX_ALT3,
+        .isGpio      = false,
+    },
+    {
+        //SPI3_SCK function, 100pin package, 84pin - SD 卡 CLK
+        .base        = PORTD,
+        .pinPortIdx  = 10U,
+        .pullConfig  = PORT_INTERNAL_PULL_NOT_ENABLED,
+        .driveSelect = PORT_STR2_DRIVE_STRENGTH,
+        .mux         = PORT_MUX_ALT5,
+        .isGpio      = false,
+    },
+    {
+        //SPI3_SOUT function, 100pin package, 76pin - SD 卡 CMD(DI)
+        .base        = PORTC,
+        .pinPortIdx  = 30U,
+        .pullConfig  = PORT_INTERNAL_PULL_NOT_ENABLED,
+        .driveSelect = PORT_STR2_DRIVE_STRENGTH,
+        .mux         = PORT_MUX_ALT5,
+        .isGpio      = false,
+    },
+    {
+        //SPI3_SIN function, 100pin package, 85pin - SD 卡 DAT0(DO)
+        .base        = PORTD,
+        .pinPortIdx  = 11U,
+        .pullConfig  = PORT_INTERNAL_PULL_UP_ENABLED,
+        .driveSelect = PORT_STR2_DRIVE_STRENGTH,
+        .mux         = PORT_MUX_ALT5,
+        .isGpio      = false,
+    },
+    {
+        //SPI3_PCS1 function, 100pin package, 40pin - SD 卡 CS
+        .base        = PORTB,
+        .pinPortIdx  = 10U,
+        .pullConfig  = PORT_INTERNAL_PULL_NOT_ENABLED,
+        .driveSelect = PORT_STR2_DRIVE_STRENGTH,
+        .mux         = PORT_MUX_ALT5,
+        .isGpio      = false,
+    },
+    {
+        //SPI1_PCS1 function, 100pin package, 58pin - W5500 SCSn
+        .base        = PORTC,
+        .pinPortIdx  = 8U,
+        .pullConfig  = PORT_INTERNAL_PULL_NOT_ENABLED,
+        .driveSelect = PORT_STR2_DRIVE_STRENGTH,
+        .mux         = PORT_MUX_ALT3,
+        .isGpio      = false,
+    },
+    {
+        //SPI1_SOUT function, 100pin package, 64pin - W5500 MOSI
+        .base        = PORTC,
+        .pinPortIdx  = 15U,
+        .pullConfig  = PORT_INTERNAL_PULL_NOT_ENABLED,
+        .driveSelect = PORT_STR2_DRIVE_STRENGTH,
+        .mux         = PORT_MUX_ALT3,
+        .isGpio      = false,
+    },
+    {
+        //SPI1_SIN function, 100pin package, 65pin - W5500 MISO
+        .base        = PORTC,
+        .pinPortIdx  = 16U,
+        .pullConfig  = PORT_INTERNAL_PULL_UP_ENABLED,
+        .driveSelect = PORT_STR2_DRIVE_STRENGTH,
+        .mux         = PORT_MUX_ALT3,
+        .isGpio      = false,
+    },
+    {
+        //SPI1_SCK function, 100pin package, 66pin - W5500 SCLK
+        .base        = PORTC,
+        .pinPortIdx  = 17U,
+        .pullConfig  = PORT_INTERNAL_PULL_NOT_ENABLED,
+        .driveSelect = PORT_STR2_DRIVE_STRENGTH,
+        .mux         = PORT_MUX_ALT3,
+        .isGpio      = false,
+    },
+    {
+        //PORTC22 function, 100pin package, 70pin - W5500 RSTn（低有效，上电保持复位）
+        .base           = PORTC,
+        .pinPortIdx     = 22U,
+        .pullConfig     = PORT_INTERNAL_PULL_NOT_ENABLED,
+        .driveSelect    = PORT_STR2_DRIVE_STRENGTH,
+        .mux            = PORT_MUX_ALT1,
+        .isGpio         = true,
+        .direction      = GPIO_OUTPUT_DIRECTION,
+        .initValue      = 0,
+        .intConfig      = PORT_INT_DISABLED,
+        .clearIntFlag   = true,
+        .debounceEnable = false,
+    },
+    {
+        //SPI0_PCS3 function, 100pin package, 83pin - SX1262 NSS
+        .base        = PORTD,
+        .pinPortIdx  = 9U,
+        .pullConfig  = PORT_INTERNAL_PULL_NOT_ENABLED,
+        .driveSelect = PORT_STR2_DRIVE_STRENGTH,
+        .mux         = PORT_MUX_ALT3,
+        .isGpio      = false,
+    },
+    {
+        //SPI0_SOUT function, 100pin package, 53pin - SX1262 MOSI
+        .base        = PORTC,
+        .pinPortIdx  = 0U,
+        .pullConfig  = PORT_INTERNAL_PULL_NOT_ENABLED,
+        .driveSelect = PORT_STR2_DRIVE_STRENGTH,
+        .mux         = PORT_MUX_ALT3,
+        .isGpio      = false,
+    },
+    {
+        //SPI0_SIN function, 100pin package, 47pin - SX1262 MISO
+        .base        = PORTB,
+        .pinPortIdx  = 20U,
+        .pullConfig  = PORT_INTERNAL_PULL_UP_ENABLED,
+        .driveSelect = PORT_STR2_DRIVE_STRENGTH,
+        .mux         = PORT_MUX_ALT3,
+        .isGpio      = false,
+    },
+    {
+        //SPI0_SCK function, 100pin package, 48pin - SX1262 SCK
+        .base        = PORTB,
+        .pinPortIdx  = 23U,
+        .pullConfig  = PORT_INTERNAL_PULL_NOT_ENABLED,
+        .driveSelect = PORT_STR2_DRIVE_STRENGTH,
+        .mux         = PORT_MUX_ALT3,
+        .isGpio      = false,
+    },
+    {
+        //PORTC10 function, 100pin package, 59pin - SX1262 NRESET（低有效，上电保持复位）
+        .base           = PORTC,
+        .pinPortIdx     = 10U,
+        .pullConfig     = PORT_INTERNAL_PULL_NOT_ENABLED,
+        .driveSelect    = PORT_STR2_DRIVE_STRENGTH,
+        .mux            = PORT_MUX_ALT1,
+        .isGpio         = true,
+        .direction      = GPIO_OUTPUT_DIRECTION,
+        .initValue      = 0,
+        .intConfig      = PORT_INT_DISABLED,
+        .clearIntFlag   = true,
+        .debounceEnable = false,
+    },
+    {
+        //PORTC3 function, 100pin package, 55pin - SX1262 BUSY（下拉：未接模块时不等待）
+        .base           = PORTC,
+        .pinPortIdx     = 3U,
+        .pullConfig     = PORT_INTERNAL_PULL_DOWN_ENABLED,
+        .driveSelect    = PORT_STR2_DRIVE_STRENGTH,
+        .mux            = PORT_MUX_ALT1,
+        .isGpio         = true,
+        .direction      = GPIO_INPUT_DIRECTION,
+        .initValue      = 0,
+        .intConfig      = PORT_INT_DISABLED,
+        .clearIntFlag   = true,
+        .debounceEnable = false,
+    },
+    {
+        //PORTC23 function, 100pin package, 71pin - SX1262 DIO1（发送完成，轮询读取）
+        .base           = PORTC,
+        .pinPortIdx     = 23U,
+        .pullConfig     = PORT_INTERNAL_PULL_DOWN_ENABLED,
+        .driveSelect    = PORT_STR2_DRIVE_STRENGTH,
+        .mux            = PORT_MUX_ALT1,
+        .isGpio         = true,
+        .direction      = GPIO_INPUT_DIRECTION,
+        .initValue      = 0,
+        .intConfig      = PORT_INT_DISABLED,
+        .clearIntFlag   = true,
+        .debounceEnable = false,
+    },
+    {
+        //PORTC19 function, 100pin package, 68pin - 射频开关 RX 使能
+        .base           = PORTC,
+        .pinPortIdx     = 19U,
+        .pullConfig     = PORT_INTERNAL_PULL_NOT_ENABLED,
+        .driveSelect    = PORT_STR2_DRIVE_STRENGTH,
+        .mux            = PORT_MUX_ALT1,
+        .isGpio         = true,
+        .direction      = GPIO_OUTPUT_DIRECTION,
+        .initValue      = 0,
+        .intConfig      = PORT_INT_DISABLED,
+        .clearIntFlag   = true,
+        .debounceEnable = false,
+    },
+    {
+        //PORTC21 function, 100pin package, 69pin - 射频开关 TX 使能
+        .base           = PORTC,
+        .pinPortIdx     = 21U,
+        .pullConfig     = PORT_INTERNAL_PULL_NOT_ENABLED,
+        .driveSelect    = PORT_STR2_DRIVE_STRENGTH,
+        .mux            = PORT_MUX_ALT1,
+        .isGpio         = true,
+        .direction      = GPIO_OUTPUT_DIRECTION,
+        .initValue      = 0,
+        .intConfig      = PORT_INT_DISABLED,
+        .clearIntFlag   = true,
+        .debounceEnable = false,
+    },
+    {
+        //CAN0_TX function, 100pin package, 8pin - CAN 收发器 TXD
+        .base        = PORTA,
+        .pinPortIdx  = 7U,
+        .pullConfig  = PORT_INTERNAL_PULL_NOT_ENABLED,
+        .driveSelect = PORT_STR2_DRIVE_STRENGTH,
+        .mux         = PORT_MUX_ALT5,
+        .isGpio      = false,
+    },
+    {
+        //CAN0_RX function, 100pin package, 9pin - CAN 收发器 RXD（上拉：未接收发器时为隐性电平）
+        .base        = PORTA,
+        .pinPortIdx  = 8U,
+        .pullConfig  = PORT_INTERNAL_PULL_UP_ENABLED,
+        .driveSelect = PORT_STR2_DRIVE_STRENGTH,
+        .mux         = PORT_MUX_ALT5,
+        .isGpio      = false,
+    },
 };
@@ -35,7 +35,7 @@
 
 #include "pins_driver.h"
 
-#define NUM_OF_CONFIGURED_PINS (31U)
+#define NUM_OF_CONFIGURED_PINS (55U)
 
 /**
  * @brief User configuration structure
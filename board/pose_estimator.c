@@ -0,0 +1,138 @@
+/**
+ * @file pose_estimator.c
+ * @author 林木@江南大学
+ * @brief 平面航位推算位姿估计实现
+ * @details 预测：中点航向积分编码器前进位移，协方差 P = F·P·Fᵀ + G·Q·Gᵀ；
+ *          观测：H30 航向作为 θ 的标量观测，单次卡尔曼更新，全部为展开的 3x3 定长运算
+ */
+
+#include "pose_estimator.h"
+#include "odometry.h"
+#include "my_move.h"
+#include <math.h>
+
+#define POSE_DEG2RAD  0.017453293f
+#define POSE_RAD2DEG  57.29578f
+#define POSE_PI       3.14159265f
+
+static float32_t s_x = 0.0f;
+static float32_t s_y = 0.0f;
+static float32_t s_th = 0.0f;           // rad
+static float32_t s_P[3][3];
+// 顺序锁：写入期间为奇数，读者据此重试，避免关中断；
+// 位姿数据本身不是 volatile，由序号两侧的内存屏障限定读写顺序（与 can_bus.c 驱动指令快照相同）
+static volatile uint32_t s_seq = 0;
+
+static float32_t wrap_pi(float32_t a)
+{
+	while (a > POSE_PI)  { a -= 2.0f * POSE_PI; }
+	while (a < -POSE_PI) { a += 2.0f * POSE_PI; }
+	return a;
+}
+
+void Pose_Reset(float32_t x_mm, float32_t y_mm, float32_t theta_deg)
+{
+	s_seq++;
+	__sync_synchronize();
+	s_x = x_mm;
+	s_y = y_mm;
+	s_th = wrap_pi(theta_deg * POSE_DEG2RAD);
+	for (int i = 0; i < 3; ++i) {
+		for (int j = 0; j < 3; ++j) {
+			s_P[i][j] = 0.0f;
+		}
+	}
+	__sync_synchronize();
+	s_seq++;
+}
+
+void Pose_Update(float32_t ds_mm, float32_t dtheta_odom_deg, float32_t yaw_deg, bool yaw_valid)
+{
+	s_seq++;
+	__sync_synchronize();
+
+	// ---- 预测 ----
+	float32_t dth = dtheta_odom_deg * POSE_DEG2RAD;
+	float32_t thm = s_th + 0.5f * dth;
+	float32_t c = cosf(thm);
+	float32_t sn = sinf(thm);
+	s_x += ds_mm * c;
+	s_y += ds_mm * sn;
+	s_th = wrap_pi(s_th + dth);
+
+	// F = [1 0 a; 0 1 b; 0 0 1]，a = -ds·sinθm，b = ds·cosθm
+	float32_t a = -ds_mm * sn;
+	float32_t b = ds_mm * c;
+	float32_t P00 = s_P[0][0], P01 = s_P[0][1], P02 = s_P[0][2];
+	float32_t P11 = s_P[1][1], P12 = s_P[1][2], P22 = s_P[2][2];
+	// F·P·Fᵀ（对称，仅计算上三角）
+	float32_t n00 = P00 + 2.0f * a * P02 + a * a * P22;
+	float32_t n01 = P01 + a * P12 + b * P02 + a * b * P22;
+	float32_t n02 = P02 + a * P22;
+	float32_t n11 = P11 + 2.0f * b * P12 + b * b * P22;
+	float32_t n12 = P12 + b * P22;
+	float32_t n22 = P22;
+
+	// 过程噪声：沿航向的距离噪声 + 横向侧滑噪声 + 航向噪声
+	float32_t ads = fabsf(ds_mm);
+	float32_t q_s = POSE_SIGMA_S_PER_MM * ads;
+	float32_t q_l = POSE_SIGMA_LAT_PER_MM * ads;
+	float32_t q_t = POSE_SIGMA_TH_PER_RAD * fabsf(dth) + POSE_SIGMA_TH_PER_MM * ads;
+	n00 += q_s * c * c + q_l * sn * sn;
+	n01 += (q_s - q_l) * c * sn;
+	n11 += q_s * sn * sn + q_l * c * c;
+	n22 += q_t;
+
+	// ---- 观测：θ ----
+	if (yaw_valid) {
+		float32_t innov = wrap_pi(yaw_deg * POSE_DEG2RAD - s_th);
+		float32_t S = n22 + POSE_YAW_MEAS_VAR;
+		float32_t k0 = n02 / S;
+		float32_t k1 = n12 / S;
+		float32_t k2 = n22 / S;
+		s_x += k0 * innov;
+		s_y += k1 * innov;
+		s_th = wrap_pi(s_th + k2 * innov);
+		// P = P - K·H·P，H = [0 0 1]
+		float32_t r0 = n02, r1 = n12, r2 = n22;
+		n00 -= k0 * r0; n01 -= k0 * r1; n02 -= k0 * r2;
+		n11 -= k1 * r1; n12 -= k1 * r2;
+		n22 -= k2 * r2;
+	}
+
+	s_P[0][0] = n00; s_P[0][1] = n01; s_P[0][2] = n02;
+	s_P[1][0] = n01; s_P[1][1] = n11; s_P[1][2] = n12;
+	s_P[2][0] = n02; s_P[2][1] = n12; s_P[2][2] = n22;
+
+	__sync_synchronize();
+	s_seq++;
+}
+
+void Pose_StepFromOdom(float32_t yaw_deg, bool yaw_valid)
+{
+	float32_t dl, dr;
+	Odom_GetLastWheelDeltaMm(&dl, &dr);
+	float32_t ds = Odom_GetLastDeltaMm();
+	float32_t dth_deg = ((dr - dl) / MY_TRACK_WIDTH_MM) * POSE_RAD2DEG;
+	Pose_Update(ds, dth_deg, yaw_deg, yaw_valid);
+}
+
+void Pose_Get(pose2d_t *out)
+{
+	if (!out) return;
+	uint32_t seq0, seq1;
+	do {
+		seq0 = s_seq;
+		__sync_synchronize();
+		out->x_mm = s_x;
+		out->y_mm = s_y;
+		out->theta_deg = s_th * POSE_RAD2DEG;
+		for (int i = 0; i < 3; ++i) {
+			for (int j = 0; j < 3; ++j) {
+				out->cov[i][j] = s_P[i][j];
+			}
+		}
+		__sync_synchronize();
+		seq1 = s_seq;
+	} while ((seq0 != seq1) || (seq0 & 1U));
+}
@@ -0,0 +1,55 @@
+/**
+ * @file pose_estimator.h
+ * @author 林木@江南大学
+ * @brief 平面航位推算位姿估计接口 (x, y, θ)
+ * @details 以编码器里程为预测输入、H30 欧拉航向为观测，扩展卡尔曼滤波估计平面位姿与协方差；
+ *          固定 3x3 运算、无动态内存，可在控制中断中调用
+ */
+
+#ifndef __POSE_ESTIMATOR_H__
+#define __POSE_ESTIMATOR_H__
+
+#include "RISCV_Typedefs.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 噪声参数（按实测调整）
+#define POSE_SIGMA_S_PER_MM      0.02f   // 前进距离噪声方差系数（mm²/mm）
+#define POSE_SIGMA_LAT_PER_MM    0.01f   // 麦克纳姆侧滑引入的横向方差系数（mm²/mm）
+#define POSE_SIGMA_TH_PER_RAD    0.30f   // 编码器差速航向增量噪声方差系数（rad²/rad）
+#define POSE_SIGMA_TH_PER_MM     2.0e-5f // 行驶引起的航向方差系数（rad²/mm）
+#define POSE_YAW_MEAS_VAR        1.0e-4f // H30 航向观测方差（rad²，约 0.6°）
+
+/**
+ * @brief 平面位姿与协方差
+ * @details 世界坐标系 x 轴对应 H30 航向 0°，航向左转为正；协方差状态顺序 (x, y, θ)，θ 以弧度计
+ */
+typedef struct {
+    float32_t x_mm;
+    float32_t y_mm;
+    float32_t theta_deg;
+    float32_t cov[3][3];
+} pose2d_t;
+
+// 复位位姿（协方差清零）
+void Pose_Reset(float32_t x_mm, float32_t y_mm, float32_t theta_deg);
+
+// 单步更新：ds_mm 为车体前进位移，dtheta_odom_deg 为编码器差速航向增量，
+// yaw_deg/yaw_valid 为 H30 航向观测（无效时仅预测）
+void Pose_Update(float32_t ds_mm, float32_t dtheta_odom_deg, float32_t yaw_deg, bool yaw_valid);
+
+// 使用里程计最近一次增量与给定航向观测更新（需在 Odom_Update 之后调用）
+void Pose_StepFromOdom(float32_t yaw_deg, bool yaw_valid);
+
+// 读取当前位姿快照（与中断中的更新无锁一致）
+void Pose_Get(pose2d_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __POSE_ESTIMATOR_H__
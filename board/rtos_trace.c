@@ -0,0 +1,175 @@
+/**
+ * @file rtos_trace.c
+ * @author 林木@江南大学
+ * @brief 内核事件追踪实现
+ * @details 记录器在调度器启动前以 TRC_START 初始化，启动阶段的事件记在 "(startup)" 名下。
+ *          导出期间记录器保持停止，缓冲区内容不再变化；导出按行输出偏移与十六进制字节，
+ *          主机端按偏移拼回原始记录区（RecorderDataType，含对象表与符号表），与调试器
+ *          直接读内存得到的快照相同
+ */
+
+#include "rtos_trace.h"
+#include <stdio.h>
+
+#if APP_USE_TRACE
+
+#include "mission.h"
+#include "board_delay.h"
+
+static traceHandle s_isr_handle[RTOS_TRACE_ISR_COUNT];
+static traceString s_channel[RTOS_TRACE_CH_COUNT];
+static const char *const s_isr_names[RTOS_TRACE_ISR_COUNT] = { "wheel_isr", "imu_isr", "echo_isr", "sleep_isr" };
+static const char *const s_channel_names[RTOS_TRACE_CH_COUNT] = { "ctrl", "sensor" };
+
+static uint64_t s_ctrl_last_us = 0;        // 上一次控制周期唤醒时刻（0: 未开始）
+static uint32_t s_ctrl_max_us = 0;         // 最大唤醒间隔
+static uint32_t s_ctrl_overruns = 0;       // 超时次数
+static volatile bool s_dump_active = false;
+static uint32_t s_dump_off = 0;
+
+void RtosTrace_Init(void)
+{
+	vTraceEnable(TRC_START);
+	// 中断优先级只用于 Tracealyzer 显示，三个中断同级
+	for (uint8_t i = 0; i < RTOS_TRACE_ISR_COUNT; i++) {
+		s_isr_handle[i] = xTraceSetISRProperties(s_isr_names[i], 1);
+	}
+	for (uint8_t i = 0; i < RTOS_TRACE_CH_COUNT; i++) {
+		s_channel[i] = xTraceRegisterString(s_channel_names[i]);
+	}
+}
+
+void RtosTrace_IsrBegin(rtos_trace_isr_t isr)
+{
+	vTraceStoreISRBegin(s_isr_handle[isr]);
+}
+
+void RtosTrace_IsrEnd(int woken)
+{
+	vTraceStoreISREnd(woken);
+}
+
+traceString RtosTrace_Channel(rtos_trace_ch_t ch)
+{
+	return s_channel[ch];
+}
+
+void RtosTrace_ControlBegin(void)
+{
+	s_ctrl_last_us = 0;
+}
+
+void RtosTrace_ControlTick(void)
+{
+	uint64_t now = board_time_us();
+	if (s_ctrl_last_us != 0U) {
+		uint32_t dt = (uint32_t)(now - s_ctrl_last_us);
+		RTOS_TRACE_EVENT(RTOS_TRACE_CH_CTRL, "period %u us", dt);
+		if (dt > s_ctrl_max_us) {
+			s_ctrl_max_us = dt;
+		}
+		if (dt > MISSION_TICK_MS * 1000U + RTOS_TRACE_OVERRUN_US) {
+			s_ctrl_overruns++;
+#if RTOS_TRACE_STOP_ON_OVERRUN
+			if (xTraceIsRecordingEnabled()) {
+				vTraceStop();
+				printf("[trc] 控制周期 %luus 超时，记录已停止（trace dump 导出）\r\n", (unsigned long)dt);
+			}
+#endif
+		}
+	}
+	s_ctrl_last_us = now;
+}
+
+void RtosTrace_Print(void)
+{
+	const char *err = xTraceGetLastError();
+	printf("[trc] %s events=%lu/%lu%s buffer=%luB freq=%luHz\r\n", xTraceIsRecordingEnabled() ? "记录中" : "已停止",
+	       (unsigned long)RecorderDataPtr->numEvents, (unsigned long)RecorderDataPtr->maxEvents,
+	       RecorderDataPtr->bufferIsFull ? " 已回绕" : "", (unsigned long)uiTraceGetTraceBufferSize(),
+	       (unsigned long)RecorderDataPtr->frequency);
+	printf("[trc] ctrl max=%luus overruns=%lu%s%s\r\n", (unsigned long)s_ctrl_max_us,
+	       (unsigned long)s_ctrl_overruns, err != NULL ? " 错误: " : "", err != NULL ? err : "");
+}
+
+bool RtosTrace_Start(void)
+{
+	if (s_dump_active) {
+		return false;
+	}
+	vTraceClear();
+	s_ctrl_max_us = 0;
+	s_ctrl_overruns = 0;
+	return uiTraceStart() != 0U;
+}
+
+void RtosTrace_Stop(void)
+{
+	vTraceStop();
+}
+
+bool RtosTrace_DumpBegin(void)
+{
+	vTraceStop();
+	s_dump_off = 0;
+	s_dump_active = true;
+	printf("[trc] begin size=%lu freq=%lu events=%lu\r\n", (unsigned long)uiTraceGetTraceBufferSize(),
+	       (unsigned long)RecorderDataPtr->frequency, (unsigned long)RecorderDataPtr->numEvents);
+	return true;
+}
+
+bool RtosTrace_DumpPoll(uint16_t max_lines)
+{
+	if (!s_dump_active) {
+		return false;
+	}
+	const uint8_t *buf = (const uint8_t *)xTraceGetTraceBuffer();
+	const uint32_t size = uiTraceGetTraceBufferSize();
+	for (uint16_t n = 0; n < max_lines && s_dump_off < size; ++n) {
+		uint32_t len = size - s_dump_off;
+		if (len > RTOS_TRACE_DUMP_BYTES) {
+			len = RTOS_TRACE_DUMP_BYTES;
+		}
+		printf("[trc] d %05lX ", (unsigned long)s_dump_off);
+		for (uint32_t i = 0; i < len; ++i) {
+			printf("%02X", buf[s_dump_off + i]);
+		}
+		printf("\r\n");
+		s_dump_off += len;
+	}
+	if (s_dump_off >= size) {
+		s_dump_active = false;
+		printf("[trc] end\r\n");
+	}
+	return s_dump_active;
+}
+
+#else
+
+void RtosTrace_Print(void)
+{
+	printf("[trc] 未启用（需 -DAPP_USE_TRACE=1 的 FreeRTOS 构建）\r\n");
+}
+
+bool RtosTrace_Start(void)
+{
+	return false;
+}
+
+void RtosTrace_Stop(void)
+{
+	RtosTrace_Print();
+}
+
+bool RtosTrace_DumpBegin(void)
+{
+	return false;
+}
+
+bool RtosTrace_DumpPoll(uint16_t max_lines)
+{
+	(void)max_lines;
+	return false;
+}
+
+#endif /* APP_USE_TRACE */
@@ -0,0 +1,122 @@
+/**
+ * @file rtos_trace.h
+ * @author 林木@江南大学
+ * @brief 内核事件追踪（APP_USE_TRACE=1 时启用 Percepio 快照记录器，否则全部为空操作）
+ * @details 记录器（SDK os/FreeRTOS trcSnapshotRecorder.c）以环形缓冲保存最近的内核事件：
+ *          任务切换、就绪、阻塞/通知等内核调用，以及本模块登记的中断进出与用户事件。
+ *          时间戳取 mtime 低 32 位（SystemTimerClock），分辨率远高于内核节拍。
+ *          控制任务每周期记录唤醒间隔，超出 MISSION_TICK_MS + RTOS_TRACE_OVERRUN_US 时停止记录，
+ *          缓冲区保留超时前的调度过程。命令行 trace dump 把记录区以十六进制文本导出，
+ *          主机端 tools/trace_convert.py 还原为 Tracealyzer 可读的 .bin 或 Perfetto 时间线
+ */
+
+#ifndef __RTOS_TRACE_H__
+#define __RTOS_TRACE_H__
+
+#include "app_config.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#if APP_USE_TRACE
+#include "FreeRTOS.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RTOS_TRACE_OVERRUN_US      2000U  // 控制周期允许的唤醒抖动，超出即视为超时
+#define RTOS_TRACE_STOP_ON_OVERRUN 1      // 1: 控制周期超时时停止记录（保留现场）
+#define RTOS_TRACE_DUMP_BYTES      32U    // 导出时每行字节数
+#define RTOS_TRACE_DUMP_LINES      4U     // 命令行每次轮询导出的行数（不撑满日志缓冲区）
+
+// 登记到记录器的中断
+typedef enum {
+    RTOS_TRACE_ISR_WHEEL = 0,   // PITMR 车轮采样释放
+    RTOS_TRACE_ISR_IMU,         // H30 数据就绪
+    RTOS_TRACE_ISR_ECHO,        // 超声波 ECHO
+    RTOS_TRACE_ISR_SLEEP,       // PITMR 亚节拍休眠释放
+    RTOS_TRACE_ISR_COUNT
+} rtos_trace_isr_t;
+
+// 用户事件通道
+typedef enum {
+    RTOS_TRACE_CH_CTRL = 0,     // 控制任务
+    RTOS_TRACE_CH_SENSOR,       // 传感器采集
+    RTOS_TRACE_CH_COUNT
+} rtos_trace_ch_t;
+
+#if APP_USE_TRACE
+
+/**
+ * @brief 初始化并启动记录器，登记中断与用户事件通道（AppRtos_Start 中创建任何内核对象之前调用）
+ */
+void RtosTrace_Init(void);
+
+// 中断入口/出口（出口参数为是否请求任务切换）
+void RtosTrace_IsrBegin(rtos_trace_isr_t isr);
+void RtosTrace_IsrEnd(int woken);
+
+/**
+ * @brief 控制任务开始周期调度前调用：清除上一次的唤醒时刻
+ */
+void RtosTrace_ControlBegin(void);
+
+/**
+ * @brief 控制任务每次周期唤醒后调用：记录唤醒间隔，超时计数并按配置停止记录
+ */
+void RtosTrace_ControlTick(void);
+
+// 用户事件通道（vTracePrintF 用）
+traceString RtosTrace_Channel(rtos_trace_ch_t ch);
+
+// 用户事件：格式串只用 %d/%u/%x（32 位整数），不支持浮点
+#define RTOS_TRACE_EVENT(ch, ...)  vTracePrintF(RtosTrace_Channel(ch), __VA_ARGS__)
+
+#else
+
+static inline void RtosTrace_Init(void) {}
+static inline void RtosTrace_IsrBegin(rtos_trace_isr_t isr) { (void)isr; }
+static inline void RtosTrace_IsrEnd(int woken) { (void)woken; }
+static inline void RtosTrace_ControlBegin(void) {}
+static inline void RtosTrace_ControlTick(void) {}
+
+#define RTOS_TRACE_EVENT(ch, ...)  ((void)0)
+
+#endif /* APP_USE_TRACE */
+
+// 以下接口两种构建均可调用，未启用时只打印提示
+
+/**
+ * @brief 打印记录器状态（是否记录中、事件数、缓冲区是否回绕、控制周期超时次数、最近错误）
+ */
+void RtosTrace_Print(void);
+
+/**
+ * @brief 清空缓冲区并重新开始记录
+ * @return 成功返回 true（导出进行中或记录器出错时返回 false）
+ */
+bool RtosTrace_Start(void);
+
+/**
+ * @brief 停止记录（缓冲区保留）
+ */
+void RtosTrace_Stop(void);
+
+/**
+ * @brief 开始导出：停止记录并打印表头，之后由 RtosTrace_DumpPoll 分批输出
+ * @return 成功返回 true
+ */
+bool RtosTrace_DumpBegin(void);
+
+/**
+ * @brief 导出至多 max_lines 行
+ * @return 仍有待导出内容返回 true
+ */
+bool RtosTrace_DumpPoll(uint16_t max_lines);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __RTOS_TRACE_H__
@@ -0,0 +1,468 @@
+/**
+ * @file sd_log.c
+ * @author 林木@江南大学
+ * @brief SD 卡运行记录实现
+ * @details 单生产者/单写入方：控制周期（生产方）只写当前填充缓冲与超级块镜像，写入方只读已提交的
+ *          缓冲与镜像并写卡；缓冲状态为交接标志，扇区地址与 CRC 都在生产方算好，
+ *          写入方不使用 CRC 单元（与控制周期共用），无需加锁。
+ *          两个缓冲按 0、1 交替填充与写出，写出顺序与填充顺序一致
+ */
+
+#include "sd_log.h"
+#include "sdk_project_config.h"
+#include "spi_sd_driver.h"
+#include "nvm_store.h"
+#include "board_delay.h"
+#include <stdio.h>
+#include <string.h>
+
+#define SDLOG_SECTOR_MAGIC  0x314C4453UL   // "SDL1"
+#define SDLOG_SUPER_MAGIC   0x534C4453UL   // "SDLS"
+#define SDLOG_VERSION       1U
+#define SDLOG_RUN_SLOTS     30U
+#define SDLOG_RUN_CLOSED    0x0001U
+#define SDLOG_MBR_TABLE     446U
+#define SDLOG_NO_BUF        0xFFU
+
+// 数据扇区头（小端）；CRC-32 覆盖 run 起至扇区末尾
+typedef struct {
+	uint32_t magic;
+	uint32_t crc32;
+	uint16_t run;
+	uint16_t n_rec;
+	uint32_t seq;       // 运行内扇区序号
+} sdlog_sector_hdr_t;
+
+typedef struct {
+	uint16_t run;
+	uint16_t flags;
+	uint32_t start;     // 数据区扇区偏移
+	uint32_t sectors;
+	uint32_t t_start_ms;
+} sdlog_run_t;
+
+// 超级块（分区第 0 扇区）；CRC-32 覆盖 version 起至扇区末尾
+typedef struct {
+	uint32_t magic;
+	uint32_t crc32;
+	uint16_t version;
+	uint16_t runs;      // 累计运行次数（最近一次运行号）
+	uint32_t next;      // 下一次运行的数据区偏移
+	uint32_t data_sectors;
+	uint32_t reserved[3];
+	sdlog_run_t run[SDLOG_RUN_SLOTS];
+} sdlog_super_t;
+
+typedef struct {
+	sdlog_sector_hdr_t hdr;
+	flight_rec_t rec[SD_LOG_RECS_PER_SECTOR];
+	uint8_t pad[SD_LOG_SECTOR - sizeof(sdlog_sector_hdr_t) - SD_LOG_RECS_PER_SECTOR * sizeof(flight_rec_t)];
+} sdlog_sector_t;
+
+_Static_assert(sizeof(sdlog_sector_t) == SD_LOG_SECTOR, "数据扇区应为 512 字节");
+_Static_assert(sizeof(sdlog_super_t) == SD_LOG_SECTOR, "超级块应为 512 字节");
+
+typedef enum {
+	SDLOG_BUF_FREE = 0,
+	SDLOG_BUF_FILLING,  // 生产方持有
+	SDLOG_BUF_FULL      // 已提交，写入方持有
+} sdlog_buf_state_t;
+
+static bool s_ready = false;
+static uint32_t s_part_lba = 0;         // 分区起始扇区（超级块）
+static void (*s_writer_hook)(void) = NULL;
+
+// 生产方状态
+static sdlog_super_t s_super;
+static sdlog_sector_t s_buf[2][SD_LOG_BUF_SECTORS];
+static volatile uint8_t s_buf_state[2] = { SDLOG_BUF_FREE, SDLOG_BUF_FREE };
+static uint32_t s_buf_base[2];          // 缓冲首扇区的数据区偏移
+static uint8_t s_buf_sectors[2];        // 已提交扇区数
+static uint16_t s_buf_recs[2];
+static uint8_t s_fill = SDLOG_NO_BUF;   // 正在填充的缓冲
+static uint8_t s_next_fill = 0;
+static uint8_t s_fill_sector = 0;
+static uint32_t s_assign = 0;           // 下一个缓冲的数据区偏移
+static bool s_run_active = false;
+static uint32_t s_run_seq = 0;          // 运行内扇区序号
+static uint32_t s_checkpoint_seq = 0;
+static uint32_t s_recs_in = 0;
+static uint32_t s_dropped = 0;
+static uint32_t s_hwm_recs = 0;         // 缓冲中待写记录数的最大值
+
+// 超级块镜像：生产方生成，写入方写出
+static sdlog_super_t s_sb_img[2];
+static volatile int32_t s_sb_pend = -1;     // 字宽：写入方以比较交换清除
+static volatile int8_t s_sb_writing = -1;
+
+// 写入方状态
+static uint8_t s_wr_buf = 0;
+static uint8_t s_wr_off = 0;
+static volatile uint32_t s_recs_out = 0;
+static uint32_t s_write_errors = 0;
+static uint32_t s_max_write_ms = 0;
+static uint32_t s_writes = 0;
+
+static uint32_t sdlog_lba(uint32_t offset)
+{
+	return s_part_lba + 1U + offset;
+}
+
+static uint32_t sdlog_wrap(uint32_t offset)
+{
+	return (offset >= s_super.data_sectors) ? (offset - s_super.data_sectors) : offset;
+}
+
+static uint32_t sdlog_align(uint32_t offset)
+{
+	return sdlog_wrap((offset + SD_LOG_BUF_SECTORS - 1U) / SD_LOG_BUF_SECTORS * SD_LOG_BUF_SECTORS);
+}
+
+static void sdlog_notify(void)
+{
+	if (s_writer_hook != NULL) {
+		s_writer_hook();
+	}
+}
+
+// ========================
+// 生产方
+// ========================
+
+// 生成超级块镜像交给写入方（正在写出的镜像不改动）
+static void sdlog_publish_super(void)
+{
+	int8_t idx = (s_sb_writing == 0) ? 1 : 0;
+	sdlog_super_t *img = &s_sb_img[idx];
+	*img = s_super;
+	img->magic = SDLOG_SUPER_MAGIC;
+	img->crc32 = NVM_Crc32(&img->version, SD_LOG_SECTOR - 8U);
+	__sync_synchronize();
+	s_sb_pend = idx;
+	sdlog_notify();
+}
+
+static sdlog_run_t *sdlog_slot(uint16_t run)
+{
+	return &s_super.run[run % SDLOG_RUN_SLOTS];
+}
+
+// 当前扇区写满或运行结束：填扇区头
+static void sdlog_seal_sector(void)
+{
+	sdlog_sector_t *sec = &s_buf[s_fill][s_fill_sector];
+	sec->hdr.magic = SDLOG_SECTOR_MAGIC;
+	sec->hdr.run = s_super.runs;
+	sec->hdr.seq = s_run_seq++;
+	sec->hdr.crc32 = NVM_Crc32(&sec->hdr.run, SD_LOG_SECTOR - 8U);
+	s_fill_sector++;
+}
+
+// 提交填充缓冲；跨过检查点间隔时更新超级块
+static void sdlog_commit(void)
+{
+	uint8_t b = s_fill;
+	s_buf_sectors[b] = s_fill_sector;
+	s_assign = sdlog_wrap(s_buf_base[b] + SD_LOG_BUF_SECTORS);
+	s_fill = SDLOG_NO_BUF;
+	// 扇区数与基址先于 FULL 标志可见
+	__sync_synchronize();
+	s_buf_state[b] = SDLOG_BUF_FULL;
+	if (s_run_active && s_run_seq - s_checkpoint_seq >= SD_LOG_CHECKPOINT_SECTORS) {
+		s_checkpoint_seq = s_run_seq;
+		sdlog_slot(s_super.runs)->sectors = s_run_seq;
+		sdlog_publish_super();
+	} else {
+		sdlog_notify();
+	}
+}
+
+void SdLog_Append(const flight_rec_t *rec)
+{
+	if (!s_run_active) {
+		return;
+	}
+	if (s_fill == SDLOG_NO_BUF) {
+		if (s_buf_state[s_next_fill] != SDLOG_BUF_FREE) {
+			// 两个缓冲都在等待写出（SD 卡写入延迟过长）
+			s_dropped++;
+			return;
+		}
+		s_fill = s_next_fill;
+		s_next_fill ^= 1U;
+		s_buf_state[s_fill] = SDLOG_BUF_FILLING;
+		s_buf_base[s_fill] = s_assign;
+		s_buf_recs[s_fill] = 0;
+		s_fill_sector = 0;
+		memset(s_buf[s_fill], 0, sizeof(s_buf[s_fill]));
+	}
+	sdlog_sector_t *sec = &s_buf[s_fill][s_fill_sector];
+	sec->rec[sec->hdr.n_rec++] = *rec;
+	s_buf_recs[s_fill]++;
+	s_recs_in++;
+	uint32_t buffered = s_recs_in - s_recs_out;
+	if (buffered > s_hwm_recs) {
+		s_hwm_recs = buffered;
+	}
+	if (sec->hdr.n_rec >= SD_LOG_RECS_PER_SECTOR) {
+		sdlog_seal_sector();
+		if (s_fill_sector >= SD_LOG_BUF_SECTORS) {
+			sdlog_commit();
+		}
+	}
+}
+
+static bool sdlog_idle(void)
+{
+	return s_fill == SDLOG_NO_BUF && s_buf_state[0] == SDLOG_BUF_FREE && s_buf_state[1] == SDLOG_BUF_FREE &&
+	       s_sb_pend < 0 && s_sb_writing < 0;
+}
+
+void SdLog_StartRun(void)
+{
+	if (!s_ready) {
+		return;
+	}
+	if (!sdlog_idle()) {
+		(void)SdLog_Flush(SD_LOG_FLUSH_MS);
+	}
+	s_super.runs++;
+	sdlog_run_t *r = sdlog_slot(s_super.runs);
+	r->run = s_super.runs;
+	r->flags = 0;
+	r->start = s_assign;
+	r->sectors = 0;
+	r->t_start_ms = board_time_ms();
+	s_run_seq = 0;
+	s_checkpoint_seq = 0;
+	s_run_active = true;
+	sdlog_publish_super();
+}
+
+void SdLog_StopRun(void)
+{
+	if (!s_run_active) {
+		return;
+	}
+	s_run_active = false;
+	if (s_fill != SDLOG_NO_BUF) {
+		if (s_buf[s_fill][s_fill_sector].hdr.n_rec > 0U) {
+			sdlog_seal_sector();
+		}
+		sdlog_commit();
+	}
+	sdlog_run_t *r = sdlog_slot(s_super.runs);
+	r->sectors = s_run_seq;
+	r->flags = SDLOG_RUN_CLOSED;
+	s_super.next = s_assign;
+	sdlog_publish_super();
+}
+
+// ========================
+// 写入方
+// ========================
+
+bool SdLog_Service(uint8_t max_sectors)
+{
+	if (!s_ready) {
+		return false;
+	}
+	uint8_t b = s_wr_buf;
+	if (s_buf_state[b] == SDLOG_BUF_FULL) {
+		__sync_synchronize();
+		uint8_t n = (uint8_t)(s_buf_sectors[b] - s_wr_off);
+		if (n > max_sectors) {
+			n = max_sectors;
+		}
+		if (n > 0U) {
+			uint32_t t0 = board_time_ms();
+			if (SD_DRV_WriteDisk(INST_SPI_3, (uint8_t *)&s_buf[b][s_wr_off], sdlog_lba(s_buf_base[b] + s_wr_off), n) != 0U) {
+				s_write_errors++;
+			}
+			uint32_t dt = board_time_ms() - t0;
+			if (dt > s_max_write_ms) {
+				s_max_write_ms = dt;
+			}
+			s_writes++;
+			s_wr_off = (uint8_t)(s_wr_off + n);
+		}
+		if (s_wr_off >= s_buf_sectors[b]) {
+			s_recs_out += s_buf_recs[b];
+			s_wr_off = 0;
+			s_wr_buf ^= 1U;
+			s_buf_state[b] = SDLOG_BUF_FREE;
+		}
+		return true;
+	}
+	// 超级块在已提交的数据之后写出
+	// 生产方优先级更高，可能在下面任意两步之间换出新镜像：先占住正在写的镜像，
+	// 只有 s_sb_pend 仍是 idx 时才清除，否则保留到下一次调用写出
+	int32_t idx = s_sb_pend;
+	if (idx >= 0) {
+		s_sb_writing = (int8_t)idx;
+		__sync_synchronize();
+		(void)__sync_bool_compare_and_swap(&s_sb_pend, idx, -1);
+		if (SD_DRV_WriteDisk(INST_SPI_3, (uint8_t *)&s_sb_img[idx], s_part_lba, 1U) != 0U) {
+			s_write_errors++;
+		}
+		s_sb_writing = -1;
+		return true;
+	}
+	return false;
+}
+
+bool SdLog_Flush(uint32_t timeout_ms)
+{
+	if (!s_ready) {
+		return true;
+	}
+	uint32_t start = board_time_ms();
+	while (!sdlog_idle()) {
+		if (s_writer_hook != NULL) {
+			s_writer_hook();
+		} else {
+			(void)SdLog_Service(SD_LOG_BUF_SECTORS);
+		}
+		if (board_time_ms() - start >= timeout_ms) {
+			printf("[sdlog] 写入超时\r\n");
+			return false;
+		}
+		simple_delay_ms(1);
+	}
+	return true;
+}
+
+void SdLog_SetWriterHook(void (*hook)(void))
+{
+	s_writer_hook = hook;
+}
+
+// ========================
+// 初始化与恢复（阻塞）
+// ========================
+
+static bool sdlog_read(uint32_t lba, void *buf)
+{
+	return SD_DRV_ReadDisk(INST_SPI_3, (uint8_t *)buf, lba, 1U) == 0U;
+}
+
+static uint32_t sdlog_le32(const uint8_t *p)
+{
+	return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// MBR 中查找记录分区，返回扇区数（0 表示没有）
+static uint32_t sdlog_find_partition(uint8_t *mbr)
+{
+	if (!sdlog_read(0U, mbr) || mbr[510] != 0x55U || mbr[511] != 0xAAU) {
+		return 0;
+	}
+	for (uint8_t i = 0; i < 4U; ++i) {
+		const uint8_t *e = &mbr[SDLOG_MBR_TABLE + i * 16U];
+		if (e[4] == SD_LOG_PART_TYPE) {
+			s_part_lba = sdlog_le32(&e[8]);
+			return sdlog_le32(&e[12]);
+		}
+	}
+	return 0;
+}
+
+// 上次运行未结束：从最近检查点沿扇区头向后扫描
+static void sdlog_recover(sdlog_run_t *r)
+{
+	sdlog_sector_t *sec = &s_buf[0][0];
+	uint32_t seq = r->sectors;
+	uint32_t limit = seq + SD_LOG_CHECKPOINT_SECTORS + 2U * SD_LOG_BUF_SECTORS;
+	while (seq < limit && seq < s_super.data_sectors &&
+	       sdlog_read(sdlog_lba(sdlog_wrap(r->start + seq)), sec) && sec->hdr.magic == SDLOG_SECTOR_MAGIC &&
+	       sec->hdr.run == r->run && sec->hdr.seq == seq &&
+	       sec->hdr.crc32 == NVM_Crc32(&sec->hdr.run, SD_LOG_SECTOR - 8U)) {
+		seq++;
+	}
+	r->sectors = seq;
+	r->flags = SDLOG_RUN_CLOSED;
+	s_super.next = sdlog_align(r->start + seq);
+	printf("[sdlog] 运行 %u 未正常结束，已恢复 %lu 扇区\r\n", r->run, (unsigned long)seq);
+}
+
+bool SdLog_Init(void)
+{
+	s_ready = false;
+	// 初始化序列要求 SCK 不高于 400kHz，完成后切换到数据速率
+	if (SPI_DRV_MasterInit(INST_SPI_3, &g_stSpiState_3, &g_stSpi3MasterConfig0) != STATUS_SUCCESS ||
+	    SD_DRV_Init(INST_SPI_3) != 0U) {
+		printf("[sdlog] 未检测到 SD 卡\r\n");
+		return false;
+	}
+	uint32_t baud;
+	(void)SPI_DRV_MasterConfigureBus(INST_SPI_3, &g_stSpi3MasterConfig1, &baud);
+
+	uint8_t *sector = (uint8_t *)s_buf[0];
+	uint32_t part_sectors = sdlog_find_partition(sector);
+	if (part_sectors <= 1U + SD_LOG_BUF_SECTORS) {
+		printf("[sdlog] SD 卡无记录分区（MBR 类型 0x%02X）\r\n", SD_LOG_PART_TYPE);
+		return false;
+	}
+	// 数据区取缓冲大小的整数倍，缓冲不跨回绕点
+	uint32_t data_sectors = (part_sectors - 1U) / SD_LOG_BUF_SECTORS * SD_LOG_BUF_SECTORS;
+	if (!sdlog_read(s_part_lba, &s_super) || s_super.magic != SDLOG_SUPER_MAGIC ||
+	    s_super.version != SDLOG_VERSION || s_super.data_sectors != data_sectors ||
+	    s_super.crc32 != NVM_Crc32(&s_super.version, SD_LOG_SECTOR - 8U)) {
+		// 新分区（或分区大小变化）：建立空超级块
+		memset(&s_super, 0, sizeof(s_super));
+		s_super.version = SDLOG_VERSION;
+		s_super.data_sectors = data_sectors;
+	} else {
+		sdlog_run_t *last = sdlog_slot(s_super.runs);
+		if (s_super.runs > 0U && last->run == s_super.runs && (last->flags & SDLOG_RUN_CLOSED) == 0U) {
+			sdlog_recover(last);
+		}
+	}
+	s_assign = sdlog_wrap(s_super.next);
+	s_ready = true;
+	sdlog_publish_super();
+	(void)SdLog_Service(0U);
+	printf("[sdlog] SD 记录分区 %luMiB 就绪，已有运行 %u 次，写指针 %lu\r\n",
+	       (unsigned long)(part_sectors >> 11), s_super.runs, (unsigned long)s_assign);
+	return true;
+}
+
+bool SdLog_IsReady(void)
+{
+	return s_ready;
+}
+
+// ========================
+// 命令行
+// ========================
+
+void SdLog_Print(void)
+{
+	if (!s_ready) {
+		printf("[sdlog] 未启用\r\n");
+		return;
+	}
+	printf("[sdlog] 运行号=%u %s 写指针=%lu 缓冲高水位=%lu/%u条 最长写入=%lums 写入=%lu 丢弃=%lu 错误=%lu\r\n",
+	       s_super.runs, s_run_active ? "记录中" : "空闲", (unsigned long)s_assign, (unsigned long)s_hwm_recs,
+	       2U * SD_LOG_BUF_SECTORS * SD_LOG_RECS_PER_SECTOR, (unsigned long)s_max_write_ms,
+	       (unsigned long)s_writes, (unsigned long)s_dropped, (unsigned long)s_write_errors);
+}
+
+void SdLog_List(void)
+{
+	if (!s_ready) {
+		printf("[sdlog] 未启用\r\n");
+		return;
+	}
+	// 按运行号从旧到新
+	uint16_t first = (s_super.runs > SDLOG_RUN_SLOTS) ? (uint16_t)(s_super.runs - SDLOG_RUN_SLOTS + 1U) : 1U;
+	for (uint16_t run = first; run != 0U && run <= s_super.runs; ++run) {
+		const sdlog_run_t *r = sdlog_slot(run);
+		if (r->run != run) {
+			continue;
+		}
+		printf("[sdlog] run=%u start=%lu sectors=%lu t0=%lums%s\r\n", r->run, (unsigned long)r->start,
+		       (unsigned long)r->sectors, (unsigned long)r->t_start_ms,
+		       (r->flags & SDLOG_RUN_CLOSED) ? "" : " 记录中");
+	}
+}
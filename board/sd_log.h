@@ -0,0 +1,70 @@
+/**
+ * @file sd_log.h
+ * @author 林木@江南大学
+ * @brief SD 卡运行记录（SPI3，spi_sd 驱动）- 原始分区顺序写入
+ * @details 不经文件系统：记录写入 MBR 中类型为 0xDA（非文件系统数据）的分区，分区第 0 扇区为超级块
+ *          （最近 30 次运行的起点/扇区数/开始时刻 + 写指针），其后为数据区，按扇区顺序追加，写满后回绕。
+ *          每个数据扇区 16 字节扇区头（魔数、CRC-32、运行号、记录数、扇区序号）+ 15 条 flight_rec_t。
+ *          控制周期只做内存拷贝（扇区写满时算一次 CRC）：两个多扇区缓冲交替，写满的缓冲由写入方
+ *          （RTOS 构建为独立的低优先级任务，裸机构建为调度空闲时间片）以多块写命令整块写出，
+ *          SD 卡写入延迟尖峰期间另一缓冲继续接收记录；两个缓冲都未写出时丢弃并计数。
+ *          超级块只在运行开始/结束及每 SD_LOG_CHECKPOINT_SECTORS 扇区更新，运行中复位后启动时
+ *          从最近的检查点向后扫描补全。主机端 tools/sdlog_extract.py 从分区/整卡镜像提取 CSV
+ */
+
+#ifndef __SD_LOG_H__
+#define __SD_LOG_H__
+
+#include "flight_rec.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SD_LOG_PART_TYPE           0xDAU   // MBR 分区类型：非文件系统数据
+#define SD_LOG_SECTOR              512U
+#define SD_LOG_RECS_PER_SECTOR     15U     // 16 字节扇区头 + 15 × 32 字节记录
+#define SD_LOG_BUF_SECTORS         4U      // 每个缓冲的扇区数（一次多块写；60 条约 1.2 s）
+#define SD_LOG_CHECKPOINT_SECTORS  128U    // 运行中超级块检查点间隔（限制复位后的扫描长度）
+#define SD_LOG_FLUSH_MS            2000U   // 任务结束后等待写完的上限
+
+/**
+ * @brief 初始化 SPI3 与 SD 卡，查找记录分区并读取超级块（上次运行中断时补全）
+ * @return 找到记录分区返回 true；否则记录器停用，其余接口为空操作
+ */
+bool SdLog_Init(void);
+bool SdLog_IsReady(void);
+
+/**
+ * @brief 设置写入方唤醒回调（RTOS 构建：通知写入任务）；未设置时由 SdLog_Flush 直接写出
+ */
+void SdLog_SetWriterHook(void (*hook)(void));
+
+// 生产方（控制周期）：开始运行、追加记录（只做拷贝，不访问 SD 卡）、结束运行
+void SdLog_StartRun(void);
+void SdLog_Append(const flight_rec_t *rec);
+void SdLog_StopRun(void);
+
+/**
+ * @brief 写入方：写出至多 max_sectors 个待写扇区或一次超级块（阻塞，SD 卡忙时可达数十毫秒）
+ * @return 本次有写入返回 true
+ */
+bool SdLog_Service(uint8_t max_sectors);
+
+/**
+ * @brief 等待全部写完（任务结束后调用）
+ * @return 在 timeout_ms 内写完返回 true
+ */
+bool SdLog_Flush(uint32_t timeout_ms);
+
+// 命令行：状态（缓冲高水位、最长写入耗时、丢弃/错误计数）、运行列表
+void SdLog_Print(void);
+void SdLog_List(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __SD_LOG_H__
@@ -39,6 +39,11 @@
 #include "peripherals_uart_5_config.h"
 #include "peripherals_i2c_0_config.h"
 #include "peripherals_pdma_0_config.h"
+#include "peripherals_flexcan_0_config.h"
+#include "peripherals_spi_0_config.h"
+#include "peripherals_spi_1_config.h"
+#include "peripherals_spi_2_config.h"
+#include "peripherals_spi_3_config.h"
 #include "pin_config.h"
 
 #endif /* __SDK_PROJECT_CONFIG_H__ */
@@ -10,6 +10,7 @@
  */
 
 #include "servo2_control.h"
+#include "board_delay.h"
 
 // 全局变量
 static servo2_control_t g_servo2_control = {
@@ -19,14 +20,16 @@ static servo2_control_t g_servo2_control = {
     .state = SERVO2_STATE_IDLE,
     .is_initialized = false
 };
+static uint8_t g_servo2_pending_cycles = 0;  // 非阻塞设置后尚未发送的 PWM 周期数
+static int16_t g_servo2_trim_us = 0;         // 脉宽修正（微秒），来自标定记录
 
 /**
  * @brief 精确延时函数(微秒级)
  * @param us 延时时间(微秒)
  */
 void servo2_delay_us(uint32_t us) {
-    // 使用系统提供的微秒延时函数
-    BASIC_DelayUs(us);
+    // 机器定时器计时的忙等延时
+    board_delay_us(us);
 }
 
 /**
@@ -42,10 +45,30 @@ uint32_t servo2_angle_to_pulse_us(uint16_t angle) {
 
     // 线性插值计算脉宽
     // 脉宽 = 最小脉宽 + (最大脉宽 - 最小脉宽) * 角度 / 180
-    uint32_t pulse_us = SERVO2_MIN_PULSE_US +
-                       ((SERVO2_MAX_PULSE_US - SERVO2_MIN_PULSE_US) * angle) / SERVO2_ANGLE_MAX;
+    int32_t pulse_us = (int32_t)(SERVO2_MIN_PULSE_US +
+                       ((SERVO2_MAX_PULSE_US - SERVO2_MIN_PULSE_US) * angle) / SERVO2_ANGLE_MAX);
+
+    // 叠加装配偏差修正，并限制在有效脉宽范围内
+    pulse_us += g_servo2_trim_us;
+    if (pulse_us < (int32_t)SERVO2_MIN_PULSE_US) pulse_us = SERVO2_MIN_PULSE_US;
+    if (pulse_us > (int32_t)SERVO2_MAX_PULSE_US) pulse_us = SERVO2_MAX_PULSE_US;
+    return (uint32_t)pulse_us;
+}
+
+/**
+ * @brief 设置脉宽修正（补偿舵机装配零位偏差）
+ * @param trim_us 修正量(微秒)
+ */
+void servo2_set_trim_us(int16_t trim_us) {
+    g_servo2_trim_us = trim_us;
+}
 
-    return pulse_us;
+/**
+ * @brief 获取脉宽修正
+ * @return 修正量(微秒)
+ */
+int16_t servo2_get_trim_us(void) {
+    return g_servo2_trim_us;
 }
 
 /**
@@ -53,6 +76,9 @@ uint32_t servo2_angle_to_pulse_us(uint16_t angle) {
  * @param pulse_width_us 脉宽(微秒)
  */
 void servo2_send_pulse(uint32_t pulse_width_us) {
+    // 高电平期间禁止任务切换，保证脉宽
+    board_sched_lock();
+
     // 设置GPIO为高电平
     PINS_DRV_WritePin(PORTC, 4U, 1);  // SERVO2_GPIO_PORT, SERVO2_GPIO_PIN
 
@@ -61,11 +87,12 @@ void servo2_send_pulse(uint32_t pulse_width_us) {
 
     // 设置GPIO为低电平
     PINS_DRV_WritePin(PORTC, 4U, 0);  // SERVO2_GPIO_PORT, SERVO2_GPIO_PIN
+    board_sched_unlock();
 
-    // 计算剩余的低电平时间
+    // 计算剩余的低电平时间（期间休眠）
     uint32_t low_time_us = SERVO2_PERIOD_US - pulse_width_us;  // SERVO2_PERIOD_US
     if (low_time_us > 0) {
-        servo2_delay_us(low_time_us);
+        board_sleep_us(low_time_us);
     }
 }
 
@@ -96,7 +123,7 @@ void myservo_left90(void) {
 	int i;
 	for(i=0;i<=90;i+=30){
 		servo2_set_angle(90-i);
-		BASIC_DelayUs(400000);
+		simple_delay_ms(400);
 	}
 }
 
@@ -104,7 +131,7 @@ void myservo_right90(void) {
 	int i;
 	for(i=0;i<=90;i+=30){
 		servo2_set_angle(90+i);
-		BASIC_DelayUs(400000);
+		simple_delay_ms(400);
 	}
 }
 
@@ -135,6 +162,42 @@ void servo2_set_angle(uint16_t angle) {
     g_servo2_control.state = SERVO2_STATE_IDLE;
 }
 
+/**
+ * @brief 非阻塞设置舵机角度：只记录目标并置为 MOVING，PWM 周期由 servo2_service() 逐个发送
+ * @param angle 舵机角度(0-180度)
+ */
+void servo2_set_angle_async(uint16_t angle) {
+    if (!g_servo2_control.is_initialized) {
+        return;
+    }
+    if (angle > SERVO2_ANGLE_MAX) {
+        angle = SERVO2_ANGLE_MAX;
+    }
+    g_servo2_control.target_angle = angle;
+    g_servo2_control.current_pulse_us = servo2_angle_to_pulse_us(angle);
+    g_servo2_control.current_angle = angle;
+    g_servo2_pending_cycles = SERVO2_PWM_CYCLES;
+    g_servo2_control.state = SERVO2_STATE_MOVING;
+}
+
+/**
+ * @brief 发送一个待发 PWM 周期（阻塞一个舵机周期 20ms），发完后回到 IDLE
+ * @return 是否发送了脉冲
+ */
+bool servo2_service(void) {
+    if (!g_servo2_control.is_initialized || g_servo2_pending_cycles == 0U) {
+        return false;
+    }
+    servo2_send_pulse(g_servo2_control.current_pulse_us);
+    // 目标可能在脉冲期间被其他任务更新，计数递减不可被打断
+    board_sched_lock();
+    if (g_servo2_pending_cycles > 0U && --g_servo2_pending_cycles == 0U) {
+        g_servo2_control.state = SERVO2_STATE_IDLE;
+    }
+    board_sched_unlock();
+    return true;
+}
+
 /**
  * @brief 舵机左转90度 (从当前位置转到0度)
  */
@@ -248,16 +311,16 @@ void servo2_rotate_relative_time(int16_t degrees) {
     servo2_rotate_continuous(speed);
     
     // 等待指定时间
-    servo2_delay_us(rotate_time_ms * 1000);  // 转换为微秒
+    simple_delay_ms(rotate_time_ms);
     
     // 停止
     servo2_rotate_continuous(0);
 }
 
 /**
- * @brief 初始化第二个舵机
+ * @brief 初始化第二个舵机，回中脉冲留给 servo2_service() 发送
  */
-void servo2_init(void) {
+void servo2_init_async(void) {
     // 初始化GPIO引脚为低电平
     PINS_DRV_WritePin(PORTC, 4U, 0);  // SERVO2_GPIO_PORT, SERVO2_GPIO_PIN
     
@@ -268,8 +331,17 @@ void servo2_init(void) {
     g_servo2_control.state = SERVO2_STATE_IDLE;
     g_servo2_control.is_initialized = true;
 
-    // 设置舵机到中心位置
-    servo2_set_angle(SERVO2_ANGLE_CENTER);
+    // 设置舵机到中心位置（状态为 MOVING，脉冲由 servo2_service() 发送）
+    servo2_set_angle_async(SERVO2_ANGLE_CENTER);
+}
+
+/**
+ * @brief 初始化第二个舵机（阻塞直到回中完成）
+ */
+void servo2_init(void) {
+    servo2_init_async();
+    while (servo2_service()) {
+    }
 }
 
 /**
@@ -299,13 +371,13 @@ void servo2_demo(void) {
     // 0->180度
     for (uint16_t angle = SERVO2_ANGLE_MIN; angle <= SERVO2_ANGLE_MAX; angle += 10) {
         servo2_set_angle(angle);
-        servo2_delay_us(200000); // 延时200ms
+        simple_delay_ms(200); // 延时200ms
     }
 
     // 180->0度
     for (uint16_t angle = SERVO2_ANGLE_MAX; angle >= SERVO2_ANGLE_MIN; angle -= 10) {
         servo2_set_angle(angle);
-        servo2_delay_us(200000); // 延时200ms
+        simple_delay_ms(200); // 延时200ms
 
         // 防止无符号整数下溢
         if (angle == SERVO2_ANGLE_MIN) {
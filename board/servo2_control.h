@@ -66,6 +66,13 @@ typedef struct {
  */
 uint32_t servo2_angle_to_pulse_us(uint16_t angle);
 
+/**
+ * @brief 设置/获取脉宽修正（补偿舵机装配零位偏差，作用于所有角度）
+ * @param trim_us 修正量(微秒)
+ */
+void servo2_set_trim_us(int16_t trim_us);
+int16_t servo2_get_trim_us(void);
+
 /**
  * @brief 发送单个PWM脉冲
  * @param pulse_width_us 脉宽(微秒)
@@ -85,6 +92,18 @@ void servo2_send_pwm_cycles(uint32_t pulse_width_us, uint8_t cycles);
  */
 void servo2_set_angle(uint16_t angle);
 
+/**
+ * @brief 非阻塞设置舵机角度（PWM 周期由 servo2_service() 逐个发送，完成前状态为 MOVING）
+ * @param angle 舵机角度(0-180度)
+ */
+void servo2_set_angle_async(uint16_t angle);
+
+/**
+ * @brief 发送一个待发 PWM 周期（阻塞 20ms）
+ * @return 是否发送了脉冲
+ */
+bool servo2_service(void);
+
 /**
  * @brief 舵机左转90度 (从当前位置转到0度)
  */
@@ -101,10 +120,15 @@ void servo2_turn_right_90(void);
 void servo2_turn_center(void);
 
 /**
- * @brief 初始化第二个舵机
+ * @brief 初始化第二个舵机（阻塞直到回中完成）
  */
 void servo2_init(void);
 
+/**
+ * @brief 初始化第二个舵机，回中脉冲留给 servo2_service() 发送
+ */
+void servo2_init_async(void);
+
 /**
  * @brief 获取舵机当前角度
  * @return 当前角度值
@@ -9,36 +9,54 @@
  */
 
 #include "servo_control.h"
+#include "board_delay.h"
 
 // 控制状态
 static struct {
     uint16_t current_angle;
     uint16_t target_angle;
     uint32_t current_pulse_us;
+    uint8_t pending_cycles;      // 非阻塞设置后尚未发送的 PWM 周期数
     bool is_initialized;
 } g_servo_ctrl = {
     .current_angle = SERVO_ANGLE_CENTER,
     .target_angle = SERVO_ANGLE_CENTER,
     .current_pulse_us = SERVO_CENTER_PULSE_US,
+    .pending_cycles = 0,
     .is_initialized = false
 };
+static int16_t s_servo_trim_us = 0;   // 脉宽修正（微秒），来自标定记录
 
 uint32_t servo_angle_to_pulse_us(uint16_t angle) {
     if (angle > SERVO_ANGLE_MAX) {
         angle = SERVO_ANGLE_MAX;
     }
-    uint32_t pulse_us = SERVO_MIN_PULSE_US +
-                        ((SERVO_MAX_PULSE_US - SERVO_MIN_PULSE_US) * angle) / SERVO_ANGLE_MAX;
-    return pulse_us;
+    int32_t pulse_us = (int32_t)(SERVO_MIN_PULSE_US +
+                        ((SERVO_MAX_PULSE_US - SERVO_MIN_PULSE_US) * angle) / SERVO_ANGLE_MAX);
+    // 叠加装配偏差修正，并限制在有效脉宽范围内
+    pulse_us += s_servo_trim_us;
+    if (pulse_us < (int32_t)SERVO_MIN_PULSE_US) pulse_us = SERVO_MIN_PULSE_US;
+    if (pulse_us > (int32_t)SERVO_MAX_PULSE_US) pulse_us = SERVO_MAX_PULSE_US;
+    return (uint32_t)pulse_us;
+}
+
+void servo_set_trim_us(int16_t trim_us) {
+    s_servo_trim_us = trim_us;
+}
+
+int16_t servo_get_trim_us(void) {
+    return s_servo_trim_us;
 }
 
 void servo_send_pulse(uint32_t pulse_width_us) {
+    board_sched_lock();                                     // 高电平期间禁止任务切换
     PINS_DRV_WritePin(SERVO_GPIO_PORT, SERVO_GPIO_PIN, 1);  // 高电平
-    BASIC_DelayUs(pulse_width_us);                          // 保持脉宽时间
+    board_delay_us(pulse_width_us);                         // 保持脉宽时间（忙等，保证精度）
     PINS_DRV_WritePin(SERVO_GPIO_PORT, SERVO_GPIO_PIN, 0);  // 低电平
+    board_sched_unlock();
     uint32_t low_time_us = SERVO_PERIOD_US - pulse_width_us;
     if (low_time_us > 0) {
-        BASIC_DelayUs(low_time_us);                          // 保持低电平时间
+        board_sleep_us(low_time_us);                         // 低电平期间休眠
     }
 }
 
@@ -72,11 +90,42 @@ void servo_set_angle(uint16_t angle) {
     g_servo_ctrl.current_angle = angle;
 }
 
+void servo_set_angle_async(uint16_t angle) {
+    if (!g_servo_ctrl.is_initialized) {
+        return;
+    }
+    if (angle > SERVO_ANGLE_MAX) {
+        angle = SERVO_ANGLE_MAX;
+    }
+    g_servo_ctrl.target_angle = angle;
+    g_servo_ctrl.current_pulse_us = servo_angle_to_pulse_us(angle);
+    g_servo_ctrl.current_angle = angle;
+    g_servo_ctrl.pending_cycles = SERVO_PWM_CYCLES;
+}
+
+bool servo_service(void) {
+    if (!g_servo_ctrl.is_initialized || g_servo_ctrl.pending_cycles == 0U) {
+        return false;
+    }
+    servo_send_pulse(g_servo_ctrl.current_pulse_us);
+    // 目标可能在脉冲期间被其他任务更新，计数递减不可被打断
+    board_sched_lock();
+    if (g_servo_ctrl.pending_cycles > 0U) {
+        g_servo_ctrl.pending_cycles--;
+    }
+    board_sched_unlock();
+    return true;
+}
+
+bool servo_is_busy(void) {
+    return g_servo_ctrl.pending_cycles != 0U;
+}
+
 uint16_t servo_get_current_angle(void) {
     return g_servo_ctrl.current_angle;
 }
 
-void servo_init(void) {
+void servo_init_async(void) {
     // 置低电平
     PINS_DRV_WritePin(SERVO_GPIO_PORT, SERVO_GPIO_PIN, 0);
 
@@ -85,16 +134,20 @@ void servo_init(void) {
     g_servo_ctrl.current_pulse_us = SERVO_CENTER_PULSE_US;
     g_servo_ctrl.is_initialized = true;
 
-    // 上电设置到中心位置
-    servo_set_angle(SERVO_ANGLE_CENTER);
+    // 上电回中：脉冲由 servo_service() 发送
+    servo_set_angle_async(SERVO_ANGLE_CENTER);
 }
 
-void delay_ms(uint32_t ms) {
-    for (volatile uint32_t i = 0; i < ms * 8000; ++i) {
-        __asm__("nop");
+void servo_init(void) {
+    servo_init_async();
+    while (servo_service()) {
     }
 }
 
+void delay_ms(uint32_t ms) {
+    simple_delay_ms(ms);
+}
+
 // 顺时针旋转指定角度
 void servo_rotate_clockwise(uint16_t degrees) {
     uint16_t new_angle = g_servo_ctrl.current_angle + degrees;
@@ -43,6 +43,13 @@
  */
 uint32_t servo_angle_to_pulse_us(uint16_t angle);
 
+/**
+ * @brief 设置/获取脉宽修正（补偿舵机装配零位偏差，作用于所有角度）
+ * @param trim_us 修正量(微秒)
+ */
+void servo_set_trim_us(int16_t trim_us);
+int16_t servo_get_trim_us(void);
+
 /**
  * @brief 发送单个PWM脉冲
  * @param pulse_width_us 脉宽(微秒)
@@ -63,10 +70,32 @@ void servo_send_pwm_cycles(uint32_t pulse_width_us, uint8_t cycles);
 void servo_set_angle(uint16_t angle);
 
 /**
- * @brief 初始化舵机
+ * @brief 非阻塞设置舵机角度：只记录目标，PWM 周期由 servo_service() 逐个发送
+ * @param angle 舵机角度(0-180度)
+ */
+void servo_set_angle_async(uint16_t angle);
+
+/**
+ * @brief 发送一个待发 PWM 周期（阻塞一个舵机周期 20ms）
+ * @return 是否发送了脉冲（无待发周期时立即返回 false）
+ */
+bool servo_service(void);
+
+/**
+ * @brief 是否仍有待发 PWM 周期
+ */
+bool servo_is_busy(void);
+
+/**
+ * @brief 初始化舵机（阻塞直到回中完成）
  */
 void servo_init(void);
 
+/**
+ * @brief 初始化舵机，回中脉冲留给 servo_service() 发送
+ */
+void servo_init_async(void);
+
 /**
  * @brief 获取舵机当前角度
  * @return 当前角度值
@@ -80,7 +109,7 @@ uint16_t servo_get_current_angle(void);
 void servo_hold_ms(uint32_t ms);
 
 /**
- * @brief 简单延时函数（兼容旧接口）
+ * @brief 简单延时函数（兼容旧接口，等同 simple_delay_ms）
  * @param ms 延时时间(毫秒)
  */
 void delay_ms(uint32_t ms);
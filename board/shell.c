@@ -0,0 +1,448 @@
+/**
+ * @file shell.c
+ * @author 林木@江南大学
+ * @brief UART2 运行时命令行实现
+ * @details 中断回调只把字节写入环形缓冲（单生产者/单消费者，无需关中断）；
+ *          命令执行中只做参数读写与状态打印，任务启动以请求标志交给主循环
+ */
+
+#include "shell.h"
+#include "sdk_project_config.h"
+#include "param.h"
+#include "my_move.h"
+#include "hcsr04.h"
+#include "mission.h"
+#include "mission_store.h"
+#include "nvm_store.h"
+#include "calib_store.h"
+#include "motor_ident.h"
+#include "odometry.h"
+#include "pose_estimator.h"
+#include "flight_rec.h"
+#include "flash_log.h"
+#include "sd_log.h"
+#include "rtos_trace.h"
+#include "net_telem.h"
+#include "lora_link.h"
+#include "can_bus.h"
+#include "fmt_lite.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SHELL_UART_INSTANCE  INST_UART_2
+
+static uint8_t s_rx_ring[SHELL_RX_RING_SIZE];
+static volatile uint16_t s_rx_head = 0;      // 中断写
+static volatile uint16_t s_rx_tail = 0;      // 主循环读
+static volatile uint32_t s_rx_overflow = 0;
+static volatile bool s_rx_rearm = false;
+static uint8_t s_rx_byte;
+
+static char s_line[SHELL_LINE_MAX];
+static uint8_t s_line_len = 0;
+static bool s_line_overlong = false;
+static uint32_t s_cmd_count = 0;
+static int s_mission_request = SHELL_MISSION_NONE;
+static void (*s_stats_hook)(void) = NULL;
+
+typedef const param_desc_t *(*param_table_fn)(uint8_t *count);
+static const param_table_fn s_param_tables[] = {
+	MyMove_GetParamTable,
+	HCSR04_GetParamTable,
+};
+
+static void shell_rx_callback(void *driverState, uart_event_t event, void *userData)
+{
+	(void)driverState;
+	(void)userData;
+	if (event == UART_EVENT_RX_FULL) {
+		uint16_t next = (uint16_t)((s_rx_head + 1U) & (SHELL_RX_RING_SIZE - 1U));
+		if (next != s_rx_tail) {
+			s_rx_ring[s_rx_head] = s_rx_byte;
+			s_rx_head = next;
+		} else {
+			s_rx_overflow++;
+		}
+		// 继续接收下一个字节
+		UART_DRV_SetRxBuffer(SHELL_UART_INSTANCE, &s_rx_byte, 1U);
+	} else if (event == UART_EVENT_ERROR || event == UART_EVENT_END_TRANSFER) {
+		s_rx_rearm = true;
+	}
+}
+
+void Shell_Init(void)
+{
+	UART_DRV_InstallRxCallback(SHELL_UART_INSTANCE, shell_rx_callback, NULL);
+	UART_DRV_ReceiveData(SHELL_UART_INSTANCE, &s_rx_byte, 1U);
+	printf("命令行就绪（UART2），输入 help 查看命令\r\n");
+}
+
+int Shell_TakeMissionRequest(void)
+{
+	int req = s_mission_request;
+	s_mission_request = SHELL_MISSION_NONE;
+	return req;
+}
+
+const param_desc_t *Shell_FindParam(const char *name)
+{
+	for (uint8_t t = 0; t < sizeof(s_param_tables) / sizeof(s_param_tables[0]); ++t) {
+		uint8_t n;
+		const param_desc_t *tab = s_param_tables[t](&n);
+		for (uint8_t i = 0; i < n; ++i) {
+			if (strcmp(tab[i].name, name) == 0) {
+				return &tab[i];
+			}
+		}
+	}
+	return NULL;
+}
+
+const param_desc_t *Shell_GetParam(uint8_t index)
+{
+	for (uint8_t t = 0; t < sizeof(s_param_tables) / sizeof(s_param_tables[0]); ++t) {
+		uint8_t n;
+		const param_desc_t *tab = s_param_tables[t](&n);
+		if (index < n) {
+			return &tab[index];
+		}
+		index = (uint8_t)(index - n);
+	}
+	return NULL;
+}
+
+static void shell_print_param(const param_desc_t *p)
+{
+	printf("%s = %.5f  [%.4f, %.4f]\r\n", p->name, *p->value, p->min, p->max);
+}
+
+static void shell_cmd_get(const char *name)
+{
+	if (name != NULL) {
+		const param_desc_t *p = Shell_FindParam(name);
+		if (p == NULL) {
+			printf("ERR 未知参数 %s\r\n", name);
+			return;
+		}
+		shell_print_param(p);
+		return;
+	}
+	for (uint8_t t = 0; t < sizeof(s_param_tables) / sizeof(s_param_tables[0]); ++t) {
+		uint8_t n;
+		const param_desc_t *tab = s_param_tables[t](&n);
+		for (uint8_t i = 0; i < n; ++i) {
+			shell_print_param(&tab[i]);
+		}
+	}
+}
+
+static void shell_cmd_set(const char *name, const char *value)
+{
+	if (name == NULL || value == NULL) {
+		printf("ERR 用法: set 名称 值\r\n");
+		return;
+	}
+	const param_desc_t *p = Shell_FindParam(name);
+	if (p == NULL) {
+		printf("ERR 未知参数 %s\r\n", name);
+		return;
+	}
+	char *end;
+	float v = strtof(value, &end);
+	if (end == value || *end != '\0' || v < p->min || v > p->max) {
+		printf("ERR 取值无效，范围 [%.4f, %.4f]\r\n", p->min, p->max);
+		return;
+	}
+	// 单个 float 写入为原子操作，控制循环下一周期即生效
+	*p->value = v;
+	shell_print_param(p);
+}
+
+static void shell_cmd_mission(const char *sub, const char *arg)
+{
+	static const char *const status_names[] = { "IDLE", "RUNNING", "DONE", "ABORTED", "FAILED" };
+	if (sub != NULL && strcmp(sub, "start") == 0) {
+		if (Mission_GetStatus() == MISSION_RUNNING) {
+			printf("ERR 任务运行中\r\n");
+			return;
+		}
+		if (arg == NULL || strcmp(arg, "builtin") == 0) {
+			s_mission_request = (arg == NULL) ? 0 : SHELL_MISSION_BUILTIN;
+		} else {
+			int slot = atoi(arg);
+			if (slot < 0 || slot >= (int)NVM_MISSION_SLOTS) {
+				printf("ERR 槽号 0~%d\r\n", NVM_MISSION_SLOTS - 1U);
+				return;
+			}
+			s_mission_request = slot;
+		}
+		printf("OK 任务启动请求已提交\r\n");
+	} else if (sub != NULL && strcmp(sub, "abort") == 0) {
+		Mission_Abort();
+		printf("OK\r\n");
+	} else if (sub != NULL && strcmp(sub, "status") == 0) {
+		mission_status_t st = Mission_GetStatus();
+		printf("mission %s step=%d t=%lums\r\n", status_names[st], Mission_GetStepIndex(),
+		       (unsigned long)Mission_GetElapsedMs());
+	} else {
+		printf("ERR 用法: mission start [槽号|builtin] | mission abort | mission status\r\n");
+	}
+}
+
+static void shell_cmd_calib(const char *sub)
+{
+	if (sub == NULL || strcmp(sub, "show") == 0) {
+		Calib_Print();
+		return;
+	}
+	// EEPROM 写入耗时较长，任务运行中不执行
+	if (Mission_GetStatus() == MISSION_RUNNING) {
+		printf("ERR 任务运行中\r\n");
+		return;
+	}
+	if (strcmp(sub, "save") == 0) {
+		printf(Calib_Save() ? "OK\r\n" : "ERR 保存失败\r\n");
+	} else if (strcmp(sub, "clear") == 0) {
+		printf(Calib_Clear() ? "OK 重启后恢复默认值\r\n" : "ERR 清除失败\r\n");
+	} else {
+		printf("ERR 用法: calib show | calib save | calib clear\r\n");
+	}
+}
+
+static void shell_cmd_motor(const char *sub)
+{
+	if (sub == NULL || strcmp(sub, "show") == 0) {
+		MotorIdent_Print();
+	} else if (strcmp(sub, "ident") == 0) {
+		if (Mission_GetStatus() == MISSION_RUNNING) {
+			printf("ERR 任务运行中\r\n");
+			return;
+		}
+		// 阻塞约 15 s，成功后写入标定记录
+		if (MotorIdent_Run() && Calib_Save()) {
+			printf("OK\r\n");
+		} else {
+			printf("ERR 自检未完成\r\n");
+		}
+	} else {
+		printf("ERR 用法: motor show | motor ident（车轮需悬空）\r\n");
+	}
+}
+
+static void shell_cmd_frec(const char *sub)
+{
+	if (sub == NULL || strcmp(sub, "show") == 0) {
+		FlightRec_Print();
+		return;
+	}
+	// 任务运行中记录持续写入，不导出/清除
+	if (Mission_GetStatus() == MISSION_RUNNING) {
+		printf("ERR 任务运行中\r\n");
+		return;
+	}
+	if (strcmp(sub, "dump") == 0) {
+		// 后续轮询分批输出，不一次占满日志缓冲
+		FlightRec_DumpBegin();
+	} else if (strcmp(sub, "clear") == 0) {
+		FlightRec_Clear();
+		printf("OK\r\n");
+	} else {
+		printf("ERR 用法: frec show | frec dump | frec clear\r\n");
+	}
+}
+
+static void shell_cmd_flog(const char *sub, const char *arg)
+{
+	if (sub == NULL || strcmp(sub, "show") == 0) {
+		FlashLog_Print();
+		return;
+	}
+	// 任务运行中 SPI2 用于写入，不读取索引/导出/清空
+	if (Mission_GetStatus() == MISSION_RUNNING) {
+		printf("ERR 任务运行中\r\n");
+		return;
+	}
+	if (strcmp(sub, "ls") == 0) {
+		FlashLog_List();
+	} else if (strcmp(sub, "dump") == 0 && arg != NULL) {
+		if (!FlashLog_DumpBegin((uint16_t)strtoul(arg, NULL, 10))) {
+			printf("ERR 无此运行或记录器忙\r\n");
+		}
+	} else if (strcmp(sub, "erase") == 0) {
+		printf(FlashLog_Erase() ? "OK\r\n" : "ERR 记录器未就绪或忙\r\n");
+	} else {
+		printf("ERR 用法: flog show | flog ls | flog dump 运行号 | flog erase\r\n");
+	}
+}
+
+static void shell_cmd_sdlog(const char *sub)
+{
+	if (sub == NULL || strcmp(sub, "show") == 0) {
+		SdLog_Print();
+	} else if (strcmp(sub, "ls") == 0) {
+		SdLog_List();
+	} else {
+		printf("ERR 用法: sdlog show | sdlog ls\r\n");
+	}
+}
+
+static void shell_cmd_trace(const char *sub)
+{
+	if (sub == NULL || strcmp(sub, "show") == 0) {
+		RtosTrace_Print();
+	} else if (strcmp(sub, "start") == 0) {
+		printf(RtosTrace_Start() ? "OK\r\n" : "ERR 未启用或导出中\r\n");
+	} else if (strcmp(sub, "stop") == 0) {
+		RtosTrace_Stop();
+	} else if (strcmp(sub, "dump") == 0) {
+		// 停止记录后分批输出，不一次占满日志缓冲
+		if (!RtosTrace_DumpBegin()) {
+			printf("ERR 未启用\r\n");
+		}
+	} else {
+		printf("ERR 用法: trace show | trace start | trace stop | trace dump\r\n");
+	}
+}
+
+static void shell_cmd_net(const char *sub)
+{
+	if (sub == NULL || strcmp(sub, "show") == 0) {
+		NetTelem_Print();
+	} else {
+		printf("ERR 用法: net show\r\n");
+	}
+}
+
+static void shell_cmd_lora(const char *sub)
+{
+	if (sub == NULL || strcmp(sub, "show") == 0) {
+		LoraLink_Print();
+	} else {
+		printf("ERR 用法: lora show\r\n");
+	}
+}
+
+static void shell_cmd_can(const char *sub)
+{
+	if (sub == NULL || strcmp(sub, "show") == 0) {
+		CanBus_Print();
+	} else if (strcmp(sub, "test") == 0) {
+		// 自检重新初始化控制器并处理参数队列，交给控制上下文执行，结果由其打印
+		(void)CanBus_RequestSelfTest();
+	} else {
+		printf("ERR 用法: can show | can test\r\n");
+	}
+}
+
+static void shell_cmd_fmt(const char *sub, const char *arg)
+{
+	if (sub != NULL && strcmp(sub, "bench") == 0) {
+		long lines = (arg != NULL) ? strtol(arg, NULL, 10) : (long)SHELL_FMT_BENCH_LINES;
+		if (lines <= 0 || lines > 100000L) {
+			printf("ERR 行数 1~100000\r\n");
+			return;
+		}
+		fmt_bench((uint32_t)lines);
+	} else {
+		printf("ERR 用法: fmt bench [行数]\r\n");
+	}
+}
+
+static void shell_cmd_stats(void)
+{
+	pose2d_t pose;
+	Pose_Get(&pose);
+	shell_cmd_mission("status", NULL);
+	printf("pose x=%.1fmm y=%.1fmm θ=%.2f° odom=%.1fmm v=%.0fmm/s\r\n",
+	       pose.x_mm, pose.y_mm, pose.theta_deg, Odom_GetDistanceMm(), Odom_GetSpeedMmS());
+	printf("turn_stop_gain=%.5f nvm=%s\r\n", MyMove_GetTurnStopGain(), NVM_IsReady() ? "ok" : "off");
+	printf("shell cmds=%lu rx_overflow=%lu\r\n", (unsigned long)s_cmd_count, (unsigned long)s_rx_overflow);
+	if (s_stats_hook != NULL) {
+		s_stats_hook();
+	}
+}
+
+void Shell_SetStatsHook(void (*hook)(void))
+{
+	s_stats_hook = hook;
+}
+
+static void shell_execute(char *line)
+{
+	char *argv[4] = { NULL, NULL, NULL, NULL };
+	uint8_t argc = 0;
+	for (char *tok = strtok(line, " \t"); tok != NULL && argc < 4U; tok = strtok(NULL, " \t")) {
+		argv[argc++] = tok;
+	}
+	if (argc == 0U) {
+		return;
+	}
+	s_cmd_count++;
+	if (strcmp(argv[0], "help") == 0) {
+		printf("help | get [名称] | set 名称 值 | mission start [槽号|builtin] | mission abort | mission status | calib show|save|clear | motor show|ident | frec show|dump|clear | flog show|ls|dump|erase | sdlog show|ls | trace show|start|stop|dump | net show | lora show | can show|test | fmt bench [行数] | stats\r\n");
+	} else if (strcmp(argv[0], "get") == 0) {
+		shell_cmd_get(argv[1]);
+	} else if (strcmp(argv[0], "set") == 0) {
+		shell_cmd_set(argv[1], argv[2]);
+	} else if (strcmp(argv[0], "mission") == 0) {
+		shell_cmd_mission(argv[1], argv[2]);
+	} else if (strcmp(argv[0], "calib") == 0) {
+		shell_cmd_calib(argv[1]);
+	} else if (strcmp(argv[0], "motor") == 0) {
+		shell_cmd_motor(argv[1]);
+	} else if (strcmp(argv[0], "frec") == 0) {
+		shell_cmd_frec(argv[1]);
+	} else if (strcmp(argv[0], "flog") == 0) {
+		shell_cmd_flog(argv[1], argv[2]);
+	} else if (strcmp(argv[0], "sdlog") == 0) {
+		shell_cmd_sdlog(argv[1]);
+	} else if (strcmp(argv[0], "trace") == 0) {
+		shell_cmd_trace(argv[1]);
+	} else if (strcmp(argv[0], "net") == 0) {
+		shell_cmd_net(argv[1]);
+	} else if (strcmp(argv[0], "lora") == 0) {
+		shell_cmd_lora(argv[1]);
+	} else if (strcmp(argv[0], "can") == 0) {
+		shell_cmd_can(argv[1]);
+	} else if (strcmp(argv[0], "fmt") == 0) {
+		shell_cmd_fmt(argv[1], argv[2]);
+	} else if (strcmp(argv[0], "stats") == 0) {
+		shell_cmd_stats();
+	} else {
+		printf("ERR 未知命令 %s\r\n", argv[0]);
+	}
+}
+
+void Shell_Poll(void)
+{
+	if (s_rx_rearm) {
+		s_rx_rearm = false;
+		UART_DRV_ReceiveData(SHELL_UART_INSTANCE, &s_rx_byte, 1U);
+	}
+	// 飞行记录/运行记录/内核追踪导出进行中：每次轮询输出一批
+	(void)FlightRec_DumpPoll(FLIGHT_REC_DUMP_LINES);
+	(void)FlashLog_DumpPoll(FLASH_LOG_DUMP_PAGES);
+	(void)RtosTrace_DumpPoll(RTOS_TRACE_DUMP_LINES);
+	for (uint8_t n = 0; n < SHELL_POLL_MAX_BYTES && s_rx_tail != s_rx_head; ++n) {
+		char c = (char)s_rx_ring[s_rx_tail];
+		s_rx_tail = (uint16_t)((s_rx_tail + 1U) & (SHELL_RX_RING_SIZE - 1U));
+		if (c == '\r' || c == '\n') {
+			if (s_line_overlong) {
+				printf("ERR 命令过长\r\n");
+			} else if (s_line_len > 0U) {
+				s_line[s_line_len] = '\0';
+				shell_execute(s_line);
+			}
+			s_line_len = 0;
+			s_line_overlong = false;
+			// 每次轮询最多执行一条命令
+			return;
+		}
+		if (s_line_len < SHELL_LINE_MAX - 1U) {
+			s_line[s_line_len++] = c;
+		} else {
+			s_line_overlong = true;
+		}
+	}
+}
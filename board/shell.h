@@ -0,0 +1,49 @@
+/**
+ * @file shell.h
+ * @author 林木@江南大学
+ * @brief UART2 运行时命令行 - 参数调节与任务启动
+ * @details 接收由 UART 中断逐字节写入环形缓冲，解析在主循环/任务调度空闲时进行，
+ *          每次轮询处理的字节数有上限，不占用控制周期；命令：
+ *          help | get [名称] | set 名称 值 | mission start [槽号|builtin] | mission abort | mission status |
+ *          calib show|save|clear | motor show|ident | frec show|dump|clear |
+ *          flog show|ls|dump|erase | sdlog show|ls | trace show|start|stop|dump | net show | lora show |
+ *          can show|test | fmt bench [行数] | stats
+ */
+
+#ifndef __SHELL_H__
+#define __SHELL_H__
+
+#include "param.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SHELL_RX_RING_SIZE     128U   // 接收环形缓冲（2 的幂）
+#define SHELL_LINE_MAX         64U    // 单行命令最大长度
+#define SHELL_POLL_MAX_BYTES   32U    // 每次轮询最多处理的字节数
+#define SHELL_FMT_BENCH_LINES  1000U  // fmt bench 默认格式化行数
+
+#define SHELL_MISSION_NONE     (-2)   // 无任务请求
+#define SHELL_MISSION_BUILTIN  (-1)   // 内置任务表
+
+// 安装 UART2 接收回调并启动中断接收
+void Shell_Init(void);
+// 处理已接收字节，遇到完整命令行时执行（在主循环或任务调度空闲钩子中调用）
+void Shell_Poll(void);
+// 取出待启动的任务请求：SHELL_MISSION_NONE / SHELL_MISSION_BUILTIN / EEPROM 槽号
+int Shell_TakeMissionRequest(void);
+// 按名称查找可调参数（网络命令通道共用同一参数表），未找到返回 NULL
+const param_desc_t *Shell_FindParam(const char *name);
+// 按索引（get 列出的顺序）取可调参数（CAN 帧放不下名称，按索引访问），越界返回 NULL
+const param_desc_t *Shell_GetParam(uint8_t index);
+// stats 命令的附加输出（如 RTOS 构建的任务栈/内存规划）
+void Shell_SetStatsHook(void (*hook)(void));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __SHELL_H__
@@ -0,0 +1,87 @@
+/**
+ * @file tlog.c
+ * @author 林木@江南大学
+ * @brief 令牌化日志帧打包与输出
+ * @details 帧格式：TLOG_SYNC | 负载长度(1) | 令牌(4) | 参数...；整帧一次写入 stdout 文件描述符，
+ *          与 printf 文本共用同一输出通道（RTOS 构建经日志流缓冲区，整帧写入或整帧丢弃）
+ */
+
+#include "tlog.h"
+
+#if APP_LOG_TOKENIZED
+
+#include <string.h>
+#include <unistd.h>
+
+#define TLOG_HEADER_BYTES  2U   // 同步字节 + 长度
+
+static volatile uint32_t s_dropped = 0;
+
+static void tlog_put(tlog_frame_t *f, const void *src, uint8_t n)
+{
+	if (f->overflow || (uint32_t)f->len + n > TLOG_FRAME_MAX) {
+		f->overflow = 1;
+		return;
+	}
+	memcpy(&f->data[f->len], src, n);
+	f->len += n;
+}
+
+void tlog_begin(tlog_frame_t *f, const char *fmt)
+{
+	uint32_t token = (uint32_t)(uintptr_t)fmt;
+	f->data[0] = TLOG_SYNC;
+	f->len = TLOG_HEADER_BYTES;
+	f->overflow = 0;
+	tlog_put(f, &token, sizeof(token));
+}
+
+void tlog_put_u32(tlog_frame_t *f, uint32_t v)
+{
+	tlog_put(f, &v, sizeof(v));
+}
+
+void tlog_put_u64(tlog_frame_t *f, uint64_t v)
+{
+	tlog_put(f, &v, sizeof(v));
+}
+
+void tlog_put_f32(tlog_frame_t *f, float v)
+{
+	tlog_put(f, &v, sizeof(v));
+}
+
+void tlog_put_ptr(tlog_frame_t *f, const void *p)
+{
+	tlog_put_u32(f, (uint32_t)(uintptr_t)p);
+}
+
+void tlog_put_str(tlog_frame_t *f, const char *s)
+{
+	if (s == NULL) {
+		s = "(null)";
+	}
+	size_t n = strlen(s);
+	uint8_t len = (uint8_t)((n > TLOG_STR_MAX) ? TLOG_STR_MAX : n);
+	tlog_put(f, &len, 1);
+	tlog_put(f, s, len);
+}
+
+void tlog_end(tlog_frame_t *f)
+{
+	if (f->overflow) {
+		s_dropped++;
+		return;
+	}
+	f->data[1] = (uint8_t)(f->len - TLOG_HEADER_BYTES);
+	// 先送出 stdio 缓冲中的文本，保持与 printf 输出的先后顺序
+	(void)fflush(stdout);
+	(void)write(STDOUT_FILENO, f->data, f->len);
+}
+
+uint32_t tlog_get_dropped(void)
+{
+	return s_dropped;
+}
+
+#endif /* APP_LOG_TOKENIZED */
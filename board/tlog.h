@@ -0,0 +1,99 @@
+/**
+ * @file tlog.h
+ * @author 林木@江南大学
+ * @brief 令牌化日志（APP_LOG_TOKENIZED=1 时启用，否则 TLOG 即 printf）
+ * @details 每个调用点的格式串放入 .tlog_fmt 段，以其链接地址作为令牌；运行时不做格式化，
+ *          只输出一帧：TLOG_SYNC、长度、令牌（4 字节）与按类型打包的原始参数（小端）：
+ *          - 浮点（float/double）：4 字节 float
+ *          - long long / unsigned long long：8 字节
+ *          - 字符串：1 字节长度 + 内容（截断到 TLOG_STR_MAX）
+ *          - 其他整数、指针：4 字节
+ *          主机端 tools/tlog_decode.py 从固件 ELF 提取字符串表，按格式串还原文本；
+ *          普通 printf 文本与帧混合输出，解码器原样透传。SDK 链接脚本（gcc_e320_flash/ram.ld.S）
+ *          把 .tlog_fmt 定义为 INFO 段，格式串只保留在 ELF 中，不占用 Flash
+ */
+
+#ifndef TLOG_H
+#define TLOG_H
+
+#include "app_config.h"
+#include <stdint.h>
+#include <stdio.h>
+
+#define TLOG_SYNC       0x1EU   // 帧起始（文本中不出现的控制字符）
+#define TLOG_FRAME_MAX  96U     // 单帧最大字节数（含帧头），超出时整帧丢弃并计数
+#define TLOG_STR_MAX    32U     // 字符串参数最大字节数
+
+#if APP_LOG_TOKENIZED
+
+typedef struct {
+	uint8_t data[TLOG_FRAME_MAX];
+	uint8_t len;
+	uint8_t overflow;
+} tlog_frame_t;
+
+void tlog_begin(tlog_frame_t *f, const char *fmt);
+void tlog_put_u32(tlog_frame_t *f, uint32_t v);
+void tlog_put_u64(tlog_frame_t *f, uint64_t v);
+void tlog_put_f32(tlog_frame_t *f, float v);
+void tlog_put_str(tlog_frame_t *f, const char *s);
+void tlog_put_ptr(tlog_frame_t *f, const void *p);
+void tlog_end(tlog_frame_t *f);
+
+// 因超长丢弃的帧数
+uint32_t tlog_get_dropped(void);
+
+#define TLOG_PUT(f, x) _Generic((x),                            \
+	float: tlog_put_f32,                                        \
+	double: tlog_put_f32,                                       \
+	long long: tlog_put_u64,                                    \
+	unsigned long long: tlog_put_u64,                           \
+	char *: tlog_put_str,                                       \
+	const char *: tlog_put_str,                                 \
+	void *: tlog_put_ptr,                                       \
+	const void *: tlog_put_ptr,                                 \
+	default: tlog_put_u32)((f), (x));
+
+// 参数个数（0..16）与逐个展开
+#define TLOG_NARG(...) TLOG_NARG_(0, ##__VA_ARGS__, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define TLOG_NARG_(_0, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, N, ...) N
+#define TLOG_CAT(a, b)  TLOG_CAT_(a, b)
+#define TLOG_CAT_(a, b) a##b
+#define TLOG_EACH(f, ...) TLOG_CAT(TLOG_EACH_, TLOG_NARG(__VA_ARGS__))(f, ##__VA_ARGS__)
+#define TLOG_EACH_0(f)
+#define TLOG_EACH_1(f, x)       TLOG_PUT(f, x)
+#define TLOG_EACH_2(f, x, ...)  TLOG_PUT(f, x) TLOG_EACH_1(f, __VA_ARGS__)
+#define TLOG_EACH_3(f, x, ...)  TLOG_PUT(f, x) TLOG_EACH_2(f, __VA_ARGS__)
+#define TLOG_EACH_4(f, x, ...)  TLOG_PUT(f, x) TLOG_EACH_3(f, __VA_ARGS__)
+#define TLOG_EACH_5(f, x, ...)  TLOG_PUT(f, x) TLOG_EACH_4(f, __VA_ARGS__)
+#define TLOG_EACH_6(f, x, ...)  TLOG_PUT(f, x) TLOG_EACH_5(f, __VA_ARGS__)
+#define TLOG_EACH_7(f, x, ...)  TLOG_PUT(f, x) TLOG_EACH_6(f, __VA_ARGS__)
+#define TLOG_EACH_8(f, x, ...)  TLOG_PUT(f, x) TLOG_EACH_7(f, __VA_ARGS__)
+#define TLOG_EACH_9(f, x, ...)  TLOG_PUT(f, x) TLOG_EACH_8(f, __VA_ARGS__)
+#define TLOG_EACH_10(f, x, ...) TLOG_PUT(f, x) TLOG_EACH_9(f, __VA_ARGS__)
+#define TLOG_EACH_11(f, x, ...) TLOG_PUT(f, x) TLOG_EACH_10(f, __VA_ARGS__)
+#define TLOG_EACH_12(f, x, ...) TLOG_PUT(f, x) TLOG_EACH_11(f, __VA_ARGS__)
+#define TLOG_EACH_13(f, x, ...) TLOG_PUT(f, x) TLOG_EACH_12(f, __VA_ARGS__)
+#define TLOG_EACH_14(f, x, ...) TLOG_PUT(f, x) TLOG_EACH_13(f, __VA_ARGS__)
+#define TLOG_EACH_15(f, x, ...) TLOG_PUT(f, x) TLOG_EACH_14(f, __VA_ARGS__)
+#define TLOG_EACH_16(f, x, ...) TLOG_PUT(f, x) TLOG_EACH_15(f, __VA_ARGS__)
+
+#define TLOG(fmt, ...)                                                                  \
+	do {                                                                                \
+		static const char tlog_fmt_[] __attribute__((section(".tlog_fmt"), used)) = fmt; \
+		tlog_frame_t tlog_frame_;                                                       \
+		if (0) {                                                                        \
+			(void)printf(fmt, ##__VA_ARGS__); /* 仅做格式串与参数检查 */                \
+		}                                                                               \
+		tlog_begin(&tlog_frame_, tlog_fmt_);                                            \
+		TLOG_EACH(&tlog_frame_, ##__VA_ARGS__)                                          \
+		tlog_end(&tlog_frame_);                                                         \
+	} while (0)
+
+#else
+
+#define TLOG(fmt, ...) printf(fmt, ##__VA_ARGS__)
+
+#endif /* APP_LOG_TOKENIZED */
+
+#endif
@@ -0,0 +1,490 @@
+/**
+ * @file app_rtos.c
+ * @author 林木@江南大学
+ * @brief FreeRTOS 任务架构实现
+ * @details SDK 驱动的阻塞传输依赖内核信号量，启动流程在控制任务中执行，完成后再放行其他任务：
+ *          - 车轮任务：任务运行期间由 PITMR 通道按 APP_WHEEL_PERIOD_US 释放，采样左右轮速度并闭合
+ *            前轮速度内环（控制任务发布目标轮速与前馈，内环按实测轮速修正占空比）；
+ *            释放时刻不依赖内核节拍，空闲时内核无节拍休眠，由 PITMR/外设中断唤醒；
+ *          - IMU 任务：等待 H30 数据就绪中断通知，读取欧拉角/角速度写入驱动缓存；
+ *          - 控制任务：vTaskDelayUntil 固定周期调用 Mission_Step，读传感器只取缓存，不访问总线
+ *            （以太网遥测帧与网络命令例外：W5500 的 SPI1 只由控制任务访问）；
+ *          - 舵机任务：发送待发 PWM 周期（两舵机轮流），高电平期间挂起调度器保证脉宽；
+ *          - 测距任务：触发超声波，由 ECHO 中断计时，结果写入驱动缓存；
+ *          - 遥测任务：输出 printf 流缓冲区与控制任务的状态记录，处理命令行，发送 LoRa 状态帧；
+ *          - SD 记录任务：控制任务写满一个记录缓冲时通知，以多块写写出（SD 卡忙等不占用控制周期）。
+ *          printf（_write）在调度器运行后只写入流缓冲区，空间不足时整段丢弃并计数，不阻塞调用任务。
+ *          任务、流缓冲区、互斥量（含空闲/定时器任务）全部静态分配，大小在编译期确定并按
+ *          APP_RTOS_RAM_BUDGET 检查，运行期不做内存分配
+ */
+
+#include "app_rtos.h"
+
+#if APP_USE_FREERTOS
+
+#include "../board/h30.h"
+#include "../board/hcsr04.h"
+#include "../board/servo2_control.h"
+#include "../board/servo_control.h"
+#include "../board/pose_estimator.h"
+#include "../board/shell.h"
+#include "../board/board_delay.h"
+#include "../board/hrtimer.h"
+#include "../board/odometry.h"
+#include "../board/my_move.h"
+#include "../board/tlog.h"
+#include "../board/sd_log.h"
+#include "../board/net_telem.h"
+#include "../board/lora_link.h"
+#include "../board/can_bus.h"
+#include "../board/rtos_trace.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "stream_buffer.h"
+#include "timers.h"
+#include <eswin_sdk_soc.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <unistd.h>
+
+// 控制任务 -> 遥测任务的状态记录
+typedef struct {
+	uint32_t t_ms;
+	float x_mm;
+	float y_mm;
+	float theta_deg;
+	uint8_t step;
+	uint8_t status;
+} app_telemetry_t;
+
+#define APP_TELEM_STREAM_BYTES  (APP_TELEM_RECORDS * sizeof(app_telemetry_t))
+#define APP_TASK_COUNT          7U
+
+// 静态内存合计（字节）：流缓冲区存储区需多 1 字节；信号量为日志互斥量与亚节拍休眠信号量（board_delay.c）
+#define APP_RTOS_STACK_WORDS    (APP_STACK_WHEEL + APP_STACK_IMU + APP_STACK_CONTROL + APP_STACK_SERVO + APP_STACK_RANGE + \
+                                 APP_STACK_TELEMETRY + APP_STACK_SDLOG + APP_STACK_IDLE + configTIMER_TASK_STACK_DEPTH)
+#define APP_RTOS_BUFFER_BYTES   ((APP_LOG_BUFFER_BYTES + 1U) + (APP_TELEM_STREAM_BYTES + 1U))
+#define APP_RTOS_OBJECT_BYTES   ((APP_TASK_COUNT + 2U) * sizeof(StaticTask_t) + 2U * sizeof(StaticStreamBuffer_t) + \
+                                 2U * sizeof(StaticSemaphore_t))
+#define APP_RTOS_STATIC_BYTES   (APP_RTOS_STACK_WORDS * sizeof(StackType_t) + APP_RTOS_BUFFER_BYTES + APP_RTOS_OBJECT_BYTES)
+
+_Static_assert(APP_RTOS_STATIC_BYTES <= APP_RTOS_RAM_BUDGET, "RTOS static memory exceeds APP_RTOS_RAM_BUDGET");
+
+static const app_rtos_hooks_t *s_hooks = NULL;
+static int s_first_source = SHELL_MISSION_NONE;
+static TaskHandle_t s_wheel_task = NULL;
+static TaskHandle_t s_imu_task = NULL;
+static TaskHandle_t s_range_task = NULL;
+static TaskHandle_t s_servo_task = NULL;
+static TaskHandle_t s_control_task = NULL;
+static TaskHandle_t s_telemetry_task = NULL;
+static TaskHandle_t s_sdlog_task = NULL;
+static volatile bool s_started = false;    // 启动流程完成
+static StreamBufferHandle_t s_log_stream = NULL;
+static StreamBufferHandle_t s_telem_stream = NULL;
+static SemaphoreHandle_t s_log_mutex = NULL;
+static volatile uint32_t s_log_dropped = 0;
+static volatile uint32_t s_wheel_overruns = 0;  // 上一周期未处理完即再次释放的次数
+
+// 静态存储
+static StackType_t s_wheel_stack[APP_STACK_WHEEL];
+static StackType_t s_imu_stack[APP_STACK_IMU];
+static StackType_t s_control_stack[APP_STACK_CONTROL];
+static StackType_t s_servo_stack[APP_STACK_SERVO];
+static StackType_t s_range_stack[APP_STACK_RANGE];
+static StackType_t s_telemetry_stack[APP_STACK_TELEMETRY];
+static StackType_t s_sdlog_stack[APP_STACK_SDLOG];
+static StackType_t s_idle_stack[APP_STACK_IDLE];
+static StackType_t s_timer_stack[configTIMER_TASK_STACK_DEPTH];
+static StaticTask_t s_task_tcbs[APP_TASK_COUNT];
+static StaticTask_t s_idle_tcb;
+static StaticTask_t s_timer_tcb;
+static uint8_t s_log_storage[APP_LOG_BUFFER_BYTES + 1U];
+static uint8_t s_telem_storage[APP_TELEM_STREAM_BYTES + 1U];
+static StaticStreamBuffer_t s_log_stream_cb;
+static StaticStreamBuffer_t s_telem_stream_cb;
+static StaticSemaphore_t s_log_mutex_cb;
+
+extern void kitty_output(const char ch);
+
+static void app_output_direct(const uint8_t *buf, size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		if (buf[i] == '\n') {
+			kitty_output('\r');
+		}
+		kitty_output((char)buf[i]);
+	}
+}
+
+/**
+ * @brief printf 输出：调度器运行后写入流缓冲区（多任务写入以互斥量串行），否则直接输出
+ */
+ssize_t _write(int fd, const void *ptr, size_t len)
+{
+	if (!isatty(fd)) {
+		return -1;
+	}
+	if (s_log_stream == NULL || xTaskGetSchedulerState() != taskSCHEDULER_RUNNING) {
+		app_output_direct((const uint8_t *)ptr, len);
+		return (ssize_t)len;
+	}
+	// 空间不足时整段丢弃，不截断文本行或令牌化日志帧
+	size_t sent = 0;
+	if (xSemaphoreTake(s_log_mutex, 1U) == pdTRUE) {
+		if (xStreamBufferSpacesAvailable(s_log_stream) >= len) {
+			sent = xStreamBufferSend(s_log_stream, ptr, len, 0);
+		}
+		xSemaphoreGive(s_log_mutex);
+	}
+	if (sent < len) {
+		s_log_dropped += (uint32_t)(len - sent);
+	}
+	return (ssize_t)len;
+}
+
+static void app_wheel_release_isr(void)
+{
+	BaseType_t woken = pdFALSE;
+	RtosTrace_IsrBegin(RTOS_TRACE_ISR_WHEEL);
+	vTaskNotifyGiveFromISR(s_wheel_task, &woken);
+	RtosTrace_IsrEnd((int)woken);
+	portYIELD_FROM_ISR(woken);
+}
+
+static void app_imu_ready_isr(void)
+{
+	BaseType_t woken = pdFALSE;
+	RtosTrace_IsrBegin(RTOS_TRACE_ISR_IMU);
+	if (s_imu_task != NULL && xTaskGetSchedulerState() == taskSCHEDULER_RUNNING) {
+		vTaskNotifyGiveFromISR(s_imu_task, &woken);
+	}
+	RtosTrace_IsrEnd((int)woken);
+	portYIELD_FROM_ISR(woken);
+}
+
+static void app_echo_isr(void)
+{
+	BaseType_t woken = pdFALSE;
+	RtosTrace_IsrBegin(RTOS_TRACE_ISR_ECHO);
+	if (s_range_task != NULL && xTaskGetSchedulerState() == taskSCHEDULER_RUNNING) {
+		vTaskNotifyGiveFromISR(s_range_task, &woken);
+	}
+	RtosTrace_IsrEnd((int)woken);
+	portYIELD_FROM_ISR(woken);
+}
+
+static void app_wheel_task(void *arg)
+{
+	(void)arg;
+	for (;;) {
+		// 通知计数大于 1 表示错过了释放，按实际经过的周期数计算速度
+		uint32_t n = ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+		if (n > 1U) {
+			s_wheel_overruns += n - 1U;
+			RTOS_TRACE_EVENT(RTOS_TRACE_CH_SENSOR, "wheel missed %u", (unsigned)(n - 1U));
+		}
+		Odom_SampleWheels(APP_WHEEL_PERIOD_US * n);
+		MyMove_WheelLoopStep(APP_WHEEL_PERIOD_US * n);
+	}
+}
+
+static void app_imu_task(void *arg)
+{
+	(void)arg;
+	(void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);   // 等待启动完成
+	for (;;) {
+		// 中断极性不符或丢失时按超时周期轮询
+		(void)ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(APP_IMU_TIMEOUT_MS));
+		if (!H30_Update()) {
+			RTOS_TRACE_EVENT(RTOS_TRACE_CH_SENSOR, "imu read failed");
+		}
+	}
+}
+
+static void app_range_task(void *arg)
+{
+	(void)arg;
+	(void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);   // 等待启动完成
+	TickType_t last = xTaskGetTickCount();
+	for (;;) {
+		(void)ulTaskNotifyTake(pdTRUE, 0);
+		if (HCSR04_Trigger()) {
+			(void)ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(HCSR04_ECHO_TIMEOUT_MS));
+		}
+		float cm = HCSR04_TakeEchoCm();
+		RTOS_TRACE_EVENT(RTOS_TRACE_CH_SENSOR, "range %d mm", (int)(cm * 10.0f));
+		HCSR04_PushSample(cm);
+		vTaskDelayUntil(&last, pdMS_TO_TICKS(APP_RANGE_PERIOD_MS));
+	}
+}
+
+static void app_servo_task(void *arg)
+{
+	(void)arg;
+	// 启动期间舵机脉冲由启动流程发送
+	(void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+	for (;;) {
+		// 发送一个待发脉冲（两舵机轮流），无脉冲时空等一个周期
+		Mission_WaitTick();
+	}
+}
+
+static void app_publish_telemetry(void)
+{
+	app_telemetry_t rec;
+	pose2d_t pose;
+	Pose_Get(&pose);
+	rec.t_ms = board_time_ms();
+	rec.x_mm = pose.x_mm;
+	rec.y_mm = pose.y_mm;
+	rec.theta_deg = pose.theta_deg;
+	rec.step = Mission_GetStepIndex();
+	rec.status = (uint8_t)Mission_GetStatus();
+	// 遥测任务跟不上时丢弃本条，控制任务不等待
+	(void)xStreamBufferSend(s_telem_stream, &rec, sizeof(rec), 0);
+}
+
+static void app_run_mission(int source)
+{
+	const mission_step_t *steps = NULL;
+	uint8_t count = s_hooks->mission_prepare(source, &steps);
+	if (count == 0U) {
+		return;
+	}
+	Mission_Start(steps, count);
+	// 内环只在行驶期间运行，停车时不产生周期中断，空闲可进入长时间无节拍休眠；
+	// 释放定时器启动失败时前轮保持开环
+	if (HrTimer_Start(HRTIMER_CH_WHEEL, APP_WHEEL_PERIOD_US, app_wheel_release_isr)) {
+		MyMove_WheelLoopEnable(true);
+	}
+	TickType_t last = xTaskGetTickCount();
+	RtosTrace_ControlBegin();
+	while (Mission_Step() == MISSION_RUNNING) {
+		app_publish_telemetry();
+		vTaskDelayUntil(&last, pdMS_TO_TICKS(MISSION_TICK_MS));
+		RtosTrace_ControlTick();
+	}
+	HrTimer_Stop(HRTIMER_CH_WHEEL);
+	MyMove_WheelLoopEnable(false);
+	app_publish_telemetry();
+	// 等舵机任务发完剩余脉冲，保证最后的舵机动作到位
+	while (servo_is_busy() || servo2_get_state() != SERVO2_STATE_IDLE) {
+		vTaskDelay(pdMS_TO_TICKS(MISSION_TICK_MS));
+	}
+	s_hooks->mission_finish();
+}
+
+static void app_sdlog_wake(void)
+{
+	xTaskNotifyGive(s_sdlog_task);
+}
+
+static void app_sdlog_task(void *arg)
+{
+	(void)arg;
+	(void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);   // 等待启动完成
+	for (;;) {
+		// 通知丢失时按超时兜底；有待写内容时连续写出
+		(void)ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(APP_SDLOG_POLL_MS));
+		while (SdLog_Service(SD_LOG_BUF_SECTORS)) {
+		}
+	}
+}
+
+// 启动完成后：传感器改为中断驱动 + 缓存读取，放行采集/测距/舵机任务
+static void app_start_sensing(void)
+{
+	// 命令行改由遥测任务处理，任务调度器不再调用空闲钩子
+	Mission_SetIdleHook(NULL);
+	// 先读一次 H30 填充缓存，之后所有读接口只取缓存
+	(void)H30_Update();
+	H30_SetCachedMode(true);
+	HCSR04_SetCachedMode(true);
+	H30_EnableDataReadyIrq(app_imu_ready_isr);
+	HCSR04_EnableEchoIrq(app_echo_isr);
+	Shell_SetStatsHook(AppRtos_PrintStats);
+	SdLog_SetWriterHook(app_sdlog_wake);
+	AppRtos_PrintMemory();
+	s_started = true;
+	xTaskNotifyGive(s_imu_task);
+	xTaskNotifyGive(s_range_task);
+	xTaskNotifyGive(s_servo_task);
+	xTaskNotifyGive(s_sdlog_task);
+}
+
+static void app_control_task(void *arg)
+{
+	(void)arg;
+	s_hooks->boot();
+	app_start_sensing();
+	int req = s_first_source;
+	for (;;) {
+		if (req != SHELL_MISSION_NONE) {
+			app_run_mission(req);
+		}
+		// 网络命令与任务中的遥测帧同在控制任务处理，SPI1 只有一个使用者；CAN 参数应答与回环自检同样在此执行
+		NetTelem_Poll();
+		CanBus_Poll();
+		vTaskDelay(pdMS_TO_TICKS(MISSION_TICK_MS));
+		req = Shell_TakeMissionRequest();
+	}
+}
+
+static void app_telemetry_task(void *arg)
+{
+	(void)arg;
+	uint8_t buf[64];
+	app_telemetry_t rec;
+	bool have_rec = false;
+	uint32_t last_print_ms = 0;
+	uint32_t reported_dropped = 0;
+	for (;;) {
+		// 无日志时最多等待一个控制周期，再处理状态记录与命令行
+		size_t n = xStreamBufferReceive(s_log_stream, buf, sizeof(buf), pdMS_TO_TICKS(MISSION_TICK_MS));
+		// 取空缓冲区后再处理命令行，分批输出（如飞行记录导出）不会累积
+		while (n > 0U) {
+			app_output_direct(buf, n);
+			n = xStreamBufferReceive(s_log_stream, buf, sizeof(buf), 0);
+		}
+		// 只保留最新记录
+		while (xStreamBufferReceive(s_telem_stream, &rec, sizeof(rec), 0) == sizeof(rec)) {
+			have_rec = true;
+		}
+		uint32_t now = board_time_ms();
+		if (have_rec && now - last_print_ms >= APP_TELEM_PERIOD_MS) {
+			TLOG("[tm] t=%lu step=%d st=%d x=%.1f y=%.1f th=%.2f\r\n", (unsigned long)rec.t_ms,
+			       rec.step, rec.status, rec.x_mm, rec.y_mm, rec.theta_deg);
+			have_rec = false;
+			last_print_ms = now;
+		}
+		if (s_log_dropped != reported_dropped) {
+			reported_dropped = s_log_dropped;
+			printf("[log] 缓冲区满，累计丢弃 %lu 字节\r\n", (unsigned long)reported_dropped);
+		}
+		if (s_started) {
+			Shell_Poll();
+			// LoRa 状态下行：控制任务只写快照，编码与射频操作在最低优先级的本任务中进行
+			LoraLink_Service();
+		}
+	}
+}
+
+typedef struct {
+	const char *name;
+	TaskFunction_t entry;
+	uint32_t stack_words;
+	UBaseType_t priority;
+	StackType_t *stack;
+	TaskHandle_t *handle_out;
+} app_task_desc_t;
+
+static const app_task_desc_t s_tasks[APP_TASK_COUNT] = {
+	{ "wheel", app_wheel_task,     APP_STACK_WHEEL,     APP_PRIO_WHEEL,     s_wheel_stack,     &s_wheel_task },
+	{ "imu",   app_imu_task,       APP_STACK_IMU,       APP_PRIO_IMU,       s_imu_stack,       &s_imu_task },
+	{ "ctrl",  app_control_task,   APP_STACK_CONTROL,   APP_PRIO_CONTROL,   s_control_stack,   &s_control_task },
+	{ "servo", app_servo_task,     APP_STACK_SERVO,     APP_PRIO_SERVO,     s_servo_stack,     &s_servo_task },
+	{ "range", app_range_task,     APP_STACK_RANGE,     APP_PRIO_RANGE,     s_range_stack,     &s_range_task },
+	{ "telem", app_telemetry_task, APP_STACK_TELEMETRY, APP_PRIO_TELEMETRY, s_telemetry_stack, &s_telemetry_task },
+	{ "sdlog", app_sdlog_task,     APP_STACK_SDLOG,     APP_PRIO_SDLOG,     s_sdlog_stack,     &s_sdlog_task },
+};
+
+static void app_print_stack(const char *name, UBaseType_t prio, uint32_t words, TaskHandle_t handle)
+{
+	if (handle != NULL) {
+		printf("[mem] %-6s prio=%lu stack=%5luB min_free=%5luB\r\n", name, (unsigned long)prio,
+		       (unsigned long)(words * sizeof(StackType_t)),
+		       (unsigned long)(uxTaskGetStackHighWaterMark(handle) * sizeof(StackType_t)));
+	} else {
+		printf("[mem] %-6s prio=%lu stack=%5luB\r\n", name, (unsigned long)prio,
+		       (unsigned long)(words * sizeof(StackType_t)));
+	}
+}
+
+void AppRtos_PrintMemory(void)
+{
+	for (uint8_t i = 0; i < APP_TASK_COUNT; i++) {
+		app_print_stack(s_tasks[i].name, s_tasks[i].priority, s_tasks[i].stack_words, *s_tasks[i].handle_out);
+	}
+	app_print_stack("idle", tskIDLE_PRIORITY, APP_STACK_IDLE, xTaskGetIdleTaskHandle());
+	app_print_stack("timer", configTIMER_TASK_PRIORITY, configTIMER_TASK_STACK_DEPTH, xTimerGetTimerDaemonTaskHandle());
+	printf("[mem] log=%luB(丢弃%lu) telem=%luB objects=%luB\r\n", (unsigned long)(APP_LOG_BUFFER_BYTES + 1U),
+	       (unsigned long)s_log_dropped, (unsigned long)(APP_TELEM_STREAM_BYTES + 1U),
+	       (unsigned long)APP_RTOS_OBJECT_BYTES);
+	printf("[mem] total=%luB budget=%luB\r\n", (unsigned long)APP_RTOS_STATIC_BYTES,
+	       (unsigned long)APP_RTOS_RAM_BUDGET);
+}
+
+void AppRtos_PrintStats(void)
+{
+	AppRtos_PrintMemory();
+	printf("[rt] wheel period=%luus releases=%lu overruns=%lu\r\n", (unsigned long)APP_WHEEL_PERIOD_US,
+	       (unsigned long)HrTimer_GetReleases(HRTIMER_CH_WHEEL), (unsigned long)s_wheel_overruns);
+#if APP_LOG_TOKENIZED
+	printf("[rt] tlog 超长丢弃=%lu\r\n", (unsigned long)tlog_get_dropped());
+#endif
+}
+
+static void app_panic(const char *msg)
+{
+	__disable_irq();
+	app_output_direct((const uint8_t *)msg, strlen(msg));
+	while (1) {
+	}
+}
+
+void vApplicationIdleHook(void)
+{
+	// 休眠到下一个中断；预计空闲不少于 configEXPECTED_IDLE_TIME_BEFORE_SLEEP 个节拍时，
+	// 醒来后由无节拍空闲（board_delay.c）停掉中间的节拍继续休眠
+	__WFI();
+}
+
+void vApplicationGetIdleTaskMemory(StaticTask_t **tcb, StackType_t **stack, uint32_t *stack_words)
+{
+	*tcb = &s_idle_tcb;
+	*stack = s_idle_stack;
+	*stack_words = APP_STACK_IDLE;
+}
+
+void vApplicationGetTimerTaskMemory(StaticTask_t **tcb, StackType_t **stack, uint32_t *stack_words)
+{
+	*tcb = &s_timer_tcb;
+	*stack = s_timer_stack;
+	*stack_words = configTIMER_TASK_STACK_DEPTH;
+}
+
+void vApplicationStackOverflowHook(TaskHandle_t task, char *name)
+{
+	(void)task;
+	(void)name;
+	app_panic("FreeRTOS: 任务栈溢出\n");
+}
+
+void AppRtos_Start(const app_rtos_hooks_t *hooks, int first_source)
+{
+	s_hooks = hooks;
+	s_first_source = first_source;
+	// 记录器要在任何内核对象创建之前初始化，对象名才能登记到记录区
+	RtosTrace_Init();
+
+	s_log_mutex = xSemaphoreCreateMutexStatic(&s_log_mutex_cb);
+	s_log_stream = xStreamBufferCreateStatic(APP_LOG_BUFFER_BYTES, 1, s_log_storage, &s_log_stream_cb);
+	s_telem_stream = xStreamBufferCreateStatic(APP_TELEM_STREAM_BYTES, sizeof(app_telemetry_t), s_telem_storage,
+	                                           &s_telem_stream_cb);
+	for (uint8_t i = 0; i < APP_TASK_COUNT; i++) {
+		const app_task_desc_t *t = &s_tasks[i];
+		*t->handle_out = xTaskCreateStatic(t->entry, t->name, t->stack_words, NULL, t->priority, t->stack,
+		                                   &s_task_tcbs[i]);
+	}
+	printf("FreeRTOS 启动：%d 个任务，静态内存 %lu / %lu 字节\r\n", APP_TASK_COUNT,
+	       (unsigned long)APP_RTOS_STATIC_BYTES, (unsigned long)APP_RTOS_RAM_BUDGET);
+
+	vTaskStartScheduler();
+	app_panic("FreeRTOS: 调度器启动失败\n");
+}
+
+#endif /* APP_USE_FREERTOS */
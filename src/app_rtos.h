@@ -0,0 +1,76 @@
+/**
+ * @file app_rtos.h
+ * @author 林木@江南大学
+ * @brief FreeRTOS 任务架构（APP_USE_FREERTOS=1 时使用）
+ * @details 控制任务按 MISSION_TICK_MS 周期推进任务调度器；车轮内环任务由 PITMR 周期中断释放（与节拍无关），闭合前轮速度环；
+ *          IMU 采集任务由 H30 数据就绪中断通知；测距任务由 ECHO 中断计时；舵机任务发送软件 PWM；
+ *          遥测任务经流缓冲区输出日志与状态；SD 记录任务写出控制任务填满的记录缓冲。
+ *          优先级：车轮 > IMU > 控制 > 舵机 > 测距 > SD 记录 > 遥测，控制周期不受串口输出、测距等待
+ *          与 SD 卡写入延迟影响
+ */
+
+#ifndef APP_RTOS_H
+#define APP_RTOS_H
+
+#include "../board/app_config.h"
+#include "../board/mission.h"
+#include <stdint.h>
+
+// 任务优先级（configMAX_PRIORITIES=10，软件定时器任务占用最高级）
+#define APP_PRIO_WHEEL         8U
+#define APP_PRIO_IMU           7U
+#define APP_PRIO_CONTROL       6U
+#define APP_PRIO_SERVO         5U
+#define APP_PRIO_RANGE         4U
+#define APP_PRIO_SDLOG         2U
+#define APP_PRIO_TELEMETRY     1U
+
+// 任务栈（单位：StackType_t 字），全部静态分配
+#define APP_STACK_WHEEL        256U
+#define APP_STACK_IMU          384U
+#define APP_STACK_CONTROL      768U
+#define APP_STACK_SERVO        256U
+#define APP_STACK_RANGE        256U
+#define APP_STACK_TELEMETRY    768U
+#define APP_STACK_SDLOG        256U   // 只调用 spi_sd 驱动，不格式化输出
+#define APP_STACK_IDLE         256U   // 空闲任务只执行 WFI（定时器任务栈为 configTIMER_TASK_STACK_DEPTH）
+
+// 内核对象静态内存预算（字节）：任务栈 + 控制块 + 流缓冲区 + 互斥量，超出时编译失败；
+// 取原 configTOTAL_HEAP_SIZE，移除堆后不再有堆管理开销
+#define APP_RTOS_RAM_BUDGET    (16U * 1024U)
+
+#define APP_WHEEL_PERIOD_US    1000U  // 车轮速度内环周期（PITMR 释放，任务运行期间启用）
+#define APP_IMU_TIMEOUT_MS     20U    // 数据就绪中断未到时按该周期轮询
+#define APP_RANGE_PERIOD_MS    60U    // 超声波测距周期（不小于最长回波时间）
+#define APP_TELEM_PERIOD_MS    200U   // 状态输出周期
+#define APP_LOG_BUFFER_BYTES   768U   // printf 流缓冲区
+#define APP_TELEM_RECORDS      8U     // 状态记录流缓冲区容量（条）
+#define APP_SDLOG_POLL_MS      500U   // SD 记录任务无通知时的检查周期
+
+typedef struct {
+	// 启动流程（在控制任务中执行，完成前其他任务等待）
+	void (*boot)(void);
+	// 任务开始前：静止采样、设定位姿原点并选择任务表；返回步骤数，0 表示不执行
+	uint8_t (*mission_prepare)(int source, const mission_step_t **steps);
+	// 任务结束后：标定写回、终点位姿输出
+	void (*mission_finish)(void);
+} app_rtos_hooks_t;
+
+/**
+ * @brief 创建任务并启动调度器（时钟/引脚/串口初始化后调用，不返回）
+ * @param hooks 任务前后处理
+ * @param first_source 上电执行的任务来源（EEPROM 槽号 / SHELL_MISSION_BUILTIN / SHELL_MISSION_NONE）
+ */
+void AppRtos_Start(const app_rtos_hooks_t *hooks, int first_source);
+
+/**
+ * @brief 输出实时统计：内存规划（见 AppRtos_PrintMemory）与周期任务的释放/超限次数
+ */
+void AppRtos_PrintStats(void);
+
+/**
+ * @brief 输出内存规划：各任务栈大小与运行以来最少剩余、缓冲区与内核对象占用、合计与预算
+ */
+void AppRtos_PrintMemory(void);
+
+#endif
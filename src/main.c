@@ -15,19 +15,253 @@
 #include "../board/servo_control.h"
 #include "../board/servo2_control.h"
 #include "../board/my_move.h"
+#include "../board/odometry.h"
+#include "../board/pose_estimator.h"
+#include "../board/mission.h"
+#include "../board/nvm_store.h"
+#include "../board/mission_store.h"
+#include "../board/shell.h"
+#include "../board/calib_store.h"
+#include "../board/boot.h"
+#include "../board/flight_rec.h"
+#include "../board/flash_log.h"
+#include "../board/sd_log.h"
+#include "../board/net_telem.h"
+#include "../board/lora_link.h"
+#include "../board/can_bus.h"
+#include "../board/app_config.h"
+#include "app_rtos.h"
 #include <stdio.h>
 #include <string.h>
 #include <stdbool.h>
+#include <math.h>
 
 // 主任务函数声明
 void nb(void);
+void nb_run(int source);
+
+// nb 路径（mm）：坐标以各段起点为原点、起始直行目标为 x 轴，左为 +y；
+// 距离取原定时段在 0.12 占空比下的标称行程，按场地微调
+#define NB_SPEED          0.12f
+#define NB_LOOKAHEAD_MM   150.0f
+#define NB_PATH_TIMEOUT_MS 20000U
+#define NB_SETTLE_MAX_MS  1000U
+
+// 第一段：直行 600 → 右转（舵机2保持105）→ 直行 220 后停车
+static const path_waypoint_t s_nb_path_a[] = {
+	{   0.0f,    0.0f, NB_SPEED,   0 },
+	{ 600.0f,    0.0f, NB_SPEED,   0 },
+	{ 600.0f, -220.0f, NB_SPEED, 105 },
+};
+
+// 第二段：直行 220 → 右转（舵机2保持102）→ 直行 540 后停车
+static const path_waypoint_t s_nb_path_b[] = {
+	{   0.0f,    0.0f, NB_SPEED,   0 },
+	{ 220.0f,    0.0f, NB_SPEED,   0 },
+	{ 220.0f, -540.0f, NB_SPEED, 102 },
+};
+
+#define NB_COUNT_OF(a) ((uint8_t)(sizeof(a) / sizeof((a)[0])))
+
+// nb 任务表：舵机动作与运动并行，需要同步处用等待步骤
+static const mission_step_t s_nb_mission[] = {
+	// 路径一：直行 → 行进中右转90° → 直行，终点停车
+	{ MISSION_STEP_PATH,  .u.path  = { s_nb_path_a, NB_COUNT_OF(s_nb_path_a), NB_LOOKAHEAD_MM, NB_PATH_TIMEOUT_MS } },
+	// 中间舵机动作：车体静止后即开始（替代固定 1s 等待），与路径二的起步并行
+	{ MISSION_STEP_WAIT,  .u.wait  = { MISSION_WAIT_STILL, NB_SETTLE_MAX_MS } },
+	{ MISSION_STEP_SERVO, .u.servo = { 1, 105 } },
+	// 路径二：以路径一终点航向为 x 轴，直行 → 右转90° → 直行，终点停车
+	{ MISSION_STEP_PATH,  .u.path  = { s_nb_path_b, NB_COUNT_OF(s_nb_path_b), NB_LOOKAHEAD_MM, NB_PATH_TIMEOUT_MS } },
+	// 收尾舵机
+	{ MISSION_STEP_WAIT,  .u.wait  = { MISSION_WAIT_STILL, NB_SETTLE_MAX_MS } },
+	{ MISSION_STEP_SERVO, .u.servo = { 1, 80 } },
+	{ MISSION_STEP_WAIT,  .u.wait  = { MISSION_WAIT_SERVOS_IDLE, 0 } },
+};
+
+// 启动步骤（序号即 BOOT_BIT 位）
+enum {
+	BOOT_NVM = 0,    // EEPROM 模拟 + 标定加载（H30 地址需在 H30_Init 前应用）
+	BOOT_SERVO1,     // 舵机回中（脉冲与其他步骤交替发送）
+	BOOT_SERVO2,
+	BOOT_IMU,        // H30 探测 + 预热（无标定时测量零偏并保存）
+	BOOT_MOTION,     // 超声波、电机 PWM、编码器里程计
+	BOOT_SHELL,      // UART2 命令行
+	BOOT_FLOG,       // 外部 SPI Flash 运行记录（页 CRC 使用 NVM 的 CRC 单元）
+	BOOT_SDLOG,      // SD 卡运行记录（同上）
+	BOOT_NET,        // W5500 以太网遥测（SPI1）
+	BOOT_LORA,       // SX1262 LoRa 状态下行（SPI0）
+	BOOT_CAN,        // FlexCAN0 上位机命令与遥测
+};
+
+#define BOOT_IMU_WARMUP_MS        1000U   // 无标定：测零偏前的稳定时间
+#define BOOT_IMU_WARMUP_CALIB_MS  200U    // 已有标定：短暂等待
+#define BOOT_IMU_BIAS_SAMPLES     100U
+#define BOOT_IMU_BIAS_PER_TICK    4U      // 每个周期采样数，避免长时间占用舵机时间片
+#define BOOT_TIMEOUT_MS           5000U
+// nb 任务所需子系统；舵机回中未完成时由任务调度器继续发送脉冲
+#define NB_BOOT_REQUIRED          (BOOT_BIT(BOOT_NVM) | BOOT_BIT(BOOT_IMU) | BOOT_BIT(BOOT_MOTION))
+
+static bool s_calib_loaded = false;
+static float s_bias_sum = 0.0f;
+static uint16_t s_bias_count = 0;
+
+static bool boot_nvm_begin(void)
+{
+	// EEPROM 不可用时任务槽/标定回退默认值，不阻止启动
+	NVM_Init();
+	s_calib_loaded = Calib_Load();
+	return true;
+}
+
+static bool boot_servo1_begin(void)
+{
+	servo_init_async();
+	return true;
+}
+
+static boot_poll_t boot_servo1_poll(uint32_t elapsed_ms)
+{
+	(void)elapsed_ms;
+	return servo_is_busy() ? BOOT_POLL_BUSY : BOOT_POLL_READY;
+}
+
+static bool boot_servo2_begin(void)
+{
+	servo2_init_async();
+	return true;
+}
+
+static boot_poll_t boot_servo2_poll(uint32_t elapsed_ms)
+{
+	(void)elapsed_ms;
+	return (servo2_get_state() == SERVO2_STATE_IDLE) ? BOOT_POLL_READY : BOOT_POLL_BUSY;
+}
+
+static bool boot_imu_begin(void)
+{
+	s_bias_sum = 0.0f;
+	s_bias_count = 0;
+	return H30_Init();
+}
+
+static boot_poll_t boot_imu_poll(uint32_t elapsed_ms)
+{
+	if (s_calib_loaded) {
+		return (elapsed_ms >= BOOT_IMU_WARMUP_CALIB_MS) ? BOOT_POLL_READY : BOOT_POLL_BUSY;
+	}
+	if (elapsed_ms < BOOT_IMU_WARMUP_MS) {
+		return BOOT_POLL_BUSY;
+	}
+	// 首次上电：静止采样陀螺零偏（分摊到多个周期），完成后保存标定
+	for (uint8_t i = 0; i < BOOT_IMU_BIAS_PER_TICK && s_bias_count < BOOT_IMU_BIAS_SAMPLES; ++i) {
+		float gz;
+		if (H30_ReadGzDps(&gz)) {
+			s_bias_sum += gz;
+			s_bias_count++;
+		}
+	}
+	if (s_bias_count < BOOT_IMU_BIAS_SAMPLES) {
+		return BOOT_POLL_BUSY;
+	}
+	float bias = s_bias_sum / (float)s_bias_count;
+	Calib_SetGyroBias(CALIB_DEFAULT_TEMP_C, bias);
+	printf("陀螺零偏测量=%.3fdps\r\n", bias);
+	Calib_Save();
+	return BOOT_POLL_READY;
+}
+
+static bool boot_motion_begin(void)
+{
+	HCSR04_Init();
+	DCMotor_Init();
+	Odom_Init();
+	return true;
+}
+
+static bool boot_shell_begin(void)
+{
+	// 命令行：UART2 中断接收，任务运行中在调度空闲时处理
+	Shell_Init();
+	Mission_SetIdleHook(Shell_Poll);
+	return true;
+}
+
+static bool boot_flog_begin(void)
+{
+	// 未焊接外部 Flash 时记录器停用，不影响任务
+	(void)FlashLog_Init();
+	return true;
+}
+
+static bool boot_sdlog_begin(void)
+{
+	// 未插卡或无记录分区时记录器停用
+	(void)SdLog_Init();
+	return true;
+}
+
+static bool boot_net_begin(void)
+{
+	// 未接 W5500 时通道停用
+	(void)NetTelem_Init();
+	return true;
+}
+
+static bool boot_lora_begin(void)
+{
+	// 未接 SX1262 时下行停用
+	(void)LoraLink_Init();
+	return true;
+}
+
+static bool boot_can_begin(void)
+{
+	// 控制器初始化失败时总线停用（未接收发器不影响初始化，只是发送无应答）
+	(void)CanBus_Init();
+	return true;
+}
+
+static const boot_step_t s_boot_steps[] = {
+	[BOOT_NVM]    = { "nvm",    0U,                    boot_nvm_begin,    NULL },
+	[BOOT_SERVO1] = { "servo1", 0U,                    boot_servo1_begin, boot_servo1_poll },
+	[BOOT_SERVO2] = { "servo2", 0U,                    boot_servo2_begin, boot_servo2_poll },
+	[BOOT_IMU]    = { "imu",    BOOT_BIT(BOOT_NVM),    boot_imu_begin,    boot_imu_poll },
+	[BOOT_MOTION] = { "motion", 0U,                    boot_motion_begin, NULL },
+	[BOOT_SHELL]  = { "shell",  0U,                    boot_shell_begin,  NULL },
+	[BOOT_FLOG]   = { "flog",   BOOT_BIT(BOOT_NVM),    boot_flog_begin,   NULL },
+	[BOOT_SDLOG]  = { "sdlog",  BOOT_BIT(BOOT_NVM),    boot_sdlog_begin,  NULL },
+	[BOOT_NET]    = { "net",    0U,                    boot_net_begin,    NULL },
+	[BOOT_LORA]   = { "lora",   0U,                    boot_lora_begin,   NULL },
+	[BOOT_CAN]    = { "can",    0U,                    boot_can_begin,    NULL },
+};
+
+/**
+ * @brief 启动流程：其余子系统按启动步骤表并行初始化，任务所需子系统未就绪时停在错误提示
+ */
+static void system_boot(void)
+{
+    Boot_Start(s_boot_steps, NB_COUNT_OF(s_boot_steps));
+    if (!Boot_WaitReady(NB_BOOT_REQUIRED, BOOT_TIMEOUT_MS)) {
+        Boot_Report();
+        while (1) {
+            printf(Boot_GetState(BOOT_IMU) == BOOT_STEP_READY ? "启动失败，请检查串口日志!\r\n"
+                                                              : "H30 初始化失败，请检查硬件连接!\r\n");
+            simple_delay_ms(1000);
+        }
+    }
+    printf("任务所需子系统就绪（%lums），陀螺零偏=%.3fdps%s\r\n", (unsigned long)Boot_GetElapsedMs(),
+           H30_GetGyroZBias(), s_calib_loaded ? "（已保存标定）" : "");
+    Boot_Report();
+}
 
 /**
- * @brief 系统初始化
+ * @brief 系统初始化：时钟/引脚/串口同步完成，其余子系统按启动步骤表并行初始化
  */
 void system_init(void)
 {
     CLOCK_SYS_Init(g_pstClockManConfigsArr[0]);
+    // 延时时基：机器定时器 + WFI 唤醒定时器
+    board_delay_init();
     // 初始化PDMA、PINMUX、UART2
     PDMA_DRV_Init(&g_stPdmaState0, &g_stPdma0UserConfig0, g_stPdma0ChnStateArray,
                   g_stPdma0ChannelConfigArray, PDMA_CHANNEL_CONFIG_COUNT);
@@ -37,90 +271,114 @@ void system_init(void)
     // I2C 初始化将在 H30_Init() 中进行
 
     printf("系统初始化完成!\r\n");
+    // 飞行记录器：复位前任务未结束时在此导出（调度器启动前直接输出）
+    FlightRec_Init();
 
-    // 舵机初始化（servo）
-    printf("\r\n舵机初始化（servo）\r\n");
-    servo_init();
-    printf("servo 初始化完成\r\n");
+#if !APP_USE_FREERTOS
+    // FreeRTOS 构建中驱动阻塞传输依赖内核信号量，启动流程改在控制任务中执行
+    system_boot();
+#endif
+}
 
-    // 舵机初始化（servo2）
-    printf("\r\n舵机初始化（servo2）\r\n");
-    servo2_init();
-    printf("servo2 初始化完成\r\n");
+/**
+ * @brief 任务开始前：静止采样设定初始目标与位姿原点，选择任务表
+ * @param source EEPROM 槽号（无效时回退内置任务表）或 SHELL_MISSION_BUILTIN
+ * @return 步骤数
+ */
+static uint8_t nb_prepare(int source, const mission_step_t **steps_out)
+{
+	// 1) 静止多次采样，设定初始目标；以起点为原点、首段航向为初始朝向开始航位推算
+	MyMove_StraightInit();
+	float first_target = MyMove_GetStraightTarget();
+	printf("[nb] 初始目标(采样均值)=%.2f°\r\n", first_target);
+	Pose_Reset(0.0f, 0.0f, first_target);
 
-    // 初始化 H30 惯性姿态模块
-    if (!H30_Init()) {
-        printf("H30 初始化失败!\r\n");
-        while (1) {
-            printf("H30 初始化失败，请检查硬件连接!\r\n");
-            simple_delay_ms(1000);
-        }
-    }
-    
-    // 初始化超声波
-    HCSR04_Init();
+	// 2) EEPROM 任务槽有效时优先使用，否则用内置任务表
+	const mission_step_t *steps = s_nb_mission;
+	uint8_t step_count = NB_COUNT_OF(s_nb_mission);
+	if (source >= 0 && MissionStore_Load((uint8_t)source, &steps, &step_count)) {
+		printf("[nb] 使用 EEPROM 任务槽%d（%d 步）\r\n", source, step_count);
+	} else {
+		steps = s_nb_mission;
+		step_count = NB_COUNT_OF(s_nb_mission);
+		printf("[nb] 使用内置任务表（%d 步）\r\n", step_count);
+	}
+	*steps_out = steps;
+	return step_count;
+}
+
+/**
+ * @brief 任务结束后：等待运行记录写完，写回学习到的标定，输出终点位姿
+ */
+static void nb_finish(void)
+{
+	(void)FlashLog_Flush(FLASH_LOG_FLUSH_MS);
+	(void)SdLog_Flush(SD_LOG_FLUSH_MS);
 
-    // 初始化电机控制
-    DCMotor_Init();
-    printf("电机控制初始化完成!\r\n");
+	// 转向停车系数学习值偏离已保存值 10% 以上时写回标定
+	float saved_gain = Calib_GetSavedTurnStopGain();
+	float gain = MyMove_GetTurnStopGain();
+	if (saved_gain > 0.0f && fabsf(gain - saved_gain) > 0.1f * saved_gain) {
+		printf("[nb] 转向停车系数 %.5f -> %.5f，更新标定\r\n", saved_gain, gain);
+		Calib_Save();
+	}
 
-    printf("H30 初始化成功!\r\n");
-    printf("零偏补偿功能已禁用，直接使用原始角速度数据\r\n");
-    
-    // 等待系统稳定
-    simple_delay_ms(1000);
+	{
+		pose2d_t pose;
+		Pose_Get(&pose);
+		printf("[nb] 终点位姿: x=%.1fmm, y=%.1fmm, θ=%.2f°, σx=%.1fmm, σy=%.1fmm\r\n",
+		       pose.x_mm, pose.y_mm, pose.theta_deg, sqrtf(pose.cov[0][0]), sqrtf(pose.cov[1][1]));
+	}
 }
 
 /**
- * @brief nb 任务流程：基于 H30 的直行航向保持与转弯，集成超声避障
+ * @brief 执行一次任务：source 为 EEPROM 槽号（无效时回退内置任务表）或 SHELL_MISSION_BUILTIN
+ */
+void nb_run(int source)
+{
+	const mission_step_t *steps = NULL;
+	uint8_t step_count = nb_prepare(source, &steps);
+	// 按任务表执行（非阻塞调度，舵机动作与运动重叠）
+	Mission_Run(steps, step_count);
+	nb_finish();
+}
+
+/**
+ * @brief nb 任务流程：上电默认任务（EEPROM 任务槽0，无效时用内置任务表）
  */
 void nb(void)
 {
-	// 1) 第一次直行：静止多次采样，设定初始目标（使用已有初始化+避障版本）
-	MyMove_StraightInit();
-	float first_target = MyMove_GetStraightTarget();
-	printf("[nb] 第一次直行目标(采样均值)=%.2f°\r\n", first_target);
-	MyMove_StraightHoldYawWithObstacleAvoidanceUseTarget(0.12f, 5500);
-
-	// 2) 执行第一次右转90°（原有实现，带舵机）
-	MyMove_TurnRight90WithServo(0.18f, 1.0f, 6000, 105);
-
-	// 3) 第二次直行：目标 = 第一次目标 - 90°（右转后继续沿着绝对参考系方向行驶）
-	float target_second = MyMove_NormalizeDeg(first_target - 90.0f);
-	MyMove_SetStraightTarget(target_second);
-	printf("[nb] 第二次直行目标(首目标-90)=%.2f°\r\n", target_second);
-	MyMove_StraightHoldYawWithObstacleAvoidanceUseTarget(0.12f, 2000);
-
-	// 4) 中间舵机动作
-	simple_delay_ms(1000);
-	servo_set_angle(105);
-	
-	// 5) 第三次直行：无拐弯，沿用第二次直行目标
-	printf("[nb] 第三次直行目标(沿用第二次)=%.2f°\r\n", MyMove_GetStraightTarget());
-	MyMove_StraightHoldYawWithObstacleAvoidanceUseTarget(0.12f, 2000);
-
-	// 6) 第二次右转90°
-	MyMove_TurnRight90WithServo(0.18f, 1.0f, 6000, 102);
-	
-	// 7) 第四次直行：目标 = 第一次目标 ±180°（等效 first_target - 180°）
-	float target_fourth = MyMove_NormalizeDeg(first_target - 180.0f);
-	MyMove_SetStraightTarget(target_fourth);
-	printf("[nb] 第四次直行目标(首目标-180)=%.2f°\r\n", target_fourth);
-	MyMove_StraightHoldYawWithObstacleAvoidanceUseTarget(0.12f, 5000);
-	
-	// 收尾舵机
-	simple_delay_ms(1000);
-	servo_set_angle(80);
+	nb_run(0);
 }
 
 
+#if APP_USE_FREERTOS
+static const app_rtos_hooks_t s_rtos_hooks = { system_boot, nb_prepare, nb_finish };
+#endif
+
 /**
  * @brief 主函数
  */
 int main(void)
 {
 	system_init();
+#if APP_USE_FREERTOS
+	// 任务架构：控制任务完成启动流程后执行 EEPROM 任务槽0（不返回）
+	AppRtos_Start(&s_rtos_hooks, 0);
+#else
 	nb();
+	// 空闲：处理命令行、网络与 CAN 命令，发送 LoRa 状态，按请求重新执行任务
+	while (1) {
+		Shell_Poll();
+		NetTelem_Poll();
+		CanBus_Poll();
+		LoraLink_Service();
+		int req = Shell_TakeMissionRequest();
+		if (req != SHELL_MISSION_NONE) {
+			nb_run(req);
+		}
+		simple_delay_ms(10);
+	}
+#endif
 	return 0;
 }
-
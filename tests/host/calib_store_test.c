@@ -0,0 +1,190 @@
+/**
+ * @file calib_store_test.c
+ * @author 林木@江南大学
+ * @brief 标定记录轮换槽的主机端测试
+ * @details EEPROM 为内存数组；H30/运动/舵机/电机模型替身只保存“当前参数”。
+ *          覆盖：空白区、多轮轮换保存后重新加载（模拟重启）、写入中掉电保留旧记录、清除
+ */
+
+#include "test_util.h"
+#include "calib_store.h"
+#include "nvm_store.h"
+#include "h30.h"
+#include "my_move.h"
+#include "servo_control.h"
+#include "servo2_control.h"
+#include <string.h>
+
+#define SLOTS  (NVM_CALIB_SIZE / CALIB_SLOT_SIZE)
+
+// ========================
+// 替身：EEPROM 与 CRC
+// ========================
+
+static uint8_t s_eeprom[0x1000];
+static int32_t s_tear_bytes = -1;    // ≥0：下一次写入只写前 N 字节后“掉电”
+
+bool NVM_Read(uint32_t addr, void *data, uint32_t size)
+{
+	if (addr + size > sizeof(s_eeprom)) {
+		return false;
+	}
+	memcpy(data, &s_eeprom[addr], size);
+	return true;
+}
+
+bool NVM_Write(uint32_t addr, const void *data, uint32_t size)
+{
+	if (addr + size > sizeof(s_eeprom)) {
+		return false;
+	}
+	if (s_tear_bytes >= 0) {
+		memcpy(&s_eeprom[addr], data, (uint32_t)s_tear_bytes < size ? (uint32_t)s_tear_bytes : size);
+		s_tear_bytes = -1;
+		return false;
+	}
+	memcpy(&s_eeprom[addr], data, size);
+	return true;
+}
+
+uint32_t NVM_Crc32(const void *data, uint32_t size)
+{
+	const uint8_t *p = (const uint8_t *)data;
+	uint32_t crc = 0xFFFFFFFFU;
+	for (uint32_t i = 0; i < size; ++i) {
+		crc ^= p[i];
+		for (uint8_t k = 0; k < 8U; ++k) {
+			crc = (crc >> 1) ^ (0xEDB88320U & (0U - (crc & 1U)));
+		}
+	}
+	return ~crc;
+}
+
+// ========================
+// 替身：各模块的当前参数
+// ========================
+
+static uint8_t s_h30_addr = 0x50;
+static float s_gyro_bias = 0.0f;
+static float32_t s_gain[4];
+static float32_t s_deadband[4];
+static float32_t s_turn_gain = 0.0f;
+static int16_t s_trim[2];
+static motor_model_t s_model[2];
+
+void H30_SetPreferredAddr(uint8_t addr_7bit) { s_h30_addr = addr_7bit; }
+uint8_t H30_GetI2cAddr(void) { return s_h30_addr; }
+void H30_SetGyroZBias(float bias_dps) { s_gyro_bias = bias_dps; }
+float H30_GetGyroZBias(void) { return s_gyro_bias; }
+
+void MyMove_SetMotorCalib(uint8_t motor, float32_t gain, float32_t deadband)
+{
+	s_gain[motor] = gain;
+	s_deadband[motor] = deadband;
+}
+
+void MyMove_GetMotorCalib(uint8_t motor, float32_t *gain, float32_t *deadband)
+{
+	*gain = s_gain[motor];
+	*deadband = s_deadband[motor];
+}
+
+float32_t MyMove_GetTurnStopGain(void) { return s_turn_gain; }
+void MyMove_SetTurnStopGain(float32_t gain) { s_turn_gain = gain; }
+void servo_set_trim_us(int16_t trim_us) { s_trim[0] = trim_us; }
+int16_t servo_get_trim_us(void) { return s_trim[0]; }
+void servo2_set_trim_us(int16_t trim_us) { s_trim[1] = trim_us; }
+int16_t servo2_get_trim_us(void) { return s_trim[1]; }
+void MotorIdent_GetModel(uint8_t side, motor_model_t *model) { *model = s_model[side]; }
+void MotorIdent_SetModel(uint8_t side, const motor_model_t *model) { s_model[side] = *model; }
+void MotorIdent_Print(void) {}
+
+// 第 k 次保存时各模块的参数
+static void set_params(int k)
+{
+	s_turn_gain = 0.01f * (float32_t)(k + 1);
+	s_trim[0] = (int16_t)k;
+	s_trim[1] = (int16_t)-k;
+	for (uint8_t m = 0; m < 4U; ++m) {
+		s_gain[m] = 1.0f + 0.001f * (float32_t)(k * 4 + m);
+		s_deadband[m] = 0.05f;
+	}
+	s_model[0].tau_ms = (uint16_t)(100 + k);
+	s_model[1].tau_ms = (uint16_t)(200 + k);
+}
+
+// 模拟重启：清掉各模块参数后加载
+static bool reboot_and_load(void)
+{
+	s_turn_gain = 0.0f;
+	s_trim[0] = s_trim[1] = 9999;
+	memset(s_gain, 0, sizeof(s_gain));
+	memset(s_model, 0, sizeof(s_model));
+	return Calib_Load();
+}
+
+static bool params_match(int k)
+{
+	return s_turn_gain == 0.01f * (float32_t)(k + 1) && s_trim[0] == k && s_trim[1] == -k &&
+	       s_gain[3] == 1.0f + 0.001f * (float32_t)(k * 4 + 3) &&
+	       s_model[0].tau_ms == 100 + k && s_model[1].tau_ms == 200 + k;
+}
+
+static void test_blank(void)
+{
+	memset(s_eeprom, 0xFF, sizeof(s_eeprom));
+	CHECK(!reboot_and_load());
+	CHECK(!Calib_IsLoaded());
+}
+
+// 保存次数超过两轮槽数，每次保存后重启都应读回最近一次保存的参数
+static void test_rotation(void)
+{
+	memset(s_eeprom, 0xFF, sizeof(s_eeprom));
+	(void)reboot_and_load();
+	for (int k = 0; k < (int)(2U * SLOTS + 3U); ++k) {
+		set_params(k);
+		CHECK(Calib_Save());
+		CHECK(reboot_and_load());
+		CHECK(params_match(k));
+	}
+	// 只有最近一轮的槽有效，且序号连续
+	CHECK(Calib_GetSavedTurnStopGain() == 0.01f * (float32_t)(2U * SLOTS + 3U));
+}
+
+// 写入中掉电：新槽只写了一部分，重启后仍是上一次保存的记录，下一次保存正常
+static void test_torn_write(void)
+{
+	memset(s_eeprom, 0xFF, sizeof(s_eeprom));
+	(void)reboot_and_load();
+	for (int k = 0; k < 3; ++k) {
+		set_params(k);
+		CHECK(Calib_Save());
+	}
+	set_params(3);
+	s_tear_bytes = (int32_t)(sizeof(calib_record_t) / 2U);
+	CHECK(!Calib_Save());
+	CHECK(reboot_and_load());
+	CHECK(params_match(2));
+	set_params(4);
+	CHECK(Calib_Save());
+	CHECK(reboot_and_load());
+	CHECK(params_match(4));
+}
+
+static void test_clear(void)
+{
+	set_params(7);
+	CHECK(Calib_Save());
+	CHECK(Calib_Clear());
+	CHECK(!reboot_and_load());
+}
+
+int main(void)
+{
+	test_blank();
+	test_rotation();
+	test_torn_write();
+	test_clear();
+	return test_done("calib_store");
+}
@@ -0,0 +1,19 @@
+/**
+ * @file RISCV_Typedefs.h
+ * @author 林木@江南大学
+ * @brief 主机端测试用的基本类型定义（目标端由工具链的 RISC-V 数学库提供同名头文件）
+ */
+
+#ifndef RISCV_TYPEDEFS_H
+#define RISCV_TYPEDEFS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef float float32_t;
+
+#define RISCV_STD_ON       1
+#define RISCV_STD_OFF      0
+#define RISCV_SUPPORT_F32  RISCV_STD_ON
+
+#endif
@@ -0,0 +1,441 @@
+/**
+ * @file lora_link_test.c
+ * @author 林木@江南大学
+ * @brief LoRa 状态下行编码的主机端测试
+ * @details Radio 替身：测试寄存器可读写（可设为未接模块读回 0xFF），Send 记下负载，
+ *          IrqProcess 按设定回调 TxDone 或保持未完成（模拟发送超时），空中时间固定。
+ *          接收端按 tools/lora_decode.py 的规则解码：差分帧累加到上一帧，序号不连续时丢弃差分帧直到关键帧。
+ *          覆盖：未检测到模块、关键帧/差分帧周期与帧长、接收端累加无漂移、航向过零、
+ *          丢帧后等待关键帧重新同步、发送超时后发关键帧并置标志、量化饱和与位置增量饱和
+ */
+
+#include "test_util.h"
+#include "lora_link.h"
+#include "sdk_project_config.h"
+#include "mission.h"
+#include "my_move.h"
+#include "pose_estimator.h"
+#include "calib_store.h"
+#include "sd_log.h"
+#include "flash_log.h"
+#include "net_telem.h"
+#include "board_delay.h"
+#include "radio.h"
+#include "sx126xboard.h"
+#include <math.h>
+#include <string.h>
+
+#define AIR_MS     41U
+#define KEY_BYTES  10U
+
+// ========================
+// 替身：SX1262 与 SPI
+// ========================
+
+static bool s_present = true;
+static uint8_t s_test_reg = 0x00U;
+static RadioEvents_t *s_events = NULL;
+static bool s_tx_pending = false;       // 已 Send，TxDone 未回调
+static bool s_tx_complete = true;       // IrqProcess 时完成发送
+static uint8_t s_air[LORA_LINK_FRAME_MAX];
+static uint8_t s_air_len = 0;
+static uint32_t s_sends = 0;
+static uint32_t s_now_ms = 0;
+
+spi_state_t g_stSpiState_0;
+spi_master_config_t g_stSpi0MasterConfig0;
+
+status_t SPI_DRV_MasterInit(uint32_t instance, spi_state_t *pstSpiState, const spi_master_config_t *pstSpiConfig)
+{
+	return STATUS_SUCCESS;
+}
+
+static void radio_init(RadioEvents_t *events) { s_events = events; }
+static void radio_set_channel(uint32_t freq) {}
+static void radio_sleep(void) {}
+
+static void radio_set_tx_config(RadioModems_t modem, int8_t power, uint32_t fdev, uint32_t bandwidth,
+                                uint32_t datarate, uint8_t coderate, uint16_t preambleLen, bool fixLen, bool crcOn,
+                                bool freqHopOn, uint8_t hopPeriod, bool iqInverted, uint32_t timeout)
+{
+}
+
+static uint32_t radio_time_on_air(RadioModems_t modem, uint32_t bandwidth, uint32_t datarate, uint8_t coderate,
+                                  uint16_t preambleLen, bool fixLen, uint8_t payloadLen, bool crcOn)
+{
+	return AIR_MS;
+}
+
+static void radio_send(uint8_t *buffer, uint8_t size)
+{
+	memcpy(s_air, buffer, size);
+	s_air_len = size;
+	s_sends++;
+	s_tx_pending = true;
+}
+
+static void radio_write(uint32_t addr, uint8_t data)
+{
+	if (addr == 0x06C0U) {
+		s_test_reg = data;
+	}
+}
+
+static uint8_t radio_read(uint32_t addr)
+{
+	return !s_present ? 0xFFU : ((addr == 0x06C0U) ? s_test_reg : 0x00U);
+}
+
+static void radio_irq_process(void)
+{
+	if (s_tx_pending && s_tx_complete) {
+		s_tx_pending = false;
+		s_events->TxDone();
+	}
+}
+
+const struct Radio_s Radio = {
+	.Init = radio_init,
+	.SetChannel = radio_set_channel,
+	.SetTxConfig = radio_set_tx_config,
+	.TimeOnAir = radio_time_on_air,
+	.Send = radio_send,
+	.Sleep = radio_sleep,
+	.Write = radio_write,
+	.Read = radio_read,
+	.IrqProcess = radio_irq_process,
+};
+
+void SX126xIoIrqPoll(void) {}
+
+// ========================
+// 替身：位姿、任务与其他模块
+// ========================
+
+static pose2d_t s_pose;
+static mission_status_t s_status = MISSION_IDLE;
+static uint8_t s_step = 0;
+static float32_t s_straight_target = 0.0f;
+
+uint32_t board_time_ms(void) { return s_now_ms; }
+void Pose_Get(pose2d_t *out) { *out = s_pose; }
+mission_status_t Mission_GetStatus(void) { return s_status; }
+uint8_t Mission_GetStepIndex(void) { return s_step; }
+float32_t MyMove_GetStraightTarget(void) { return s_straight_target; }
+bool Calib_IsLoaded(void) { return true; }
+bool SdLog_IsReady(void) { return true; }
+bool FlashLog_IsReady(void) { return true; }
+bool NetTelem_IsReady(void) { return false; }
+
+float32_t MyMove_NormalizeDeg(float32_t a)
+{
+	while (a > 180.0f) a -= 360.0f;
+	while (a <= -180.0f) a += 360.0f;
+	return a;
+}
+
+static uint16_t batt_mv(void) { return 7420U; }
+
+// ========================
+// 接收端（与 tools/lora_decode.py 相同的规则）
+// ========================
+
+typedef struct {
+	lora_link_state_t st;
+	bool valid;             // 有参考状态（差分帧可解）
+	int last_seq;           // -1：尚未收到
+	uint32_t frames;        // 解出的帧
+	uint32_t skipped;       // 等待关键帧丢弃的差分帧
+	uint32_t bad;           // 位数与帧长不符
+} rx_t;
+
+typedef struct {
+	const uint8_t *data;
+	uint8_t len;
+	uint16_t pos;
+} rx_bits_t;
+
+static rx_t s_rx;
+
+static uint32_t rx_get(rx_bits_t *b, uint8_t n)
+{
+	uint32_t v = 0U;
+	while (n-- > 0U) {
+		uint8_t byte = (b->pos >> 3 < b->len) ? b->data[b->pos >> 3] : 0U;
+		v = (v << 1) | ((byte >> (7U - (b->pos & 7U))) & 1U);
+		b->pos++;
+	}
+	return v;
+}
+
+static int32_t rx_get_var(rx_bits_t *b)
+{
+	static const uint8_t widths[4] = { 0U, 4U, 8U, 16U };
+	uint32_t z = rx_get(b, widths[rx_get(b, 2U)]);
+	return (int32_t)(z >> 1) ^ -(int32_t)(z & 1U);
+}
+
+static void rx_get_misc(rx_bits_t *b, lora_link_state_t *st)
+{
+	st->step = (uint8_t)rx_get(b, 6U);
+	st->status = (uint8_t)rx_get(b, 3U);
+	st->flags = (uint8_t)rx_get(b, 8U);
+	st->batt_dv = (uint8_t)rx_get(b, 8U);
+}
+
+static void rx_reset(void)
+{
+	memset(&s_rx, 0, sizeof(s_rx));
+	s_rx.last_seq = -1;
+}
+
+// 接收一帧；返回帧类型（解不出时为 -1）
+static int rx_frame(const uint8_t *data, uint8_t len)
+{
+	rx_bits_t b = { data, len, 0U };
+	int kind = (int)rx_get(&b, 1U);
+	int seq = (int)rx_get(&b, 4U);
+	if (s_rx.last_seq >= 0 && seq != ((s_rx.last_seq + 1) & 0x0F)) {
+		s_rx.valid = false;
+	}
+	s_rx.last_seq = seq;
+	lora_link_state_t st = s_rx.st;
+	if (kind == (int)LORA_LINK_KIND_KEY) {
+		st.x_cm = (int16_t)rx_get(&b, 16U);
+		st.y_cm = (int16_t)rx_get(&b, 16U);
+		st.yaw_hdeg = (uint16_t)rx_get(&b, 10U);
+		st.herr_hdeg = (int8_t)rx_get(&b, 8U);
+		rx_get_misc(&b, &st);
+	} else {
+		if (!s_rx.valid) {
+			s_rx.skipped++;
+			return -1;
+		}
+		st.x_cm = (int16_t)(s_rx.st.x_cm + rx_get_var(&b));
+		st.y_cm = (int16_t)(s_rx.st.y_cm + rx_get_var(&b));
+		st.yaw_hdeg = (uint16_t)((s_rx.st.yaw_hdeg + rx_get_var(&b) + 720) % 720);
+		st.herr_hdeg = (int8_t)rx_get_var(&b);
+		if (rx_get(&b, 1U) != 0U) {
+			rx_get_misc(&b, &st);
+		}
+	}
+	if ((uint8_t)((b.pos + 7U) >> 3) != len) {
+		s_rx.bad++;
+		s_rx.valid = false;
+		return -1;
+	}
+	s_rx.st = st;
+	s_rx.valid = true;
+	s_rx.frames++;
+	return kind;
+}
+
+// ========================
+// 测试辅助
+// ========================
+
+static void set_pose(float32_t x_mm, float32_t y_mm, float32_t theta_deg)
+{
+	s_pose.x_mm = x_mm;
+	s_pose.y_mm = y_mm;
+	s_pose.theta_deg = theta_deg;
+}
+
+static void boot(void)
+{
+	s_present = true;
+	s_tx_pending = false;
+	s_tx_complete = true;
+	s_status = MISSION_IDLE;
+	s_step = 0;
+	s_straight_target = 0.0f;
+	set_pose(0.0f, 0.0f, 0.0f);
+	s_now_ms += 10000U;
+	LoraLink_SetBatteryHook(batt_mv);
+	CHECK(LoraLink_Init());
+	rx_reset();
+}
+
+// 推进到下一个发送时刻：先取上一帧的发送结果，再发出一帧；返回新发出的帧数
+static uint32_t next_frame(void)
+{
+	uint32_t sends = s_sends;
+	s_now_ms += LORA_LINK_PERIOD_MS;
+	LoraLink_Service();
+	return s_sends - sends;
+}
+
+// 发一帧并由接收端解码；返回帧类型（未发出或解不出时为 -1）
+static int send_and_receive(void)
+{
+	if (next_frame() == 0U) {
+		return -1;
+	}
+	return rx_frame(s_air, s_air_len);
+}
+
+static bool rx_matches(int16_t x_cm, int16_t y_cm, uint16_t yaw_hdeg)
+{
+	return s_rx.valid && s_rx.st.x_cm == x_cm && s_rx.st.y_cm == y_cm && s_rx.st.yaw_hdeg == yaw_hdeg;
+}
+
+// ========================
+// 测试
+// ========================
+
+static void test_absent(void)
+{
+	s_present = false;
+	CHECK(!LoraLink_Init());
+	CHECK(!LoraLink_IsReady());
+	uint32_t sends = s_sends;
+	s_now_ms += 5000U;
+	LoraLink_Service();
+	CHECK(s_sends == sends);
+}
+
+// 直行：首帧与每 LORA_LINK_KEY_EVERY 帧为关键帧，其余差分帧短且接收端累加与当前量化位姿一致
+static void test_key_and_delta(void)
+{
+	boot();
+	uint32_t keys = 0U;
+	for (uint32_t i = 0; i < 3U * LORA_LINK_KEY_EVERY; ++i) {
+		// 每秒前进 0.31 m，航向在 0° 两侧来回，差分须取最短方向（过零不回绕时增量为 ±718）
+		set_pose(310.0f * (float32_t)i + 1.0f, -50.0f * (float32_t)i, (i & 1U) ? -0.5f : 0.5f);
+		int kind = send_and_receive();
+		CHECK(kind >= 0);
+		if (kind == (int)LORA_LINK_KIND_KEY) {
+			keys++;
+			CHECK(i % LORA_LINK_KEY_EVERY == 0U);
+			CHECK(s_air_len == KEY_BYTES);
+		} else {
+			CHECK(i % LORA_LINK_KEY_EVERY != 0U);
+			CHECK(s_air_len <= 4U);
+		}
+		CHECK(rx_matches((int16_t)(31U * i), (int16_t)(-5 * (int32_t)i), (i & 1U) ? 719U : 1U));
+		CHECK(s_rx.st.batt_dv == 74U);
+		CHECK(s_rx.st.status == (uint8_t)MISSION_IDLE);
+		CHECK((s_rx.st.flags & LORA_LINK_F_NO_NET) != 0U);
+	}
+	CHECK(keys == 3U);
+	CHECK(s_rx.bad == 0U && s_rx.skipped == 0U);
+
+	// 位姿不变时差分帧只有各字段的长度码
+	int kind = send_and_receive();
+	CHECK(kind == (int)LORA_LINK_KIND_KEY);
+	kind = send_and_receive();
+	CHECK(kind == (int)LORA_LINK_KIND_DELTA);
+	CHECK(s_air_len == 2U);
+
+	// 任务步骤变化时差分帧带 misc 字段
+	s_step = 70U;
+	CHECK(send_and_receive() == (int)LORA_LINK_KIND_DELTA);
+	CHECK(s_rx.st.step == 63U);
+}
+
+// 接收端漏收一帧：之后的差分帧丢弃，直到下一个关键帧重新同步，且同步后与发送端一致
+static void test_resync_after_loss(void)
+{
+	boot();
+	for (uint32_t i = 0; i < 3U; ++i) {
+		set_pose(100.0f * (float32_t)i, 0.0f, 10.0f);
+		CHECK(send_and_receive() >= 0);
+	}
+	// 第 4 帧发出但未收到
+	set_pose(300.0f, 0.0f, 10.0f);
+	CHECK(next_frame() == 1U);
+	uint32_t skipped = 0U;
+	int kind = -1;
+	for (uint32_t i = 4U; i < LORA_LINK_KEY_EVERY + 1U; ++i) {
+		set_pose(100.0f * (float32_t)i, 20.0f, 10.0f);
+		kind = send_and_receive();
+		if (kind < 0) {
+			skipped++;
+			CHECK(!s_rx.valid);
+		}
+	}
+	CHECK(skipped == LORA_LINK_KEY_EVERY - 4U);
+	CHECK(s_rx.skipped == skipped);
+	CHECK(kind == (int)LORA_LINK_KIND_KEY);
+	CHECK(rx_matches(80, 2, 20U));
+	set_pose(950.0f, 30.0f, 11.0f);
+	CHECK(send_and_receive() == (int)LORA_LINK_KIND_DELTA);
+	CHECK(rx_matches(95, 3, 22U));
+	CHECK(s_rx.bad == 0U);
+}
+
+// 发送超时（无 TxDone）：下一帧为关键帧并带超时标志，接收端据此重新同步；恢复后标志清除
+static void test_tx_timeout(void)
+{
+	boot();
+	CHECK(send_and_receive() == (int)LORA_LINK_KIND_KEY);
+	CHECK(send_and_receive() == (int)LORA_LINK_KIND_DELTA);
+	LoraLink_Service();
+	s_tx_complete = false;
+	set_pose(500.0f, 0.0f, 0.0f);
+	CHECK(next_frame() == 1U);              // 这一帧发送超时，接收端未收到
+	s_tx_complete = true;
+	s_tx_pending = false;                   // 射频丢掉了这一帧，不再有 TxDone
+	set_pose(600.0f, 0.0f, 0.0f);
+	CHECK(send_and_receive() == (int)LORA_LINK_KIND_KEY);
+	CHECK((s_rx.st.flags & LORA_LINK_F_TX_TIMEOUT) != 0U);
+	CHECK(rx_matches(60, 0, 0U));
+	set_pose(700.0f, 0.0f, 0.0f);
+	CHECK(send_and_receive() == (int)LORA_LINK_KIND_DELTA);
+	CHECK((s_rx.st.flags & LORA_LINK_F_TX_TIMEOUT) == 0U);
+	CHECK(rx_matches(70, 0, 0U));
+}
+
+// 量化饱和：位置超出 int16 cm、航向误差超出 ±63.5°、NaN
+static void test_quantize_saturation(void)
+{
+	boot();
+	s_status = MISSION_RUNNING;
+	set_pose(1.0e7f, -1.0e7f, NAN);
+	flight_rec_t rec;
+	memset(&rec, 0, sizeof(rec));
+	rec.yaw_cdeg = -9000;                   // 目标 0°，误差 +90°
+	rec.step = 3U;
+	rec.flags = FLIGHT_REC_FLAG_OBSTACLE;
+	LoraLink_Capture(&rec);
+	CHECK(send_and_receive() == (int)LORA_LINK_KIND_KEY);
+	CHECK(s_rx.st.x_cm == 32767 && s_rx.st.y_cm == -32768);
+	CHECK(s_rx.st.yaw_hdeg == 0U);
+	CHECK(s_rx.st.herr_hdeg == 127);
+	CHECK(s_rx.st.step == 3U);
+	CHECK(s_rx.st.status == (uint8_t)MISSION_RUNNING);
+	CHECK((s_rx.st.flags & LORA_LINK_F_OBSTACLE) != 0U);
+	rec.yaw_cdeg = 9000;
+	LoraLink_Capture(&rec);
+	CHECK(send_and_receive() == (int)LORA_LINK_KIND_DELTA);
+	CHECK(s_rx.st.herr_hdeg == -127);
+}
+
+// 位置增量超出 int16：差分帧饱和，接收端与编码器参考一致，下一帧补齐剩余部分
+static void test_delta_saturation(void)
+{
+	boot();
+	set_pose(-327000.0f, 327000.0f, 0.0f);
+	CHECK(send_and_receive() == (int)LORA_LINK_KIND_KEY);
+	CHECK(rx_matches(-32700, 32700, 0U));
+	set_pose(327000.0f, -327000.0f, 0.0f);
+	CHECK(send_and_receive() == (int)LORA_LINK_KIND_DELTA);
+	CHECK(s_rx.bad == 0U);
+	CHECK(rx_matches(-32700 + 32767, 32700 - 32768, 0U));
+	CHECK(send_and_receive() == (int)LORA_LINK_KIND_DELTA);
+	CHECK(rx_matches(32700, -32700, 0U));
+	CHECK(send_and_receive() == (int)LORA_LINK_KIND_DELTA);
+	CHECK(s_air_len == 2U);
+	CHECK(rx_matches(32700, -32700, 0U));
+}
+
+int main(void)
+{
+	test_absent();
+	test_key_and_delta();
+	test_resync_after_loss();
+	test_tx_timeout();
+	test_quantize_saturation();
+	test_delta_saturation();
+	return test_done("lora_link");
+}
@@ -0,0 +1,498 @@
+/**
+ * @file net_telem_test.c
+ * @author 林木@江南大学
+ * @brief W5500 以太网遥测与命令通道的主机端测试
+ * @details SPI_DRV_MasterTransferBlocking 替身按 VDM 帧（16 位地址 + 控制字节 + 数据）访问 W5500 寄存器模型：
+ *          通用寄存器、套接字 0 寄存器、2 KiB 发送/接收缓冲（指针 16 位，按缓冲大小回绕）；
+ *          Sn_CR 命令（OPEN/SEND/RECV）、Sn_IR 写 1 清零、Sn_RX_RSR 由读写指针计算。
+ *          SEND 把 Sn_TX_RD~Sn_TX_WR 之间的数据作为一个数据报记下，可设置为暂不完成（模拟 ARP/发送未完）。
+ *          覆盖：复位检测与地址/套接字配置、未检测到芯片、命令行打印不访问 SPI、订阅与遥测帧内容、
+ *          上一帧未完成时丢帧、GET/SET 应答、格式错误、发送/接收缓冲回绕与超长数据报跳过、订阅超时、
+ *          目的地址只在变化时重写
+ */
+
+#include "test_util.h"
+#include "net_telem.h"
+#include "sdk_project_config.h"
+#include "shell.h"
+#include "mission.h"
+#include "odometry.h"
+#include "pose_estimator.h"
+#include "hcsr04.h"
+#include "board_delay.h"
+#include <string.h>
+#include "w5500.h"
+
+#define BUF_SIZE     2048U
+#define HOST_IP      { 192, 168, 1, 10 }
+#define HOST_PORT    6000U
+
+// ========================
+// W5500 寄存器模型
+// ========================
+
+typedef struct {
+	uint8_t ip[4];
+	uint16_t port;
+	uint16_t len;
+	uint8_t data[128];
+} datagram_t;
+
+static uint8_t s_common[0x40];
+static uint8_t s_sreg[0x30];
+static uint8_t s_txbuf[BUF_SIZE];
+static uint8_t s_rxbuf[BUF_SIZE];
+static uint16_t s_rx_wr = 0;            // 接收写指针（芯片内部）
+static bool s_present = true;           // 芯片在位
+static bool s_reset_released = false;
+static uint32_t s_ready_at_ms = 0;      // 复位释放后 VERSIONR 可读的时刻
+static bool s_send_complete = true;     // SEND 后立即置 SEND_OK
+static uint16_t s_open_tx_ptr = 0;      // OPEN 后的 Sn_TX_RD/WR 初值
+static uint32_t s_spi_xfers = 0;
+static uint32_t s_dipr_writes = 0;
+static datagram_t s_sent[8];            // 最近发出的数据报（环形）
+static uint32_t s_sent_count = 0;
+static uint32_t s_now_ms = 0;
+
+static uint16_t be16(const uint8_t *p)
+{
+	return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+static void put_be16(uint8_t *p, uint16_t v)
+{
+	p[0] = (uint8_t)(v >> 8);
+	p[1] = (uint8_t)v;
+}
+
+static void w5500_command(uint8_t cmd)
+{
+	switch (cmd) {
+	case Sn_CR_OPEN:
+		s_sreg[0x03] = ((s_sreg[0x00] & 0x0FU) == Sn_MR_UDP) ? SOCK_UDP : 0x00U;
+		put_be16(&s_sreg[0x22], s_open_tx_ptr);
+		put_be16(&s_sreg[0x24], s_open_tx_ptr);
+		put_be16(&s_sreg[0x28], s_rx_wr);
+		break;
+	case Sn_CR_SEND: {
+		datagram_t *d = &s_sent[s_sent_count++ % 8U];
+		uint16_t rd = be16(&s_sreg[0x22]);
+		uint16_t wr = be16(&s_sreg[0x24]);
+		memcpy(d->ip, &s_sreg[0x0C], 4U);
+		d->port = be16(&s_sreg[0x10]);
+		d->len = (uint16_t)(wr - rd);
+		for (uint16_t i = 0; i < d->len && i < sizeof(d->data); ++i) {
+			d->data[i] = s_txbuf[(uint16_t)(rd + i) % BUF_SIZE];
+		}
+		put_be16(&s_sreg[0x22], wr);
+		if (s_send_complete) {
+			s_sreg[0x02] |= Sn_IR_SEND_OK;
+		}
+		break;
+	}
+	case Sn_CR_RECV:
+		// 读指针由 Sn_RX_RD 给出，RSR 按读写指针差计算
+		break;
+	default:
+		break;
+	}
+	s_sreg[0x01] = 0U;
+}
+
+static uint8_t w5500_read(uint8_t bsb, uint16_t addr)
+{
+	switch (bsb) {
+	case 0:
+		if (addr == 0x39U) {
+			return (s_reset_released && s_now_ms >= s_ready_at_ms) ? 0x04U : 0x00U;
+		}
+		return (addr < sizeof(s_common)) ? s_common[addr] : 0U;
+	case 1:
+		if (addr == 0x26U || addr == 0x27U) {
+			uint8_t rsr[2];
+			put_be16(rsr, (uint16_t)(s_rx_wr - be16(&s_sreg[0x28])));
+			return rsr[addr - 0x26U];
+		}
+		return (addr < sizeof(s_sreg)) ? s_sreg[addr] : 0U;
+	case 2:
+		return s_txbuf[addr % BUF_SIZE];
+	case 3:
+		return s_rxbuf[addr % BUF_SIZE];
+	default:
+		return 0U;
+	}
+}
+
+static void w5500_write(uint8_t bsb, uint16_t addr, uint8_t v)
+{
+	switch (bsb) {
+	case 0:
+		if (addr < sizeof(s_common)) {
+			s_common[addr] = v;
+		}
+		break;
+	case 1:
+		if (addr == 0x01U) {
+			w5500_command(v);
+		} else if (addr == 0x02U) {
+			s_sreg[0x02] &= (uint8_t)~v;
+		} else if (addr < sizeof(s_sreg)) {
+			if (addr == 0x0CU) {
+				s_dipr_writes++;
+			}
+			s_sreg[addr] = v;
+		}
+		break;
+	case 2:
+		s_txbuf[addr % BUF_SIZE] = v;
+		break;
+	default:
+		break;
+	}
+}
+
+// 主机发来的数据报：信息段（源 IP + 源端口 + 长度，大端）+ 数据写入接收缓冲
+static void host_send(const uint8_t ip[4], uint16_t port, const void *data, uint16_t len)
+{
+	uint8_t info[8] = { ip[0], ip[1], ip[2], ip[3] };
+	put_be16(&info[4], port);
+	put_be16(&info[6], len);
+	for (uint16_t i = 0; i < 8U; ++i) {
+		s_rxbuf[(uint16_t)(s_rx_wr + i) % BUF_SIZE] = info[i];
+	}
+	for (uint16_t i = 0; i < len; ++i) {
+		s_rxbuf[(uint16_t)(s_rx_wr + 8U + i) % BUF_SIZE] = ((const uint8_t *)data)[i];
+	}
+	s_rx_wr = (uint16_t)(s_rx_wr + 8U + len);
+}
+
+static void w5500_reset_model(void)
+{
+	memset(s_common, 0, sizeof(s_common));
+	memset(s_sreg, 0, sizeof(s_sreg));
+	s_reset_released = false;
+	s_send_complete = true;
+	s_sent_count = 0;
+	s_dipr_writes = 0;
+	s_spi_xfers = 0;
+}
+
+// ========================
+// 替身：SPI、引脚、时间与其他模块
+// ========================
+
+spi_state_t g_stSpiState_1;
+spi_master_config_t g_stSpi1MasterConfig0;
+
+status_t SPI_DRV_MasterInit(uint32_t instance, spi_state_t *pstSpiState, const spi_master_config_t *pstSpiConfig)
+{
+	return STATUS_SUCCESS;
+}
+
+status_t SPI_DRV_MasterTransferBlocking(uint32_t instance, const uint8_t *sendBuffer, uint8_t *receiveBuffer,
+                                        uint16_t transferByteCount, uint32_t timeout)
+{
+	s_spi_xfers++;
+	if (!s_present || transferByteCount < 3U) {
+		if (receiveBuffer != NULL) {
+			memset(receiveBuffer, 0, transferByteCount);
+		}
+		return STATUS_SUCCESS;
+	}
+	uint16_t addr = be16(sendBuffer);
+	uint8_t bsb = (uint8_t)(sendBuffer[2] >> 3);
+	bool write = (sendBuffer[2] & 0x04U) != 0U;
+	for (uint16_t i = 3; i < transferByteCount; ++i, ++addr) {
+		if (write) {
+			w5500_write(bsb, addr, sendBuffer[i]);
+		} else {
+			receiveBuffer[i] = w5500_read(bsb, addr);
+		}
+	}
+	return STATUS_SUCCESS;
+}
+
+void PINS_DRV_WritePin(uint8_t port, pins_channel_type_t pin, pins_level_type_t value)
+{
+	if (port == PORTC && pin == 22U) {
+		s_reset_released = (value != 0U);
+		s_ready_at_ms = s_now_ms + 3U;
+	}
+}
+
+void board_delay_us(uint32_t us) {}
+void simple_delay_ms(unsigned int ms) { s_now_ms += ms; }
+uint32_t board_time_ms(void) { return s_now_ms; }
+
+static float32_t s_kp = 0.5f;
+static const param_desc_t s_params[] = {
+	{ "straight_kp", &s_kp, 0.0f, 2.0f },
+};
+
+const param_desc_t *Shell_FindParam(const char *name)
+{
+	return (strcmp(name, s_params[0].name) == 0) ? &s_params[0] : NULL;
+}
+
+void Pose_Get(pose2d_t *out)
+{
+	memset(out, 0, sizeof(*out));
+	out->x_mm = 123.4f;
+	out->y_mm = -56.7f;
+	out->theta_deg = -45.67f;
+}
+
+float HCSR04_GetCachedDistance(void) { return 35.2f; }
+float32_t Odom_GetSpeedMmS(void) { return 250.6f; }
+mission_status_t Mission_GetStatus(void) { return MISSION_RUNNING; }
+
+// ========================
+// 主机侧报文
+// ========================
+
+static const uint8_t s_host_ip[4] = HOST_IP;
+
+static void host_cmd(uint8_t type, uint16_t seq, const void *payload, uint16_t len)
+{
+	uint8_t pkt[64];
+	net_telem_hdr_t h = { NET_TELEM_MAGIC, NET_TELEM_VERSION, type, seq, len };
+	memcpy(pkt, &h, sizeof(h));
+	memcpy(&pkt[sizeof(h)], payload, len);
+	host_send(s_host_ip, HOST_PORT, pkt, (uint16_t)(sizeof(h) + len));
+}
+
+static void host_param(uint8_t type, uint16_t seq, const char *name, float value)
+{
+	net_telem_param_t p;
+	memset(&p, 0, sizeof(p));
+	strncpy(p.name, name, sizeof(p.name) - 1U);
+	p.value = value;
+	host_cmd(type, seq, &p, sizeof(p));
+}
+
+static const datagram_t *last_sent(void)
+{
+	return (s_sent_count > 0U) ? &s_sent[(s_sent_count - 1U) % 8U] : NULL;
+}
+
+static const net_telem_hdr_t *sent_hdr(const datagram_t *d)
+{
+	return (const net_telem_hdr_t *)d->data;
+}
+
+static const net_telem_ack_t *sent_ack(const datagram_t *d)
+{
+	return (const net_telem_ack_t *)&d->data[sizeof(net_telem_hdr_t)];
+}
+
+static flight_rec_t make_rec(uint32_t t_ms)
+{
+	flight_rec_t r;
+	memset(&r, 0, sizeof(r));
+	r.t_ms = t_ms;
+	r.seq = (uint16_t)t_ms;
+	return r;
+}
+
+static void boot(uint16_t tx_ptr)
+{
+	w5500_reset_model();
+	s_open_tx_ptr = tx_ptr;
+	s_present = true;
+	CHECK(NetTelem_Init());
+}
+
+// ========================
+// 测试
+// ========================
+
+static void test_init(void)
+{
+	w5500_reset_model();
+	s_present = false;
+	CHECK(!NetTelem_Init());
+	CHECK(!NetTelem_IsReady());
+	uint32_t xfers = s_spi_xfers;
+	flight_rec_t r = make_rec(1U);
+	NetTelem_Publish(&r);
+	NetTelem_Poll();
+	CHECK(s_spi_xfers == xfers);
+
+	boot(0U);
+	CHECK(NetTelem_IsReady());
+	static const uint8_t gw[4] = NET_TELEM_GATEWAY;
+	static const uint8_t mask[4] = NET_TELEM_NETMASK;
+	static const uint8_t mac[6] = NET_TELEM_MAC;
+	static const uint8_t ip[4] = NET_TELEM_IP;
+	CHECK(memcmp(&s_common[0x01], gw, 4U) == 0 && memcmp(&s_common[0x05], mask, 4U) == 0);
+	CHECK(memcmp(&s_common[0x09], mac, 6U) == 0 && memcmp(&s_common[0x0F], ip, 4U) == 0);
+	CHECK(be16(&s_common[0x19]) == 1000U && s_common[0x1B] == 2U);
+	CHECK(s_sreg[0x03] == SOCK_UDP && be16(&s_sreg[0x04]) == NET_TELEM_PORT);
+
+	// 链路状态由 NetTelem_Poll 读取，命令行打印（遥测任务）不访问 SPI1
+	s_common[0x2E] = 0x07U;
+	NetTelem_Poll();
+	xfers = s_spi_xfers;
+	NetTelem_Print();
+	CHECK(s_spi_xfers == xfers);
+}
+
+static void test_subscribe_and_publish(void)
+{
+	boot(0U);
+	flight_rec_t r = make_rec(100U);
+	// 未订阅：不发送遥测
+	NetTelem_Publish(&r);
+	CHECK(s_sent_count == 0U);
+
+	host_cmd(NET_TELEM_T_HELLO, 7U, NULL, 0U);
+	NetTelem_Poll();
+	const datagram_t *d = last_sent();
+	CHECK(d != NULL && sent_hdr(d)->type == NET_TELEM_T_ACK && sent_hdr(d)->seq == 7U);
+	CHECK(d != NULL && d->port == HOST_PORT && memcmp(d->ip, s_host_ip, 4U) == 0);
+
+	NetTelem_Publish(&r);
+	d = last_sent();
+	CHECK(s_sent_count == 2U);
+	CHECK(d->len == sizeof(net_telem_hdr_t) + sizeof(net_telem_rec_t));
+	const net_telem_hdr_t *h = sent_hdr(d);
+	CHECK(h->magic == NET_TELEM_MAGIC && h->version == NET_TELEM_VERSION && h->type == NET_TELEM_T_REC);
+	CHECK(h->len == sizeof(net_telem_rec_t));
+	net_telem_rec_t f;
+	memcpy(&f, &d->data[sizeof(*h)], sizeof(f));
+	CHECK(f.rec.t_ms == 100U && f.x_dmm == 1234 && f.y_dmm == -567);
+	CHECK(f.theta_cdeg == -4567 && f.speed_mms == 251 && f.range_mm == 352U);
+	CHECK(f.status == MISSION_RUNNING && f.drops == 0U);
+	// 目的地址与应答相同，不重写
+	CHECK(s_dipr_writes == 1U);
+}
+
+static void test_drop_when_busy(void)
+{
+	boot(0U);
+	host_cmd(NET_TELEM_T_HELLO, 1U, NULL, 0U);
+	NetTelem_Poll();
+	flight_rec_t r = make_rec(1U);
+	NetTelem_Publish(&r);
+	uint16_t seq0 = sent_hdr(last_sent())->seq;   // 帧序号在重新初始化后接续
+	uint32_t sent = s_sent_count;
+	// 发送未完成（如 ARP 进行中）：之后的帧丢弃，控制周期不等待
+	s_send_complete = false;
+	NetTelem_Publish(&r);
+	uint32_t xfers = s_spi_xfers;
+	NetTelem_Publish(&r);
+	NetTelem_Publish(&r);
+	CHECK(s_sent_count == sent + 1U);
+	CHECK(s_spi_xfers - xfers <= 2U * 8U);
+	// 完成后恢复；序号跳过丢弃的帧，drops 计数随帧发出
+	s_sreg[0x02] |= Sn_IR_SEND_OK;
+	s_send_complete = true;
+	NetTelem_Publish(&r);
+	const datagram_t *d = last_sent();
+	net_telem_rec_t f;
+	memcpy(&f, &d->data[sizeof(net_telem_hdr_t)], sizeof(f));
+	CHECK(sent_hdr(d)->seq == seq0 + 4U && f.drops == 2U);
+}
+
+static void test_params(void)
+{
+	boot(0U);
+	s_kp = 0.5f;
+	host_param(NET_TELEM_T_GET, 10U, "straight_kp", 0.0f);
+	NetTelem_Poll();
+	const net_telem_ack_t *a = sent_ack(last_sent());
+	CHECK(a->cmd == NET_TELEM_T_GET && a->result == NET_TELEM_OK && a->value == 0.5f);
+	CHECK(strcmp(a->name, "straight_kp") == 0 && a->min == 0.0f && a->max == 2.0f);
+
+	host_param(NET_TELEM_T_SET, 11U, "straight_kp", 1.25f);
+	NetTelem_Poll();
+	a = sent_ack(last_sent());
+	CHECK(a->result == NET_TELEM_OK && s_kp == 1.25f && a->value == 1.25f);
+
+	host_param(NET_TELEM_T_SET, 12U, "straight_kp", 9.0f);
+	NetTelem_Poll();
+	a = sent_ack(last_sent());
+	CHECK(a->result == NET_TELEM_ERR_RANGE && s_kp == 1.25f);
+
+	host_param(NET_TELEM_T_GET, 13U, "no_such", 0.0f);
+	NetTelem_Poll();
+	a = sent_ack(last_sent());
+	CHECK(a->result == NET_TELEM_ERR_UNKNOWN && sent_hdr(last_sent())->seq == 13U);
+
+	// 负载长度不符：应答格式错误；魔数错误：不应答
+	uint8_t short_payload[4] = { 0 };
+	host_cmd(NET_TELEM_T_SET, 14U, short_payload, sizeof(short_payload));
+	NetTelem_Poll();
+	CHECK(sent_ack(last_sent())->result == NET_TELEM_ERR_FORMAT);
+	uint32_t sent = s_sent_count;
+	uint8_t junk[8] = { 0x12, 0x34, 1, NET_TELEM_T_GET, 0, 0, 0, 0 };
+	host_send(s_host_ip, HOST_PORT, junk, sizeof(junk));
+	NetTelem_Poll();
+	CHECK(s_sent_count == sent);
+}
+
+// 发送写指针跨过 16 位与 2 KiB 缓冲边界，接收缓冲中的数据报跨过缓冲末尾，超长数据报只读前部后跳过
+static void test_buffer_wrap(void)
+{
+	boot((uint16_t)(0x10000U - 100U));
+	host_cmd(NET_TELEM_T_HELLO, 1U, NULL, 0U);
+	NetTelem_Poll();
+	for (uint32_t i = 0; i < 80U; ++i) {
+		flight_rec_t r = make_rec(1000U + i);
+		NetTelem_Publish(&r);
+		const datagram_t *d = last_sent();
+		net_telem_rec_t f;
+		memcpy(&f, &d->data[sizeof(net_telem_hdr_t)], sizeof(f));
+		CHECK(d->len == sizeof(net_telem_hdr_t) + sizeof(net_telem_rec_t));
+		CHECK(sent_hdr(d)->magic == NET_TELEM_MAGIC && f.rec.t_ms == 1000U + i);
+	}
+
+	s_rx_wr = (uint16_t)(BUF_SIZE * 3U - 10U);
+	boot(0U);
+	uint8_t big[100];
+	memset(big, 0xAB, sizeof(big));
+	host_send(s_host_ip, HOST_PORT, big, sizeof(big));
+	s_kp = 0.5f;
+	host_param(NET_TELEM_T_SET, 20U, "straight_kp", 0.75f);
+	NetTelem_Poll();
+	CHECK(s_kp == 0.75f && sent_ack(last_sent())->result == NET_TELEM_OK);
+	CHECK(sent_hdr(last_sent())->seq == 20U);
+	// 全部取走
+	CHECK(be16(&s_sreg[0x28]) == s_rx_wr);
+}
+
+static void test_peer_timeout(void)
+{
+	boot(0U);
+	host_cmd(NET_TELEM_T_HELLO, 1U, NULL, 0U);
+	NetTelem_Poll();
+	flight_rec_t r = make_rec(1U);
+	s_now_ms += NET_TELEM_PEER_TIMEOUT_MS - 100U;
+	uint32_t sent = s_sent_count;
+	NetTelem_Publish(&r);
+	CHECK(s_sent_count == sent + 1U);
+	s_now_ms += 200U;
+	NetTelem_Publish(&r);
+	CHECK(s_sent_count == sent + 1U);
+	// 换一个主机订阅：目的地址重写
+	const uint8_t other[4] = { 192, 168, 1, 20 };
+	uint8_t hello[8];
+	net_telem_hdr_t h = { NET_TELEM_MAGIC, NET_TELEM_VERSION, NET_TELEM_T_HELLO, 2U, 0U };
+	memcpy(hello, &h, sizeof(h));
+	uint32_t dipr = s_dipr_writes;
+	host_send(other, HOST_PORT, hello, sizeof(hello));
+	NetTelem_Poll();
+	NetTelem_Publish(&r);
+	CHECK(memcmp(last_sent()->ip, other, 4U) == 0 && s_dipr_writes == dipr + 1U);
+}
+
+int main(void)
+{
+	test_init();
+	test_subscribe_and_publish();
+	test_drop_when_busy();
+	test_params();
+	test_buffer_wrap();
+	test_peer_timeout();
+	return test_done("net_telem");
+}
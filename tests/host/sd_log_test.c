@@ -0,0 +1,442 @@
+/**
+ * @file sd_log_test.c
+ * @author 林木@江南大学
+ * @brief SD 卡运行记录的主机端测试
+ * @details SD 卡为临时文件（按 512 字节扇区读写，第 0 扇区为带 0xDA 分区的 MBR）。
+ *          每次“上电”在子进程中运行，sd_log.c 的静态状态随进程丢弃、镜像文件保留，
+ *          写入中掉电即子进程在多块写写出一部分扇区后退出；子进程的检查结果经管道交回。
+ *          覆盖：双缓冲交替与两缓冲都未写出时丢弃、数据区回绕、运行中掉电后从检查点恢复
+ */
+
+#include "test_util.h"
+#include "sd_log.h"
+#include "sdk_project_config.h"
+#include "spi_sd_driver.h"
+#include "nvm_store.h"
+#include "board_delay.h"
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#define SECTOR     SD_LOG_SECTOR
+#define BUF_RECS   (SD_LOG_BUF_SECTORS * SD_LOG_RECS_PER_SECTOR)
+#define PART_LBA   8U
+
+// ========================
+// 替身：文件 SD 卡、SPI、CRC 与时间
+// ========================
+
+static int s_disk_fd = -1;
+static int32_t s_cut_sectors = -1;   // ≥0：下一次写入只写前 N 个扇区后掉电
+static uint32_t s_data_writes = 0;   // 数据区多块写次数
+static uint32_t s_last_write_lba = 0;
+static uint32_t s_last_write_count = 0;
+static uint32_t s_now_ms = 0;
+static int s_result_fd = -1;
+
+spi_state_t g_stSpiState_3;
+spi_master_config_t g_stSpi3MasterConfig0;
+spi_master_config_t g_stSpi3MasterConfig1;
+
+status_t SPI_DRV_MasterInit(uint32_t instance, spi_state_t *pstSpiState, const spi_master_config_t *pstSpiConfig)
+{
+	return STATUS_SUCCESS;
+}
+
+status_t SPI_DRV_MasterConfigureBus(uint32_t instance, const spi_master_config_t *pstSpiConfig,
+                                    uint32_t *calculatedBaudRate)
+{
+	*calculatedBaudRate = 12000000U;
+	return STATUS_SUCCESS;
+}
+
+uint8_t SD_DRV_Init(uint32_t instance)
+{
+	return 0U;
+}
+
+uint8_t SD_DRV_ReadDisk(uint32_t instance, uint8_t *buffer, uint32_t addr, uint32_t blockCount)
+{
+	ssize_t n = pread(s_disk_fd, buffer, (size_t)blockCount * SECTOR, (off_t)addr * SECTOR);
+	return (n == (ssize_t)(blockCount * SECTOR)) ? 0U : 1U;
+}
+
+static void boot_exit(void);
+
+uint8_t SD_DRV_WriteDisk(uint32_t instance, uint8_t *buffer, uint32_t addr, uint32_t blockCount)
+{
+	if (addr > PART_LBA) {
+		s_data_writes++;
+		s_last_write_lba = addr;
+		s_last_write_count = blockCount;
+	}
+	if (s_cut_sectors >= 0) {
+		uint32_t n = ((uint32_t)s_cut_sectors < blockCount) ? (uint32_t)s_cut_sectors : blockCount;
+		(void)pwrite(s_disk_fd, buffer, (size_t)n * SECTOR, (off_t)addr * SECTOR);
+		boot_exit();
+	}
+	ssize_t n = pwrite(s_disk_fd, buffer, (size_t)blockCount * SECTOR, (off_t)addr * SECTOR);
+	return (n == (ssize_t)(blockCount * SECTOR)) ? 0U : 1U;
+}
+
+uint32_t NVM_Crc32(const void *data, uint32_t size)
+{
+	const uint8_t *p = (const uint8_t *)data;
+	uint32_t crc = 0xFFFFFFFFU;
+	for (uint32_t i = 0; i < size; ++i) {
+		crc ^= p[i];
+		for (uint8_t k = 0; k < 8U; ++k) {
+			crc = (crc >> 1) ^ (0xEDB88320U & (0U - (crc & 1U)));
+		}
+	}
+	return ~crc;
+}
+
+uint32_t board_time_ms(void)
+{
+	return s_now_ms;
+}
+
+void simple_delay_ms(unsigned int ms)
+{
+	s_now_ms += ms;
+}
+
+// ========================
+// 镜像：建立与解析（布局同 tools/sdlog_extract.py）
+// ========================
+
+static void put_le32(uint8_t *p, uint32_t v)
+{
+	p[0] = (uint8_t)v;
+	p[1] = (uint8_t)(v >> 8);
+	p[2] = (uint8_t)(v >> 16);
+	p[3] = (uint8_t)(v >> 24);
+}
+
+static uint32_t get_le32(const uint8_t *p)
+{
+	return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint16_t get_le16(const uint8_t *p)
+{
+	return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+// 全零镜像 + MBR：一个记录分区，数据区 data_sectors 扇区（分区首扇区为超级块）
+static void disk_create(uint32_t data_sectors)
+{
+	if (s_disk_fd >= 0) {
+		close(s_disk_fd);
+	}
+	FILE *f = tmpfile();
+	s_disk_fd = dup(fileno(f));
+	fclose(f);
+	uint32_t part_sectors = 1U + data_sectors;
+	if (ftruncate(s_disk_fd, (off_t)(PART_LBA + part_sectors) * SECTOR) != 0) {
+		abort();
+	}
+	uint8_t mbr[SECTOR] = { 0 };
+	mbr[446 + 4] = SD_LOG_PART_TYPE;
+	put_le32(&mbr[446 + 8], PART_LBA);
+	put_le32(&mbr[446 + 12], part_sectors);
+	mbr[510] = 0x55U;
+	mbr[511] = 0xAAU;
+	(void)pwrite(s_disk_fd, mbr, SECTOR, 0);
+}
+
+typedef struct {
+	uint16_t runs;
+	uint32_t next;
+	uint32_t data_sectors;
+	bool valid;
+} super_t;
+
+typedef struct {
+	uint16_t run;
+	bool closed;
+	uint32_t start;
+	uint32_t sectors;
+} run_t;
+
+static super_t read_super(void)
+{
+	uint8_t sb[SECTOR];
+	super_t s = { 0 };
+	(void)SD_DRV_ReadDisk(0, sb, PART_LBA, 1U);
+	s.valid = get_le32(&sb[0]) == 0x534C4453UL && get_le32(&sb[4]) == NVM_Crc32(&sb[8], SECTOR - 8U);
+	s.runs = get_le16(&sb[10]);
+	s.next = get_le32(&sb[12]);
+	s.data_sectors = get_le32(&sb[16]);
+	return s;
+}
+
+static run_t read_run(uint16_t run)
+{
+	uint8_t sb[SECTOR];
+	(void)SD_DRV_ReadDisk(0, sb, PART_LBA, 1U);
+	const uint8_t *e = &sb[32 + (run % 30U) * 16U];
+	run_t r = { get_le16(&e[0]), (get_le16(&e[2]) & 1U) != 0U, get_le32(&e[4]), get_le32(&e[8]) };
+	return r;
+}
+
+// 读数据区扇区：扇区头有效且属于 run/seq 时返回记录数，否则返回 -1；t_ms 取各记录的时间戳
+static int read_sector(uint32_t data_sectors, uint32_t offset, uint16_t run, uint32_t seq, uint32_t *t_ms)
+{
+	uint8_t sec[SECTOR];
+	(void)SD_DRV_ReadDisk(0, sec, PART_LBA + 1U + offset % data_sectors, 1U);
+	if (get_le32(&sec[0]) != 0x314C4453UL || get_le32(&sec[4]) != NVM_Crc32(&sec[8], SECTOR - 8U) ||
+	    get_le16(&sec[8]) != run || get_le32(&sec[12]) != seq) {
+		return -1;
+	}
+	uint16_t n = get_le16(&sec[10]);
+	for (uint16_t i = 0; i < n && i < SD_LOG_RECS_PER_SECTOR; ++i) {
+		t_ms[i] = get_le32(&sec[16U + i * sizeof(flight_rec_t)]);
+	}
+	return n;
+}
+
+// 运行的全部记录按时间戳与期望序列 expect[0..count) 比较
+static bool run_records_match(const super_t *sb, const run_t *r, const uint32_t *expect, uint32_t count)
+{
+	uint32_t k = 0;
+	for (uint32_t seq = 0; seq < r->sectors; ++seq) {
+		uint32_t t[SD_LOG_RECS_PER_SECTOR];
+		int n = read_sector(sb->data_sectors, r->start + seq, r->run, seq, t);
+		if (n < 0) {
+			return false;
+		}
+		for (int i = 0; i < n; ++i, ++k) {
+			if (k >= count || t[i] != expect[k]) {
+				return false;
+			}
+		}
+	}
+	return k == count;
+}
+
+// ========================
+// 上电（子进程）
+// ========================
+
+static void boot_exit(void)
+{
+	int r[2] = { s_test_checks, s_test_failures };
+	fflush(NULL);
+	(void)write(s_result_fd, r, sizeof(r));
+	_exit(0);
+}
+
+static void boot(void (*fn)(void))
+{
+	int fds[2];
+	if (pipe(fds) != 0) {
+		abort();
+	}
+	fflush(NULL);
+	pid_t pid = fork();
+	if (pid == 0) {
+		close(fds[0]);
+		s_result_fd = fds[1];
+		s_test_checks = 0;
+		s_test_failures = 0;
+		fn();
+		boot_exit();
+	}
+	close(fds[1]);
+	int r[2] = { 0, 0 };
+	ssize_t n = read(fds[0], r, sizeof(r));
+	close(fds[0]);
+	int status = 0;
+	(void)waitpid(pid, &status, 0);
+	CHECK(n == (ssize_t)sizeof(r) && WIFEXITED(status) && WEXITSTATUS(status) == 0);
+	s_test_checks += r[0];
+	s_test_failures += r[1];
+}
+
+// 追加 n 条记录（t_ms 为全局递增编号）；service=true 时每条之后让写入方写出
+static uint32_t s_next_t = 0;
+
+static void append_n(uint32_t n, bool service)
+{
+	for (uint32_t i = 0; i < n; ++i) {
+		flight_rec_t rec;
+		memset(&rec, 0, sizeof(rec));
+		rec.t_ms = s_next_t++;
+		rec.seq = (uint16_t)rec.t_ms;
+		SdLog_Append(&rec);
+		if (service) {
+			(void)SdLog_Service(SD_LOG_BUF_SECTORS);
+		}
+	}
+}
+
+static void fill_seq(uint32_t *out, uint32_t first, uint32_t n)
+{
+	for (uint32_t i = 0; i < n; ++i) {
+		out[i] = first + i;
+	}
+}
+
+// ========================
+// 双缓冲交替
+// ========================
+
+static void ping_pong_boot(void)
+{
+	CHECK(SdLog_Init());
+	SdLog_StartRun();
+	s_next_t = 0;
+	// 写入方未运行：两个缓冲写满后的记录丢弃
+	append_n(2U * BUF_RECS + 5U, false);
+	CHECK(s_data_writes == 0U);
+	// 写入方写出缓冲 0（一次多块写），生产方随即继续填充缓冲 0
+	CHECK(SdLog_Service(SD_LOG_BUF_SECTORS));
+	CHECK(s_data_writes == 1U && s_last_write_count == SD_LOG_BUF_SECTORS);
+	CHECK(s_last_write_lba == PART_LBA + 1U);
+	append_n(BUF_RECS, false);
+	// 按填充顺序写出：缓冲 1（数据区偏移 4）再缓冲 0（偏移 8）
+	CHECK(SdLog_Service(SD_LOG_BUF_SECTORS));
+	CHECK(s_last_write_lba == PART_LBA + 1U + SD_LOG_BUF_SECTORS);
+	CHECK(SdLog_Service(SD_LOG_BUF_SECTORS));
+	CHECK(s_last_write_lba == PART_LBA + 1U + 2U * SD_LOG_BUF_SECTORS);
+	CHECK(s_data_writes == 3U);
+	SdLog_StopRun();
+	CHECK(SdLog_Flush(100U));
+}
+
+static void test_ping_pong(void)
+{
+	disk_create(64U);
+	boot(ping_pong_boot);
+	super_t sb = read_super();
+	run_t r = read_run(1U);
+	CHECK(sb.valid && sb.runs == 1U && sb.next == 3U * SD_LOG_BUF_SECTORS);
+	CHECK(r.run == 1U && r.closed && r.start == 0U && r.sectors == 3U * SD_LOG_BUF_SECTORS);
+	// 前两个缓冲之后的 5 条丢弃
+	static uint32_t expect[3U * BUF_RECS];
+	fill_seq(expect, 0U, 2U * BUF_RECS);
+	fill_seq(&expect[2U * BUF_RECS], 2U * BUF_RECS + 5U, BUF_RECS);
+	CHECK(run_records_match(&sb, &r, expect, 3U * BUF_RECS));
+}
+
+// ========================
+// 数据区回绕：20 扇区数据区，每次运行 3 个整缓冲 + 7 条（13 扇区）
+// ========================
+
+#define WRAP_DATA_SECTORS  20U
+#define WRAP_RUN_RECS      (3U * BUF_RECS + 7U)
+
+static void wrap_boot(void)
+{
+	CHECK(SdLog_Init());
+	for (int run = 0; run < 2; ++run) {
+		SdLog_StartRun();
+		s_next_t = (uint32_t)run * 1000U;
+		append_n(WRAP_RUN_RECS, true);
+		SdLog_StopRun();
+		CHECK(SdLog_Flush(100U));
+	}
+}
+
+static void wrap_next_boot(void)
+{
+	CHECK(SdLog_Init());
+	SdLog_StartRun();
+	s_next_t = 2000U;
+	append_n(10U, true);
+	SdLog_StopRun();
+	CHECK(SdLog_Flush(100U));
+}
+
+static void test_wrap(void)
+{
+	static uint32_t expect[WRAP_RUN_RECS];
+	disk_create(WRAP_DATA_SECTORS);
+	boot(wrap_boot);
+	super_t sb = read_super();
+	run_t r1 = read_run(1U);
+	run_t r2 = read_run(2U);
+	CHECK(sb.valid && sb.runs == 2U && sb.data_sectors == WRAP_DATA_SECTORS);
+	CHECK(r1.closed && r1.start == 0U && r1.sectors == 13U);
+	// 第二次运行从对齐后的偏移 16 开始，跨过数据区末尾回到 0
+	CHECK(r2.closed && r2.start == 16U && r2.sectors == 13U);
+	CHECK(sb.next == 12U);
+	fill_seq(expect, 1000U, WRAP_RUN_RECS);
+	CHECK(run_records_match(&sb, &r2, expect, WRAP_RUN_RECS));
+	// 第一次运行被覆盖的部分不再属于它，未覆盖的扇区（偏移 12）仍完整
+	uint32_t t[SD_LOG_RECS_PER_SECTOR];
+	CHECK(read_sector(sb.data_sectors, 0U, 1U, 0U, t) < 0);
+	CHECK(read_sector(sb.data_sectors, 12U, 1U, 12U, t) == 7);
+	CHECK(t[0] == 12U * SD_LOG_RECS_PER_SECTOR);
+
+	// 重新上电：写指针与运行号从超级块接续
+	boot(wrap_next_boot);
+	sb = read_super();
+	run_t r3 = read_run(3U);
+	CHECK(sb.runs == 3U && r3.closed && r3.start == 12U && r3.sectors == 1U);
+	fill_seq(expect, 2000U, 10U);
+	CHECK(run_records_match(&sb, &r3, expect, 10U));
+}
+
+// ========================
+// 运行中掉电：超过一个检查点后，某次多块写只写出前 2 个扇区时掉电
+// ========================
+
+#define CUT_FULL_SECTORS  (SD_LOG_CHECKPOINT_SECTORS + 3U * SD_LOG_BUF_SECTORS)
+
+static void cut_boot(void)
+{
+	CHECK(SdLog_Init());
+	SdLog_StartRun();
+	s_next_t = 0;
+	append_n(CUT_FULL_SECTORS * SD_LOG_RECS_PER_SECTOR, true);
+	s_cut_sectors = 2;
+	append_n(BUF_RECS, true);
+	CHECK(false);   // 不应到达：写入中已掉电
+}
+
+static void recover_boot(void)
+{
+	CHECK(SdLog_Init());
+	SdLog_StartRun();
+	s_next_t = 50000U;
+	append_n(20U, true);
+	SdLog_StopRun();
+	CHECK(SdLog_Flush(100U));
+}
+
+static void test_power_cut(void)
+{
+	static uint32_t expect[(CUT_FULL_SECTORS + 2U) * SD_LOG_RECS_PER_SECTOR];
+	disk_create(256U);
+	boot(cut_boot);
+	// 掉电时超级块只有检查点
+	super_t sb = read_super();
+	run_t r = read_run(1U);
+	CHECK(sb.valid && !r.closed && r.sectors == SD_LOG_CHECKPOINT_SECTORS);
+
+	boot(recover_boot);
+	sb = read_super();
+	r = read_run(1U);
+	uint32_t recovered = CUT_FULL_SECTORS + 2U;
+	CHECK(r.closed && r.start == 0U && r.sectors == recovered);
+	fill_seq(expect, 0U, recovered * SD_LOG_RECS_PER_SECTOR);
+	CHECK(run_records_match(&sb, &r, expect, recovered * SD_LOG_RECS_PER_SECTOR));
+	// 下一次运行从恢复扇区之后的缓冲边界开始，不覆盖恢复的记录
+	run_t r2 = read_run(2U);
+	uint32_t aligned = (recovered + SD_LOG_BUF_SECTORS - 1U) / SD_LOG_BUF_SECTORS * SD_LOG_BUF_SECTORS;
+	CHECK(sb.runs == 2U && r2.closed && r2.start == aligned && r2.sectors == 2U);
+	fill_seq(expect, 50000U, 20U);
+	CHECK(run_records_match(&sb, &r2, expect, 20U));
+}
+
+int main(void)
+{
+	test_ping_pong();
+	test_wrap();
+	test_power_cut();
+	return test_done("sd_log");
+}
@@ -0,0 +1,30 @@
+/**
+ * @file test_util.h
+ * @author 林木@江南大学
+ * @brief 主机端测试的检查宏与结果汇总（每个测试一个可执行文件，失败时返回非 0）
+ */
+
+#ifndef TEST_UTIL_H
+#define TEST_UTIL_H
+
+#include <stdio.h>
+
+static int s_test_checks = 0;
+static int s_test_failures = 0;
+
+#define CHECK(cond) do { \
+        s_test_checks++; \
+        if (!(cond)) { \
+            s_test_failures++; \
+            fprintf(stderr, "%s:%d: 失败: %s\n", __FILE__, __LINE__, #cond); \
+        } \
+    } while (0)
+
+// main 结尾：打印汇总并返回退出码
+static inline int test_done(const char *name)
+{
+	printf("[%s] %d 项检查，失败 %d\n", name, s_test_checks, s_test_failures);
+	return (s_test_failures == 0) ? 0 : 1;
+}
+
+#endif
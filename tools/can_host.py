@@ -0,0 +1,293 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+CAN 上位机工具（FlexCAN0，500 kbit/s 标准帧，帧格式见 board/can_bus.h）
+
+需要 python-can（pip install python-can），默认 SocketCAN 接口 can0
+（ip link set can0 up type can bitrate 500000）。
+listen 接收 POSE/MOTION/STATUS 帧，每秒打印一行；-o 写 CSV
+（每个 STATUS 帧一行，带最近的位姿与运动量）。
+drive 以固定频率发送航向/速度指令（小车须在 remote 步骤中），退出时发送 RELEASE 结束该步骤。
+参数按索引访问：list 逐个读出名称与当前值，get/set 可给名称（先经 list 查索引）或索引。
+
+用法：
+    can_host.py listen                               每秒打印一行
+    can_host.py listen -o run.csv --seconds 30
+    can_host.py drive 90 300                         航向 90°、300 mm/s，Ctrl-C 停止并 RELEASE
+    can_host.py drive 0 200 --seconds 5 --hold       5 s 后停车但不结束 remote 步骤
+    can_host.py release
+    can_host.py list
+    can_host.py get straight_kp
+    can_host.py set 3 0.35
+    can_host.py --channel can1 --node 1 ...          多车同一总线时按节点号偏移 ID
+"""
+
+import argparse
+import struct
+import sys
+import time
+
+try:
+    import can
+except ImportError:
+    can = None
+
+ID_DRIVE = 0x120
+ID_PARAM = 0x121
+ID_POSE = 0x180
+ID_MOTION = 0x181
+ID_STATUS = 0x182
+ID_PARAM_ACK = 0x1A1
+
+DRIVE_RELEASE = 0
+DRIVE_GO = 1
+OP_GET, OP_SET, OP_NAME = range(3)
+NAME_CHUNK = 4
+NAME_MAX = 20
+
+RESULTS = {0: 'OK', 1: '索引越界', 2: '超出范围', 3: '请求无效'}
+STATUS = ['IDLE', 'RUNNING', 'DONE', 'ABORTED', 'FAILED']
+FLAGS = [(0x01, 'OBSTACLE'), (0x02, 'REMOTE'), (0x04, 'DRIVE_VALID')]
+
+DRIVE = struct.Struct('<hhHBB')
+PARAM = struct.Struct('<BBBxf')
+PARAM_ACK = struct.Struct('<BBBB4s')
+POSE = struct.Struct('<ii')
+MOTION = struct.Struct('<hhhH')
+STATUS_FRAME = struct.Struct('<IBBBB')
+
+COLUMNS = ['host_t', 't_ms', 'step', 'status', 'flags', 'seq', 'x_mm', 'y_mm', 'theta_deg', 'rate_dps', 'speed_mms',
+           'range_mm']
+
+CMD_TIMEOUT_S = 0.1
+CMD_RETRIES = 5
+
+
+class CanError(Exception):
+    pass
+
+
+class Link:
+    def __init__(self, channel, interface, node):
+        self.offset = node * 0x10
+        self.bus = can.Bus(channel=channel, interface=interface)
+        filters = [{'can_id': base + self.offset, 'can_mask': 0x7FF, 'extended': False}
+                   for base in (ID_POSE, ID_MOTION, ID_STATUS, ID_PARAM_ACK)]
+        self.bus.set_filters(filters)
+
+    def send(self, base, data):
+        self.bus.send(can.Message(arbitration_id=base + self.offset, data=data, is_extended_id=False))
+
+    def recv(self, timeout):
+        """返回 (基准 ID, 数据)；超时返回 None"""
+        msg = self.bus.recv(timeout)
+        if msg is None or msg.is_extended_id or msg.is_remote_frame or msg.dlc != 8:
+            return None
+        return msg.arbitration_id - self.offset, bytes(msg.data)
+
+    def close(self):
+        self.bus.shutdown()
+
+
+def param_request(link, op, index, chunk=0, value=0.0):
+    """发送参数请求并等待对应应答，返回 (结果, 4 字节负载)"""
+    req = PARAM.pack(op, index, chunk, value)
+    for _ in range(CMD_RETRIES):
+        link.send(ID_PARAM, req)
+        deadline = time.monotonic() + CMD_TIMEOUT_S
+        while True:
+            left = deadline - time.monotonic()
+            if left <= 0:
+                break
+            r = link.recv(left)
+            if r is None or r[0] != ID_PARAM_ACK:
+                continue
+            a_op, a_index, result, a_chunk, payload = PARAM_ACK.unpack(r[1])
+            if (a_op, a_index, a_chunk) == (op, index, chunk):
+                return result, payload
+    raise CanError('参数请求（op=%d index=%d）无应答' % (op, index))
+
+
+def param_name(link, index):
+    """逐段读取参数名；索引越界返回 None"""
+    name = b''
+    for chunk in range((NAME_MAX + NAME_CHUNK - 1) // NAME_CHUNK):
+        result, payload = param_request(link, OP_NAME, index, chunk)
+        if result != 0:
+            return None
+        name += payload.split(b'\0', 1)[0]
+        if b'\0' in payload:
+            break
+    return name.decode(errors='replace')
+
+
+def param_value(result, payload):
+    return struct.unpack('<f', payload)[0] if result in (0, 2) else None
+
+
+def list_params(link, verbose=True):
+    names = []
+    for index in range(256):
+        name = param_name(link, index)
+        if name is None:
+            break
+        names.append(name)
+        if verbose:
+            result, payload = param_request(link, OP_GET, index)
+            print('%3d %-20s %.5f' % (index, name, param_value(result, payload)))
+    return names
+
+
+def resolve(link, key):
+    if key.isdigit():
+        return int(key), key
+    names = list_params(link, verbose=False)
+    if key not in names:
+        raise CanError('未知参数 %s' % key)
+    return names.index(key), key
+
+
+def print_param(label, result, payload):
+    value = param_value(result, payload)
+    if result != 0:
+        print('%s: %s' % (label, RESULTS.get(result, 'ERR %d' % result)), file=sys.stderr)
+        if value is not None:
+            print('%s = %.5f' % (label, value), file=sys.stderr)
+        return 1
+    print('%s = %.5f' % (label, value))
+    return 0
+
+
+def flag_names(flags):
+    names = [n for m, n in FLAGS if flags & m]
+    return '|'.join(names) if names else '-'
+
+
+def listen(link, out_path, seconds):
+    out = open(out_path, 'w') if out_path else None
+    if out:
+        out.write(','.join(COLUMNS) + '\n')
+    start = time.monotonic()
+    next_print = start + 1.0
+    counts = {ID_POSE: 0, ID_MOTION: 0, ID_STATUS: 0}
+    pose = motion = status = None
+    try:
+        while seconds is None or time.monotonic() - start < seconds:
+            now = time.monotonic()
+            if now >= next_print:
+                if status is not None and pose is not None and motion is not None:
+                    st = STATUS[status[2]] if status[2] < len(STATUS) else str(status[2])
+                    print('%d/%d/%d 帧/s | t=%dms step=%d %-7s x=%.0fmm y=%.0fmm θ=%.2f° v=%dmm/s range=%s %s'
+                          % (counts[ID_POSE], counts[ID_MOTION], counts[ID_STATUS], status[0], status[1], st,
+                             pose[0], pose[1], motion[0] / 100.0, motion[2],
+                             '-' if motion[3] == 0xFFFF else '%dmm' % motion[3], flag_names(status[3])))
+                else:
+                    print('等待遥测帧')
+                counts = dict.fromkeys(counts, 0)
+                next_print = now + 1.0
+            r = link.recv(max(0.01, next_print - time.monotonic()))
+            if r is None or r[0] not in counts:
+                continue
+            base, data = r
+            counts[base] += 1
+            if base == ID_POSE:
+                pose = POSE.unpack(data)
+            elif base == ID_MOTION:
+                motion = MOTION.unpack(data)
+            else:
+                status = STATUS_FRAME.unpack(data)
+                if out and pose is not None and motion is not None:
+                    out.write('%.3f,%d,%d,%d,%d,%d,%d,%d,%.2f,%.1f,%d,%s\n'
+                              % (time.monotonic() - start, status[0], status[1], status[2], status[3], status[4],
+                                 pose[0], pose[1], motion[0] / 100.0, motion[1] / 10.0, motion[2],
+                                 '' if motion[3] == 0xFFFF else motion[3]))
+    except KeyboardInterrupt:
+        pass
+    finally:
+        if out:
+            out.close()
+    return 0
+
+
+def drive_frame(heading, speed, ttl, mode, seq):
+    h = (heading + 180.0) % 360.0 - 180.0
+    return DRIVE.pack(int(round(h * 100)), max(-32767, min(32767, int(round(speed)))), ttl, mode, seq & 0xFF)
+
+
+def drive(link, heading, speed, rate, ttl, seconds, hold):
+    period = 1.0 / rate
+    start = time.monotonic()
+    seq = 0
+    try:
+        while seconds is None or time.monotonic() - start < seconds:
+            link.send(ID_DRIVE, drive_frame(heading, speed, ttl, DRIVE_GO, seq))
+            seq += 1
+            time.sleep(max(0.0, start + seq * period - time.monotonic()))
+    except KeyboardInterrupt:
+        pass
+    # 停车（速度 0）或结束 remote 步骤
+    link.send(ID_DRIVE, drive_frame(heading, 0.0, ttl, DRIVE_GO if hold else DRIVE_RELEASE, seq))
+    print('已发送 %d 帧，%s' % (seq, '停车' if hold else 'RELEASE'))
+    return 0
+
+
+def main():
+    ap = argparse.ArgumentParser(description='CAN 上位机工具（FlexCAN0 命令与遥测）')
+    ap.add_argument('--channel', default='can0', help='CAN 接口（默认 can0）')
+    ap.add_argument('--interface', default='socketcan', help='python-can 接口类型（默认 socketcan）')
+    ap.add_argument('--node', type=int, default=0, help='节点号（ID 偏移 node×0x10，默认 0）')
+    sub = ap.add_subparsers(dest='cmd', required=True)
+    p = sub.add_parser('listen', help='接收遥测')
+    p.add_argument('-o', '--output', help='写 CSV')
+    p.add_argument('--seconds', type=float, help='接收时长（默认直到 Ctrl-C）')
+    p = sub.add_parser('drive', help='发送航向/速度指令')
+    p.add_argument('heading', type=float, help='绝对航向（°）')
+    p.add_argument('speed', type=float, help='速度（mm/s）')
+    p.add_argument('--rate', type=float, default=20.0, help='发送频率 Hz（默认 20）')
+    p.add_argument('--ttl', type=int, default=200, help='指令有效期 ms（默认 200）')
+    p.add_argument('--seconds', type=float, help='发送时长（默认直到 Ctrl-C）')
+    p.add_argument('--hold', action='store_true', help='结束时只停车，不发送 RELEASE')
+    sub.add_parser('release', help='结束 remote 步骤')
+    sub.add_parser('list', help='列出参数')
+    p = sub.add_parser('get', help='读参数')
+    p.add_argument('param', help='名称或索引')
+    p = sub.add_parser('set', help='写参数')
+    p.add_argument('param', help='名称或索引')
+    p.add_argument('value', type=float)
+    args = ap.parse_args()
+
+    if can is None:
+        print('错误: 需要 python-can（pip install python-can）', file=sys.stderr)
+        return 1
+    if args.cmd == 'drive' and not (args.rate > 0 and 0 < args.ttl <= 0xFFFF):
+        print('错误: --rate 应大于 0，--ttl 应为 1~65535', file=sys.stderr)
+        return 1
+    try:
+        link = Link(args.channel, args.interface, args.node)
+    except (OSError, can.CanError) as e:
+        print('错误: %s' % e, file=sys.stderr)
+        return 1
+    try:
+        if args.cmd == 'listen':
+            return listen(link, args.output, args.seconds)
+        if args.cmd == 'drive':
+            return drive(link, args.heading, args.speed, args.rate, args.ttl, args.seconds, args.hold)
+        if args.cmd == 'release':
+            link.send(ID_DRIVE, drive_frame(0.0, 0.0, 0, DRIVE_RELEASE, 0))
+            return 0
+        if args.cmd == 'list':
+            list_params(link)
+            return 0
+        index, label = resolve(link, args.param)
+        if args.cmd == 'get':
+            return print_param(label, *param_request(link, OP_GET, index))
+        return print_param(label, *param_request(link, OP_SET, index, value=args.value))
+    except (OSError, can.CanError, CanError) as e:
+        print('错误: %s' % e, file=sys.stderr)
+        return 1
+    finally:
+        link.close()
+
+
+if __name__ == '__main__':
+    sys.exit(main())
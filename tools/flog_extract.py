@@ -0,0 +1,218 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+外部 Flash 运行记录提取：把 flog dump 的串口输出或整片 Flash 镜像按运行解码为 CSV
+（存储格式见 board/flash_log.h），列与 frec dump 相同。
+
+输入：
+    串口文本    含 "[flog] begin run=N ..." / "[flog] p <地址> <十六进制页>" / "[flog] end" 的日志
+    --image    整片 Flash 读出的二进制镜像（编程器读出），经索引区定位各运行
+
+用法：
+    flog_extract.py log.txt                       每个运行写 run_<N>.csv
+    flog_extract.py --image flash.bin --list      列出镜像中的运行
+    flog_extract.py --image flash.bin --run 3 -o run3.csv
+"""
+
+import argparse
+import re
+import struct
+import sys
+import zlib
+
+INDEX_ADDR = 0x000000
+INDEX_SIZE = 0x010000
+DATA_ADDR = 0x010000
+PAGE = 0x100
+HDR = struct.Struct('<IIHHIHH')
+RUN = struct.Struct('<IHHIIIIII')
+PAGE_MAGIC = 0x31474C46
+RUN_MAGIC = 0x4E555246
+DONE_MAGIC = 0x454E4F44
+
+COLUMNS = ['t_ms', 'seq', 'step', 'flags', 'yaw_cdeg', 'rate_ddps', 'err_ddps', 'p_e4', 'i_e4', 'ff_e4',
+           'd1_e4', 'd2_e4', 'd3_e4', 'd4_e4', 'dist_dmm']
+SECOND_ORDER = (0, 1, 14)   # 时间、序号、里程取二阶差分
+WIDTH = [32, 16, 8, 8] + [16] * 10 + [32]
+SIGNED = [False, False, False, False] + [True] * 10 + [True]
+
+
+class ExtractError(Exception):
+    pass
+
+
+def wrap(value, k):
+    """按固件字段宽度回绕（编码器以 32 位整数做差分）"""
+    bits = WIDTH[k]
+    value &= (1 << bits) - 1
+    if SIGNED[k] and value >= 1 << (bits - 1):
+        value -= 1 << bits
+    return value
+
+
+def decode_page(page, run=None, seq=None):
+    """校验页头与 CRC，返回 (页头字典, 记录列表)"""
+    if len(page) < HDR.size:
+        raise ExtractError('页过短')
+    magic, crc, prun, n_rec, pseq, length, _ = HDR.unpack_from(page)
+    if magic != PAGE_MAGIC:
+        raise ExtractError('页魔数错误')
+    if length > PAGE - HDR.size or len(page) < HDR.size + length:
+        raise ExtractError('页长度错误')
+    if zlib.crc32(page[8:HDR.size + length]) != crc:
+        raise ExtractError('页 CRC 错误（run=%d seq=%d）' % (prun, pseq))
+    if run is not None and prun != run:
+        raise ExtractError('页属于运行 %d' % prun)
+    if seq is not None and pseq != seq:
+        raise ExtractError('页序号 %d（应为 %d）' % (pseq, seq))
+
+    payload = page[HDR.size:HDR.size + length]
+    prev = [0] * len(COLUMNS)
+    prev_d = [0] * len(COLUMNS)
+    records = []
+    pos = 0
+    while pos < len(payload):
+        if pos + 2 > len(payload):
+            raise ExtractError('记录截断')
+        mask = payload[pos] | (payload[pos + 1] << 8)
+        pos += 2
+        row = []
+        for k in range(len(COLUMNS)):
+            res = 0
+            if mask & (1 << k):
+                z = 0
+                shift = 0
+                while True:
+                    if pos >= len(payload):
+                        raise ExtractError('变长整数截断')
+                    b = payload[pos]
+                    pos += 1
+                    z |= (b & 0x7F) << shift
+                    shift += 7
+                    if not b & 0x80:
+                        break
+                res = (z >> 1) ^ -(z & 1)
+            d = res + prev_d[k] if k in SECOND_ORDER else res
+            d = ((d + (1 << 31)) & 0xFFFFFFFF) - (1 << 31)
+            prev_d[k] = d
+            prev[k] = ((prev[k] + d + (1 << 31)) & 0xFFFFFFFF) - (1 << 31)
+            row.append(wrap(prev[k], k))
+        records.append(row)
+    if len(records) != n_rec:
+        raise ExtractError('记录数 %d（页头 %d）' % (len(records), n_rec))
+    return {'run': prun, 'seq': pseq, 'n_rec': n_rec}, records
+
+
+def runs_from_text(lines):
+    """解析 flog dump 输出：{运行号: 记录列表}"""
+    runs = {}
+    cur = None
+    for line in lines:
+        m = re.search(r'\[flog\] begin run=(\d+)', line)
+        if m:
+            cur = int(m.group(1))
+            runs[cur] = []
+            seq = 0
+            continue
+        m = re.search(r'\[flog\] p ([0-9A-Fa-f]+) ([0-9A-Fa-f]+)', line)
+        if m and cur is not None:
+            try:
+                _, recs = decode_page(bytes.fromhex(m.group(2)), cur, seq)
+            except (ExtractError, ValueError) as e:
+                print('run %d 页 %s: %s，跳过' % (cur, m.group(1), e), file=sys.stderr)
+            else:
+                runs[cur].extend(recs)
+            seq += 1
+            continue
+        if '[flog] end' in line:
+            cur = None
+    return runs
+
+
+def index_from_image(image):
+    """读取镜像索引区：运行字典列表"""
+    entries = []
+    for addr in range(INDEX_ADDR, INDEX_ADDR + INDEX_SIZE, RUN.size):
+        magic, run, _, start, t0, end, pages, records, done = RUN.unpack_from(image, addr)
+        if magic != RUN_MAGIC:
+            break
+        entries.append({'run': run, 'start': start, 't0': t0, 'end': end, 'pages': pages,
+                        'records': records, 'closed': done == DONE_MAGIC})
+    return entries
+
+
+def run_from_image(image, entry):
+    """沿数据区读取一个运行；未收尾的运行按页头序号读到第一处不连续为止"""
+    records = []
+    addr = entry['start']
+    limit = entry['pages'] if entry['closed'] else (len(image) - DATA_ADDR) // PAGE
+    for seq in range(limit):
+        try:
+            _, recs = decode_page(image[addr:addr + PAGE], entry['run'], seq)
+        except ExtractError as e:
+            if entry['closed']:
+                print('run %d 第 %d 页: %s（可能已被覆盖）' % (entry['run'], seq, e), file=sys.stderr)
+            break
+        records.extend(recs)
+        addr += PAGE
+        if addr >= len(image):
+            addr = DATA_ADDR
+    return records
+
+
+def write_csv(path, records):
+    with open(path, 'w') as f:
+        f.write(','.join(COLUMNS) + '\n')
+        for row in records:
+            f.write(','.join(str(v) for v in row) + '\n')
+
+
+def main():
+    ap = argparse.ArgumentParser(description='外部 Flash 运行记录提取')
+    ap.add_argument('input', help='串口日志文本，或 --image 时为 Flash 镜像')
+    ap.add_argument('--image', action='store_true', help='输入为整片 Flash 二进制镜像')
+    ap.add_argument('--list', action='store_true', help='只列出运行')
+    ap.add_argument('--run', type=int, help='只提取指定运行')
+    ap.add_argument('-o', '--output', help='输出文件（配合 --run；默认 run_<N>.csv）')
+    args = ap.parse_args()
+
+    try:
+        if args.image:
+            with open(args.input, 'rb') as f:
+                image = f.read()
+            if len(image) < DATA_ADDR + PAGE:
+                raise ExtractError('镜像过短')
+            entries = index_from_image(image)
+            if args.list:
+                for e in entries:
+                    print('run=%d start=0x%06X t0=%dms pages=%d records=%d%s' % (
+                        e['run'], e['start'], e['t0'], e['pages'] if e['closed'] else 0,
+                        e['records'] if e['closed'] else 0, '' if e['closed'] else ' 未结束'))
+                return 0
+            runs = {e['run']: run_from_image(image, e) for e in entries
+                    if args.run is None or e['run'] == args.run}
+        else:
+            with open(args.input, 'r', errors='replace') as f:
+                runs = runs_from_text(f)
+            if args.list:
+                for run, recs in sorted(runs.items()):
+                    print('run=%d records=%d' % (run, len(recs)))
+                return 0
+            if args.run is not None:
+                runs = {k: v for k, v in runs.items() if k == args.run}
+    except (OSError, ExtractError) as e:
+        print('错误: %s' % e, file=sys.stderr)
+        return 1
+
+    if not runs:
+        print('错误: 未找到运行记录', file=sys.stderr)
+        return 1
+    for run, recs in sorted(runs.items()):
+        path = args.output if (args.output and args.run is not None) else 'run_%d.csv' % run
+        write_csv(path, recs)
+        print('run %d: %d 条 -> %s' % (run, len(recs), path))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,88 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+格式化输出代码体积对比：同一工程分别以 APP_PRINTF_LITE=1（board/fmt_lite.c）与 APP_PRINTF_LITE=0（newlib printf）
+构建，比较两个 ELF 的段大小与符号差异。每行周期数由目标端 shell `fmt bench` 给出（在 newlib 构建上运行时
+同时比较两者输出是否逐字节相同）。
+
+段大小用 size（SIZE 环境变量，默认 riscv64-unknown-elf-size），符号用 nm -S（NM 环境变量，
+默认 riscv64-unknown-elf-nm）。格式化相关符号（fmt_*、newlib 的 *printf*、_dtoa_r 与 Bigint 运算等）单独汇总，
+其余按大小差值列出前 N 个。
+
+用法：
+    fmt_size.py build_lite/app.elf build_newlib/app.elf
+    fmt_size.py lite.elf newlib.elf --top 30
+"""
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+
+# 格式化路径上的符号：本模块与 newlib vfprintf/浮点转换（含 mprec.c 的大数运算与 localeconv）
+FORMAT_RE = re.compile(r'^(fmt_\w+|_?v?[fsd]?n?i?printf(_r)?|_?v?[fsd]?n?i?printf_r|_s?vf?i?printf_r|__s?sprint_r|'
+                       r'__sfputs_r|__sfputc_r|_printf_(float|i|common)|_?puts(_r)?|_?putchar(_r)?|_dtoa_r|__d2b|'
+                       r'_Balloc|_Bfree|__multadd|__mdiff|__lshift|__pow5mult|__mcmp|__i2b|__multiply|__hi0bits|'
+                       r'__lo0bits|__b2d|__ratio|__ulp|__s2b|__mprec_\w+|_mprec_log10|_localeconv_r|__localeconv_l|'
+                       r'__ssputs_r|__ssprint_r|__swbuf_r|__swsetup_r|__sprint_r|cvt|exponent)$')
+
+
+def section_sizes(elf):
+    size = os.environ.get('SIZE', 'riscv64-unknown-elf-size')
+    out = subprocess.run([size, elf], check=True, capture_output=True, text=True).stdout
+    fields = out.splitlines()[1].split()
+    return int(fields[0]), int(fields[1]), int(fields[2])
+
+
+def symbol_sizes(elf):
+    nm = os.environ.get('NM', 'riscv64-unknown-elf-nm')
+    out = subprocess.run([nm, '-S', elf], check=True, capture_output=True, text=True).stdout
+    sizes = {}
+    for line in out.splitlines():
+        parts = line.split()
+        if len(parts) == 4 and parts[2] in 'tTwWrRdDbB':
+            sizes[parts[3]] = sizes.get(parts[3], 0) + int(parts[1], 16)
+    return sizes
+
+
+def main():
+    ap = argparse.ArgumentParser(description='格式化输出代码体积对比（fmt_lite 与 newlib printf）')
+    ap.add_argument('lite', help='APP_PRINTF_LITE=1 构建的 ELF')
+    ap.add_argument('newlib', help='APP_PRINTF_LITE=0 构建的 ELF')
+    ap.add_argument('--top', type=int, default=15, help='列出大小差值最大的前 N 个其他符号（默认 15）')
+    args = ap.parse_args()
+
+    try:
+        secs = [section_sizes(args.lite), section_sizes(args.newlib)]
+        syms = [symbol_sizes(args.lite), symbol_sizes(args.newlib)]
+    except (OSError, subprocess.CalledProcessError, IndexError, ValueError) as e:
+        print('错误: %s' % e, file=sys.stderr)
+        return 1
+
+    print('%-8s %9s %9s %9s' % ('', 'text', 'data', 'bss'))
+    for label, (text, data, bss) in zip(('lite', 'newlib'), secs):
+        print('%-8s %9d %9d %9d' % (label, text, data, bss))
+    print('%-8s %+9d %+9d %+9d' % ('差值', *(a - b for a, b in zip(*secs))))
+
+    names = set(syms[0]) | set(syms[1])
+    fmt_names = sorted((n for n in names if FORMAT_RE.match(n)),
+                       key=lambda n: -max(syms[0].get(n, 0), syms[1].get(n, 0)))
+    totals = [sum(s.get(n, 0) for n in fmt_names) for s in syms]
+    print('\n格式化相关符号：lite %d 字节，newlib %d 字节（%+d）' % (totals[0], totals[1], totals[0] - totals[1]))
+    for n in fmt_names:
+        a, b = syms[0].get(n, 0), syms[1].get(n, 0)
+        if a or b:
+            print('  %7s %7s  %s' % (a or '-', b or '-', n))
+
+    others = [(syms[0].get(n, 0) - syms[1].get(n, 0), n) for n in names if not FORMAT_RE.match(n)]
+    others = sorted((d for d in others if d[0]), key=lambda d: -abs(d[0]))[:max(0, args.top)]
+    if others:
+        print('\n其他符号差值（前 %d）：' % len(others))
+        for delta, n in others:
+            print('  %+7d  %s' % (delta, n))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
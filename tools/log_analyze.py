@@ -0,0 +1,577 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+运行日志分析：从串口日志或记录镜像计算可对比的性能指标，输出 CSV/JSON。
+
+输入（可混合多个文件，按扩展名与内容自动识别）：
+    串口文本      printf 日志（可带串口助手的 "[HH:MM:SS.mmm]接收←" 前缀），其中的
+                  frec dump 段与 flog dump 页一并解析
+    令牌化日志    二进制串口流，配合 --elf 或 --table 先还原（同 tlog_decode.py）
+    记录 CSV      frec dump / flog_extract.py / sdlog_extract.py 输出的 CSV
+    Flash 镜像    外部 SPI Flash 整片镜像（flog_extract.py --image 格式）
+    SD 卡镜像     SD 卡记录分区或整卡镜像（sdlog_extract.py 格式）
+
+指标（按任务步骤分段；无 MissionStep 日志的旧文本按控制类型与目标航向分段）：
+    控制周期直方图  记录的设备时间戳间隔；纯文本只有串口助手时间戳，为日志输出间隔（source=host）
+    航向误差        RMS / 最大值：文本日志相对日志中的目标航向；记录相对直行段的平均航向
+    转向稳定时间    转向段进入 ±settle-tol 并不再离开的时刻（相对段开始）
+    避障等待        等待次数与总时长（文本取“本次等待时间”，记录取避障标志持续时间）
+    占空比饱和      任一电机 |占空比| ≥ --sat 的样本比例
+
+用法：
+    log_analyze.py 日志输出.md                                  终端摘要
+    log_analyze.py run_*.csv --csv seg.csv --json summary.json  分段 CSV + 完整 JSON
+    log_analyze.py --elf build/app.elf capture.bin --hist hist.csv
+    log_analyze.py card.bin flash.bin --json -                  JSON 输出到标准输出
+"""
+
+import argparse
+import json
+import math
+import os
+import re
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import flog_extract   # noqa: E402
+import sdlog_extract  # noqa: E402
+
+STEP_KIND = {0: 'path', 1: 'straight', 2: 'turn', 3: 'servo', 4: 'wait', 5: 'remote'}
+FLAG_TYPE_MASK = 0x0F
+FLAG_OBSTACLE = 0x10
+REC_HEADER = 't_ms,seq,step,flags'
+CHUNK = 1 << 16
+
+NUM = r'(-?\d+(?:\.\d+)?)'
+DUTY4 = r'°, duty%: M1=' + NUM + '% M2=' + NUM + '% M3=' + NUM + '% M4=' + NUM + '%'
+TS_RE = re.compile(r'^\[(\d\d):(\d\d):(\d\d)\.(\d{3})\]')
+# 文本日志中与指标相关的行（my_move.c / mission.c 的格式）；先用关键字整体筛选，绝大多数行不进入逐项匹配
+LINE_RES = {
+    'StraightTick:': ('straight', re.compile(r'StraightTick: yaw=' + NUM + DUTY4)),
+    'StraightUseTargetTick:': ('straight_target', re.compile(r'StraightUseTargetTick: yaw=' + NUM + DUTY4 +
+                                                             ', 目标=' + NUM)),
+    'StraightDistanceTick:': ('distance', re.compile(r'StraightDistanceTick: yaw=' + NUM + r'°.*?duty=' + NUM)),
+    'TurnTick:': ('turn', re.compile(r'TurnTick: yaw=' + NUM + r'°, target=' + NUM + r'°, err=' + NUM)),
+    'ArcTick:': ('arc', re.compile(r'ArcTick: yaw=' + NUM + r'°, rem=' + NUM)),
+    'PathTick:': ('path', re.compile(r'PathTick: seg=\d+, pos=\(' + NUM + ', ' + NUM + r'\), θ=' + NUM + r'°, xte=' +
+                                     NUM + r'mm.*?duty=' + NUM)),
+    'StraightInit:': ('ref', re.compile(r'StraightInit: yaw0=' + NUM)),
+    'StraightDistance:': ('ref', re.compile(r'StraightDistance: targetYaw=' + NUM)),
+    '本次等待时间': ('wait', re.compile(r'本次等待时间: (\d+)ms')),
+    'TurnDone:': ('turn_done', re.compile(r'TurnDone: .*?time=(\d+)ms')),
+    'TurnTimeout:': ('turn_timeout', re.compile(r'TurnTimeout:')),
+    'MissionStep:': ('step', re.compile(r'MissionStep: idx=(\d+), type=(\d+), t=(\d+)ms')),
+    'MissionStart:': ('mission', re.compile(r'MissionStart:')),
+    '[frec] begin': ('frec', None),
+}
+PREFILTER = re.compile('|'.join(re.escape(k) for k in LINE_RES))
+TICKS = ('straight', 'straight_target', 'distance', 'turn', 'arc', 'path')
+
+
+class AnalyzeError(Exception):
+    pass
+
+
+def wrap180(deg):
+    return (deg + 180.0) % 360.0 - 180.0
+
+
+class Segment:
+    """一个分段的样本与事件"""
+
+    def __init__(self, run, index, kind, key=None, t_start=None):
+        self.run = run
+        self.index = index
+        self.kind = kind
+        self.key = key         # 分段依据：记录的步骤号 / 文本的目标航向
+        self.t_start = t_start
+        self.ref = ''          # 航向误差参考：target / segment_mean
+        self.t = []
+        self.yaw = []
+        self.err = []          # 航向误差（°）
+        self.duty = []         # 每样本最大 |占空比|（0..1）
+        self.xte = []
+        self.obstacle = []
+        self.waits = []
+        self.turn_done_ms = None
+        self.timeout = False
+
+
+class Run:
+    def __init__(self, name, source):
+        self.name = name
+        self.source = source   # device：设备时间戳；host：串口助手时间戳
+        self.segments = []
+        self.periods = []
+
+    def new_segment(self, kind, key=None, t_start=None):
+        seg = Segment(self.name, len(self.segments), kind, key, t_start)
+        self.segments.append(seg)
+        return seg
+
+
+# ========================
+# 记录输入（frec / flog / sdlog）
+# ========================
+
+def run_from_records(name, rows):
+    run = Run(name, 'device')
+    seg = None
+    last_t = None
+    for r in rows:
+        t, step, flags = r[0], r[2], r[3]
+        kind = STEP_KIND.get(flags & FLAG_TYPE_MASK, 'other')
+        if seg is None or step != seg.key or kind != seg.kind:
+            seg = run.new_segment(kind, step, t)
+        if last_t is not None:
+            run.periods.append((t - last_t) & 0xFFFFFFFF)
+        last_t = t
+        seg.t.append(t)
+        seg.yaw.append(r[4] / 100.0)
+        seg.duty.append(max(abs(r[10]), abs(r[11]), abs(r[12]), abs(r[13])) / 10000.0)
+        seg.obstacle.append(bool(flags & FLAG_OBSTACLE))
+    for seg in run.segments:
+        if seg.kind == 'straight':
+            # 记录不含目标航向：直行段相对段内平均航向（圆周平均）
+            mean = math.degrees(math.atan2(sum(math.sin(math.radians(y)) for y in seg.yaw),
+                                           sum(math.cos(math.radians(y)) for y in seg.yaw)))
+            seg.err = [wrap180(y - mean) for y in seg.yaw]
+            seg.ref = 'segment_mean'
+        elif seg.kind == 'turn':
+            # 转向段以段末航向为目标
+            seg.err = [wrap180(y - seg.yaw[-1]) for y in seg.yaw]
+        seg.waits = obstacle_waits(seg)
+    return run
+
+
+def obstacle_waits(seg):
+    """避障标志连续为真的区间时长"""
+    waits = []
+    start = None
+    for t, ob in zip(seg.t, seg.obstacle):
+        if ob and start is None:
+            start = t
+        elif not ob and start is not None:
+            waits.append(t - start)
+            start = None
+    if start is not None:
+        waits.append(seg.t[-1] - start)
+    return waits
+
+
+def rows_from_csv_lines(lines):
+    rows = []
+    for line in lines:
+        parts = line.strip().split(',')
+        if len(parts) == 15 and parts[0].isdigit():
+            try:
+                rows.append([int(p) for p in parts])
+            except ValueError:
+                pass
+    return rows
+
+
+# ========================
+# 文本输入
+# ========================
+
+class TextParser:
+    """逐行解析串口文本；MissionStart 开始新运行，MissionStep 开始新分段"""
+
+    def __init__(self, name):
+        self.name = name
+        self.runs = []
+        self.run = Run(name, 'host')
+        self.seg = None
+        self.step_mode = False   # 本次运行有 MissionStep 日志
+        self.ref = None          # 直行目标航向（StraightInit / StraightDistance）
+        self.host_ms = None
+        self.chunk_ms = None     # 当前接收块的时间戳与块内的控制日志（分段, 下标）
+        self.chunk_ticks = []
+        self.frec = None
+
+    def finish_run(self):
+        if self.run.segments:
+            self.runs.append(self.run)
+
+    def line(self, raw):
+        m = TS_RE.match(raw)
+        if m:
+            h, mi, s, ms = (int(x) for x in m.groups())
+            self.stamp(((h * 60 + mi) * 60 + s) * 1000 + ms)
+            raw = raw[m.end():]
+        if self.frec is not None:
+            if '[frec] end' in raw:
+                self.runs.append(run_from_records('%s#frec%d' % (self.name, len(self.runs) + 1),
+                                                  rows_from_csv_lines(self.frec)))
+                self.frec = None
+            else:
+                self.frec.append(raw.split('←')[-1])
+            return
+        m = PREFILTER.search(raw)
+        if not m:
+            return
+        key, rx = LINE_RES[m.group(0)]
+        if rx is None:
+            self.frec = []
+            return
+        m = rx.search(raw)
+        if not m:
+            return
+        g = m.groups()
+        if key in TICKS:
+            self.tick(key, g)
+        elif key == 'ref':
+            self.ref = float(g[0])
+        elif key == 'wait':
+            self.current('straight', self.ref).waits.append(int(g[0]))
+        elif key == 'turn_done':
+            if self.seg is not None:
+                self.seg.turn_done_ms = int(g[0])
+        elif key == 'turn_timeout':
+            if self.seg is not None:
+                self.seg.timeout = True
+        elif key == 'step':
+            self.step_mode = True
+            self.ref = None
+            self.seg = self.run.new_segment(STEP_KIND.get(int(g[1]), 'other'), int(g[0]), self.host_ms)
+        else:  # mission
+            self.finish_run()
+            self.run = Run('%s#%d' % (self.name, len(self.runs) + 1), 'host')
+            self.seg = None
+            self.step_mode = False
+
+    def stamp(self, ms):
+        # 串口助手按接收块打时间戳：块间隔均摊到块内的控制日志条数，作为周期估计
+        # 块内各条的时刻按均摊间隔插值
+        if self.chunk_ms is not None and self.chunk_ticks and ms >= self.chunk_ms:
+            per = (ms - self.chunk_ms) // len(self.chunk_ticks)
+            self.run.periods.extend([per] * len(self.chunk_ticks))
+            for k, (seg, i) in enumerate(self.chunk_ticks):
+                seg.t[i] = self.chunk_ms + k * per
+        if self.chunk_ms is None or self.chunk_ticks:
+            self.chunk_ms = ms
+            self.chunk_ticks = []
+        self.host_ms = ms
+
+    def current(self, kind, key):
+        # 无 MissionStep 日志（旧固件或单项测试）时：控制类型或目标变化即新分段
+        seg = self.seg
+        if seg is None or (not self.step_mode and (seg.kind != kind or seg.key != key)):
+            seg = self.seg = self.run.new_segment(kind, key, self.host_ms)
+        return seg
+
+    def tick(self, key, g):
+        duty = None
+        if key == 'straight':
+            s = self.current('straight', self.ref)
+            yaw = float(g[0])
+            duty = max(abs(float(x)) for x in g[1:5]) / 100.0
+            if self.ref is not None:
+                s.err.append(wrap180(yaw - self.ref))
+                s.ref = 'target'
+        elif key == 'straight_target':
+            target = float(g[5])
+            s = self.current('straight', target)
+            yaw = float(g[0])
+            duty = max(abs(float(x)) for x in g[1:5]) / 100.0
+            s.err.append(wrap180(yaw - target))
+            s.ref = 'target'
+        elif key == 'distance':
+            s = self.current('straight', self.ref)
+            yaw = float(g[0])
+            duty = abs(float(g[1]))
+            if self.ref is not None:
+                s.err.append(wrap180(yaw - self.ref))
+                s.ref = 'target'
+        elif key == 'turn':
+            s = self.current('turn', float(g[1]))
+            yaw = float(g[0])
+            s.err.append(float(g[2]))
+        elif key == 'arc':
+            s = self.current('arc', None)
+            yaw = float(g[0])
+            s.err.append(float(g[1]))
+        else:  # path
+            s = self.current('path', None)
+            yaw = float(g[2])
+            duty = abs(float(g[4]))
+            s.xte.append(float(g[3]))
+        self.chunk_ticks.append((s, len(s.t)))
+        s.t.append(self.host_ms)
+        s.yaw.append(yaw)
+        if duty is not None:
+            s.duty.append(duty)
+
+
+def runs_from_text(name, lines):
+    p = TextParser(name)
+    for line in lines:
+        p.line(line)
+    p.finish_run()
+    return p.runs
+
+
+# ========================
+# 指标
+# ========================
+
+def rms(values):
+    return math.sqrt(sum(v * v for v in values) / len(values)) if values else None
+
+
+def settle_time(seg, tol):
+    """转向段：误差最后一次超出 ±tol 之后的首个样本时刻（相对段开始）"""
+    if seg.kind != 'turn' or not seg.t or seg.t[0] is None or seg.t[-1] is None:
+        return None
+    if seg.err:
+        errs = seg.err
+    else:
+        final = seg.yaw[-1]
+        errs = [wrap180(y - final) for y in seg.yaw]
+    last_out = -1
+    for i, e in enumerate(errs):
+        if abs(e) > tol:
+            last_out = i
+    if last_out + 1 >= len(errs):
+        return None
+    t0 = seg.t_start if seg.t_start is not None else seg.t[0]
+    return seg.t[last_out + 1] - t0
+
+
+def segment_row(seg, args):
+    heading = seg.err if seg.kind in ('straight', 'path') else []
+    t0 = seg.t_start if seg.t_start is not None else (seg.t[0] if seg.t else None)
+    duration = (seg.t[-1] - t0) if (seg.t and t0 is not None and seg.t[-1] is not None) else None
+    sat = sum(1 for d in seg.duty if d >= args.sat)
+    row = {
+        'run': seg.run,
+        'segment': seg.index,
+        'kind': seg.kind,
+        't_start_ms': t0,
+        'duration_ms': duration,
+        'samples': len(seg.t),
+        'heading_ref': seg.ref if heading else '',
+        'heading_rms_deg': rms(heading),
+        'heading_max_deg': max((abs(e) for e in heading), default=None),
+        'xte_rms_mm': rms(seg.xte),
+        'turn_settle_ms': settle_time(seg, args.settle_tol),
+        'turn_done_ms': seg.turn_done_ms,
+        'turn_timeout': seg.timeout,
+        'obstacle_waits': len(seg.waits),
+        'obstacle_wait_ms': sum(seg.waits),
+        'duty_sat_pct': (100.0 * sat / len(seg.duty)) if seg.duty else None,
+    }
+    return row
+
+
+def histogram(periods, bin_ms, max_ms):
+    bins = {}
+    overflow = 0
+    for p in periods:
+        if p >= max_ms:
+            overflow += 1
+        else:
+            b = (p // bin_ms) * bin_ms
+            bins[b] = bins.get(b, 0) + 1
+    return bins, overflow
+
+
+def percentile(sorted_values, q):
+    if not sorted_values:
+        return None
+    i = min(len(sorted_values) - 1, int(round(q * (len(sorted_values) - 1))))
+    return sorted_values[i]
+
+
+def period_summary(runs, args):
+    out = {}
+    for source in ('device', 'host'):
+        periods = [p for r in runs if r.source == source for p in r.periods]
+        if not periods:
+            continue
+        srt = sorted(periods)
+        bins, overflow = histogram(periods, args.bin_ms, args.hist_max_ms)
+        out[source] = {
+            'count': len(periods),
+            'mean_ms': sum(periods) / len(periods),
+            'p50_ms': percentile(srt, 0.50),
+            'p99_ms': percentile(srt, 0.99),
+            'max_ms': srt[-1],
+            'bin_ms': args.bin_ms,
+            'hist': {str(k): v for k, v in sorted(bins.items())},
+            'overflow': overflow,
+        }
+    return out
+
+
+def totals(rows, runs):
+    heading = [r for r in rows if r['heading_rms_deg'] is not None]
+    samples = sum(r['samples'] for r in heading)
+    duty_rows = [r for r in rows if r['duty_sat_pct'] is not None]
+    duty_n = sum(r['samples'] for r in duty_rows)
+    settles = [r['turn_settle_ms'] for r in rows if r['turn_settle_ms'] is not None]
+    return {
+        'runs': len(runs),
+        'segments': len(rows),
+        'heading_rms_deg': math.sqrt(sum(r['heading_rms_deg'] ** 2 * r['samples'] for r in heading) / samples)
+        if samples else None,
+        'heading_max_deg': max((r['heading_max_deg'] for r in heading), default=None),
+        'turns': sum(1 for r in rows if r['kind'] == 'turn'),
+        'turn_settle_mean_ms': (sum(settles) / len(settles)) if settles else None,
+        'turn_settle_max_ms': max(settles, default=None),
+        'turn_timeouts': sum(1 for r in rows if r['turn_timeout']),
+        'obstacle_waits': sum(r['obstacle_waits'] for r in rows),
+        'obstacle_wait_ms': sum(r['obstacle_wait_ms'] for r in rows),
+        'duty_sat_pct': (sum(r['duty_sat_pct'] * r['samples'] for r in duty_rows) / duty_n) if duty_n else None,
+    }
+
+
+# ========================
+# 输入识别
+# ========================
+
+def load(path, args, table):
+    with open(path, 'rb') as f:
+        data = f.read()
+    name = os.path.basename(path)
+    if len(data) >= 4 and data[:4] == b'FRUN':
+        runs = []
+        for e in flog_extract.index_from_image(data):
+            runs.append(run_from_records('%s#run%d' % (name, e['run']), flog_extract.run_from_image(data, e)))
+        return runs
+    if len(data) >= 512 and (data[:4] == b'SDLS' or data[510:512] == b'\x55\xAA'):
+        try:
+            part = sdlog_extract.find_partition(data)
+            sb, entries = sdlog_extract.read_super(part)
+        except sdlog_extract.ExtractError as e:
+            raise AnalyzeError('%s: %s' % (path, e))
+        return [run_from_records('%s#run%d' % (name, e['run']), sdlog_extract.read_run(part, sb, e))
+                for e in entries]
+    if table is not None:
+        import tlog_decode
+        dec = tlog_decode.Decoder(table, args.raw)
+        data = b''.join(dec.feed(data[i:i + CHUNK]) for i in range(0, len(data), CHUNK)) + dec.feed(b'', final=True)
+    text = data.decode('utf-8', errors='replace')
+    if text.lstrip().startswith(REC_HEADER):
+        return [run_from_records(name, rows_from_csv_lines(text.splitlines()))]
+    lines = text.splitlines()
+    runs = runs_from_text(name, lines)
+    # flog dump 页
+    if '[flog] p ' in text:
+        for run_id, recs in sorted(flog_extract.runs_from_text(lines).items()):
+            runs.append(run_from_records('%s#flog%d' % (name, run_id), recs))
+    return runs
+
+
+def load_table(args):
+    if not (args.elf or args.table):
+        return None
+    import tlog_decode
+    if args.elf:
+        return tlog_decode.build_table(*tlog_decode.read_elf_section(args.elf, tlog_decode.SECTION))
+    with open(args.table, encoding='utf-8') as f:
+        return {int(k, 0): v for k, v in json.load(f).items()}
+
+
+# ========================
+# 输出
+# ========================
+
+CSV_COLUMNS = ['run', 'segment', 'kind', 't_start_ms', 'duration_ms', 'samples', 'heading_ref', 'heading_rms_deg',
+               'heading_max_deg', 'xte_rms_mm', 'turn_settle_ms', 'turn_done_ms', 'turn_timeout', 'obstacle_waits',
+               'obstacle_wait_ms', 'duty_sat_pct']
+
+
+def fmt(v):
+    if v is None:
+        return ''
+    if isinstance(v, bool):
+        return '1' if v else '0'
+    if isinstance(v, float):
+        return '%.3f' % v
+    return str(v)
+
+
+def open_out(path):
+    return sys.stdout if path == '-' else open(path, 'w', encoding='utf-8')
+
+
+def print_summary(tot, periods):
+    def f(v, unit=''):
+        return '-' if v is None else ('%.2f%s' % (v, unit) if isinstance(v, float) else '%s%s' % (v, unit))
+    print('运行 %d，分段 %d' % (tot['runs'], tot['segments']))
+    for source, p in periods.items():
+        label = '控制周期' if source == 'device' else '日志间隔（串口助手时间戳）'
+        print('%s: n=%d 平均=%.2fms p50=%sms p99=%sms 最大=%sms' % (label, p['count'], p['mean_ms'], p['p50_ms'],
+                                                                 p['p99_ms'], p['max_ms']))
+    print('航向误差: RMS=%s 最大=%s' % (f(tot['heading_rms_deg'], '°'), f(tot['heading_max_deg'], '°')))
+    print('转向: %d 次，稳定时间 平均=%s 最大=%s，超时 %d 次' % (tot['turns'], f(tot['turn_settle_mean_ms'], 'ms'),
+                                                     f(tot['turn_settle_max_ms'], 'ms'), tot['turn_timeouts']))
+    print('避障等待: %d 次，共 %dms' % (tot['obstacle_waits'], tot['obstacle_wait_ms']))
+    print('占空比饱和: %s' % f(tot['duty_sat_pct'], '%'))
+
+
+def main():
+    ap = argparse.ArgumentParser(description='运行日志分析（控制周期、航向误差、转向稳定、避障等待、占空比饱和）')
+    ap.add_argument('inputs', nargs='+', help='串口日志 / 记录 CSV / Flash 或 SD 卡镜像')
+    tok = ap.add_mutually_exclusive_group()
+    tok.add_argument('--elf', help='令牌化日志：固件 ELF')
+    tok.add_argument('--table', help='令牌化日志：tlog_decode.py --export 导出的字符串表')
+    ap.add_argument('--raw', action='store_true', help='令牌化日志链路未做 \\n -> \\r\\n 展开')
+    ap.add_argument('--csv', metavar='FILE', help='分段指标 CSV（- 为标准输出）')
+    ap.add_argument('--json', metavar='FILE', help='完整结果 JSON（- 为标准输出）')
+    ap.add_argument('--hist', metavar='FILE', help='周期直方图 CSV（source,bin_ms,count）')
+    ap.add_argument('--sat', type=float, default=0.98, help='占空比饱和阈值（默认 0.98）')
+    ap.add_argument('--settle-tol', type=float, default=2.0, help='转向稳定误差带（°，默认 2）')
+    ap.add_argument('--bin-ms', type=int, default=1, help='直方图分箱宽度（ms，默认 1）')
+    ap.add_argument('--hist-max-ms', type=int, default=200, help='直方图上限，超出计入 overflow（默认 200）')
+    args = ap.parse_args()
+
+    try:
+        table = load_table(args)
+        runs = []
+        for path in args.inputs:
+            runs.extend(load(path, args, table))
+    except (OSError, ValueError, AnalyzeError, flog_extract.ExtractError) as e:
+        print('错误: %s' % e, file=sys.stderr)
+        return 1
+    if not runs:
+        print('错误: 输入中没有可分析的记录', file=sys.stderr)
+        return 1
+
+    rows = [segment_row(s, args) for r in runs for s in r.segments]
+    periods = period_summary(runs, args)
+    tot = totals(rows, runs)
+
+    if args.csv:
+        out = open_out(args.csv)
+        out.write(','.join(CSV_COLUMNS) + '\n')
+        for row in rows:
+            out.write(','.join(fmt(row[c]) for c in CSV_COLUMNS) + '\n')
+        if out is not sys.stdout:
+            out.close()
+    if args.hist:
+        out = open_out(args.hist)
+        out.write('source,bin_ms,count\n')
+        for source, p in periods.items():
+            for b, n in p['hist'].items():
+                out.write('%s,%s,%d\n' % (source, b, n))
+            if p['overflow']:
+                out.write('%s,>=%d,%d\n' % (source, args.hist_max_ms, p['overflow']))
+        if out is not sys.stdout:
+            out.close()
+    if args.json:
+        out = open_out(args.json)
+        json.dump({'inputs': args.inputs, 'params': {'sat': args.sat, 'settle_tol_deg': args.settle_tol},
+                   'totals': tot, 'periods': periods, 'segments': rows}, out, ensure_ascii=False, indent=1)
+        out.write('\n')
+        if out is not sys.stdout:
+            out.close()
+    if args.csv != '-' and args.json != '-' and args.hist != '-':
+        print_summary(tot, periods)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,159 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+LoRa 状态下行帧解码（帧格式见 board/lora_link.h）
+
+输入为文本，每行一帧十六进制负载（接收端串口输出；行内其他文字忽略，取行内最后一段连续十六进制串），
+也接受命令行 lora show 输出的 "[lora] last=..." 行。差分帧按上一帧累加，帧序号不连续时丢弃差分帧
+直到下一个关键帧。
+
+用法：
+    python3 tools/lora_decode.py rx.log                 # 逐帧打印
+    python3 tools/lora_decode.py rx.log -o status.csv   # 同时写 CSV
+    cat /dev/ttyUSB1 | python3 tools/lora_decode.py -   # 实时解码接收端串口
+"""
+
+import argparse
+import re
+import sys
+
+KIND_KEY = 0
+KIND_DELTA = 1
+
+STATUS = ['IDLE', 'RUNNING', 'DONE', 'ABORTED', 'FAILED']
+FLAGS = [(0x01, 'OBSTACLE'), (0x02, 'NO_CALIB'), (0x04, 'NO_SDLOG'), (0x08, 'NO_FLOG'), (0x10, 'NO_NET'),
+         (0x20, 'TX_TIMEOUT')]
+
+COLUMNS = ['line', 'seq', 'kind', 'bytes', 'x_cm', 'y_cm', 'yaw_deg', 'herr_deg', 'step', 'status', 'flags', 'batt_v']
+
+HEX_RE = re.compile(r'\b[0-9A-Fa-f]{4,}\b')
+
+
+class FrameError(Exception):
+    pass
+
+
+class Bits:
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def get(self, n):
+        v = 0
+        for _ in range(n):
+            byte = self.pos >> 3
+            if byte >= len(self.data):
+                raise FrameError('帧长度不足')
+            v = (v << 1) | ((self.data[byte] >> (7 - (self.pos & 7))) & 1)
+            self.pos += 1
+        return v
+
+    def get_signed(self, n):
+        v = self.get(n)
+        return v - (1 << n) if v & (1 << (n - 1)) else v
+
+    def get_var(self):
+        z = self.get([0, 4, 8, 16][self.get(2)])
+        return (z >> 1) ^ -(z & 1)
+
+
+def get_misc(b, st):
+    st['step'] = b.get(6)
+    st['status'] = b.get(3)
+    st['flags'] = b.get(8)
+    st['batt_dv'] = b.get(8)
+
+
+def decode(data, prev):
+    """返回 (kind, seq, 状态)；差分帧需要 prev（上一帧状态）"""
+    b = Bits(data)
+    kind = b.get(1)
+    seq = b.get(4)
+    if kind == KIND_KEY:
+        st = {'x_cm': b.get_signed(16), 'y_cm': b.get_signed(16), 'yaw_hdeg': b.get(10),
+              'herr_hdeg': b.get_signed(8)}
+        if st['yaw_hdeg'] >= 720:
+            raise FrameError('航向超出范围')
+        get_misc(b, st)
+    else:
+        if prev is None:
+            return kind, seq, None
+        st = dict(prev)
+        st['x_cm'] = prev['x_cm'] + b.get_var()
+        st['y_cm'] = prev['y_cm'] + b.get_var()
+        st['yaw_hdeg'] = (prev['yaw_hdeg'] + b.get_var()) % 720
+        st['herr_hdeg'] = b.get_var()
+        if b.get(1):
+            get_misc(b, st)
+    if (b.pos + 7) >> 3 != len(data):
+        raise FrameError('帧长度与内容不符（%d 字节，解码 %d 位）' % (len(data), b.pos))
+    return kind, seq, st
+
+
+def flag_names(flags):
+    names = [n for m, n in FLAGS if flags & m]
+    return '|'.join(names) if names else '-'
+
+
+def main():
+    ap = argparse.ArgumentParser(description='LoRa 状态下行帧解码')
+    ap.add_argument('input', help='接收日志（- 为标准输入）')
+    ap.add_argument('-o', '--output', help='写 CSV')
+    args = ap.parse_args()
+
+    try:
+        src = sys.stdin if args.input == '-' else open(args.input, encoding='utf-8', errors='replace')
+        out = open(args.output, 'w') if args.output else None
+    except OSError as e:
+        print('错误: %s' % e, file=sys.stderr)
+        return 1
+    if out:
+        out.write(','.join(COLUMNS) + '\n')
+
+    prev = None
+    last_seq = None
+    frames = keys = lost = skipped = bad = total_bytes = 0
+    for lineno, line in enumerate(src, 1):
+        runs = [r for r in HEX_RE.findall(line) if len(r) % 2 == 0]
+        if not runs:
+            continue
+        data = bytes.fromhex(runs[-1])
+        try:
+            b = Bits(data)
+            kind, seq = b.get(1), b.get(4)
+            if last_seq is not None and seq != (last_seq + 1) & 0x0F:
+                lost += (seq - last_seq - 1) & 0x0F
+                prev = None
+            last_seq = seq
+            kind, seq, st = decode(data, prev)
+        except FrameError as e:
+            print('第 %d 行: %s' % (lineno, e), file=sys.stderr)
+            bad += 1
+            prev = None
+            continue
+        if st is None:
+            skipped += 1
+            continue
+        prev = st
+        frames += 1
+        keys += kind == KIND_KEY
+        total_bytes += len(data)
+        status = STATUS[st['status']] if st['status'] < len(STATUS) else str(st['status'])
+        batt = '%.1fV' % (st['batt_dv'] / 10.0) if st['batt_dv'] else '-'
+        print('#%-2d %s %2dB x=%7.2fm y=%7.2fm θ=%6.1f° err=%+5.1f° step=%-2d %-7s %s %s'
+              % (seq, 'K' if kind == KIND_KEY else 'D', len(data), st['x_cm'] / 100.0, st['y_cm'] / 100.0,
+                 st['yaw_hdeg'] / 2.0, st['herr_hdeg'] / 2.0, st['step'], status, batt, flag_names(st['flags'])))
+        if out:
+            out.write('%d,%d,%s,%d,%d,%d,%.1f,%.1f,%d,%s,%s,%.1f\n'
+                      % (lineno, seq, 'key' if kind == KIND_KEY else 'delta', len(data), st['x_cm'], st['y_cm'],
+                         st['yaw_hdeg'] / 2.0, st['herr_hdeg'] / 2.0, st['step'], status, flag_names(st['flags']),
+                         st['batt_dv'] / 10.0))
+    if out:
+        out.close()
+    print('共 %d 帧（关键帧 %d，平均 %.1f 字节），丢失 %d，等待关键帧跳过 %d，无效 %d'
+          % (frames, keys, total_bytes / frames if frames else 0.0, lost, skipped, bad))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,134 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+RTOS 内存规划报告：按 src/app_rtos.h 与 FreeRTOSConfig.h 的编译期常量列出各任务栈、
+流缓冲区与内核对象的静态内存，对照 APP_RTOS_RAM_BUDGET 检查。
+
+给出固件 ELF 时用 nm 读取实际符号大小（控制块大小随内核配置变化，以此为准）；
+否则控制块按 RV32 典型值估算并标注“估”。运行期的栈最少剩余由 shell `stats` 输出。
+
+用法：
+    mem_budget.py                          仅按头文件常量
+    mem_budget.py --elf build/app.elf      读取实际符号大小（NM 环境变量指定 nm，默认 riscv64-unknown-elf-nm）
+"""
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+
+ROOT = os.path.normpath(os.path.join(os.path.dirname(os.path.abspath(__file__)), '..'))
+APP_HEADER = os.path.join(ROOT, 'src', 'app_rtos.h')
+RTOS_CONFIG = os.path.join(ROOT, 'ESWIN_SDK', 'os', 'FreeRTOS', 'Config', 'FreeRTOSConfig.h')
+
+WORD_BYTES = 4                      # RV32 StackType_t
+EST_TCB_BYTES = 112                 # StaticTask_t 估算值
+EST_STREAM_CB_BYTES = 36            # StaticStreamBuffer_t 估算值
+EST_SEM_CB_BYTES = 80               # StaticSemaphore_t 估算值
+TELEM_RECORD_BYTES = 20             # app_telemetry_t
+
+# (任务名, 栈常量, 优先级常量, 栈符号)
+TASKS = [
+    ('wheel', 'APP_STACK_WHEEL', 'APP_PRIO_WHEEL', 's_wheel_stack'),
+    ('imu', 'APP_STACK_IMU', 'APP_PRIO_IMU', 's_imu_stack'),
+    ('ctrl', 'APP_STACK_CONTROL', 'APP_PRIO_CONTROL', 's_control_stack'),
+    ('servo', 'APP_STACK_SERVO', 'APP_PRIO_SERVO', 's_servo_stack'),
+    ('range', 'APP_STACK_RANGE', 'APP_PRIO_RANGE', 's_range_stack'),
+    ('telem', 'APP_STACK_TELEMETRY', 'APP_PRIO_TELEMETRY', 's_telemetry_stack'),
+    ('sdlog', 'APP_STACK_SDLOG', 'APP_PRIO_SDLOG', 's_sdlog_stack'),
+    ('idle', 'APP_STACK_IDLE', None, 's_idle_stack'),
+    ('timer', 'configTIMER_TASK_STACK_DEPTH', 'configTIMER_TASK_PRIORITY', 's_timer_stack'),
+]
+
+DEFINE_RE = re.compile(r'^\s*#define\s+(\w+)\s+(.+?)\s*(//.*|/\*.*)?$')
+
+
+def read_defines(path):
+    defines = {}
+    with open(path, encoding='utf-8') as f:
+        for line in f:
+            m = DEFINE_RE.match(line)
+            if m:
+                defines[m.group(1)] = m.group(2)
+    return defines
+
+
+def evaluate(expr, defines, depth=0):
+    if depth > 8:
+        raise ValueError('宏展开过深: %s' % expr)
+    expr = re.sub(r'\b(\d+)[uUlL]+\b', r'\1', expr)
+    expr = re.sub(r'\(\s*TickType_t\s*\)', '', expr)
+
+    def subst(m):
+        name = m.group(0)
+        if name in defines:
+            return '(%d)' % evaluate(defines[name], defines, depth + 1)
+        return name
+    expr = re.sub(r'\b[A-Za-z_]\w*\b', subst, expr)
+    return int(eval(expr, {'__builtins__': {}}, {}))
+
+
+def read_symbol_sizes(elf):
+    nm = os.environ.get('NM', 'riscv64-unknown-elf-nm')
+    out = subprocess.run([nm, '-S', elf], check=True, capture_output=True, text=True).stdout
+    sizes = {}
+    for line in out.splitlines():
+        parts = line.split()
+        if len(parts) == 4:
+            sizes[parts[3]] = int(parts[1], 16)
+    return sizes
+
+
+def main():
+    ap = argparse.ArgumentParser(description='RTOS 静态内存规划报告')
+    ap.add_argument('--elf', help='固件 ELF，读取实际符号大小')
+    args = ap.parse_args()
+
+    defines = read_defines(RTOS_CONFIG)
+    defines.update(read_defines(APP_HEADER))
+    sizes = read_symbol_sizes(args.elf) if args.elf else {}
+
+    # 栈与缓冲区由常量精确给出；控制块无 ELF 时为估算值
+    def sym(name, fallback, exact=True):
+        if name in sizes:
+            return sizes[name], ''
+        return fallback, '' if exact else '估'
+
+    print('%-8s %6s %10s %s' % ('任务', '优先级', '栈(字节)', ''))
+    stack_total = 0
+    for name, stack_macro, prio_macro, stack_sym in TASKS:
+        words = evaluate(stack_macro, defines)
+        nbytes, note = sym(stack_sym, words * WORD_BYTES)
+        prio = evaluate(prio_macro, defines) if prio_macro else 0
+        stack_total += nbytes
+        print('%-8s %6d %10d %s' % (name, prio, nbytes, note))
+
+    log_bytes, log_note = sym('s_log_storage', evaluate('APP_LOG_BUFFER_BYTES', defines) + 1)
+    telem_bytes, telem_note = sym('s_telem_storage',
+                                  evaluate('APP_TELEM_RECORDS', defines) * TELEM_RECORD_BYTES + 1)
+    task_count = len(TASKS)
+    tcb_bytes, note = sym('s_task_tcbs', EST_TCB_BYTES * (task_count - 2), False)
+    idle_tcb, _ = sym('s_idle_tcb', EST_TCB_BYTES, False)
+    timer_tcb, _ = sym('s_timer_tcb', EST_TCB_BYTES, False)
+    stream_cb, _ = sym('s_log_stream_cb', EST_STREAM_CB_BYTES, False)
+    sem_cb, _ = sym('s_log_mutex_cb', EST_SEM_CB_BYTES, False)
+    hr_sem_cb, _ = sym('s_hr_sem_cb', EST_SEM_CB_BYTES, False)   # board_delay.c 亚节拍休眠
+    objects = tcb_bytes + idle_tcb + timer_tcb + 2 * stream_cb + sem_cb + hr_sem_cb
+
+    print('%-8s %17d %s' % ('log 流', log_bytes, log_note))
+    print('%-8s %17d %s' % ('telem 流', telem_bytes, telem_note))
+    print('%-8s %17d %s' % ('控制块', objects, note))
+
+    total = stack_total + log_bytes + telem_bytes + objects
+    budget = evaluate('APP_RTOS_RAM_BUDGET', defines)
+    print('合计 %d / 预算 %d 字节（%.0f%%）' % (total, budget, 100.0 * total / budget))
+    if args.elf and 's_osifSemaphorePool' in sizes:
+        print('OSIF 驱动信号量池 %d 字节（不计入预算）' % sizes['s_osifSemaphorePool'])
+    if args.elf and 'RecorderData' in sizes:
+        print('内核追踪记录区 %d 字节（APP_USE_TRACE，不计入预算）' % sizes['RecorderData'])
+    return 0 if total <= budget else 1
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,157 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+任务编译器：把文本任务描述编译为 board/mission_store.h 定义的二进制镜像（MSN1 v1）
+
+文本格式（每行一条，# 之后为注释）：
+    path [lookahead=150] [timeout=20000]     开始一段航点路径，以 end 结束
+      wp X Y [speed=0.12] [servo2=105]       航点（mm，起点位姿为原点、起始航向为 x 轴，左为 +y）
+    end
+    straight DIST [speed=0.12] [timeout=15000]
+    turn DELTA_DEG [speed=0.3] [stop=1.0] [timeout=6000]   正=左转
+    servo CHANNEL ANGLE                       舵机目标（并行执行）
+    wait ms T | wait servos | wait still [T]  等待
+    remote [timeout=0]                        按上位机 CAN 指令行驶，收到 RELEASE 结束（0 不限时）
+
+用法：
+    mission_compiler.py nb.txt -o nb.bin          生成二进制镜像
+    mission_compiler.py nb.txt --c-array          输出 C 数组（便于内置或调试）
+    mission_compiler.py nb.txt --hex              输出十六进制串（串口下发）
+"""
+
+import argparse
+import struct
+import sys
+import zlib
+
+MAGIC = 0x314E534D
+VERSION = 1
+MAX_STEPS = 32
+MAX_WPS = 48
+SLOT_SIZE = 0x400
+
+STEP_PATH, STEP_STRAIGHT, STEP_TURN, STEP_SERVO, STEP_WAIT, STEP_REMOTE = range(6)
+WAIT_MS, WAIT_SERVOS_IDLE, WAIT_STILL = range(3)
+
+
+class CompileError(Exception):
+    pass
+
+
+def parse_kv(tokens, defaults, lineno):
+    opts = dict(defaults)
+    for tok in tokens:
+        if '=' not in tok:
+            raise CompileError(f"第{lineno}行：参数应为 key=value：{tok}")
+        k, v = tok.split('=', 1)
+        if k not in defaults:
+            raise CompileError(f"第{lineno}行：未知参数 {k}")
+        opts[k] = float(v)
+    return opts
+
+
+def step_record(typ, arg8=0, arg16=0, heading_deg=0.0, speed=0.0, value=0, timeout=0):
+    return struct.pack('<BBHhHiI', typ, arg8, arg16, int(round(heading_deg * 100)),
+                       int(round(speed * 1000)), int(round(value)), int(timeout))
+
+
+def compile_text(text):
+    steps = []
+    wps = []
+    path = None
+    for lineno, raw in enumerate(text.splitlines(), 1):
+        line = raw.split('#', 1)[0].strip()
+        if not line:
+            continue
+        tok = line.split()
+        cmd = tok[0].lower()
+        if path is not None:
+            if cmd == 'wp':
+                if len(tok) < 3:
+                    raise CompileError(f"第{lineno}行：wp 需要 X Y")
+                o = parse_kv(tok[3:], {'speed': 0.12, 'servo2': 0}, lineno)
+                path['wps'].append(struct.pack('<hhHH', int(round(float(tok[1]))), int(round(float(tok[2]))),
+                                               int(round(o['speed'] * 1000)), int(o['servo2'])))
+                continue
+            if cmd == 'end':
+                n = len(path['wps'])
+                if n < 2 or n > 16:
+                    raise CompileError(f"第{path['line']}行：路径航点数应为 2~16（当前 {n}）")
+                steps.append(step_record(STEP_PATH, arg8=n, arg16=len(wps), value=path['lookahead'],
+                                         timeout=path['timeout']))
+                wps.extend(path['wps'])
+                path = None
+                continue
+            raise CompileError(f"第{lineno}行：路径内只允许 wp/end")
+        if cmd == 'path':
+            o = parse_kv(tok[1:], {'lookahead': 150, 'timeout': 20000}, lineno)
+            path = {'line': lineno, 'lookahead': o['lookahead'], 'timeout': o['timeout'], 'wps': []}
+        elif cmd == 'straight':
+            o = parse_kv(tok[2:], {'speed': 0.12, 'timeout': 15000}, lineno)
+            steps.append(step_record(STEP_STRAIGHT, speed=o['speed'], value=float(tok[1]), timeout=o['timeout']))
+        elif cmd == 'turn':
+            o = parse_kv(tok[2:], {'speed': 0.3, 'stop': 1.0, 'timeout': 6000}, lineno)
+            steps.append(step_record(STEP_TURN, arg16=int(round(o['stop'] * 10)), heading_deg=float(tok[1]),
+                                     speed=o['speed'], timeout=o['timeout']))
+        elif cmd == 'servo':
+            ch, ang = int(tok[1]), int(tok[2])
+            if ch not in (1, 2) or not 0 <= ang <= 180:
+                raise CompileError(f"第{lineno}行：舵机通道 1/2、角度 0~180")
+            steps.append(step_record(STEP_SERVO, arg8=ch, arg16=ang))
+        elif cmd == 'wait':
+            kind = tok[1].lower() if len(tok) > 1 else ''
+            if kind == 'ms':
+                steps.append(step_record(STEP_WAIT, arg8=WAIT_MS, value=int(tok[2])))
+            elif kind == 'servos':
+                steps.append(step_record(STEP_WAIT, arg8=WAIT_SERVOS_IDLE))
+            elif kind == 'still':
+                steps.append(step_record(STEP_WAIT, arg8=WAIT_STILL, value=int(tok[2]) if len(tok) > 2 else 0))
+            else:
+                raise CompileError(f"第{lineno}行：wait ms T | wait servos | wait still [T]")
+        elif cmd == 'remote':
+            o = parse_kv(tok[1:], {'timeout': 0}, lineno)
+            steps.append(step_record(STEP_REMOTE, timeout=o['timeout']))
+        else:
+            raise CompileError(f"第{lineno}行：未知指令 {tok[0]}")
+    if path is not None:
+        raise CompileError(f"第{path['line']}行：path 缺少 end")
+    if not 0 < len(steps) <= MAX_STEPS:
+        raise CompileError(f"步骤数应为 1~{MAX_STEPS}（当前 {len(steps)}）")
+    if len(wps) > MAX_WPS:
+        raise CompileError(f"航点总数超过 {MAX_WPS}")
+
+    payload = b''.join(steps) + b''.join(wps)
+    tail = struct.pack('<BBBBHH', VERSION, len(steps), len(wps), 0, len(payload), 0) + payload
+    image = struct.pack('<II', MAGIC, zlib.crc32(tail) & 0xFFFFFFFF) + tail
+    if len(image) > SLOT_SIZE:
+        raise CompileError(f"镜像 {len(image)} 字节超过任务槽 {SLOT_SIZE} 字节")
+    return image
+
+
+def main():
+    ap = argparse.ArgumentParser(description='编译文本任务描述为 EEPROM 任务镜像')
+    ap.add_argument('input')
+    ap.add_argument('-o', '--output', help='输出二进制文件')
+    ap.add_argument('--c-array', action='store_true', help='输出 C 数组')
+    ap.add_argument('--hex', action='store_true', help='输出十六进制串')
+    args = ap.parse_args()
+
+    with open(args.input, encoding='utf-8') as f:
+        try:
+            image = compile_text(f.read())
+        except (CompileError, ValueError, IndexError) as e:
+            sys.exit(f"{args.input}: {e}")
+
+    if args.output:
+        with open(args.output, 'wb') as f:
+            f.write(image)
+    if args.c_array:
+        body = ',\n'.join('    ' + ', '.join(f'0x{b:02X}' for b in image[i:i + 12]) for i in range(0, len(image), 12))
+        print(f'static const uint8_t s_mission_image[{len(image)}] = {{\n{body}\n}};')
+    if args.hex:
+        print(image.hex())
+    print(f"{args.input}: {len(image)} 字节, CRC32=0x{struct.unpack_from('<I', image, 4)[0]:08X}", file=sys.stderr)
+
+
+if __name__ == '__main__':
+    main()
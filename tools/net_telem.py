@@ -0,0 +1,210 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+以太网遥测与命令（W5500，UDP，报文格式见 board/net_telem.h）
+
+listen 每秒发送一次 HELLO 订阅（固件 5 s 未续订即停止发送），接收每个控制周期的遥测帧，
+按帧序号统计丢帧；-o 写 CSV（前 15 列与 frec dump 相同，其后为位姿/速度/测距/任务状态）。
+get/set 按名称读写命令行同一参数表，无应答时重发。
+
+用法：
+    net_telem.py listen                            订阅并每秒打印一行统计
+    net_telem.py listen -o run.csv --seconds 30    同时写 CSV，30 s 后退出
+    net_telem.py get straight_kp
+    net_telem.py set straight_kp 0.35
+    net_telem.py --host 192.168.1.88 --port 5000 ...
+"""
+
+import argparse
+import socket
+import struct
+import sys
+import time
+
+MAGIC = 0x544E
+VERSION = 1
+NAME_MAX = 20
+
+T_REC = 0x01
+T_HELLO = 0x10
+T_BYE = 0x11
+T_GET = 0x12
+T_SET = 0x13
+T_ACK = 0x80
+
+RESULTS = {0: 'OK', 1: '未知参数', 2: '超出范围', 3: '报文无效'}
+STATUS = ['IDLE', 'RUNNING', 'DONE', 'ABORTED', 'FAILED']
+
+HDR = struct.Struct('<HBBHH')
+REC = struct.Struct('<IHBBhhhhhhhhhhi' + 'iihhHBB')
+PARAM = struct.Struct('<%dsf' % NAME_MAX)
+ACK = struct.Struct('<BBH%dsfff' % NAME_MAX)
+
+COLUMNS = ['t_ms', 'seq', 'step', 'flags', 'yaw_cdeg', 'rate_ddps', 'err_ddps', 'p_e4', 'i_e4', 'ff_e4',
+           'd1_e4', 'd2_e4', 'd3_e4', 'd4_e4', 'dist_dmm',
+           'x_dmm', 'y_dmm', 'theta_cdeg', 'speed_mms', 'range_mm', 'status', 'drops']
+
+HELLO_PERIOD_S = 1.0
+CMD_TIMEOUT_S = 0.3
+CMD_RETRIES = 5
+
+
+class NetError(Exception):
+    pass
+
+
+def packet(ptype, seq, payload=b''):
+    return HDR.pack(MAGIC, VERSION, ptype, seq & 0xFFFF, len(payload)) + payload
+
+
+def parse(data):
+    """返回 (类型, 序号, 负载)；报文无效返回 None"""
+    if len(data) < HDR.size:
+        return None
+    magic, version, ptype, seq, length = HDR.unpack_from(data)
+    if magic != MAGIC or version != VERSION or length != len(data) - HDR.size:
+        return None
+    return ptype, seq, data[HDR.size:]
+
+
+def open_socket(local_port):
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.bind(('', local_port))
+    return sock
+
+
+def command(sock, dev, ptype, name=None, value=0.0):
+    """发送命令并等待对应序号的应答（遥测帧忽略）"""
+    seq = int(time.monotonic() * 1000) & 0xFFFF
+    payload = b''
+    if name is not None:
+        raw = name.encode()
+        if len(raw) >= NAME_MAX:
+            raise NetError('参数名超过 %d 字节' % (NAME_MAX - 1))
+        payload = PARAM.pack(raw, value)
+    pkt = packet(ptype, seq, payload)
+    for _ in range(CMD_RETRIES):
+        sock.sendto(pkt, dev)
+        deadline = time.monotonic() + CMD_TIMEOUT_S
+        while True:
+            left = deadline - time.monotonic()
+            if left <= 0:
+                break
+            sock.settimeout(left)
+            try:
+                data, _ = sock.recvfrom(2048)
+            except socket.timeout:
+                break
+            p = parse(data)
+            if p is None or p[0] != T_ACK or p[1] != seq or len(p[2]) != ACK.size:
+                continue
+            cmd, result, _, rname, val, vmin, vmax = ACK.unpack(p[2])
+            if cmd != ptype:
+                continue
+            return result, rname.split(b'\0', 1)[0].decode(errors='replace'), val, vmin, vmax
+    raise NetError('%s:%d 无应答' % dev)
+
+
+def print_param(result, name, value, vmin, vmax):
+    if result != 0:
+        print('%s: %s' % (name, RESULTS.get(result, 'ERR %d' % result)), file=sys.stderr)
+        if result == 2:
+            print('%s = %.5f  [%.4f, %.4f]' % (name, value, vmin, vmax), file=sys.stderr)
+        return 1
+    print('%s = %.5f  [%.4f, %.4f]' % (name, value, vmin, vmax))
+    return 0
+
+
+def listen(sock, dev, out_path, seconds):
+    out = open(out_path, 'w') if out_path else None
+    if out:
+        out.write(','.join(COLUMNS) + '\n')
+    start = time.monotonic()
+    next_hello = start
+    next_print = start + 1.0
+    last_seq = None
+    frames = lost = bad = 0
+    win_frames = 0
+    row = None
+    try:
+        while seconds is None or time.monotonic() - start < seconds:
+            now = time.monotonic()
+            if now >= next_hello:
+                sock.sendto(packet(T_HELLO, 0), dev)
+                next_hello = now + HELLO_PERIOD_S
+            if now >= next_print:
+                if row is not None:
+                    print('%5.1f帧/s 累计=%d 丢失=%d 无效=%d | t=%dms step=%d %s x=%.1fmm y=%.1fmm θ=%.2f° '
+                          'v=%dmm/s' % (win_frames / (now - next_print + 1.0), frames, lost, bad, row[0], row[2],
+                                        STATUS[row[20]] if row[20] < len(STATUS) else row[20], row[15] / 10.0,
+                                        row[16] / 10.0, row[17] / 100.0, row[18]))
+                else:
+                    print('等待遥测帧（HELLO -> %s:%d）' % dev)
+                win_frames = 0
+                next_print = now + 1.0
+            sock.settimeout(max(0.01, min(next_hello, next_print) - time.monotonic()))
+            try:
+                data, _ = sock.recvfrom(2048)
+            except socket.timeout:
+                continue
+            p = parse(data)
+            if p is None:
+                bad += 1
+                continue
+            ptype, seq, payload = p
+            if ptype != T_REC:
+                continue
+            if len(payload) != REC.size:
+                bad += 1
+                continue
+            if last_seq is not None:
+                lost += (seq - last_seq - 1) & 0xFFFF
+            last_seq = seq
+            frames += 1
+            win_frames += 1
+            row = REC.unpack(payload)
+            if out:
+                out.write(','.join(str(v) for v in row) + '\n')
+    except KeyboardInterrupt:
+        pass
+    finally:
+        sock.sendto(packet(T_BYE, 0), dev)
+        if out:
+            out.close()
+    total = frames + lost
+    print('共 %d 帧，丢失 %d（%.2f%%），无效 %d%s' % (frames, lost, 100.0 * lost / total if total else 0.0, bad,
+                                               ' -> %s' % out_path if out_path else ''))
+    return 0
+
+
+def main():
+    ap = argparse.ArgumentParser(description='以太网遥测与命令（W5500 UDP）')
+    ap.add_argument('--host', default='192.168.1.88', help='小车 IP（默认 192.168.1.88）')
+    ap.add_argument('--port', type=int, default=5000, help='小车 UDP 端口（默认 5000）')
+    ap.add_argument('--local-port', type=int, default=0, help='本机 UDP 端口（默认自动分配）')
+    sub = ap.add_subparsers(dest='cmd', required=True)
+    p = sub.add_parser('listen', help='订阅遥测')
+    p.add_argument('-o', '--output', help='写 CSV')
+    p.add_argument('--seconds', type=float, help='接收时长（默认直到 Ctrl-C）')
+    p = sub.add_parser('get', help='读参数')
+    p.add_argument('name')
+    p = sub.add_parser('set', help='写参数')
+    p.add_argument('name')
+    p.add_argument('value', type=float)
+    args = ap.parse_args()
+
+    dev = (args.host, args.port)
+    try:
+        sock = open_socket(args.local_port)
+        if args.cmd == 'listen':
+            return listen(sock, dev, args.output, args.seconds)
+        if args.cmd == 'get':
+            return print_param(*command(sock, dev, T_GET, args.name))
+        return print_param(*command(sock, dev, T_SET, args.name, args.value))
+    except (OSError, NetError) as e:
+        print('错误: %s' % e, file=sys.stderr)
+        return 1
+
+
+if __name__ == '__main__':
+    sys.exit(main())
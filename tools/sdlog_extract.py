@@ -0,0 +1,142 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+SD 卡运行记录提取：从记录分区镜像（或带 MBR 的整卡镜像）按运行解码为 CSV
+（分区布局见 board/sd_log.h），列与 frec dump 相同。
+
+镜像读取：
+    sudo dd if=/dev/sdX2 of=sdlog.bin bs=1M          只读记录分区
+    sudo dd if=/dev/sdX of=card.bin bs=1M            整卡（自动按 MBR 找 0xDA 分区）
+
+准备记录分区（一次）：用 fdisk 新建分区并把类型设为 da（Non-FS data），不需要格式化；
+固件首次使用时自动建立超级块。
+
+用法：
+    sdlog_extract.py sdlog.bin --list                列出运行
+    sdlog_extract.py card.bin                        最近各运行分别写 run_<N>.csv
+    sdlog_extract.py sdlog.bin --run 12 -o run12.csv
+"""
+
+import argparse
+import struct
+import sys
+import zlib
+
+SECTOR = 512
+PART_TYPE = 0xDA
+SECTOR_MAGIC = 0x314C4453
+SUPER_MAGIC = 0x534C4453
+VERSION = 1
+RUN_SLOTS = 30
+RUN_CLOSED = 0x0001
+RECS_PER_SECTOR = 15
+
+SECTOR_HDR = struct.Struct('<IIHHI')
+SUPER_HDR = struct.Struct('<IIHHII12x')
+RUN = struct.Struct('<HHIII')
+REC = struct.Struct('<IHBBhhhhhhhhhhi')
+
+COLUMNS = ['t_ms', 'seq', 'step', 'flags', 'yaw_cdeg', 'rate_ddps', 'err_ddps', 'p_e4', 'i_e4', 'ff_e4',
+           'd1_e4', 'd2_e4', 'd3_e4', 'd4_e4', 'dist_dmm']
+
+
+class ExtractError(Exception):
+    pass
+
+
+def find_partition(image):
+    """整卡镜像按 MBR 定位记录分区；已是分区镜像时原样返回"""
+    if len(image) >= SECTOR and struct.unpack_from('<I', image, 0)[0] == SUPER_MAGIC:
+        return image
+    if len(image) < SECTOR or image[510:512] != b'\x55\xAA':
+        raise ExtractError('既不是记录分区也不是带 MBR 的整卡镜像')
+    for i in range(4):
+        entry = image[446 + i * 16:446 + (i + 1) * 16]
+        if entry[4] == PART_TYPE:
+            start, count = struct.unpack_from('<II', entry, 8)
+            return image[start * SECTOR:(start + count) * SECTOR]
+    raise ExtractError('MBR 中没有类型 0x%02X 的分区' % PART_TYPE)
+
+
+def read_super(part):
+    magic, crc, version, runs, nxt, data_sectors = SUPER_HDR.unpack_from(part, 0)
+    if magic != SUPER_MAGIC or version != VERSION:
+        raise ExtractError('超级块无效（分区未被固件使用过？）')
+    if zlib.crc32(part[8:SECTOR]) != crc:
+        raise ExtractError('超级块 CRC 错误')
+    entries = []
+    for i in range(RUN_SLOTS):
+        run, flags, start, sectors, t0 = RUN.unpack_from(part, SUPER_HDR.size + i * RUN.size)
+        if run != 0 and run + RUN_SLOTS > runs:
+            entries.append({'run': run, 'closed': bool(flags & RUN_CLOSED), 'start': start,
+                            'sectors': sectors, 't0': t0})
+    entries.sort(key=lambda e: e['run'])
+    return {'runs': runs, 'next': nxt, 'data_sectors': data_sectors}, entries
+
+
+def read_run(part, sb, entry):
+    """按扇区头读取一个运行；遇到 CRC/序号不符（已被回绕覆盖）时停止"""
+    records = []
+    # 未结束的运行只记录到最近检查点，继续向后读到扇区头不连续为止
+    limit = entry['sectors'] if entry['closed'] else sb['data_sectors']
+    for seq in range(limit):
+        off = (1 + (entry['start'] + seq) % sb['data_sectors']) * SECTOR
+        sector = part[off:off + SECTOR]
+        if len(sector) < SECTOR:
+            print('run %d: 镜像在扇区 %d 处截断' % (entry['run'], seq), file=sys.stderr)
+            break
+        magic, crc, run, n_rec, sseq = SECTOR_HDR.unpack_from(sector)
+        if (magic != SECTOR_MAGIC or run != entry['run'] or sseq != seq or n_rec > RECS_PER_SECTOR or
+                zlib.crc32(sector[8:]) != crc):
+            if entry['closed']:
+                print('run %d: 第 %d 扇区无效（可能已被覆盖）' % (entry['run'], seq), file=sys.stderr)
+            break
+        for i in range(n_rec):
+            r = REC.unpack_from(sector, SECTOR_HDR.size + i * REC.size)
+            records.append(list(r))
+    return records
+
+
+def write_csv(path, records):
+    with open(path, 'w') as f:
+        f.write(','.join(COLUMNS) + '\n')
+        for row in records:
+            f.write(','.join(str(v) for v in row) + '\n')
+
+
+def main():
+    ap = argparse.ArgumentParser(description='SD 卡运行记录提取')
+    ap.add_argument('image', help='记录分区镜像或整卡镜像')
+    ap.add_argument('--list', action='store_true', help='只列出运行')
+    ap.add_argument('--run', type=int, help='只提取指定运行')
+    ap.add_argument('-o', '--output', help='输出文件（配合 --run；默认 run_<N>.csv）')
+    args = ap.parse_args()
+
+    try:
+        with open(args.image, 'rb') as f:
+            part = find_partition(f.read())
+        sb, entries = read_super(part)
+    except (OSError, ExtractError) as e:
+        print('错误: %s' % e, file=sys.stderr)
+        return 1
+
+    if args.list:
+        for e in entries:
+            print('run=%d start=%d sectors=%d t0=%dms%s' % (e['run'], e['start'], e['sectors'], e['t0'],
+                                                          '' if e['closed'] else ' 未结束'))
+        return 0
+    if args.run is not None:
+        entries = [e for e in entries if e['run'] == args.run]
+    if not entries:
+        print('错误: 未找到运行记录', file=sys.stderr)
+        return 1
+    for e in entries:
+        recs = read_run(part, sb, e)
+        path = args.output if (args.output and args.run is not None) else 'run_%d.csv' % e['run']
+        write_csv(path, recs)
+        print('run %d: %d 条 -> %s' % (e['run'], len(recs), path))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,238 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+令牌化日志解码器：从固件 ELF 的 .tlog_fmt 段提取格式串表，把串口输出中的日志帧还原为文本
+（帧格式见 board/tlog.h），帧以外的字节（普通 printf 文本）原样透传。
+
+串口驱动输出时把 \\n 展开为 \\r\\n（对二进制帧同样如此），解码前先逆变换；
+链路不做展开时加 --raw。
+
+用法：
+    tlog_decode.py --elf build/app.elf log.bin           解码文件
+    cat /dev/ttyUSB0 | tlog_decode.py --elf build/app.elf  解码串口（先 stty raw 设置波特率）
+    tlog_decode.py --elf build/app.elf --export tbl.json  仅导出字符串表（随固件版本归档）
+    tlog_decode.py --table tbl.json log.bin              用导出的字符串表解码
+"""
+
+import argparse
+import json
+import re
+import struct
+import sys
+
+SECTION = '.tlog_fmt'
+SYNC = 0x1E
+STR_MAX = 32
+
+# printf 转换说明：标志、宽度、精度、长度修饰、转换字符
+CONV_RE = re.compile(r'%([-+ #0]*)(\d+|\*)?(?:\.(\d+|\*))?(hh|h|ll|l|z|j|t|L)?([diouxXeEfFgGcsp%])')
+
+
+class DecodeError(Exception):
+    pass
+
+
+def read_elf_section(path, name):
+    """返回 (段地址, 段内容)；支持 32/64 位小端 ELF"""
+    with open(path, 'rb') as f:
+        data = f.read()
+    if data[:4] != b'\x7fELF':
+        raise DecodeError('%s 不是 ELF 文件' % path)
+    is64 = data[4] == 2
+    if data[5] != 1:
+        raise DecodeError('只支持小端 ELF')
+    if is64:
+        shoff, = struct.unpack_from('<Q', data, 0x28)
+        shentsize, shnum, shstrndx = struct.unpack_from('<HHH', data, 0x3A)
+        sh_fmt = '<IIQQQQIIQQ'
+    else:
+        shoff, = struct.unpack_from('<I', data, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from('<HHH', data, 0x2E)
+        sh_fmt = '<IIIIIIIIII'
+
+    def header(i):
+        return struct.unpack_from(sh_fmt, data, shoff + i * shentsize)
+
+    strtab = header(shstrndx)
+    str_off = strtab[4]
+    for i in range(shnum):
+        h = header(i)
+        end = data.index(b'\0', str_off + h[0])
+        if data[str_off + h[0]:end].decode() == name:
+            # sh_addr, sh_offset, sh_size
+            return h[3], data[h[4]:h[4] + h[5]]
+    raise DecodeError('ELF 中没有 %s 段（未启用 APP_LOG_TOKENIZED？）' % name)
+
+
+def build_table(addr, blob):
+    """段内每个以 NUL 结尾的串，以其链接地址为令牌"""
+    table = {}
+    pos = 0
+    while pos < len(blob):
+        if blob[pos] == 0:
+            pos += 1
+            continue
+        end = blob.index(b'\0', pos)
+        table[addr + pos] = blob[pos:end].decode('utf-8', errors='replace')
+        pos = end + 1
+    return table
+
+
+def format_message(fmt, payload):
+    """按格式串从 payload 取参数并格式化；参数字节数与格式不符时抛出 DecodeError"""
+    out = []
+    pos = 0
+    last = 0
+    for m in CONV_RE.finditer(fmt):
+        out.append(fmt[last:m.start()])
+        last = m.end()
+        flags, width, prec, length, conv = m.groups()
+        if conv == '%':
+            out.append('%')
+            continue
+        if width == '*' or prec == '*':
+            raise DecodeError('不支持 * 宽度/精度')
+        spec = '%' + (flags or '') + (width or '') + ('.' + prec if prec is not None else '')
+        if conv == 's':
+            if pos >= len(payload):
+                raise DecodeError('参数不足')
+            n = payload[pos]
+            s = payload[pos + 1:pos + 1 + n]
+            if len(s) != n or n > STR_MAX:
+                raise DecodeError('字符串参数越界')
+            pos += 1 + n
+            out.append((spec + 's') % s.decode('utf-8', errors='replace'))
+            continue
+        size = 8 if length == 'll' else 4
+        raw = payload[pos:pos + size]
+        if len(raw) != size:
+            raise DecodeError('参数不足')
+        pos += size
+        if conv in 'eEfFgG':
+            out.append((spec + conv) % struct.unpack('<f', raw)[0])
+        elif conv in 'di':
+            out.append((spec + 'd') % struct.unpack('<q' if size == 8 else '<i', raw)[0])
+        elif conv == 'c':
+            out.append((spec + 'c') % chr(struct.unpack('<I', raw)[0] & 0xFF))
+        elif conv == 'p':
+            out.append('0x%08x' % struct.unpack('<I', raw)[0])
+        else:
+            out.append((spec + ('d' if conv == 'u' else conv)) % struct.unpack('<Q' if size == 8 else '<I', raw)[0])
+    out.append(fmt[last:])
+    if pos != len(payload):
+        raise DecodeError('参数多余')
+    return ''.join(out)
+
+
+class Decoder:
+    def __init__(self, table, raw=False):
+        self.table = table
+        self.raw = raw
+        self.buf = bytearray()
+        self.pending_cr = False
+        self.frames = 0
+        self.bad = 0
+
+    def _undo_crlf(self, chunk):
+        # 逆变换 \n -> \r\n；块末尾的 \r 留到下一块再判断
+        if self.raw:
+            return chunk
+        if self.pending_cr:
+            chunk = b'\r' + chunk
+            self.pending_cr = False
+        if chunk.endswith(b'\r'):
+            chunk = chunk[:-1]
+            self.pending_cr = True
+        return chunk.replace(b'\r\n', b'\n')
+
+    def feed(self, chunk, final=False):
+        """输入原始字节，返回可输出的文本（bytes）"""
+        self.buf += self._undo_crlf(chunk)
+        if final and self.pending_cr:
+            self.buf += b'\r'
+            self.pending_cr = False
+        out = bytearray()
+        while self.buf:
+            i = self.buf.find(bytes([SYNC]))
+            if i < 0:
+                out += self.buf
+                self.buf.clear()
+                break
+            out += self.buf[:i]
+            del self.buf[:i]
+            if len(self.buf) < 2 or len(self.buf) < 2 + self.buf[1]:
+                if final:
+                    out += self.buf
+                    self.buf.clear()
+                break
+            n = self.buf[1]
+            frame = bytes(self.buf[2:2 + n])
+            text = None
+            if n >= 4:
+                token, = struct.unpack_from('<I', frame, 0)
+                fmt = self.table.get(token)
+                if fmt is not None:
+                    try:
+                        text = format_message(fmt, frame[4:])
+                    except DecodeError:
+                        text = None
+            if text is None:
+                # 不是有效帧：同步字节按普通文本处理，从下一字节重新同步
+                self.bad += 1
+                out += self.buf[:1]
+                del self.buf[:1]
+                continue
+            self.frames += 1
+            out += text.encode('utf-8')
+            del self.buf[:2 + n]
+        return bytes(out)
+
+
+def main():
+    ap = argparse.ArgumentParser(description='令牌化日志解码器')
+    src = ap.add_mutually_exclusive_group(required=True)
+    src.add_argument('--elf', help='固件 ELF（读取 %s 段）' % SECTION)
+    src.add_argument('--table', help='--export 导出的字符串表（JSON）')
+    ap.add_argument('--export', metavar='JSON', help='导出字符串表后退出')
+    ap.add_argument('--raw', action='store_true', help='链路未做 \\n -> \\r\\n 展开')
+    ap.add_argument('input', nargs='?', default='-', help='日志字节流文件（默认标准输入）')
+    args = ap.parse_args()
+
+    try:
+        if args.elf:
+            table = build_table(*read_elf_section(args.elf, SECTION))
+        else:
+            with open(args.table, encoding='utf-8') as f:
+                table = {int(k, 0): v for k, v in json.load(f).items()}
+    except (OSError, ValueError, DecodeError) as e:
+        print('错误: %s' % e, file=sys.stderr)
+        return 1
+
+    if args.export:
+        with open(args.export, 'w', encoding='utf-8') as f:
+            json.dump({'0x%08x' % k: v for k, v in sorted(table.items())}, f, ensure_ascii=False, indent=1)
+        print('导出 %d 条格式串 -> %s' % (len(table), args.export), file=sys.stderr)
+        return 0
+
+    dec = Decoder(table, args.raw)
+    stream = sys.stdin.buffer if args.input == '-' else open(args.input, 'rb')
+    out = sys.stdout.buffer
+    try:
+        while True:
+            chunk = stream.read1(4096) if hasattr(stream, 'read1') else stream.read(4096)
+            if not chunk:
+                break
+            out.write(dec.feed(chunk))
+            out.flush()
+        out.write(dec.feed(b'', final=True))
+    except KeyboardInterrupt:
+        pass
+    finally:
+        if stream is not sys.stdin.buffer:
+            stream.close()
+    print('\n[tlog] 帧 %d，无效 %d' % (dec.frames, dec.bad), file=sys.stderr)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
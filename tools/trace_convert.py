@@ -0,0 +1,480 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+内核事件追踪转换：把 trace dump 导出的 Percepio 快照记录区（board/rtos_trace.h）还原为
+时间线，输出任务/中断时间统计，并可转为 Tracealyzer 快照文件或 Perfetto / chrome://tracing JSON。
+
+输入（自动识别）：
+    串口文本      含 "[trc] begin / d / end" 行的 printf 日志（可带串口助手前缀），取最后一次完整导出
+    内存镜像      调试器导出的 RAM 镜像（按记录区起始标记定位，如 dump binary memory ram.bin ...）
+
+统计：
+    任务          CPU 占比、切入次数、最长连续运行（不含被中断时间）、就绪到运行延迟 p50/p99/最大、被中断次数与时间
+    中断          次数、平均/最长执行时间（中断入口到返回）
+    控制周期      ctrl 通道 "period" 用户事件的最小/平均/最大唤醒间隔
+
+用法：
+    trace_convert.py 日志输出.md                          终端摘要
+    trace_convert.py 日志输出.md --bin trace.bin          Tracealyzer：File → Open → trace.bin
+    trace_convert.py ram.bin --json trace.json            Perfetto（ui.perfetto.dev）或 chrome://tracing 打开
+    trace_convert.py 日志输出.md --csv slices.csv --events 用户事件逐条列出
+"""
+
+import argparse
+import json
+import re
+import struct
+import sys
+
+START_MARKER = bytes([0x01, 0x02, 0x03, 0x04, 0x71, 0x72, 0x73, 0x74, 0xF1, 0xF2, 0xF3, 0xF4])
+END_MARKER = bytes([0x0A, 0x0B, 0x0C, 0x0D, 0x71, 0x72, 0x73, 0x74, 0xF1, 0xF2, 0xF3, 0xF4])
+HEADER = struct.Struct('<HBBIIIIIIIIIIIIiI')    # 起始标记之后到对象表之前
+SYMBOL_TABLE_HEAD = struct.Struct('<II')
+SYSINFO_BYTES = 80
+
+CLASS_TASK = 3
+CLASS_ISR = 4
+
+# 事件类型（trcKernelPort.h）
+EV_NULL = 0x00
+EV_XPS = 0x01
+EV_TASK_READY = 0x02
+EV_ISR_BEGIN = 0x04
+EV_ISR_RESUME = 0x05
+EV_TASK_BEGIN = 0x06
+EV_TASK_RESUME = 0x07
+EV_USER_FIRST = 0x98
+EV_USER_LAST = 0xA7
+EV_XTS8 = 0xA8
+EV_XTS16 = 0xA9
+EV_BEING_WRITTEN = 0xAA
+EV_XID = 0xAE
+
+# 差分时间戳位置：默认为字节 2..3（16 位）
+NO_DTS = set([EV_NULL, EV_XPS, EV_BEING_WRITTEN, 0xAB, EV_XID]) | set(range(0x08, 0x18))
+# KernelCallWithParamAndHandle / TaskInstanceStatusEvent：字节 3（8 位）
+DTS8_AT3 = (set(range(0x8D, 0x90)) | set(range(0xB1, 0xB9)) | set(range(0xBA, 0xC2)) | set(range(0xC4, 0xCB)) |
+            set(range(0xCC, 0xD2)) | set(range(0xD3, 0xD9)))
+# KernelCallWithParam16（只带数值参数）：字节 1（8 位）
+DTS8_AT1 = set([0x03, 0x88, 0x89, 0xB9, 0xC3]) | set(range(0x40, 0x48)) | set(range(0x94, 0x98))
+
+ARG_RE = re.compile(r'%(%|[0-9#.]*(lf|hd|hu|bd|bu|[duxXsf]))')
+DUMP_BEGIN_RE = re.compile(r'\[trc\] begin size=(\d+)')
+DUMP_LINE_RE = re.compile(r'\[trc\] d ([0-9A-Fa-f]+) ([0-9A-Fa-f]+)')
+DUMP_END_RE = re.compile(r'\[trc\] end')
+
+
+class TraceError(Exception):
+    pass
+
+
+def load_text(data):
+    """串口文本：取最后一次 begin 之后的 d 行按偏移拼回记录区"""
+    text = data.decode('utf-8', errors='replace')
+    size = None
+    chunks = {}
+    complete = None
+    for line in text.splitlines():
+        m = DUMP_LINE_RE.search(line)
+        if m and size is not None:
+            chunks[int(m.group(1), 16)] = bytes.fromhex(m.group(2))
+            continue
+        m = DUMP_BEGIN_RE.search(line)
+        if m:
+            size = int(m.group(1))
+            chunks = {}
+            continue
+        if size is not None and DUMP_END_RE.search(line):
+            complete = (size, chunks)
+    if complete is None:
+        raise TraceError('没有完整的 trace dump 导出（缺少 [trc] begin/end）')
+    size, chunks = complete
+    buf = bytearray()
+    for off in sorted(chunks):
+        if off != len(buf):
+            raise TraceError('导出在偏移 0x%X 处缺失数据（串口丢字节？）' % len(buf))
+        buf += chunks[off]
+    if len(buf) != size:
+        raise TraceError('导出长度 %d 与表头 size=%d 不符' % (len(buf), size))
+    return bytes(buf)
+
+
+def load_image(data):
+    """内存镜像：按起始标记定位，用表头 filesize 截取并核对结束标记"""
+    pos = data.find(START_MARKER)
+    while pos >= 0:
+        if pos + 20 <= len(data):
+            size = struct.unpack_from('<I', data, pos + 16)[0]
+            end = pos + size
+            if size > len(START_MARKER) * 2 and end <= len(data) and data[end - len(END_MARKER):end] == END_MARKER:
+                return data[pos:end]
+        pos = data.find(START_MARKER, pos + 1)
+    raise TraceError('镜像中没有找到记录区（起始/结束标记不匹配）')
+
+
+def load(path):
+    with open(path, 'rb') as f:
+        data = f.read()
+    if b'[trc] begin' in data:
+        return load_text(data)
+    return load_image(data)
+
+
+class Snapshot:
+    """按 RecorderDataType 布局解析的快照"""
+
+    def __init__(self, buf):
+        if not buf.startswith(START_MARKER) or not buf.endswith(END_MARKER):
+            raise TraceError('记录区起始/结束标记错误')
+        (self.version, _, self.irq_order, self.filesize, self.num_events, self.max_events, self.next_free,
+         self.buffer_full, self.frequency, self.abs_time, self.abs_sec, self.active, _, _, _,
+         marker0, self.handles16) = HEADER.unpack_from(buf, 12)
+        if marker0 != -0x0F0F0F10:
+            raise TraceError('debugMarker0 错误（布局不符或数据损坏）')
+        if self.handles16:
+            raise TraceError('不支持 16 位对象句柄（TRC_CFG_USE_16BIT_OBJECT_HANDLES=1）')
+        self.buf = buf
+
+        off = 12 + HEADER.size
+        ncls, opt_size = struct.unpack_from('<II', buf, off)
+        n4 = 4 * ((ncls + 3) // 4)
+        n2 = 2 * ((ncls + 1) // 2)
+        p = off + 8
+        self.obj_count = list(buf[p:p + ncls])
+        p += n4
+        self.name_len = list(buf[p:p + ncls])
+        p += n4
+        self.prop_bytes = list(buf[p:p + ncls])
+        p += n4
+        self.class_start = list(struct.unpack_from('<%dH' % ncls, buf, p))
+        p += n2 * 2
+        self.objbytes = buf[p:p + opt_size]
+        p += 4 * ((opt_size + 3) // 4)
+        if struct.unpack_from('<I', buf, p)[0] != 0xF1F1F1F1:
+            raise TraceError('debugMarker1 错误')
+        p += 4
+        sym_size, self.sym_next = SYMBOL_TABLE_HEAD.unpack_from(buf, p)
+        p += SYMBOL_TABLE_HEAD.size
+        self.symbytes = buf[p:p + sym_size]
+        p += 4 * ((sym_size + 3) // 4) + 64 * 2
+        _, self.internal_error, marker2 = struct.unpack_from('<III', buf, p)
+        p += 12
+        if marker2 != 0xF2F2F2F2:
+            raise TraceError('debugMarker2 错误')
+        self.system_info = buf[p:p + SYSINFO_BYTES].split(b'\0', 1)[0].decode('utf-8', errors='replace')
+        p += SYSINFO_BYTES + 4
+        self.event_off = p
+        if p + self.max_events * 4 > len(buf):
+            raise TraceError('事件区超出记录区')
+
+    def object_name(self, cls, handle):
+        if cls >= len(self.class_start) or handle == 0 or handle > self.obj_count[cls]:
+            return None
+        p = self.class_start[cls] + (handle - 1) * self.prop_bytes[cls]
+        raw = self.objbytes[p:p + self.name_len[cls]].split(b'\0', 1)[0]
+        return raw.decode('utf-8', errors='replace') or None
+
+    def symbol(self, idx):
+        """符号表项：2 字节链表 + 2 字节所属通道 + 以 0 结尾的字符串"""
+        if idx == 0 or idx + 4 >= len(self.symbytes):
+            return '', 0
+        chn = struct.unpack_from('<H', self.symbytes, idx + 2)[0]
+        text = self.symbytes[idx + 4:].split(b'\0', 1)[0].decode('utf-8', errors='replace')
+        return text, chn
+
+    def slots(self):
+        """按时间顺序返回事件槽（环形缓冲回绕时从最老的槽开始）"""
+        ev = self.buf[self.event_off:self.event_off + self.max_events * 4]
+        if self.buffer_full:
+            order = list(range(self.next_free, self.max_events)) + list(range(0, self.next_free))
+        else:
+            order = range(0, self.next_free)
+        return [ev[i * 4:i * 4 + 4] for i in order]
+
+
+def format_user_event(snap, fmt, data):
+    """按格式串从参数字节（4 字节对齐规则同 trcSnapshotRecorder.c）还原文本"""
+    pos = 0
+    out = []
+    last = 0
+    for m in ARG_RE.finditer(fmt):
+        out.append(fmt[last:m.start()])
+        last = m.end()
+        spec = m.group(2)
+        if m.group(1) == '%':
+            out.append('%')
+            continue
+        if spec in ('hd', 'hu', 's'):
+            pos += pos % 2
+            size = 2
+        elif spec in ('bd', 'bu'):
+            size = 1
+        else:
+            pos += (4 - pos % 4) % 4
+            size = 8 if spec == 'lf' else 4
+        raw = data[pos:pos + size]
+        pos += size
+        if len(raw) < size:
+            out.append('?')
+            continue
+        if spec == 's':
+            out.append(snap.symbol(struct.unpack('<H', raw)[0])[0])
+        elif spec in ('f', 'lf'):
+            out.append('?')     # 记录器未开启浮点支持
+        else:
+            v = int.from_bytes(raw, 'little')
+            if spec.endswith('d'):
+                v -= (1 << (size * 8)) if v >> (size * 8 - 1) else 0
+                out.append(str(v))
+            elif spec in ('x', 'X'):
+                out.append(('%' + spec) % v)
+            else:
+                out.append(str(v))
+    out.append(fmt[last:])
+    return ''.join(out)
+
+
+def decode_events(snap):
+    """展开差分时间戳，返回 (tick, kind, handle, extra) 列表；tick 从缓冲区最老事件起算"""
+    events = []
+    tick = 0
+    xts = None
+    slots = snap.slots()
+    i = 0
+    while i < len(slots):
+        s = slots[i]
+        code = s[0]
+        i += 1
+        if code == EV_XTS8:
+            xts = (s[1] << 24) | (struct.unpack_from('<H', s, 2)[0] << 8)
+            continue
+        if code == EV_XTS16:
+            xts = struct.unpack_from('<H', s, 2)[0] << 16
+            continue
+        if code in NO_DTS:
+            continue
+        if EV_USER_FIRST <= code <= EV_USER_LAST:
+            extra = code - EV_USER_FIRST
+            data = b''.join(slots[i:i + extra])
+            i += extra
+            dts = s[1]
+        elif code in DTS8_AT3:
+            dts = s[3]
+        elif code in DTS8_AT1:
+            dts = s[1]
+        else:
+            dts = struct.unpack_from('<H', s, 2)[0]
+        if xts is not None:
+            dts |= xts
+            xts = None
+        tick += dts
+        if EV_USER_FIRST <= code <= EV_USER_LAST:
+            fmt, chn = snap.symbol(struct.unpack_from('<H', s, 2)[0])
+            channel = snap.symbol(chn)[0] if chn else ''
+            events.append((tick, 'user', channel, format_user_event(snap, fmt, s[4:] + data)))
+        elif code in (EV_TASK_BEGIN, EV_TASK_RESUME):
+            events.append((tick, 'task', s[1], code == EV_TASK_BEGIN))
+        elif code in (EV_ISR_BEGIN, EV_ISR_RESUME):
+            events.append((tick, 'isr', s[1], code == EV_ISR_BEGIN))
+        elif code == EV_TASK_READY:
+            events.append((tick, 'ready', s[1], None))
+    return events
+
+
+class Timeline:
+    """由切换事件重建的执行片段与统计"""
+
+    def __init__(self, snap, events):
+        self.snap = snap
+        self.slices = []        # (start, end, kind, handle)
+        self.user = []          # (tick, context_kind, context_handle, channel, text)
+        self.latency = {}       # 任务 -> [就绪到运行 tick]
+        self.runs = {}          # 任务 -> [连续运行 tick（不含中断）]
+        self.switch_in = {}
+        self.preempt = {}       # 任务 -> [被中断次数, 中断 tick]
+        self.span = (events[0][0], events[-1][0]) if events else (0, 0)
+        ready_at = {}
+        cur = None              # 当前执行上下文 (kind, handle)
+        start = 0
+        task = None             # 最近运行的任务
+        run_acc = 0
+        isr_stack = []
+
+        def close(t):
+            if cur is not None and t > start:
+                self.slices.append((start, t, cur[0], cur[1]))
+                if cur[0] == 'task':
+                    return t - start
+                if task is not None:
+                    self.preempt.setdefault(task, [0, 0])[1] += t - start
+            return 0
+
+        for t, kind, h, extra in events:
+            if kind == 'user':
+                ctx = cur if cur is not None else ('task', 0)
+                self.user.append((t, ctx[0], ctx[1], h, extra))
+                continue
+            if kind == 'ready':
+                ready_at.setdefault(h, t)
+                continue
+            run_acc += close(t)
+            if kind == 'task':
+                isr_stack = []
+                if h != task:
+                    if task is not None:
+                        self.runs.setdefault(task, []).append(run_acc)
+                    run_acc = 0
+                    self.switch_in[h] = self.switch_in.get(h, 0) + 1
+                    if h in ready_at:
+                        self.latency.setdefault(h, []).append(t - ready_at[h])
+                ready_at.pop(h, None)
+                task = h
+                cur = ('task', h)
+            else:
+                if extra:
+                    isr_stack.append(h)
+                    if task is not None and len(isr_stack) == 1:
+                        self.preempt.setdefault(task, [0, 0])[0] += 1
+                elif isr_stack:
+                    isr_stack.pop()
+                cur = ('isr', h)
+            start = t
+        run_acc += close(self.span[1])
+        if task is not None:
+            self.runs.setdefault(task, []).append(run_acc)
+
+    def name(self, kind, handle):
+        cls = CLASS_TASK if kind == 'task' else CLASS_ISR
+        n = self.snap.object_name(cls, handle)
+        return n if n else '%s#%d' % (kind, handle)
+
+
+def percentile(values, q):
+    if not values:
+        return 0
+    v = sorted(values)
+    return v[min(len(v) - 1, int(q * (len(v) - 1) + 0.5))]
+
+
+def summary(snap, tl, freq, tick_us):
+    us = lambda ticks: ticks * 1e6 / freq    # noqa: E731
+    span = tl.span[1] - tl.span[0]
+    print('记录区 %d/%d 事件槽%s，时钟 %d Hz，跨度 %.1f ms%s' % (
+        snap.num_events, snap.max_events, '（已回绕）' if snap.buffer_full else '', freq,
+        us(span) / 1000.0, '' if snap.active else '，已停止'))
+    if snap.internal_error:
+        print('记录器错误: %s' % snap.system_info)
+
+    busy = {}
+    for s, e, kind, h in tl.slices:
+        busy[(kind, h)] = busy.get((kind, h), 0) + e - s
+    print('%-16s %6s %6s %10s %24s %14s' % ('任务', 'CPU%', '切入', '最长运行us', '就绪延迟 p50/p99/max us', '被中断 次/us'))
+    tasks = sorted(set(h for k, h in busy if k == 'task') | set(tl.switch_in), key=lambda h: -busy.get(('task', h), 0))
+    for h in tasks:
+        lat = tl.latency.get(h, [])
+        pre = tl.preempt.get(h, [0, 0])
+        print('%-16s %6.1f %6d %10.0f %8.0f/%6.0f/%8.0f %6d/%7.0f' % (
+            tl.name('task', h), 100.0 * busy.get(('task', h), 0) / span if span else 0, tl.switch_in.get(h, 0),
+            us(max(tl.runs.get(h, [0]))), us(percentile(lat, 0.5)), us(percentile(lat, 0.99)),
+            us(max(lat) if lat else 0), pre[0], us(pre[1])))
+
+    isr = {}
+    for s, e, kind, h in tl.slices:
+        if kind == 'isr':
+            isr.setdefault(h, []).append(e - s)
+    if isr:
+        print('%-16s %6s %10s %10s' % ('中断', '次数', '平均us', '最长us'))
+        for h in sorted(isr):
+            d = isr[h]
+            print('%-16s %6d %10.1f %10.1f' % (tl.name('isr', h), len(d), us(sum(d) / len(d)), us(max(d))))
+
+    periods = []
+    for _, _, _, ch, text in tl.user:
+        m = re.match(r'period (\d+) us', text)
+        if ch == 'ctrl' and m:
+            periods.append(int(m.group(1)))
+    if periods:
+        over = sum(1 for p in periods if p > tick_us)
+        print('控制周期 %d 次：min %d / avg %.0f / max %d us，超过 %d us %d 次' % (
+            len(periods), min(periods), sum(periods) / len(periods), max(periods), tick_us, over))
+    counts = {}
+    for _, _, _, ch, _ in tl.user:
+        counts[ch] = counts.get(ch, 0) + 1
+    if counts:
+        print('用户事件: ' + ', '.join('%s=%d' % kv for kv in sorted(counts.items())))
+
+
+def write_json(path, tl, freq):
+    """Chrome Trace Event 格式：每个任务/中断一条轨道，执行片段为 X，用户事件为 i"""
+    to_us = lambda t: (t - tl.span[0]) * 1e6 / freq    # noqa: E731
+    tid = lambda kind, h: h if kind == 'task' else 1000 + h    # noqa: E731
+    ev = []
+    seen = set()
+    for s, e, kind, h in tl.slices:
+        seen.add((kind, h))
+        ev.append({'name': tl.name(kind, h), 'cat': kind, 'ph': 'X', 'pid': 1, 'tid': tid(kind, h),
+                   'ts': to_us(s), 'dur': to_us(e) - to_us(s)})
+    for t, kind, h, ch, text in tl.user:
+        seen.add((kind, h))
+        ev.append({'name': text, 'cat': ch, 'ph': 'i', 's': 't', 'pid': 1, 'tid': tid(kind, h), 'ts': to_us(t)})
+    for kind, h in seen:
+        ev.append({'name': 'thread_name', 'ph': 'M', 'pid': 1, 'tid': tid(kind, h), 'args': {'name': tl.name(kind, h)}})
+        ev.append({'name': 'thread_sort_index', 'ph': 'M', 'pid': 1, 'tid': tid(kind, h),
+                   'args': {'sort_index': tid(kind, h)}})
+    ev.append({'name': 'process_name', 'ph': 'M', 'pid': 1, 'args': {'name': 'EAM2011 FreeRTOS'}})
+    with open(path, 'w') as f:
+        json.dump({'traceEvents': ev, 'displayTimeUnit': 'ns'}, f, ensure_ascii=False)
+
+
+def write_csv(path, tl, freq):
+    with open(path, 'w') as f:
+        f.write('start_us,end_us,kind,name\n')
+        for s, e, kind, h in tl.slices:
+            f.write('%.2f,%.2f,%s,%s\n' % ((s - tl.span[0]) * 1e6 / freq, (e - tl.span[0]) * 1e6 / freq, kind,
+                                           tl.name(kind, h)))
+
+
+def main():
+    ap = argparse.ArgumentParser(description='内核事件追踪转换（Percepio 快照 → 统计 / Tracealyzer / Perfetto）')
+    ap.add_argument('input', help='含 trace dump 的串口日志，或 RAM 镜像')
+    ap.add_argument('--bin', metavar='FILE', help='写出原始记录区（Tracealyzer 直接打开）')
+    ap.add_argument('--json', metavar='FILE', help='Chrome Trace Event JSON（Perfetto / chrome://tracing）')
+    ap.add_argument('--csv', metavar='FILE', help='执行片段 CSV')
+    ap.add_argument('--events', action='store_true', help='逐条列出用户事件')
+    ap.add_argument('--freq', type=int, help='时间戳频率（Hz），覆盖记录区中的值')
+    ap.add_argument('--tick-us', type=int, default=22000,
+                    help='控制周期超时阈值（us，默认 MISSION_TICK_MS + RTOS_TRACE_OVERRUN_US = 22000）')
+    args = ap.parse_args()
+
+    try:
+        buf = load(args.input)
+        snap = Snapshot(buf)
+    except (OSError, TraceError, struct.error) as e:
+        print('错误: %s' % e, file=sys.stderr)
+        return 1
+    freq = args.freq or snap.frequency
+    if freq == 0:
+        print('错误: 记录区时间戳频率为 0（没有记录到事件？），用 --freq 指定', file=sys.stderr)
+        return 1
+
+    if args.bin:
+        with open(args.bin, 'wb') as f:
+            f.write(buf)
+    events = decode_events(snap)
+    if not events:
+        print('错误: 记录区中没有事件', file=sys.stderr)
+        return 1
+    tl = Timeline(snap, events)
+    if args.json:
+        write_json(args.json, tl, freq)
+    if args.csv:
+        write_csv(args.csv, tl, freq)
+    summary(snap, tl, freq, args.tick_us)
+    if args.events:
+        for t, kind, h, ch, text in tl.user:
+            print('%12.1f us  %-10s %-8s %s' % ((t - tl.span[0]) * 1e6 / freq, tl.name(kind, h), ch, text))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())